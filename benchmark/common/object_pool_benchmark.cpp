@@ -0,0 +1,80 @@
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/object_pool.h"
+#include "common/scoped_timer.h"
+#include "common/sharded_object_pool.h"
+#include "common/worker_pool.h"
+#include "storage/record_buffer.h"
+#include "test_util/multithread_test_util.h"
+
+namespace terrier {
+
+/**
+ * Compares the throughput of ObjectPool and ShardedObjectPool as the number of threads getting and releasing objects
+ * grows. Every thread repeatedly gets a few buffer segments and releases them again, like a transaction does with its
+ * undo buffer.
+ */
+class ObjectPoolBenchmark : public benchmark::Fixture {
+ public:
+  template <class Pool>
+  void GetRelease(benchmark::State *const state) {
+    const auto num_threads = static_cast<uint32_t>(state->range(0));
+    common::WorkerPool thread_pool(num_threads, {});
+    Pool pool(size_limit_, reuse_limit_);
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      auto workload = [&](uint32_t) {
+        std::vector<storage::RecordBufferSegment *> segments;
+        segments.reserve(segments_per_txn_);
+        for (uint32_t txn = 0; txn < num_txns_; txn++) {
+          for (uint32_t i = 0; i < segments_per_txn_; i++) segments.push_back(pool.Get());
+          for (auto *segment : segments) pool.Release(segment);
+          segments.clear();
+        }
+      };
+      uint64_t elapsed_ms;
+      {
+        common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+        MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+    state->SetItemsProcessed(state->iterations() * num_threads * num_txns_ * segments_per_txn_);
+  }
+
+  const uint64_t size_limit_ = 100000;
+  const uint64_t reuse_limit_ = 10000;
+  const uint32_t num_txns_ = 100000;
+  const uint32_t segments_per_txn_ = 4;
+};
+
+/**
+ * Get and release objects from a pool behind a single latch
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ObjectPoolBenchmark, SingleLatch)(benchmark::State &state) {
+  GetRelease<common::ObjectPool<storage::RecordBufferSegment, storage::RecordBufferSegmentAllocator>>(&state);
+}
+
+/**
+ * Get and release objects from a pool split into shards
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(ObjectPoolBenchmark, Sharded)(benchmark::State &state) {
+  GetRelease<common::ShardedObjectPool<storage::RecordBufferSegment, storage::RecordBufferSegmentAllocator>>(&state);
+}
+
+// clang-format off
+BENCHMARK_REGISTER_F(ObjectPoolBenchmark, SingleLatch)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_REGISTER_F(ObjectPoolBenchmark, Sharded)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+// clang-format on
+}  // namespace terrier
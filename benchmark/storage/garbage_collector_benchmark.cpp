@@ -91,6 +91,46 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, UnlinkTime)(benchmark::State &stat
   state.SetItemsProcessed(state.iterations() * num_txns_);
 }
 
+// Same as UnlinkTime, but the GC splits the unlinking across the given number of worker threads
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, ParallelUnlinkTime)(benchmark::State &state) {
+  const auto num_gc_threads = static_cast<uint32_t>(state.range(0));
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    // generate our table and instantiate GC
+    LargeDataTableBenchmarkObject tested({8, 8, 8}, initial_table_size_, txn_length_, update_select_ratio_,
+                                         &block_store_, &buffer_pool_, &generator_, true);
+    gc_ = new storage::GarbageCollector(common::ManagedPointer(tested.GetTimestampManager()), DISABLED,
+                                        common::ManagedPointer(tested.GetTxnManager()), DISABLED, num_gc_threads);
+
+    // clean up insert txn
+    gc_->PerformGarbageCollection();
+    gc_->PerformGarbageCollection();
+
+    // run all txns
+    tested.SimulateOltp(num_txns_, num_concurrent_txns_);
+
+    // time just the unlinking process, verify nothing deallocated
+    uint64_t elapsed_ms;
+    std::pair<uint32_t, uint32_t> result;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      result = gc_->PerformGarbageCollection();
+    }
+    EXPECT_EQ(result.first, 0);
+    EXPECT_EQ(result.second, num_txns_);
+
+    // run another GC pass to perform deallocation, verify nothing unlinked
+    result = gc_->PerformGarbageCollection();
+    EXPECT_EQ(result.second, 0);
+
+    delete gc_;
+
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_txns_);
+}
+
 // Create a table with 100,000 tuples, then run 100,000 txns running update statements. Then run GC and profile how long
 // the deallocation stage takes for those txns
 // NOLINTNEXTLINE
@@ -155,6 +195,13 @@ BENCHMARK_DEFINE_F(GarbageCollectorBenchmark, HighContention)(benchmark::State &
 }
 
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, UnlinkTime)->Unit(benchmark::kMillisecond)->UseManualTime()->MinTime(1);
+BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ParallelUnlinkTime)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8);
 BENCHMARK_REGISTER_F(GarbageCollectorBenchmark, ReclaimTime)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
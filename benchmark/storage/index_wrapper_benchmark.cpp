@@ -1,6 +1,10 @@
+#include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include <tbb/task_arena.h>
+
 #include "benchmark/benchmark.h"
 #include "common/scoped_timer.h"
 #include "parser/expression/column_value_expression.h"
@@ -41,6 +45,10 @@ class IndexBenchmark : public benchmark::Fixture {
   // Table size chosen to exceed L3 cache size on benchmark machine
   const uint32_t table_size_ = 100000000;
 
+  // Number of keys loaded by the bulk load benchmarks, kept smaller than the table so that every iteration can build
+  // a new index
+  const uint32_t bulk_load_size_ = 10000000;
+
   // SqlTable
   storage::SqlTable *sql_table_;
   storage::ProjectedRowInitializer tuple_initializer_ =
@@ -166,6 +174,40 @@ class IndexBenchmark : public benchmark::Fixture {
     txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
     return total_ns;
   }
+
+  // Bulk load bulk_load_size_ shuffled keys into a fresh index of the given type, using at most num_threads threads as
+  // a parallel CREATE INDEX would; scoped timer only times the BulkLoad call
+  uint64_t RunBulkLoadWorkload(const storage::index::IndexType type, const int num_threads) {
+    CreateIndex(type);
+    const auto &initializer = index_->GetProjectedRowInitializer();
+    const auto key_size = initializer.ProjectedRowSize();
+    auto *const keys = common::AllocationUtil::AllocateAligned(key_size * bulk_load_size_);
+
+    std::vector<uint32_t> values(bulk_load_size_);
+    for (uint32_t i = 0; i < bulk_load_size_; i++) values[i] = i;
+    std::shuffle(values.begin(), values.end(), generator_);
+
+    // The values don't matter to the index, so every key shares one slot
+    std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> entries;
+    entries.reserve(bulk_load_size_);
+    for (uint32_t i = 0; i < bulk_load_size_; i++) {
+      auto *const key = initializer.InitializeRow(keys + i * key_size);
+      *reinterpret_cast<uint32_t *>(key->AccessForceNotNull(0)) = values[i];
+      entries.emplace_back(key, storage::TupleSlot());
+    }
+
+    auto *const load_txn = txn_manager_->BeginTransaction();
+    uint64_t elapsed_ns = 0;
+    tbb::task_arena arena(num_threads);
+    {
+      common::ScopedTimer<std::chrono::nanoseconds> timer(&elapsed_ns);
+      arena.execute([&] { EXPECT_TRUE(index_->BulkLoad(common::ManagedPointer(load_txn), entries)); });
+    }
+    txn_manager_->Commit(load_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    delete[] keys;
+    return elapsed_ns;
+  }
 };
 
 // Determine required time to run key lookup with BwTree structure for index
@@ -199,6 +241,53 @@ BENCHMARK_DEFINE_F(IndexBenchmark, HashIndexRandomScanKey)(benchmark::State &sta
   state.SetItemsProcessed(state.iterations() * table_size_);
 }
 
+// Determine required time to run key lookup with adaptive radix tree structure for index
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(IndexBenchmark, ArtIndexRandomScanKey)(benchmark::State &state) {
+  CreateIndex(storage::index::IndexType::ART);
+  PopulateTableAndIndex();
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    // Run key lookup and record amount of time required in seconds
+    const auto total_ns = RunWorkload();
+    state.SetIterationTime(static_cast<double>(total_ns) / 1000000000.0);
+  }
+  // Determine total number of items processed
+  state.SetItemsProcessed(state.iterations() * table_size_);
+}
+
+// Determine required time to bulk load a BwTree index with a given number of threads
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(IndexBenchmark, BwTreeIndexBulkLoad)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    const auto total_ns = RunBulkLoadWorkload(storage::index::IndexType::BWTREE, static_cast<int>(state.range(0)));
+    state.SetIterationTime(static_cast<double>(total_ns) / 1000000000.0);
+    gc_thread_->GetGarbageCollector()->UnregisterIndexForGC(index_);
+    delete[] key_buffer_;
+    delete index_.Get();
+  }
+  state.SetItemsProcessed(state.iterations() * bulk_load_size_);
+  // TearDown unregisters the index and frees the key buffer made by the last call to CreateIndex
+  CreateIndex(storage::index::IndexType::BWTREE);
+}
+
+// Determine required time to bulk load an adaptive radix tree index with a given number of threads
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(IndexBenchmark, ArtIndexBulkLoad)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    const auto total_ns = RunBulkLoadWorkload(storage::index::IndexType::ART, static_cast<int>(state.range(0)));
+    state.SetIterationTime(static_cast<double>(total_ns) / 1000000000.0);
+    gc_thread_->GetGarbageCollector()->UnregisterIndexForGC(index_);
+    delete[] key_buffer_;
+    delete index_.Get();
+  }
+  state.SetItemsProcessed(state.iterations() * bulk_load_size_);
+  // TearDown unregisters the index and frees the key buffer made by the last call to CreateIndex
+  CreateIndex(storage::index::IndexType::ART);
+}
+
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
@@ -209,6 +298,19 @@ BENCHMARK_REGISTER_F(IndexBenchmark, BwTreeIndexRandomScanKey)
 BENCHMARK_REGISTER_F(IndexBenchmark, HashIndexRandomScanKey)
     ->UseManualTime()
     ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(IndexBenchmark, ArtIndexRandomScanKey)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(IndexBenchmark, BwTreeIndexBulkLoad)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(IndexBenchmark, ArtIndexBulkLoad)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond);
 // clang-format on
 
 }  // namespace terrier
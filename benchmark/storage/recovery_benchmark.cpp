@@ -27,8 +27,10 @@ class RecoveryBenchmark : public benchmark::Fixture {
    * Runs the recovery benchmark with the provided config
    * @param state benchmark state
    * @param config config to use for test object
+   * @param num_replay_threads number of threads the recovery manager replays changes with
    */
-  void RunBenchmark(benchmark::State *state, const LargeSqlTableTestConfiguration &config) {
+  void RunBenchmark(benchmark::State *state, const LargeSqlTableTestConfiguration &config,
+                    const uint32_t num_replay_threads = 1) {
     // NOLINTNEXTLINE
     for (auto _ : *state) {
       // Blow away log file after every benchmark iteration
@@ -72,7 +74,7 @@ class RecoveryBenchmark : public benchmark::Fixture {
       storage::DiskLogProvider log_provider(terrier::BenchmarkConfig::logfile_path.data());
       storage::RecoveryManager recovery_manager(
           common::ManagedPointer<storage::AbstractLogProvider>(&log_provider), recovery_catalog, recovery_txn_manager,
-          recovery_deferred_action_manager, recovery_thread_registry, recovery_block_store);
+          recovery_deferred_action_manager, recovery_thread_registry, recovery_block_store, num_replay_threads);
 
       uint64_t elapsed_ms;
       {
@@ -127,6 +129,25 @@ BENCHMARK_DEFINE_F(RecoveryBenchmark, HighStress)(benchmark::State &state) {
   RunBenchmark(&state, config);
 }
 
+/**
+ * Insert-heavy workload spread across many tables (5 statements per txn, 80% inserts, 20% updates). state.range(0) is
+ * the number of threads used to replay the log, so the results show how recovery scales with replay parallelism.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(RecoveryBenchmark, MultiTableParallelReplay)(benchmark::State &state) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(16)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(initial_table_size_ / 16)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.8, 0.2, 0.0, 0.0})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+
+  RunBenchmark(&state, config, static_cast<uint32_t>(state.range(0)));
+}
+
 /**
  * Similar to high-stress workload, blast a narrow table with inserts (1 statements per txn, 100% inserts), but also
  * recovery indexes built on the table
@@ -250,6 +271,14 @@ BENCHMARK_REGISTER_F(RecoveryBenchmark, HighStress)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(10);
+BENCHMARK_REGISTER_F(RecoveryBenchmark, MultiTableParallelReplay)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(10)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8);
 BENCHMARK_REGISTER_F(RecoveryBenchmark, IndexRecovery)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
@@ -1556,6 +1556,8 @@ bool DatabaseCatalog::CreateIndexEntry(const common::ManagedPointer<transaction:
       indexes_insert_pr->AccessForceNotNull(pg_index_all_cols_prm_[postgres::INDISLIVE_COL_OID]))) = true;
   *(reinterpret_cast<storage::index::IndexType *>(
       indexes_insert_pr->AccessForceNotNull(pg_index_all_cols_prm_[postgres::IND_TYPE_COL_OID]))) = schema.type_;
+  *(reinterpret_cast<uint16_t *>(indexes_insert_pr->AccessForceNotNull(
+      pg_index_all_cols_prm_[postgres::IND_NUM_INCLUDE_COL_OID]))) = schema.num_include_columns_;
 
   // Insert into pg_index table
   const auto indexes_tuple_slot = indexes_->Insert(txn, indexes_insert_redo);
@@ -1601,7 +1603,8 @@ bool DatabaseCatalog::CreateIndexEntry(const common::ManagedPointer<transaction:
   std::vector<IndexSchema::Column> cols =
       GetColumns<IndexSchema::Column, index_oid_t, indexkeycol_oid_t>(txn, index_oid);
   auto *new_schema =
-      new IndexSchema(cols, schema.Type(), schema.Unique(), schema.Primary(), schema.Exclusion(), schema.Immediate());
+      new IndexSchema(cols, schema.Type(), schema.Unique(), schema.Primary(), schema.Exclusion(), schema.Immediate(),
+                      schema.NumIncludeColumns());
   txn->RegisterAbortAction([=]() { delete new_schema; });
 
   auto *const update_redo = txn->StageWrite(db_oid_, postgres::CLASS_TABLE_OID, set_class_schema_pri_);
@@ -34,6 +34,7 @@ nlohmann::json IndexSchema::ToJson() const {
   j["primary"] = is_primary_;
   j["exclusion"] = is_exclusion_;
   j["immediate"] = is_immediate_;
+  j["num_include_columns"] = num_include_columns_;
   return j;
 }
 
@@ -49,8 +50,10 @@ std::unique_ptr<IndexSchema> IndexSchema::DeserializeSchema(const nlohmann::json
   auto exclusion = j.at("exclusion").get<bool>();
   auto immediate = j.at("immediate").get<bool>();
   auto type = static_cast<storage::index::IndexType>(j.at("type").get<char>());
+  auto num_include_columns = j.at("num_include_columns").get<uint16_t>();
 
-  auto schema = std::make_unique<IndexSchema>(columns, type, unique, primary, exclusion, immediate);
+  auto schema =
+      std::make_unique<IndexSchema>(columns, type, unique, primary, exclusion, immediate, num_include_columns);
 
   return schema;
 }
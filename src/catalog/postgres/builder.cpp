@@ -291,6 +291,10 @@ Schema Builder::GetIndexTableSchema() {
                        parser::ConstantValueExpression(type::TypeId::TINYINT));
   columns.back().SetOid(IND_TYPE_COL_OID);
 
+  columns.emplace_back("numinclude", type::TypeId::SMALLINT, false,
+                       parser::ConstantValueExpression(type::TypeId::SMALLINT));
+  columns.back().SetOid(IND_NUM_INCLUDE_COL_OID);
+
   return Schema(columns);
 }
 
@@ -0,0 +1,97 @@
+#include "common/numa.h"
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace terrier::common {
+
+namespace {
+
+// Parses a list of CPUs in the format sysfs uses, e.g. "0-3,8,10-11"
+std::vector<uint32_t> ParseCpuList(const std::string &list) {
+  std::vector<uint32_t> result;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos) end = list.size();
+    const std::string range = list.substr(pos, end - pos);
+    const size_t dash = range.find('-');
+    const auto first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+    const auto last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+    for (uint32_t cpu = first; cpu <= last; cpu++) result.push_back(cpu);
+    pos = end + 1;
+  }
+  return result;
+}
+
+struct NumaTopology {
+  NumaTopology() {
+    // Nodes are numbered contiguously from 0, except on machines with offline nodes, where we only use the nodes
+    // before the first gap
+    for (uint16_t node = 0; node < NumaUtil::ANY_NODE; node++) {
+      std::ifstream cpulist("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      if (!cpulist.is_open()) break;
+      std::string list;
+      std::getline(cpulist, list);
+      node_cpus_.push_back(ParseCpuList(list));
+      for (const uint32_t cpu : node_cpus_.back()) {
+        if (cpu >= cpu_nodes_.size()) cpu_nodes_.resize(cpu + 1, 0);
+        cpu_nodes_[cpu] = node;
+      }
+    }
+    // No NUMA support, everything is on the same node
+    if (node_cpus_.empty()) node_cpus_.emplace_back();
+  }
+
+  std::vector<std::vector<uint32_t>> node_cpus_;
+  std::vector<uint16_t> cpu_nodes_;
+};
+
+const NumaTopology &Topology() {
+  static const NumaTopology topology;
+  return topology;
+}
+
+}  // namespace
+
+uint16_t NumaUtil::NumNodes() { return static_cast<uint16_t>(Topology().node_cpus_.size()); }
+
+uint16_t NumaUtil::CurrentNode() {
+  const NumaTopology &topology = Topology();
+  // Unlike getcpu, sched_getcpu does not need to enter the kernel on most platforms
+  const int cpu = sched_getcpu();
+  if (cpu < 0 || static_cast<uint32_t>(cpu) >= topology.cpu_nodes_.size()) return 0;
+  return topology.cpu_nodes_[cpu];
+}
+
+void NumaUtil::BindMemory(void *const addr, const uint64_t size, const uint16_t node) {
+  if (NumNodes() <= 1 || node >= NumNodes()) return;
+  constexpr uint32_t bits_per_word = 8 * sizeof(uint64_t);
+  std::vector<uint64_t> node_mask(node / bits_per_word + 1, 0);
+  node_mask[node / bits_per_word] |= uint64_t(1) << (node % bits_per_word);
+  // The kernel ignores the last bit of the mask, hence the extra bit. Failure is fine, the memory simply stays where
+  // the kernel would have put it anyway.
+  syscall(SYS_mbind, addr, size, MPOL_PREFERRED, node_mask.data(), node_mask.size() * bits_per_word + 1,
+          MPOL_MF_MOVE);
+}
+
+NumaUtil::ScopedNodeBinding::ScopedNodeBinding(const uint16_t node) {
+  if (NumNodes() <= 1 || node >= NumNodes()) return;
+  if (sched_getaffinity(0, sizeof(previous_cpus_), &previous_cpus_) != 0) return;
+  cpu_set_t node_cpus;
+  CPU_ZERO(&node_cpus);
+  for (const uint32_t cpu : Topology().node_cpus_[node])
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &node_cpus);
+  bound_ = sched_setaffinity(0, sizeof(node_cpus), &node_cpus) == 0;
+}
+
+NumaUtil::ScopedNodeBinding::~ScopedNodeBinding() {
+  if (bound_) sched_setaffinity(0, sizeof(previous_cpus_), &previous_cpus_);
+}
+
+}  // namespace terrier::common
@@ -6,6 +6,7 @@
 #include "execution/ast/context.h"
 #include "execution/ast/type.h"
 #include "execution/compiler/executable_query_builder.h"
+#include "execution/sql/table_vector_iterator.h"
 #include "spdlog/fmt/fmt.h"
 #include "storage/index/index_defs.h"
 
@@ -173,10 +174,16 @@ ast::Expr *CodeGen::ArrayType(uint64_t num_elems, ast::BuiltinType::Kind kind) {
   return GetFactory()->NewArrayType(position_, Const64(num_elems), BuiltinType(kind));
 }
 
+ast::Expr *CodeGen::ArrayType(uint64_t num_elems, ast::Expr *elem_type) {
+  return GetFactory()->NewArrayType(position_, Const64(num_elems), elem_type);
+}
+
 ast::Expr *CodeGen::ArrayAccess(ast::Identifier arr, uint64_t idx) {
   return GetFactory()->NewIndexExpr(position_, MakeExpr(arr), Const64(idx));
 }
 
+ast::Expr *CodeGen::ArrayAccess(ast::Expr *arr, ast::Expr *idx) { return GetFactory()->NewIndexExpr(position_, arr, idx); }
+
 ast::Expr *CodeGen::TplType(sql::TypeId type) {
   switch (type) {
     case sql::TypeId::Boolean:
@@ -381,8 +388,12 @@ ast::Expr *CodeGen::StringToSql(std::string_view str) const {
 
 ast::Expr *CodeGen::IndexIteratorInit(ast::Identifier iter, ast::Expr *exec_ctx_var, uint32_t num_attrs,
                                       uint32_t table_oid, uint32_t index_oid, ast::Identifier col_oids) {
+  return IndexIteratorInit(AddressOf(iter), exec_ctx_var, num_attrs, table_oid, index_oid, col_oids);
+}
+
+ast::Expr *CodeGen::IndexIteratorInit(ast::Expr *iter_ptr, ast::Expr *exec_ctx_var, uint32_t num_attrs,
+                                      uint32_t table_oid, uint32_t index_oid, ast::Identifier col_oids) {
   // @indexIteratorInit(&iter, table_oid, index_oid, execCtx)
-  ast::Expr *iter_ptr = AddressOf(iter);
   ast::Expr *num_attrs_expr = Const32(static_cast<int32_t>(num_attrs));
   ast::Expr *table_oid_expr = Const32(static_cast<int32_t>(table_oid));
   ast::Expr *index_oid_expr = Const32(static_cast<int32_t>(index_oid));
@@ -552,6 +563,35 @@ ast::Expr *CodeGen::TableIterClose(ast::Expr *table_iter) {
   return call;
 }
 
+ast::Expr *CodeGen::TableIterAddZoneFilter(ast::Expr *table_iter, parser::ExpressionType comp_type, uint32_t col_idx,
+                                           ast::Expr *filter_val) {
+  sql::ZoneFilterComparison comparison;
+  switch (comp_type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      comparison = sql::ZoneFilterComparison::Equal;
+      break;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      comparison = sql::ZoneFilterComparison::LessThan;
+      break;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      comparison = sql::ZoneFilterComparison::LessThanEqual;
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      comparison = sql::ZoneFilterComparison::GreaterThan;
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      comparison = sql::ZoneFilterComparison::GreaterThanEqual;
+      break;
+    default:
+      throw NOT_IMPLEMENTED_EXCEPTION(fmt::format("CodeGen: Zone filter type {} not supported.",
+                                                  parser::ExpressionTypeToString(comp_type, true)));
+  }
+  ast::Expr *call = CallBuiltin(ast::Builtin::TableIterAddZoneFilter,
+                                {table_iter, Const32(col_idx), Const32(static_cast<int32_t>(comparison)), filter_val});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::IterateTableParallel(catalog::table_oid_t table_oid, ast::Identifier col_oids,
                                          ast::Expr *query_state, ast::Expr *exec_ctx, ast::Identifier worker_name) {
   ast::Expr *call = CallBuiltin(
@@ -1126,7 +1166,11 @@ ast::Expr *CodeGen::CSVReaderClose(ast::Expr *reader) {
 
 ast::Expr *CodeGen::StorageInterfaceInit(ast::Identifier si, ast::Expr *exec_ctx, uint32_t table_oid,
                                          ast::Identifier col_oids, bool need_indexes) {
-  ast::Expr *si_ptr = AddressOf(si);
+  return StorageInterfaceInit(AddressOf(si), exec_ctx, table_oid, col_oids, need_indexes);
+}
+
+ast::Expr *CodeGen::StorageInterfaceInit(ast::Expr *si_ptr, ast::Expr *exec_ctx, uint32_t table_oid,
+                                         ast::Identifier col_oids, bool need_indexes) {
   ast::Expr *table_oid_expr = Const64(static_cast<int64_t>(table_oid));
   ast::Expr *col_oids_expr = MakeExpr(col_oids);
   ast::Expr *need_indexes_expr = ConstBool(need_indexes);
@@ -22,7 +22,6 @@ IndexCreateTranslator::IndexCreateTranslator(const planner::CreateIndexPlanNode
                                              CompilationContext *compilation_context, Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, brain::ExecutionOperatingUnitType::CREATE_INDEX),
       codegen_(compilation_context->GetCodeGen()),
-      inserter_(codegen_->MakeFreshIdentifier("inserter")),
       index_pr_(codegen_->MakeFreshIdentifier("index_pr")),
       tvi_var_(codegen_->MakeFreshIdentifier("tvi")),
       vpi_var_(codegen_->MakeFreshIdentifier("vpi")),
@@ -36,41 +35,100 @@ IndexCreateTranslator::IndexCreateTranslator(const planner::CreateIndexPlanNode
   for (const auto &index_col : index_schema.GetColumns()) {
     compilation_context->Prepare(*index_col.StoredExpression());
   }
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
+
+  // The query owns the inserter that loads the index. Parallel workers stage their keys in their own inserter, which
+  // are merged into the query's at the end of the pipeline.
+  ast::Expr *storage_interface_type = codegen_->BuiltinType(ast::BuiltinType::Kind::StorageInterface);
+  global_inserter_ =
+      compilation_context->GetQueryState()->DeclareStateEntry(codegen_, "indexInserter", storage_interface_type);
+  if (pipeline->IsParallel()) {
+    local_inserter_ = pipeline->DeclarePipelineStateEntry("indexInserter", storage_interface_type);
+  }
+}
+
+void IndexCreateTranslator::InitializeQueryState(FunctionBuilder *function) const {
+  InitializeInserter(function, global_inserter_.GetPtr(codegen_));
+}
+
+void IndexCreateTranslator::TearDownQueryState(FunctionBuilder *function) const {
+  FreeInserter(function, global_inserter_.GetPtr(codegen_));
+}
+
+void IndexCreateTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (pipeline.IsParallel()) {
+    InitializeInserter(function, local_inserter_.GetPtr(codegen_));
+  }
+}
+
+void IndexCreateTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (pipeline.IsParallel()) {
+    FreeInserter(function, local_inserter_.GetPtr(codegen_));
+  }
 }
 
 void IndexCreateTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
-  InitScan(function);
+  const bool parallel = GetPipeline()->IsParallel();
+  auto *inserter = parallel ? local_inserter_.GetPtr(codegen_) : global_inserter_.GetPtr(codegen_);
+  DeclareIndexPR(function, inserter);
+  // Parallel workers are handed the TVI over their share of the table.
+  if (!parallel) {
+    SetOids(function);
+    DeclareTVI(function);
+  }
+  DeclareSlot(function);
 
   // Scan it.
-  ScanTable(context, function);
+  ScanTable(context, function, inserter);
 
   // Close TVI, if need be.
-  function->Append(codegen_->TableIterClose(codegen_->MakeExpr(tvi_var_)));
+  if (!parallel) {
+    function->Append(codegen_->TableIterClose(codegen_->MakeExpr(tvi_var_)));
+  }
+}
 
-  FreeInserter(function);
+void IndexCreateTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // Build the index out of everything the scan staged.
+  ast::Expr *index_load_call;
+  if (pipeline.IsParallel()) {
+    // if (!@indexBulkLoadParallel(&queryState.inserter, tls, offset)) { Abort(); }
+    index_load_call = codegen_->CallBuiltin(
+        ast::Builtin::IndexBulkLoadParallel,
+        {global_inserter_.GetPtr(codegen_), GetThreadStateContainer(), local_inserter_.OffsetFromState(codegen_)});
+  } else {
+    // if (!@indexBulkLoad(&queryState.inserter)) { Abort(); }
+    index_load_call = codegen_->CallBuiltin(ast::Builtin::IndexBulkLoad, {global_inserter_.GetPtr(codegen_)});
+  }
+  auto *cond = codegen_->UnaryOp(parsing::Token::Type::BANG, index_load_call);
+  If success(function, cond);
+  { function->Append(codegen_->AbortTxn(GetExecutionContext())); }
+  success.EndIf();
 }
 
-void IndexCreateTranslator::InitScan(FunctionBuilder *function) const {
-  // Init inserter, index pr, create index, and init tvi
-  DeclareInserter(function);
-  DeclareIndexPR(function);
-  DeclareTVI(function);
-  DeclareSlot(function);
+util::RegionVector<ast::FieldDecl *> IndexCreateTranslator::GetWorkerParams() const {
+  auto *tvi_type = codegen_->PointerType(ast::BuiltinType::TableVectorIterator);
+  return codegen_->MakeFieldList({codegen_->MakeField(tvi_var_, tvi_type)});
 }
 
-void IndexCreateTranslator::DeclareInserter(FunctionBuilder *function) const {
+void IndexCreateTranslator::LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const {
+  SetOids(function);
+  function->Append(codegen_->IterateTableParallel(GetPlanAs<planner::CreateIndexPlanNode>().GetTableOid(),
+                                                  col_oids_var_, GetQueryStatePtr(), GetExecutionContext(),
+                                                  work_func_name));
+}
+
+void IndexCreateTranslator::InitializeInserter(FunctionBuilder *function, ast::Expr *inserter) const {
   // var col_oids: [num_cols]uint32
   // col_oids[i] = ...
   SetOids(function);
-  // var inserter : StorageInterface
-  auto *storage_interface_type = codegen_->BuiltinType(ast::BuiltinType::Kind::StorageInterface);
-  function->Append(codegen_->DeclareVar(inserter_, storage_interface_type, nullptr));
   // @storageInterfaceInit(inserter, execCtx, table_oid, col_oids_var_, false)
   ast::Expr *inserter_setup = codegen_->StorageInterfaceInit(
-      inserter_, GetExecutionContext(), uint32_t(GetPlanAs<planner::CreateIndexPlanNode>().GetTableOid()),
+      inserter, GetExecutionContext(), uint32_t(GetPlanAs<planner::CreateIndexPlanNode>().GetTableOid()),
       col_oids_var_, false);
   function->Append(codegen_->MakeStmt(inserter_setup));
+  // @getIndexPR(inserter, oid) selects the index that the inserter stages keys for and loads.
+  std::vector<ast::Expr *> pr_call_args{inserter, codegen_->Const32(uint32_t(index_oid_))};
+  function->Append(codegen_->MakeStmt(codegen_->CallBuiltin(ast::Builtin::GetIndexPR, pr_call_args)));
 }
 
 void IndexCreateTranslator::SetOids(FunctionBuilder *function) const {
@@ -86,9 +144,9 @@ void IndexCreateTranslator::SetOids(FunctionBuilder *function) const {
   }
 }
 
-void IndexCreateTranslator::DeclareIndexPR(FunctionBuilder *function) const {
-  // var index_pr = @getIndexPR(&inserter, oid)
-  std::vector<ast::Expr *> pr_call_args{codegen_->AddressOf(inserter_), codegen_->Const32(uint32_t(index_oid_))};
+void IndexCreateTranslator::DeclareIndexPR(FunctionBuilder *function, ast::Expr *inserter) const {
+  // var index_pr = @getIndexPR(inserter, oid)
+  std::vector<ast::Expr *> pr_call_args{inserter, codegen_->Const32(uint32_t(index_oid_))};
   auto get_index_pr_call = codegen_->CallBuiltin(ast::Builtin::GetIndexPR, pr_call_args);
   function->Append(codegen_->DeclareVar(index_pr_, nullptr, get_index_pr_call));
 }
@@ -118,7 +176,7 @@ std::vector<catalog::col_oid_t> IndexCreateTranslator::AllColOids(const catalog:
   return oids;
 }
 
-void IndexCreateTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) const {
+void IndexCreateTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function, ast::Expr *inserter) const {
   // for (@tableIterAdvance(tvi))
   Loop tvi_loop(function, codegen_->TableIterAdvance(codegen_->MakeExpr(tvi_var_)));
   {
@@ -127,13 +185,14 @@ void IndexCreateTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *functio
     function->Append(codegen_->DeclareVarWithInit(vpi_var_, codegen_->TableIterGetVPI(codegen_->MakeExpr(tvi_var_))));
 
     if (!ctx->GetPipeline().IsVectorized()) {
-      ScanVPI(ctx, function, vpi);
+      ScanVPI(ctx, function, vpi, inserter);
     }
   }
   tvi_loop.EndLoop();
 }
 
-void IndexCreateTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast::Expr *vpi) const {
+void IndexCreateTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast::Expr *vpi,
+                                    ast::Expr *inserter) const {
   auto gen_vpi_loop = [&](bool is_filtered) {
     Loop vpi_loop(function, nullptr, codegen_->VPIHasNext(vpi, is_filtered),
                   codegen_->MakeStmt(codegen_->VPIAdvance(vpi, is_filtered)));
@@ -142,7 +201,7 @@ void IndexCreateTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function,
       auto make_slot = codegen_->CallBuiltin(ast::Builtin::VPIGetSlot, {codegen_->MakeExpr(vpi_var_)});
       auto assign = codegen_->Assign(codegen_->MakeExpr(slot_var_), make_slot);
       function->Append(assign);
-      IndexInsert(ctx, function);
+      IndexInsert(ctx, function, inserter);
       // We expect create index to be the end of a pipeline, so no need to push to parent
     }
     vpi_loop.EndLoop();
@@ -150,7 +209,7 @@ void IndexCreateTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function,
   gen_vpi_loop(false);
 }
 
-void IndexCreateTranslator::IndexInsert(WorkContext *ctx, FunctionBuilder *function) const {
+void IndexCreateTranslator::IndexInsert(WorkContext *ctx, FunctionBuilder *function, ast::Expr *inserter) const {
   const auto &index = codegen_->GetCatalogAccessor()->GetIndex(index_oid_);
   const auto &index_pm = index->GetKeyOidToOffsetMap();
   const auto &index_schema = codegen_->GetCatalogAccessor()->GetIndexSchema(index_oid_);
@@ -184,21 +243,18 @@ void IndexCreateTranslator::IndexInsert(WorkContext *ctx, FunctionBuilder *funct
     function->Append(codegen_->MakeStmt(set_key_call));
   }
 
-  // if (!@IndexInsertWithSlot(&inserter, &slot_var_, unique)) { Abort(); }
-  auto *index_insert_call = codegen_->CallBuiltin(
-      ast::Builtin::IndexInsertWithSlot,
-      {codegen_->AddressOf(inserter_), codegen_->AddressOf(slot_var_), codegen_->ConstBool(index_schema.Unique())});
-  auto *cond = codegen_->UnaryOp(parsing::Token::Type::BANG, index_insert_call);
-  If success(function, cond);
-  { function->Append(codegen_->AbortTxn(GetExecutionContext())); }
-  success.EndIf();
+  // @indexBulkLoadAdd(inserter, &slot_var_)
+  // The index is not visible to other transactions until this one commits, so nothing else can write to it during the
+  // scan and the keys can be staged and loaded all at once.
+  auto *index_add_call =
+      codegen_->CallBuiltin(ast::Builtin::IndexBulkLoadAdd, {inserter, codegen_->AddressOf(slot_var_)});
+  function->Append(codegen_->MakeStmt(index_add_call));
 }
 
-void IndexCreateTranslator::FreeInserter(FunctionBuilder *function) const {
+void IndexCreateTranslator::FreeInserter(FunctionBuilder *function, ast::Expr *inserter) const {
   // Call @storageInterfaceFree
-  ast::Expr *inserter_free =
-      GetCodeGen()->CallBuiltin(ast::Builtin::StorageInterfaceFree, {GetCodeGen()->AddressOf(inserter_)});
-  function->Append(GetCodeGen()->MakeStmt(inserter_free));
+  ast::Expr *inserter_free = codegen_->CallBuiltin(ast::Builtin::StorageInterfaceFree, {inserter});
+  function->Append(codegen_->MakeStmt(inserter_free));
 }
 
 }  // namespace terrier::execution::compiler
@@ -1,8 +1,10 @@
 #include "execution/compiler/operator/index_join_translator.h"
 
+#include <string>
 #include <unordered_map>
 
 #include "catalog/catalog_accessor.h"
+#include "common/constants.h"
 #include "execution/compiler/codegen.h"
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/function_builder.h"
@@ -16,6 +18,10 @@
 
 namespace terrier::execution::compiler {
 
+namespace {
+const char *outer_row_attr_prefix = "attr";
+}  // namespace
+
 IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
                                          CompilationContext *compilation_context, Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, brain::ExecutionOperatingUnitType::IDXJOIN),
@@ -24,12 +30,16 @@ IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
       table_pm_(GetCodeGen()->GetCatalogAccessor()->GetTable(plan.GetTableOid())->ProjectionMapForOids(input_oids_)),
       index_schema_(GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(plan.GetIndexOid())),
       index_pm_(GetCodeGen()->GetCatalogAccessor()->GetIndex(plan.GetIndexOid())->GetKeyOidToOffsetMap()),
+      batched_(plan.GetScanType() == planner::IndexScanType::Exact),
       index_iter_(GetCodeGen()->MakeFreshIdentifier("index_iter")),
       col_oids_(GetCodeGen()->MakeFreshIdentifier("col_oids")),
       lo_index_pr_(GetCodeGen()->MakeFreshIdentifier("lo_index_pr")),
       hi_index_pr_(GetCodeGen()->MakeFreshIdentifier("hi_index_pr")),
       table_pr_(GetCodeGen()->MakeFreshIdentifier("table_pr")),
-      slot_(GetCodeGen()->MakeFreshIdentifier("slot")) {
+      slot_(GetCodeGen()->MakeFreshIdentifier("slot")),
+      outer_row_(GetCodeGen()->MakeFreshIdentifier("outerRow")),
+      outer_row_type_(GetCodeGen()->MakeFreshIdentifier("OuterRow")),
+      probe_batch_fn_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("ProbeIndexBatch"))) {
   pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
   if (plan.GetJoinPredicate() != nullptr) {
     compilation_context->Prepare(*plan.GetJoinPredicate());
@@ -43,9 +53,76 @@ IndexJoinTranslator::IndexJoinTranslator(const planner::IndexJoinPlanNode &plan,
   }
 
   compilation_context->Prepare(*GetPlan().GetChild(0), pipeline);
+
+  if (batched_) {
+    auto *codegen = GetCodeGen();
+    ast::Expr *iter_type = codegen->BuiltinType(ast::BuiltinType::IndexIterator);
+    ast::Expr *batch_type =
+        codegen->ArrayType(common::Constants::K_DEFAULT_VECTOR_SIZE, codegen->MakeExpr(outer_row_type_));
+    batch_iter_ = pipeline->DeclarePipelineStateEntry("indexIter", iter_type);
+    batch_ = pipeline->DeclarePipelineStateEntry("joinBatch", batch_type);
+    batch_size_ = pipeline->DeclarePipelineStateEntry("joinBatchSize", codegen->Int32Type());
+  }
+}
+
+void IndexJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
+  if (!batched_) {
+    return;
+  }
+  auto *codegen = GetCodeGen();
+  auto fields = codegen->MakeEmptyFieldList();
+  GetAllChildOutputFields(0, outer_row_attr_prefix, &fields);
+  decls->push_back(codegen->DeclareStruct(outer_row_type_, std::move(fields)));
+}
+
+void IndexJoinTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (!batched_) {
+    return;
+  }
+  auto *codegen = GetCodeGen();
+  // var col_oids: [num_cols]uint32
+  // col_oids[i] = ...
+  SetOids(function);
+  // @indexIteratorInit(&pipelineState.indexIter, queryState.execCtx, num_attrs, table_oid, index_oid, col_oids)
+  const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
+  ast::Expr *init_call = codegen->IndexIteratorInit(
+      batch_iter_.GetPtr(codegen), GetCompilationContext()->GetExecutionContextPtrFromQueryState(),
+      op.GetLoIndexColumns().size(), op.GetTableOid().UnderlyingValue(), op.GetIndexOid().UnderlyingValue(),
+      col_oids_);
+  function->Append(codegen->MakeStmt(init_call));
+  // pipelineState.joinBatchSize = 0
+  function->Append(codegen->Assign(batch_size_.Get(codegen), codegen->Const32(0)));
+}
+
+void IndexJoinTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (batched_) {
+    // @indexIteratorFree(&pipelineState.indexIter)
+    FreeIterator(function, batch_iter_.GetPtr(GetCodeGen()));
+  }
 }
 
 void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
+  if (batched_) {
+    AddToBatch(context, function);
+  } else {
+    ProbeTuple(context, function);
+  }
+}
+
+void IndexJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (!batched_) {
+    return;
+  }
+  auto *codegen = GetCodeGen();
+  // if (pipelineState.joinBatchSize > 0) { ProbeIndexBatch(queryState, pipelineState) }
+  ast::Expr *cond = codegen->Compare(parsing::Token::Type::GREATER, batch_size_.Get(codegen), codegen->Const32(0));
+  If has_tuples(function, cond);
+  function->Append(
+      codegen->Call(probe_batch_fn_, {function->GetParameterByPosition(0), pipeline.GetPipelineStatePtr()}));
+  has_tuples.EndIf();
+}
+
+void IndexJoinTranslator::ProbeTuple(WorkContext *context, FunctionBuilder *function) const {
   const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
   // var col_oids: [num_cols]uint32
   // col_oids[i] = ...
@@ -61,14 +138,96 @@ void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
   // @prSet(hi_index_pr, ...)
   FillKey(context, function, hi_index_pr_, op.GetHiIndexColumns());
 
-  // @indexIteratorScanKey(&index_iter)
+  // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);) { PARENT_CODE }
   ast::Expr *scan_call = GetCodeGen()->IndexIteratorScan(index_iter_, op.GetScanType(), 0);
-  ast::Stmt *loop_init = GetCodeGen()->MakeStmt(scan_call);
+  PushMatches(context, function, GetCodeGen()->MakeStmt(scan_call));
+
+  // @indexIteratorFree(&index_iter_)
+  FreeIterator(function, GetIteratorPtr());
+}
+
+void IndexJoinTranslator::AddToBatch(WorkContext *context, FunctionBuilder *function) const {
+  const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
+  auto *codegen = GetCodeGen();
+
+  // var outerRow = &pipelineState.joinBatch[pipelineState.joinBatchSize]
+  ast::Expr *outer_row = codegen->AddressOf(codegen->ArrayAccess(batch_.Get(codegen), batch_size_.Get(codegen)));
+  function->Append(codegen->DeclareVarWithInit(outer_row_, outer_row));
+  // outerRow.attr_i = ...
+  const auto child_schema = GetPlan().GetChild(0)->GetOutputSchema();
+  for (uint32_t attr_idx = 0; attr_idx < child_schema->GetColumns().size(); attr_idx++) {
+    auto attr_name = codegen->MakeIdentifier(outer_row_attr_prefix + std::to_string(attr_idx));
+    ast::Expr *lhs = codegen->AccessStructMember(codegen->MakeExpr(outer_row_), attr_name);
+    function->Append(codegen->Assign(lhs, OperatorTranslator::GetChildOutput(context, 0, attr_idx)));
+  }
+
+  // var lo_index_pr = @indexIteratorAddBatchKey(&pipelineState.indexIter)
+  ast::Expr *add_key_call = codegen->CallBuiltin(ast::Builtin::IndexIteratorAddBatchKey, {batch_iter_.GetPtr(codegen)});
+  function->Append(codegen->DeclareVarWithInit(lo_index_pr_, add_key_call));
+  // @prSet(lo_index_pr, ...)
+  FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
+
+  // pipelineState.joinBatchSize = pipelineState.joinBatchSize + 1
+  ast::Expr *increment = codegen->BinaryOp(parsing::Token::Type::PLUS, batch_size_.Get(codegen), codegen->Const32(1));
+  function->Append(codegen->Assign(batch_size_.Get(codegen), increment));
+
+  // The matches are pushed from a separate function, called below once the batch is full and again for the last batch
+  // when the pipeline finishes. Values derived so far belong to the current outer tuple, not to the batch.
+  context->ClearExpressionCache();
+  GetPipeline()->DeclareWorkHelperFunction(GenerateProbeBatchFunction(context));
+
+  // if (pipelineState.joinBatchSize == BATCH_SIZE) { ProbeIndexBatch(queryState, pipelineState) }
+  If batch_full(function, codegen->Compare(parsing::Token::Type::EQUAL_EQUAL, batch_size_.Get(codegen),
+                                           codegen->Const32(common::Constants::K_DEFAULT_VECTOR_SIZE)));
+  function->Append(
+      codegen->Call(probe_batch_fn_, {function->GetParameterByPosition(0), function->GetParameterByPosition(1)}));
+  batch_full.EndIf();
+}
+
+ast::FunctionDecl *IndexJoinTranslator::GenerateProbeBatchFunction(WorkContext *context) const {
+  auto *codegen = GetCodeGen();
+  FunctionBuilder function(codegen, probe_batch_fn_, GetPipeline()->PipelineParams(), codegen->Nil());
+  {
+    CodeGen::CodeScope code_scope(codegen);
+    reading_batch_ = true;
+
+    // var index_iter = &pipelineState.indexIter
+    function.Append(codegen->DeclareVarWithInit(index_iter_, batch_iter_.GetPtr(codegen)));
+    // @indexIteratorScanKeyBatch(index_iter)
+    function.Append(codegen->CallBuiltin(ast::Builtin::IndexIteratorScanKeyBatch, {GetIteratorPtr()}));
+
+    // var batchIdx: int32 = 0
+    // for (; batchIdx < pipelineState.joinBatchSize; batchIdx = batchIdx + 1)
+    ast::Identifier idx = codegen->MakeFreshIdentifier("batchIdx");
+    function.Append(codegen->DeclareVar(idx, codegen->Int32Type(), codegen->Const32(0)));
+    ast::Expr *cond = codegen->Compare(parsing::Token::Type::LESS, codegen->MakeExpr(idx), batch_size_.Get(codegen));
+    ast::Expr *increment = codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(idx), codegen->Const32(1));
+    ast::Stmt *next = codegen->Assign(codegen->MakeExpr(idx), increment);
+    Loop batch_loop(&function, nullptr, cond, next);
+    {
+      // var outerRow = &pipelineState.joinBatch[batchIdx]
+      ast::Expr *outer_row = codegen->AddressOf(codegen->ArrayAccess(batch_.Get(codegen), codegen->MakeExpr(idx)));
+      function.Append(codegen->DeclareVarWithInit(outer_row_, outer_row));
+      // for (@indexIteratorSelectBatchKey(index_iter, batchIdx); @indexIteratorAdvance(index_iter);) { PARENT_CODE }
+      ast::Expr *select_call =
+          codegen->CallBuiltin(ast::Builtin::IndexIteratorSelectBatchKey, {GetIteratorPtr(), codegen->MakeExpr(idx)});
+      PushMatches(context, &function, codegen->MakeStmt(select_call));
+    }
+    batch_loop.EndLoop();
+
+    // pipelineState.joinBatchSize = 0
+    function.Append(codegen->Assign(batch_size_.Get(codegen), codegen->Const32(0)));
+    reading_batch_ = false;
+  }
+  return function.Finish();
+}
+
+void IndexJoinTranslator::PushMatches(WorkContext *context, FunctionBuilder *function, ast::Stmt *loop_init) const {
+  const auto &op = GetPlanAs<planner::IndexJoinPlanNode>();
   // @indexIteratorAdvance(&index_iter)
-  ast::Expr *advance_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {GetCodeGen()->AddressOf(index_iter_)});
+  ast::Expr *advance_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {GetIteratorPtr()});
 
-  // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);)
+  // for (loop_init; @indexIteratorAdvance(&index_iter);)
   Loop loop(function, loop_init, advance_call, nullptr);
   {
     // var table_pr = @indexIteratorGetTablePR(&index_iter)
@@ -89,9 +248,6 @@ void IndexJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
     }
   }
   loop.EndLoop();
-
-  // @indexIteratorFree(&index_iter_)
-  FreeIterator(function);
 }
 
 ast::Expr *IndexJoinTranslator::GetTableColumn(catalog::col_oid_t col_oid) const {
@@ -140,17 +296,15 @@ void IndexJoinTranslator::DeclareIndexPR(terrier::execution::compiler::FunctionB
   builder->Append(GetCodeGen()->DeclareVar(hi_index_pr_, nullptr, hi_pr_call));
 }
 
-void IndexJoinTranslator::DeclareTablePR(terrier::execution::compiler::FunctionBuilder *builder) const {
+void IndexJoinTranslator::DeclareTablePR(FunctionBuilder *builder) const {
   // var table_pr = @indexIteratorGetTablePR(&index_iter)
-  ast::Expr *get_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {GetCodeGen()->AddressOf(index_iter_)});
+  ast::Expr *get_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {GetIteratorPtr()});
   builder->Append(GetCodeGen()->DeclareVar(table_pr_, nullptr, get_pr_call));
 }
 
-void IndexJoinTranslator::DeclareSlot(terrier::execution::compiler::FunctionBuilder *builder) const {
+void IndexJoinTranslator::DeclareSlot(FunctionBuilder *builder) const {
   // var slot = @indexIteratorGetSlot(&index_iter)
-  ast::Expr *get_slot_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {GetCodeGen()->AddressOf(index_iter_)});
+  ast::Expr *get_slot_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {GetIteratorPtr()});
   builder->Append(GetCodeGen()->DeclareVar(slot_, nullptr, get_slot_call));
 }
 
@@ -169,15 +323,29 @@ void IndexJoinTranslator::FillKey(
   }
 }
 
+ast::Expr *IndexJoinTranslator::GetIteratorPtr() const {
+  // A batched join reaches its iterator through a pointer into the pipeline state, see GenerateProbeBatchFunction().
+  return batched_ ? GetCodeGen()->MakeExpr(index_iter_) : GetCodeGen()->AddressOf(index_iter_);
+}
+
+ast::Expr *IndexJoinTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const {
+  // While the matches of a batch are pushed, the outer tuple they join with is read from the batch.
+  if (reading_batch_ && child_idx == 0) {
+    auto *codegen = GetCodeGen();
+    auto attr_name = codegen->MakeIdentifier(outer_row_attr_prefix + std::to_string(attr_idx));
+    return codegen->AccessStructMember(codegen->MakeExpr(outer_row_), attr_name);
+  }
+  return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
+}
+
 ast::Expr *IndexJoinTranslator::GetSlotAddress() const {
   // &slot
   return GetCodeGen()->AddressOf(slot_);
 }
 
-void IndexJoinTranslator::FreeIterator(FunctionBuilder *builder) const {
+void IndexJoinTranslator::FreeIterator(FunctionBuilder *builder, ast::Expr *iter) const {
   // @indexIteratorFree(&index_iter_)
-  ast::Expr *free_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorFree, {GetCodeGen()->AddressOf(index_iter_)});
+  ast::Expr *free_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorFree, {iter});
   builder->Append(GetCodeGen()->MakeStmt(free_call));
 }
 
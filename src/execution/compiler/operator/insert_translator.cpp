@@ -141,7 +141,7 @@ void InsertTranslator::GenSetTablePR(FunctionBuilder *builder, WorkContext *cont
     const auto &table_col = table_schema_.GetColumn(table_col_oid);
     const auto &pr_set_call =
         GetCodeGen()->PRSet(GetCodeGen()->MakeExpr(insert_pr_), table_col.Type(), table_col.Nullable(),
-                            table_pm_.find(table_col_oid)->second, src, true);
+                            table_pm_.find(table_col_oid)->second, src, false);
     builder->Append(GetCodeGen()->MakeStmt(pr_set_call));
   }
 }
@@ -124,9 +124,8 @@ void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::Fu
     ast::Expr *tid_list = builder.GetParameterByPosition(2);
     if (parser::ExpressionUtil::IsColumnCompareWithConst(*predicate)) {
       auto cve = predicate->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
-      auto translator = GetCompilationContext()->LookupTranslator(*predicate->GetChild(1));
       auto col_index = GetColOidIndex(cve->GetColumnOid());
-      auto const_val = translator->DeriveValue(nullptr, nullptr);
+      auto const_val = GetComparedValue(predicate, builder.GetParameterByPosition(0));
       builder.Append(codegen->VPIFilter(exec_ctx,                        // The execution context
                                         vector_proj,                     // The vector projection
                                         predicate->GetExpressionType(),  // Comparison type
@@ -134,46 +133,9 @@ void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::Fu
                                         const_val,                       // Constant value
                                         tid_list));                      // TID list
     } else if (parser::ExpressionUtil::IsColumnCompareWithParam(*predicate)) {
-      // TODO(WAN): temporary hacky implementation, poke Prashanth...
       auto cve = predicate->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
       auto col_index = GetColOidIndex(cve->GetColumnOid());
-
-      auto param_val = predicate->GetChild(1).CastManagedPointerTo<parser::ParameterValueExpression>();
-      auto param_idx = param_val->GetValueIdx();
-      ast::Builtin builtin;
-      switch (param_val->GetReturnValueType()) {
-        case type::TypeId::BOOLEAN:
-          builtin = ast::Builtin::GetParamBool;
-          break;
-        case type::TypeId::TINYINT:
-          builtin = ast::Builtin::GetParamTinyInt;
-          break;
-        case type::TypeId::SMALLINT:
-          builtin = ast::Builtin::GetParamSmallInt;
-          break;
-        case type::TypeId::INTEGER:
-          builtin = ast::Builtin::GetParamInt;
-          break;
-        case type::TypeId::BIGINT:
-          builtin = ast::Builtin::GetParamBigInt;
-          break;
-        case type::TypeId::DECIMAL:
-          builtin = ast::Builtin::GetParamDouble;
-          break;
-        case type::TypeId::DATE:
-          builtin = ast::Builtin::GetParamDate;
-          break;
-        case type::TypeId::TIMESTAMP:
-          builtin = ast::Builtin::GetParamTimestamp;
-          break;
-        case type::TypeId::VARCHAR:
-          builtin = ast::Builtin::GetParamString;
-          break;
-        default:
-          UNREACHABLE("Unsupported parameter type");
-      }
-      auto const_val = codegen->CallBuiltin(
-          builtin, {codegen->MakeExpr(codegen->MakeIdentifier("execCtx")), codegen->Const32(param_idx)});
+      auto const_val = GetComparedValue(predicate, builder.GetParameterByPosition(0));
       builder.Append(codegen->VPIFilter(exec_ctx,                        // The execution context
                                         vector_proj,                     // The vector projection
                                         predicate->GetExpressionType(),  // Comparison type
@@ -193,6 +155,111 @@ void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::Fu
   decls->push_back(builder.Finish());
 }
 
+ast::Expr *SeqScanTranslator::GetComparedValue(common::ManagedPointer<parser::AbstractExpression> predicate,
+                                               ast::Expr *exec_ctx) const {
+  auto *codegen = GetCodeGen();
+  if (parser::ExpressionUtil::IsColumnCompareWithConst(*predicate)) {
+    auto translator = GetCompilationContext()->LookupTranslator(*predicate->GetChild(1));
+    return translator->DeriveValue(nullptr, nullptr);
+  }
+
+  // TODO(WAN): temporary hacky implementation, poke Prashanth...
+  TERRIER_ASSERT(parser::ExpressionUtil::IsColumnCompareWithParam(*predicate), "Expected a comparison with a param");
+  auto param_val = predicate->GetChild(1).CastManagedPointerTo<parser::ParameterValueExpression>();
+  auto param_idx = param_val->GetValueIdx();
+  ast::Builtin builtin;
+  switch (param_val->GetReturnValueType()) {
+    case type::TypeId::BOOLEAN:
+      builtin = ast::Builtin::GetParamBool;
+      break;
+    case type::TypeId::TINYINT:
+      builtin = ast::Builtin::GetParamTinyInt;
+      break;
+    case type::TypeId::SMALLINT:
+      builtin = ast::Builtin::GetParamSmallInt;
+      break;
+    case type::TypeId::INTEGER:
+      builtin = ast::Builtin::GetParamInt;
+      break;
+    case type::TypeId::BIGINT:
+      builtin = ast::Builtin::GetParamBigInt;
+      break;
+    case type::TypeId::DECIMAL:
+      builtin = ast::Builtin::GetParamDouble;
+      break;
+    case type::TypeId::DATE:
+      builtin = ast::Builtin::GetParamDate;
+      break;
+    case type::TypeId::TIMESTAMP:
+      builtin = ast::Builtin::GetParamTimestamp;
+      break;
+    case type::TypeId::VARCHAR:
+      builtin = ast::Builtin::GetParamString;
+      break;
+    default:
+      UNREACHABLE("Unsupported parameter type");
+  }
+  return codegen->CallBuiltin(builtin, {exec_ctx, codegen->Const32(param_idx)});
+}
+
+namespace {
+
+// Zone maps hold integers and doubles, so a value can only be checked against them if it has the same
+// interpretation as the column.
+bool IsZoneFilterType(const type::TypeId col_type, const type::TypeId val_type) {
+  auto is_integral = [](const type::TypeId type) {
+    return type == type::TypeId::TINYINT || type == type::TypeId::SMALLINT || type == type::TypeId::INTEGER ||
+           type == type::TypeId::BIGINT;
+  };
+  if (is_integral(col_type)) return is_integral(val_type);
+  switch (col_type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+      return col_type == val_type;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+void SeqScanTranslator::AddZoneFilters(FunctionBuilder *function,
+                                       common::ManagedPointer<parser::AbstractExpression> predicate) const {
+  // Every conjunct has to hold for a tuple to match, so each one can rule out blocks on its own
+  if (predicate->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+    for (const auto &child : predicate->GetChildren()) AddZoneFilters(function, child);
+    return;
+  }
+
+  switch (predicate->GetExpressionType()) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      break;
+    default:
+      return;
+  }
+  if (!parser::ExpressionUtil::IsColumnCompareWithConst(*predicate) &&
+      !parser::ExpressionUtil::IsColumnCompareWithParam(*predicate)) {
+    return;
+  }
+
+  auto *codegen = GetCodeGen();
+  auto cve = predicate->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
+  const auto &schema = codegen->GetCatalogAccessor()->GetSchema(GetTableOid());
+  if (!IsZoneFilterType(schema.GetColumn(cve->GetColumnOid()).Type(), predicate->GetChild(1)->GetReturnValueType())) {
+    return;
+  }
+  // @tableIterAddZoneFilter(tvi, col_idx, comparison, val)
+  function->Append(codegen->TableIterAddZoneFilter(codegen->MakeExpr(tvi_var_), predicate->GetExpressionType(),
+                                                   GetColOidIndex(cve->GetColumnOid()),
+                                                   GetComparedValue(predicate, GetExecutionContext())));
+}
+
 void SeqScanTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
   if (HasPredicate()) {
     std::vector<ast::Identifier> curr_clause;
@@ -278,6 +345,11 @@ void SeqScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilde
         codegen->TableIterInit(codegen->MakeExpr(tvi_var_), GetExecutionContext(), GetTableOid(), col_oids_var_));
   }
 
+  // Zone maps can only rule out blocks if the predicate is a single conjunction, i.e., has a single filter clause
+  if (HasPredicate() && filters_.size() == 1) {
+    AddZoneFilters(function, GetPlanAs<planner::SeqScanPlanNode>().GetScanPredicate());
+  }
+
   auto declare_slot = codegen->DeclareVarNoInit(slot_var_, ast::BuiltinType::TupleSlot);
   function->Append(declare_slot);
 
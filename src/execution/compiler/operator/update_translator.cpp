@@ -154,7 +154,7 @@ void UpdateTranslator::GetUpdatePR(terrier::execution::compiler::FunctionBuilder
       const auto idx = table_pm_.find(oid)->second;
 
       ast::Expr *child_expr = child->GetTableColumn(oid);
-      ast::Expr *set_pr = GetCodeGen()->PRSet(update_pr, col.Type(), col.Nullable(), idx, child_expr, true);
+      ast::Expr *set_pr = GetCodeGen()->PRSet(update_pr, col.Type(), col.Nullable(), idx, child_expr, false);
       builder->Append(GetCodeGen()->MakeStmt(set_pr));
     }
   }
@@ -169,7 +169,7 @@ void UpdateTranslator::GenSetTablePR(FunctionBuilder *builder, WorkContext *cont
     const auto &table_col = table_schema_.GetColumn(table_col_oid);
     const auto &clause_expr = context->DeriveValue(*clause.second, this);
     auto *pr_set_call = GetCodeGen()->PRSet(GetCodeGen()->MakeExpr(update_pr_), table_col.Type(), table_col.Nullable(),
-                                            table_pm_.find(table_col_oid)->second, clause_expr, true);
+                                            table_pm_.find(table_col_oid)->second, clause_expr, false);
     builder->Append(GetCodeGen()->MakeStmt(pr_set_call));
   }
 }
@@ -69,6 +69,8 @@ StateDescriptor::Entry Pipeline::DeclarePipelineStateEntry(const std::string &na
   return state_.DeclareStateEntry(codegen_, name, type_repr);
 }
 
+void Pipeline::DeclareWorkHelperFunction(ast::FunctionDecl *function) { work_helper_functions_.push_back(function); }
+
 std::string Pipeline::CreatePipelineFunctionName(const std::string &func_name) const {
   auto result = fmt::format("{}_Pipeline{}", compilation_context_->GetFunctionPrefix(), id_);
   if (!func_name.empty()) {
@@ -115,6 +117,8 @@ util::RegionVector<ast::FieldDecl *> Pipeline::PipelineParams() const {
   return query_params;
 }
 
+ast::Expr *Pipeline::GetPipelineStatePtr() const { return state_.GetStatePointer(codegen_); }
+
 void Pipeline::LinkSourcePipeline(Pipeline *dependency) {
   TERRIER_ASSERT(dependency != nullptr, "Source cannot be null");
   dependencies_.push_back(dependency);
@@ -257,9 +261,10 @@ ast::FunctionDecl *Pipeline::GenerateRunPipelineFunction(query_id_t query_id) co
           codegen_->Call(GetWorkFunctionName(), {builder.GetParameterByPosition(0), codegen_->MakeExpr(state_var_)}));
     }
 
-    // Let the operators perform some completion work in this pipeline.
-    for (auto op : steps_) {
-      op->FinishPipelineWork(*this, &builder);
+    // Let the operators perform some completion work in this pipeline. Start at the source, so that an operator still
+    // holding on to tuples can push them up the pipeline before the operators above it finish.
+    for (auto iter = Begin(), end = End(); iter != end; ++iter) {
+      (*iter)->FinishPipelineWork(*this, &builder);
     }
 
     if (started_tracker) {
@@ -290,8 +295,12 @@ void Pipeline::GeneratePipeline(ExecutableQueryFragmentBuilder *builder, query_i
   builder->DeclareFunction(GenerateSetupPipelineStateFunction());
   builder->DeclareFunction(GenerateTearDownPipelineStateFunction());
 
-  // Generate main pipeline logic.
-  builder->DeclareFunction(GeneratePipelineWorkFunction());
+  // Generate main pipeline logic. Helper functions generated along the way are called by it, so they go first.
+  ast::FunctionDecl *work_function = GeneratePipelineWorkFunction();
+  for (auto *function : work_helper_functions_) {
+    builder->DeclareFunction(function);
+  }
+  builder->DeclareFunction(work_function);
 
   // Register the main init, run, tear-down functions as steps, in that order.
   builder->RegisterStep(GenerateInitPipelineFunction());
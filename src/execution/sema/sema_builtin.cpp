@@ -1032,6 +1032,28 @@ void Sema::CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin)
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::TableIterAddZoneFilter: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // The second argument is the column index
+      if (!call_args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      // The third argument is the comparison
+      if (!call_args[2]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      // The fourth argument is the SQL value to compare with
+      if (!call_args[3]->GetType()->IsSqlValueType()) {
+        ReportIncorrectCallArg(call, 3, "Fourth argument should be a SQL value.");
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     default: {
       UNREACHABLE("Impossible table iteration call");
     }
@@ -2038,6 +2060,7 @@ void Sema::CheckBuiltinIndexIteratorScan(execution::ast::CallExpr *call, ast::Bu
 
   switch (builtin) {
     case ast::Builtin::IndexIteratorScanKey:
+    case ast::Builtin::IndexIteratorScanKeyBatch:
     case ast::Builtin::IndexIteratorScanDescending: {
       if (!CheckArgCount(call, 1)) return;
       break;
@@ -2046,7 +2069,8 @@ void Sema::CheckBuiltinIndexIteratorScan(execution::ast::CallExpr *call, ast::Bu
       if (!CheckArgCount(call, 3)) return;
       break;
     }
-    case ast::Builtin::IndexIteratorScanLimitDescending: {
+    case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorSelectBatchKey: {
       if (!CheckArgCount(call, 2)) return;
       auto uint32_kind = ast::BuiltinType::Uint32;
       // Second argument is an integer
@@ -2108,6 +2132,7 @@ void Sema::CheckBuiltinIndexIteratorPRCall(ast::CallExpr *call, ast::Builtin bui
     case ast::Builtin::IndexIteratorGetLoPR:
     case ast::Builtin::IndexIteratorGetHiPR:
     case ast::Builtin::IndexIteratorGetTablePR:
+    case ast::Builtin::IndexIteratorAddBatchKey:
       call->SetType(GetBuiltinType(ast::BuiltinType::ProjectedRow)->PointerTo());
       break;
     case ast::Builtin::IndexIteratorGetSlot:
@@ -2397,6 +2422,45 @@ void Sema::CheckBuiltinStorageInterfaceCall(ast::CallExpr *call, ast::Builtin bu
       call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
       break;
     }
+    case ast::Builtin::IndexBulkLoadAdd: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a tuple slot
+      auto tuple_slot_type = ast::BuiltinType::TupleSlot;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), tuple_slot_type)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(tuple_slot_type)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::IndexBulkLoad: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::IndexBulkLoadParallel: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument must be a thread state container pointer
+      const auto tls_kind = ast::BuiltinType::ThreadStateContainer;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), tls_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(tls_kind)->PointerTo());
+        return;
+      }
+      // Third argument must be a 32-bit integer representing the offset
+      const auto uint32_kind = ast::BuiltinType::Uint32;
+      if (!call_args[2]->GetType()->IsSpecificBuiltin(uint32_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(uint32_kind));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
     case ast::Builtin::IndexDelete: {
       if (!CheckArgCount(call, 2)) {
         return;
@@ -2908,7 +2972,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::TableIterInit:
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPI:
-    case ast::Builtin::TableIterClose: {
+    case ast::Builtin::TableIterClose:
+    case ast::Builtin::TableIterAddZoneFilter: {
       CheckBuiltinTableIterCall(call, builtin);
       break;
     }
@@ -3099,7 +3164,9 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorScanKey:
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
-    case ast::Builtin::IndexIteratorScanLimitDescending: {
+    case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorScanKeyBatch:
+    case ast::Builtin::IndexIteratorSelectBatchKey: {
       CheckBuiltinIndexIteratorScan(call, builtin);
       break;
     }
@@ -3111,7 +3178,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorGetLoPR:
     case ast::Builtin::IndexIteratorGetHiPR:
     case ast::Builtin::IndexIteratorGetSlot:
-    case ast::Builtin::IndexIteratorGetTablePR: {
+    case ast::Builtin::IndexIteratorGetTablePR:
+    case ast::Builtin::IndexIteratorAddBatchKey: {
       CheckBuiltinIndexIteratorPRCall(call, builtin);
       break;
     }
@@ -3181,6 +3249,9 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::IndexInsert:
     case ast::Builtin::IndexInsertUnique:
     case ast::Builtin::IndexInsertWithSlot:
+    case ast::Builtin::IndexBulkLoadAdd:
+    case ast::Builtin::IndexBulkLoad:
+    case ast::Builtin::IndexBulkLoadParallel:
     case ast::Builtin::IndexDelete:
     case ast::Builtin::StorageInterfaceFree: {
       CheckBuiltinStorageInterfaceCall(call, builtin);
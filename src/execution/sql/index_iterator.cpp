@@ -1,8 +1,12 @@
 #include "execution/sql/index_iterator.h"
 
+#include <cstring>
+
 #include "catalog/catalog_accessor.h"
 #include "execution/sql/value.h"
+#include "parser/expression/column_value_expression.h"
 #include "storage/sql_table.h"
+#include "type/type_util.h"
 
 namespace terrier::execution::sql {
 
@@ -11,6 +15,7 @@ IndexIterator::IndexIterator(exec::ExecutionContext *exec_ctx, uint32_t num_attr
     : exec_ctx_(exec_ctx),
       num_attrs_(num_attrs),
       col_oids_(col_oids, col_oids + num_oids),
+      index_oid_(index_oid),
       index_(exec_ctx_->GetAccessor()->GetIndex(catalog::index_oid_t(index_oid))),
       table_(exec_ctx_->GetAccessor()->GetTable(catalog::table_oid_t(table_oid))) {}
 
@@ -29,19 +34,78 @@ void IndexIterator::Init() {
   hi_index_buffer_ =
       exec_ctx_->GetMemoryPool()->AllocateAligned(index_pri.ProjectedRowSize(), alignof(uint64_t), false);
   hi_index_pr_ = index_pri.InitializeRow(hi_index_buffer_);
+
+  if (index_->StoresColumns()) CoverColumns();
+}
+
+void IndexIterator::CoverColumns() {
+  // Look for every column read among the columns the index stores
+  const auto &index_schema = exec_ctx_->GetAccessor()->GetIndexSchema(catalog::index_oid_t(index_oid_));
+  const auto &key_oid_to_offset = index_->GetKeyOidToOffsetMap();
+  const auto table_offsets = table_->ProjectionMapForOids(col_oids_);
+  std::vector<CoveredColumn> covered_columns;
+  for (const auto &col_oid : col_oids_) {
+    const catalog::IndexSchema::Column *index_col = nullptr;
+    for (const auto &col : index_schema.GetColumns()) {
+      const auto expr = col.StoredExpression();
+      if (expr->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
+          expr.CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid() == col_oid) {
+        index_col = &col;
+        break;
+      }
+    }
+    // A column the index doesn't store has to be read from the table
+    if (index_col == nullptr) return;
+    covered_columns.push_back({table_offsets.at(col_oid), key_oid_to_offset.at(index_col->Oid()),
+                               type::TypeUtil::GetTypeSize(index_col->Type())});
+  }
+  covered_columns_ = std::move(covered_columns);
 }
 
 void IndexIterator::ScanKey() {
   // Scan the index
   tuples_.clear();
   curr_index_ = 0;
-  index_->ScanKey(*exec_ctx_->GetTxn(), *index_pr_, &tuples_);
+  if (covered_columns_.empty()) {
+    index_->ScanKey(*exec_ctx_->GetTxn(), *index_pr_, &tuples_);
+  } else {
+    index_->ScanKeyCovered(*exec_ctx_->GetTxn(), *index_pr_, &tuples_, &covered_rows_, &covered_);
+  }
+}
+
+storage::ProjectedRow *IndexIterator::AddBatchKey() {
+  auto &index_pri = index_->GetProjectedRowInitializer();
+  if (num_batch_keys_ == batch_key_buffers_.size()) {
+    void *buffer = exec_ctx_->GetMemoryPool()->AllocateAligned(index_pri.ProjectedRowSize(), alignof(uint64_t), false);
+    batch_key_buffers_.push_back(buffer);
+  }
+  // Reinitialize the row, since the last batch may have left nulls behind
+  return index_pri.InitializeRow(batch_key_buffers_[num_batch_keys_++]);
+}
+
+void IndexIterator::ScanKeyBatch() {
+  // Scan the index
+  batch_keys_.clear();
+  for (uint32_t i = 0; i < num_batch_keys_; i++) {
+    batch_keys_.push_back(reinterpret_cast<const storage::ProjectedRow *>(batch_key_buffers_[i]));
+  }
+  index_->ScanKeyBatch(*exec_ctx_->GetTxn(), batch_keys_, &batch_tuples_);
+  num_batch_keys_ = 0;
+}
+
+void IndexIterator::SelectBatchKey(uint32_t key_idx) {
+  TERRIER_ASSERT(key_idx < batch_tuples_.size(), "Key is not part of the last batch.");
+  // Every key is selected at most once per batch, so its results can be moved out instead of copied
+  tuples_.swap(batch_tuples_[key_idx]);
+  curr_index_ = 0;
+  covered_.clear();
 }
 
 void IndexIterator::ScanAscending(storage::index::ScanType scan_type, uint32_t limit) {
   // Scan the index
   tuples_.clear();
   curr_index_ = 0;
+  covered_.clear();
   index_->ScanAscending(*exec_ctx_->GetTxn(), scan_type, num_attrs_, index_pr_, hi_index_pr_, limit, &tuples_);
 }
 
@@ -49,6 +113,7 @@ void IndexIterator::ScanDescending() {
   // Scan the index
   tuples_.clear();
   curr_index_ = 0;
+  covered_.clear();
   index_->ScanDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_);
 }
 
@@ -56,6 +121,7 @@ void IndexIterator::ScanLimitDescending(uint32_t limit) {
   // Scan the index
   tuples_.clear();
   curr_index_ = 0;
+  covered_.clear();
   index_->ScanLimitDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_, limit);
 }
 
@@ -68,7 +134,18 @@ bool IndexIterator::Advance() {
 }
 
 storage::ProjectedRow *IndexIterator::TablePR() {
-  table_->Select(exec_ctx_->GetTxn(), tuples_[curr_index_ - 1], table_pr_);
+  const auto idx = curr_index_ - 1;
+  if (idx < covered_.size() && covered_[idx]) {
+    // The index holds the same values as the table, so there is no need to read the tuple
+    const auto row_size = index_->GetProjectedRowInitializer().ProjectedRowSize();
+    const auto *const row = reinterpret_cast<const storage::ProjectedRow *>(covered_rows_.data() + idx * row_size);
+    for (const auto &col : covered_columns_) {
+      std::memcpy(table_pr_->AccessForceNotNull(col.table_offset_), row->AccessWithNullCheck(col.index_offset_),
+                  col.size_);
+    }
+    return table_pr_;
+  }
+  table_->Select(exec_ctx_->GetTxn(), tuples_[idx], table_pr_);
   return table_pr_;
 }
 
@@ -77,5 +154,8 @@ IndexIterator::~IndexIterator() {
   exec_ctx_->GetMemoryPool()->Deallocate(table_buffer_, table_pr_->Size());
   exec_ctx_->GetMemoryPool()->Deallocate(index_buffer_, index_pr_->Size());
   exec_ctx_->GetMemoryPool()->Deallocate(hi_index_buffer_, hi_index_pr_->Size());
+  for (void *buffer : batch_key_buffers_) {
+    exec_ctx_->GetMemoryPool()->Deallocate(buffer, index_pr_->Size());
+  }
 }
 }  // namespace terrier::execution::sql
@@ -1,10 +1,14 @@
 #include "execution/sql/storage_interface.h"
 
 #include <algorithm>
+#include <cstring>
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
 #include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/thread_state_container.h"
 #include "execution/util/execution_common.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
@@ -18,7 +22,8 @@ StorageInterface::StorageInterface(exec::ExecutionContext *exec_ctx, catalog::ta
       exec_ctx_(exec_ctx),
       col_oids_(col_oids, col_oids + num_oids),
       need_indexes_(need_indexes),
-      pri_(num_oids > 0 ? table_->InitializerForProjectedRow(col_oids_) : storage::ProjectedRowInitializer()) {
+      pri_(num_oids > 0 ? table_->InitializerForProjectedRow(col_oids_) : storage::ProjectedRowInitializer()),
+      bulk_load_memory_limit_(exec_ctx->GetExecutionSettings().GetIndexBulkLoadMemoryLimit()) {
   // Initialize the index projected row if needed.
   if (need_indexes_) {
     // Get index pr size
@@ -91,4 +96,94 @@ bool StorageInterface::IndexInsertWithTuple(storage::TupleSlot table_tuple_slot,
   return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
 }
 
+void StorageInterface::IndexBulkLoadAdd(storage::TupleSlot table_tuple_slot) {
+  TERRIER_ASSERT(need_indexes_, "Index PR not allocated!");
+  if (bulk_load_one_at_a_time_) {
+    if (!curr_index_->InsertEntry(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot)) bulk_load_failed_ = true;
+    return;
+  }
+
+  const uint32_t num_words = (index_pr_->Size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  const auto offset = bulk_load_keys_.size();
+  if ((offset + num_words) * sizeof(uint64_t) + (bulk_load_slots_.size() + 1) * sizeof(storage::TupleSlot) >
+      bulk_load_memory_limit_) {
+    // Staging every key of a large table takes as much memory as the table itself. Past the limit, the keys go into
+    // the index one at a time, which is slower but takes no memory on top of the index.
+    std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> entries;
+    CollectBulkLoadEntries(&entries);
+    if (!LoadBulkLoadEntries(entries, true)) bulk_load_failed_ = true;
+    bulk_load_keys_ = std::vector<uint64_t>();
+    bulk_load_slots_ = std::vector<storage::TupleSlot>();
+    bulk_load_one_at_a_time_ = true;
+    IndexBulkLoadAdd(table_tuple_slot);
+    return;
+  }
+
+  bulk_load_keys_.resize(offset + num_words);
+  std::memcpy(&bulk_load_keys_[offset], index_pr_, index_pr_->Size());
+  bulk_load_slots_.emplace_back(table_tuple_slot);
+}
+
+bool StorageInterface::IndexBulkLoad() {
+  TERRIER_ASSERT(need_indexes_, "Index PR not allocated!");
+  std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> entries;
+  CollectBulkLoadEntries(&entries);
+  const bool result = LoadBulkLoadEntries(entries, bulk_load_one_at_a_time_) && !bulk_load_failed_;
+  ClearBulkLoadEntries();
+  return result;
+}
+
+bool StorageInterface::IndexBulkLoadParallel(const ThreadStateContainer *thread_state_container,
+                                             std::size_t si_offset) {
+  TERRIER_ASSERT(need_indexes_, "Index PR not allocated!");
+  std::vector<StorageInterface *> tl_storage_interfaces;
+  thread_state_container->CollectThreadLocalStateElementsAs(&tl_storage_interfaces, si_offset);
+
+  // The entries point into the thread-local buffers, so no key is copied again
+  std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> entries;
+  CollectBulkLoadEntries(&entries);
+  bool one_at_a_time = bulk_load_one_at_a_time_;
+  bool failed = bulk_load_failed_;
+  for (const auto *storage_interface : tl_storage_interfaces) {
+    storage_interface->CollectBulkLoadEntries(&entries);
+    one_at_a_time = one_at_a_time || storage_interface->bulk_load_one_at_a_time_;
+    failed = failed || storage_interface->bulk_load_failed_;
+  }
+  const bool result = LoadBulkLoadEntries(entries, one_at_a_time) && !failed;
+
+  ClearBulkLoadEntries();
+  for (auto *storage_interface : tl_storage_interfaces) {
+    storage_interface->ClearBulkLoadEntries();
+  }
+  return result;
+}
+
+void StorageInterface::CollectBulkLoadEntries(
+    std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> *entries) const {
+  if (bulk_load_slots_.empty()) return;
+  const uint32_t num_words = (index_pr_->Size() + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  entries->reserve(entries->size() + bulk_load_slots_.size());
+  for (uint64_t i = 0; i < bulk_load_slots_.size(); i++) {
+    entries->emplace_back(reinterpret_cast<const storage::ProjectedRow *>(&bulk_load_keys_[i * num_words]),
+                          bulk_load_slots_[i]);
+  }
+}
+
+void StorageInterface::ClearBulkLoadEntries() {
+  bulk_load_keys_ = std::vector<uint64_t>();
+  bulk_load_slots_ = std::vector<storage::TupleSlot>();
+  bulk_load_one_at_a_time_ = false;
+  bulk_load_failed_ = false;
+}
+
+bool StorageInterface::LoadBulkLoadEntries(
+    const std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> &entries,
+    const bool one_at_a_time) {
+  if (!one_at_a_time) return curr_index_->BulkLoad(exec_ctx_->GetTxn(), entries);
+  for (const auto &entry : entries) {
+    if (!curr_index_->InsertEntry(exec_ctx_->GetTxn(), *entry.first, entry.second)) return false;
+  }
+  return true;
+}
+
 }  // namespace terrier::execution::sql
@@ -3,14 +3,17 @@
 #include <tbb/parallel_for.h>
 #include <tbb/task_scheduler_init.h>
 
+#include <algorithm>
 #include <limits>
 #include <numeric>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
+#include "common/numa.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/sql/value.h"
 #include "execution/util/timer.h"
 #include "loggers/execution_logger.h"
 
@@ -62,6 +65,82 @@ bool TableVectorIterator::Init(uint32_t block_start, uint32_t block_end) {
   return true;
 }
 
+void TableVectorIterator::AddZoneFilter(const uint32_t col_idx, const ZoneFilterComparison comparison,
+                                        const Val &val) {
+  TERRIER_ASSERT(IsInitialized(), "Zone filters can only be added to an initialized iterator");
+  TERRIER_ASSERT(col_idx < col_oids_.size(), "Column index out of bounds");
+  // Comparisons with NULL never match, but that is left to the regular filters
+  if (val.is_null_) return;
+
+  const auto &column = table_->GetColumnMap().at(col_oids_[col_idx]);
+  ZoneFilter filter{column.col_id_, GetTypeId(column.col_type_), comparison, 0, 0.0};
+  switch (filter.type_) {
+    case TypeId::Boolean:
+      filter.int_val_ = static_cast<const BoolVal &>(val).val_;
+      break;
+    case TypeId::TinyInt:
+    case TypeId::SmallInt:
+    case TypeId::Integer:
+    case TypeId::BigInt:
+      filter.int_val_ = static_cast<const Integer &>(val).val_;
+      break;
+    case TypeId::Date:
+      filter.int_val_ = static_cast<const DateVal &>(val).val_.ToNative();
+      break;
+    case TypeId::Timestamp:
+      filter.int_val_ = static_cast<int64_t>(static_cast<const TimestampVal &>(val).val_.ToNative());
+      break;
+    case TypeId::Double:
+      filter.real_val_ = static_cast<const Real &>(val).val_;
+      break;
+    default:
+      // Varlen columns have no zone maps
+      return;
+  }
+  zone_filters_.push_back(filter);
+  if (!block_filter_) {
+    block_filter_ = [this](const storage::ArrowBlockMetadata &metadata) { return BlockMayMatch(metadata); };
+  }
+}
+
+namespace {
+
+// Check whether a column with values in [min, max] can hold a value comparing true with the given value
+template <typename T>
+bool RangeMayMatch(const ZoneFilterComparison comparison, const T min, const T max, const T val) {
+  switch (comparison) {
+    case ZoneFilterComparison::Equal:
+      return min <= val && val <= max;
+    case ZoneFilterComparison::LessThan:
+      return min < val;
+    case ZoneFilterComparison::LessThanEqual:
+      return min <= val;
+    case ZoneFilterComparison::GreaterThan:
+      return max > val;
+    case ZoneFilterComparison::GreaterThanEqual:
+      return max >= val;
+    default:
+      return true;
+  }
+}
+
+}  // namespace
+
+bool TableVectorIterator::BlockMayMatch(const storage::ArrowBlockMetadata &metadata) const {
+  const storage::BlockLayout &layout = table_->table_.data_table_->GetBlockLayout();
+  for (const auto &filter : zone_filters_) {
+    // Comparisons with NULL never match
+    if (metadata.NullCount(filter.col_id_) == metadata.NumRecords()) return false;
+    const storage::ArrowZoneMap &zone_map = metadata.GetZoneMap(layout, filter.col_id_);
+    const bool may_match =
+        filter.type_ == TypeId::Double
+            ? RangeMayMatch(filter.comparison_, zone_map.MinReal(), zone_map.MaxReal(), filter.real_val_)
+            : RangeMayMatch(filter.comparison_, zone_map.Min(), zone_map.Max(), filter.int_val_);
+    if (!may_match) return false;
+  }
+  return true;
+}
+
 bool TableVectorIterator::Advance() {
   // Cannot advance if not initialized.
   if (!IsInitialized()) {
@@ -74,7 +153,7 @@ bool TableVectorIterator::Advance() {
   }
 
   // Otherwise, scan the table to set the vector projection.
-  table_->Scan(exec_ctx_->GetTxn(), iter_.get(), &vector_projection_);
+  table_->Scan(exec_ctx_->GetTxn(), iter_.get(), &vector_projection_, block_filter_);
   vector_projection_iterator_.SetVectorProjection(&vector_projection_);
 
   return true;
@@ -120,6 +199,13 @@ class ScanTask {
   TableVectorIterator::ScanFn scanner_;
 };
 
+// Consecutive blocks of a table that are placed on the same NUMA node
+struct NumaBlockRun {
+  uint16_t numa_node_;
+  uint32_t begin_;
+  uint32_t end_;
+};
+
 }  // namespace
 
 bool TableVectorIterator::ParallelScan(uint32_t table_oid, uint32_t *col_oids, uint32_t num_oids,
@@ -137,8 +223,31 @@ bool TableVectorIterator::ParallelScan(uint32_t table_oid, uint32_t *col_oids, u
 
   // Execute parallel scan
   tbb::task_scheduler_init scan_scheduler;
-  tbb::blocked_range<uint32_t> block_range(0, table->table_.data_table_->GetNumBlocks(), min_grain_size);
-  tbb::parallel_for(block_range, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn));
+  ScanTask scan_task(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn);
+  if (common::NumaUtil::NumNodes() == 1) {
+    tbb::blocked_range<uint32_t> block_range(0, table->table_.data_table_->GetNumBlocks(), min_grain_size);
+    tbb::parallel_for(block_range, scan_task);
+  } else {
+    // Cut the table into runs of consecutive blocks on the same node, and scan each run on a thread bound to the node.
+    // Runs are grouped by node, so that the runs a worker splits off together tend to be on the same node.
+    const std::vector<uint16_t> block_nodes = table->table_.data_table_->GetBlockNumaNodes();
+    const uint32_t max_run_length = std::max(min_grain_size, 1u);
+    std::vector<NumaBlockRun> runs;
+    for (uint32_t begin = 0; begin < block_nodes.size();) {
+      uint32_t end = begin + 1;
+      while (end < block_nodes.size() && end - begin < max_run_length && block_nodes[end] == block_nodes[begin]) end++;
+      runs.push_back({block_nodes[begin], begin, end});
+      begin = end;
+    }
+    std::stable_sort(runs.begin(), runs.end(),
+                     [](const NumaBlockRun &a, const NumaBlockRun &b) { return a.numa_node_ < b.numa_node_; });
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, runs.size()), [&](const tbb::blocked_range<size_t> &run_range) {
+      for (size_t i = run_range.begin(); i < run_range.end(); i++) {
+        common::NumaUtil::ScopedNodeBinding binding(runs[i].numa_node_);
+        scan_task(tbb::blocked_range<uint32_t>(runs[i].begin_, runs[i].end_));
+      }
+    });
+  }
 
   timer.Stop();
 
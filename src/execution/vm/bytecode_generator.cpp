@@ -677,6 +677,13 @@ void BytecodeGenerator::VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Buil
       GetEmitter()->Emit(Bytecode::TableVectorIteratorFree, iter);
       break;
     }
+    case ast::Builtin::TableIterAddZoneFilter: {
+      LocalVar col_idx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar comparison = VisitExpressionForRValue(call->Arguments()[2]);
+      LocalVar val = VisitExpressionForLValue(call->Arguments()[3]);
+      GetEmitter()->Emit(Bytecode::TableVectorIteratorAddZoneFilter, iter, col_idx, comparison, val);
+      break;
+    }
     default: {
       UNREACHABLE("Impossible table iteration call");
     }
@@ -2138,6 +2145,25 @@ void BytecodeGenerator::VisitBuiltinStorageInterfaceCall(ast::CallExpr *call, as
       GetEmitter()->Emit(Bytecode::StorageInterfaceIndexInsertWithSlot, cond, storage_interface, tuple_slot, unique);
       break;
     }
+    case ast::Builtin::IndexBulkLoadAdd: {
+      LocalVar tuple_slot = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::StorageInterfaceIndexBulkLoadAdd, storage_interface, tuple_slot);
+      break;
+    }
+    case ast::Builtin::IndexBulkLoad: {
+      LocalVar cond = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+      GetEmitter()->Emit(Bytecode::StorageInterfaceIndexBulkLoad, cond, storage_interface);
+      GetExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
+    case ast::Builtin::IndexBulkLoadParallel: {
+      LocalVar cond = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
+      LocalVar tls = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar si_offset = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::StorageInterfaceIndexBulkLoadParallel, cond, storage_interface, tls, si_offset);
+      GetExecutionResult()->SetDestination(cond.ValueOf());
+      break;
+    }
     case ast::Builtin::IndexDelete: {
       LocalVar tuple_slot = VisitExpressionForRValue(call->Arguments()[1]);
       GetEmitter()->Emit(Bytecode::StorageInterfaceIndexDelete, storage_interface, tuple_slot);
@@ -2402,7 +2428,8 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::TableIterInit:
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPI:
-    case ast::Builtin::TableIterClose: {
+    case ast::Builtin::TableIterClose:
+    case ast::Builtin::TableIterAddZoneFilter: {
       VisitBuiltinTableIterCall(call, builtin);
       break;
     }
@@ -2580,6 +2607,9 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorAddBatchKey:
+    case ast::Builtin::IndexIteratorScanKeyBatch:
+    case ast::Builtin::IndexIteratorSelectBatchKey:
     case ast::Builtin::IndexIteratorAdvance:
     case ast::Builtin::IndexIteratorFree:
     case ast::Builtin::IndexIteratorGetPR:
@@ -2671,6 +2701,9 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexInsert:
     case ast::Builtin::IndexInsertUnique:
     case ast::Builtin::IndexInsertWithSlot:
+    case ast::Builtin::IndexBulkLoadAdd:
+    case ast::Builtin::IndexBulkLoad:
+    case ast::Builtin::IndexBulkLoadParallel:
     case ast::Builtin::IndexDelete:
     case ast::Builtin::StorageInterfaceFree: {
       VisitBuiltinStorageInterfaceCall(call, builtin);
@@ -2811,6 +2844,20 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::IndexIteratorScanLimitDescending, iterator, limit);
       break;
     }
+    case ast::Builtin::IndexIteratorAddBatchKey: {
+      LocalVar pr = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      GetEmitter()->Emit(Bytecode::IndexIteratorAddBatchKey, pr, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorScanKeyBatch: {
+      GetEmitter()->Emit(Bytecode::IndexIteratorScanKeyBatch, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorSelectBatchKey: {
+      auto key_idx = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::IndexIteratorSelectBatchKey, iterator, key_idx);
+      break;
+    }
     case ast::Builtin::IndexIteratorAdvance: {
       LocalVar cond = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
       GetEmitter()->Emit(Bytecode::IndexIteratorAdvance, cond, iterator);
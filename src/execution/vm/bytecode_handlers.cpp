@@ -29,6 +29,12 @@ void OpTableVectorIteratorFree(terrier::execution::sql::TableVectorIterator *ite
   iter->~TableVectorIterator();
 }
 
+void OpTableVectorIteratorAddZoneFilter(terrier::execution::sql::TableVectorIterator *iter, uint32_t col_idx,
+                                        uint32_t comparison, const terrier::execution::sql::Val *val) {
+  TERRIER_ASSERT(iter != nullptr, "NULL iterator given to add zone filter to");
+  iter->AddZoneFilter(col_idx, static_cast<terrier::execution::sql::ZoneFilterComparison>(comparison), *val);
+}
+
 void OpVPIInit(terrier::execution::sql::VectorProjectionIterator *vpi, terrier::execution::sql::VectorProjection *vp) {
   new (vpi) terrier::execution::sql::VectorProjectionIterator(vp);
 }
@@ -218,6 +224,18 @@ void OpStorageInterfaceIndexInsertWithSlot(bool *result, terrier::execution::sql
                                            terrier::storage::TupleSlot *tuple_slot, bool unique) {
   *result = storage_interface->IndexInsertWithTuple(*tuple_slot, unique);
 }
+void OpStorageInterfaceIndexBulkLoadAdd(terrier::execution::sql::StorageInterface *storage_interface,
+                                        terrier::storage::TupleSlot *tuple_slot) {
+  storage_interface->IndexBulkLoadAdd(*tuple_slot);
+}
+void OpStorageInterfaceIndexBulkLoad(bool *result, terrier::execution::sql::StorageInterface *storage_interface) {
+  *result = storage_interface->IndexBulkLoad();
+}
+void OpStorageInterfaceIndexBulkLoadParallel(bool *result, terrier::execution::sql::StorageInterface *storage_interface,
+                                             terrier::execution::sql::ThreadStateContainer *thread_state_container,
+                                             uint32_t si_offset) {
+  *result = storage_interface->IndexBulkLoadParallel(thread_state_container, si_offset);
+}
 void OpStorageInterfaceIndexDelete(terrier::execution::sql::StorageInterface *storage_interface,
                                    terrier::storage::TupleSlot *tuple_slot) {
   storage_interface->IndexDelete(*tuple_slot);
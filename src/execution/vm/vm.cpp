@@ -579,6 +579,15 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(TableVectorIteratorAddZoneFilter) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto comparison = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto *val = frame->LocalAt<sql::Val *>(READ_LOCAL_ID());
+    OpTableVectorIteratorAddZoneFilter(iter, col_idx, comparison, val);
+    DISPATCH_NEXT();
+  }
+
   OP(ParallelScanTable) : {
     auto table_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
     auto col_oids = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
@@ -1713,6 +1722,26 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorAddBatchKey) : {
+    auto *pr = frame->LocalAt<storage::ProjectedRow **>(READ_LOCAL_ID());
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorAddBatchKey(pr, iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorScanKeyBatch) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorScanKeyBatch(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorSelectBatchKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    auto key_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpIndexIteratorSelectBatchKey(iter, key_idx);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorFree) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorFree(iter);
@@ -1924,6 +1953,29 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(StorageInterfaceIndexBulkLoadAdd) : {
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    auto *tuple_slot = frame->LocalAt<storage::TupleSlot *>(READ_LOCAL_ID());
+    OpStorageInterfaceIndexBulkLoadAdd(storage_interface, tuple_slot);
+    DISPATCH_NEXT();
+  }
+
+  OP(StorageInterfaceIndexBulkLoad) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    OpStorageInterfaceIndexBulkLoad(result, storage_interface);
+    DISPATCH_NEXT();
+  }
+
+  OP(StorageInterfaceIndexBulkLoadParallel) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
+    auto *thread_state_container = frame->LocalAt<sql::ThreadStateContainer *>(READ_LOCAL_ID());
+    auto si_offset = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpStorageInterfaceIndexBulkLoadParallel(result, storage_interface, thread_state_container, si_offset);
+    DISPATCH_NEXT();
+  }
+
   OP(StorageInterfaceIndexDelete) : {
     auto *storage_interface = frame->LocalAt<sql::StorageInterface *>(READ_LOCAL_ID());
     auto *tuple_slot = frame->LocalAt<storage::TupleSlot *>(READ_LOCAL_ID());
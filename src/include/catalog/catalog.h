@@ -17,6 +17,7 @@ class TransactionManager;
 }  // namespace terrier::transaction
 
 namespace terrier::storage {
+class CheckpointManager;
 class GarbageCollector;
 class RecoveryManager;
 }  // namespace terrier::storage
@@ -136,6 +137,7 @@ class Catalog {
 
  private:
   DISALLOW_COPY_AND_MOVE(Catalog);
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
   const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
   const common::ManagedPointer<storage::BlockStore> catalog_block_store_;
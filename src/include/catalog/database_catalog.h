@@ -25,6 +25,7 @@ class TransactionContext;
 }
 
 namespace terrier::storage {
+class CheckpointManager;
 class GarbageCollector;
 class RecoveryManager;
 class SqlTable;
@@ -542,6 +543,7 @@ class DatabaseCatalog {
 
   friend class Catalog;
   friend class postgres::Builder;
+  friend class storage::CheckpointManager;
   friend class storage::RecoveryManager;
 
   /**
@@ -237,16 +237,21 @@ class IndexSchema {
    * @param is_primary indicating whether this will be the index for a primary key
    * @param is_exclusion indicating whether this index is for exclusion constraints
    * @param is_immediate indicating that the uniqueness check fails at insertion time
+   * @param num_include_columns how many of the last columns are INCLUDE columns, which the index stores alongside each
+   * key but which are not part of the key
    */
   IndexSchema(std::vector<Column> columns, const storage::index::IndexType type, const bool is_unique,
-              const bool is_primary, const bool is_exclusion, const bool is_immediate)
+              const bool is_primary, const bool is_exclusion, const bool is_immediate,
+              const uint16_t num_include_columns = 0)
       : columns_(std::move(columns)),
         type_(type),
         is_unique_(is_unique),
         is_primary_(is_primary),
         is_exclusion_(is_exclusion),
-        is_immediate_(is_immediate) {
+        is_immediate_(is_immediate),
+        num_include_columns_(num_include_columns) {
     TERRIER_ASSERT((is_primary && is_unique) || (!is_primary), "is_primary requires is_unique to be true as well.");
+    TERRIER_ASSERT(num_include_columns < columns_.size(), "An index needs at least one key column.");
     ExtractIndexedColOids();
   }
 
@@ -279,6 +284,16 @@ class IndexSchema {
     throw std::out_of_range("Column name doesn't exist");
   }
 
+  /**
+   * @return number of key columns, which come before the INCLUDE columns in the column vector
+   */
+  uint16_t NumKeyColumns() const { return static_cast<uint16_t>(columns_.size() - num_include_columns_); }
+
+  /**
+   * @return number of INCLUDE columns, which are stored by the index but are not part of the key
+   */
+  uint16_t NumIncludeColumns() const { return num_include_columns_; }
+
   /**
    * @return true if is a unique index
    */
@@ -381,6 +396,7 @@ class IndexSchema {
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(is_primary_));
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(is_exclusion_));
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(is_immediate_));
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(num_include_columns_));
     return hash;
   }
 
@@ -395,6 +411,7 @@ class IndexSchema {
     if (is_primary_ != rhs.is_primary_) return false;
     if (is_exclusion_ != rhs.is_exclusion_) return false;
     if (is_immediate_ != rhs.is_immediate_) return false;
+    if (num_include_columns_ != rhs.num_include_columns_) return false;
     // TODO(Ling): Does column order matter for compare equal?
     if (indexed_oids_ != rhs.indexed_oids_) return false;
     return columns_ == rhs.columns_;
@@ -416,6 +433,7 @@ class IndexSchema {
   bool is_primary_;
   bool is_exclusion_;
   bool is_immediate_;
+  uint16_t num_include_columns_ = 0;
 
   friend class Catalog;
   friend class postgres::Builder;
@@ -99,6 +99,12 @@ struct Constants {
    */
   static constexpr const float ADAPTIVE_PRED_ORDER_SAMPLE_FREQ = 0.1;
 
+  /**
+   * The most memory, in bytes, that a storage interface stages index keys in for a bulk load during CREATE INDEX.
+   * Beyond it, the keys are inserted into the index one at a time instead.
+   */
+  static constexpr const uint64_t INDEX_BULK_LOAD_MEMORY_LIMIT = 256 * MB;
+
   /**
    * Flag indicating if parallel execution is supported.
    */
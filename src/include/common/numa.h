@@ -0,0 +1,68 @@
+#pragma once
+
+#include <sched.h>
+
+#include <cstdint>
+
+#include "common/macros.h"
+
+namespace terrier::common {
+
+/**
+ * Utility class for placing memory and threads on NUMA nodes. The topology of the machine is read from sysfs once.
+ * Machines and kernels without NUMA support are treated as a single node, in which case placing things is a no-op.
+ */
+class NumaUtil {
+ public:
+  /** This class cannot be instantiated. */
+  DISALLOW_INSTANTIATION(NumaUtil);
+  /** This class cannot be copied or moved. */
+  DISALLOW_COPY_AND_MOVE(NumaUtil);
+
+  /**
+   * Stands for no node in particular
+   */
+  static constexpr uint16_t ANY_NODE = UINT16_MAX;
+
+  /**
+   * @return number of NUMA nodes of the machine, which is at least 1
+   */
+  static uint16_t NumNodes();
+
+  /**
+   * @return the NUMA node of the CPU the calling thread is currently running on
+   */
+  static uint16_t CurrentNode();
+
+  /**
+   * Asks the kernel to back the given memory with pages from the given node, moving pages that were already touched.
+   * This is best effort. The kernel falls back to other nodes when the node runs out of memory, and nothing happens
+   * if the node does not exist.
+   * @param addr start of the memory, which must be page aligned
+   * @param size size of the memory in bytes
+   * @param node the node to place the memory on
+   */
+  static void BindMemory(void *addr, uint64_t size, uint16_t node);
+
+  /**
+   * Restricts the calling thread to the CPUs of a NUMA node for as long as the object lives, after which the thread
+   * may run on the CPUs it could run on before again. Does nothing on machines with a single node.
+   */
+  class ScopedNodeBinding {
+   public:
+    /**
+     * @param node the node to run the calling thread on
+     */
+    explicit ScopedNodeBinding(uint16_t node);
+
+    ~ScopedNodeBinding();
+
+    DISALLOW_COPY_AND_MOVE(ScopedNodeBinding);
+
+   private:
+    cpu_set_t previous_cpus_;
+    bool bound_ = false;
+  };
+};
+
+}  // namespace terrier::common
@@ -68,9 +68,10 @@ class ObjectPool {
    *
    * @param size_limit the maximum number of objects the object pool controls
    * @param reuse_limit the maximum number of reusable objects
+   * @param alloc the allocator to construct and destruct objects with
    */
-  ObjectPool(uint64_t size_limit, uint64_t reuse_limit)
-      : size_limit_(size_limit), reuse_limit_(reuse_limit), current_size_(0) {}
+  ObjectPool(uint64_t size_limit, uint64_t reuse_limit, Allocator alloc = Allocator())
+      : alloc_(std::move(alloc)), size_limit_(size_limit), reuse_limit_(reuse_limit), current_size_(0) {}
 
   /**
    * Destructs the memory pool. Frees any memory it holds.
@@ -181,9 +182,17 @@ class ObjectPool {
    */
   uint64_t GetSizeLimit() const { return size_limit_; }
 
+  /**
+   * @return number of objects handed out by the object pool that have not been released back to it
+   */
+  uint64_t GetNumObjectsInUse() const {
+    SpinLatch::ScopedSpinLatch guard(&latch_);
+    return current_size_ - reuse_queue_.size();
+  }
+
  private:
   Allocator alloc_;
-  SpinLatch latch_;
+  mutable SpinLatch latch_;
   // TODO(yangjuns): We don't need to reuse objects in a FIFO pattern. We could potentially pass a second template
   // parameter to define the backing container for the std::queue. That way we can measure each backing container.
   std::queue<T *> reuse_queue_;
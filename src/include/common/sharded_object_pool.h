@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "common/allocator.h"
+#include "common/constants.h"
+#include "common/object_pool.h"
+#include "common/spin_latch.h"
+
+namespace terrier::common {
+
+/**
+ * Object pool with the same interface and limits as ObjectPool, for pools that many threads get objects from at the
+ * same time.
+ *
+ * Reusable objects are kept in magazines, which are small stacks of objects. Every thread is assigned one of a fixed
+ * number of shards, and the shard holds the magazine that its threads get objects from and release objects into. A
+ * thread only leaves its shard once it runs out of objects, or its magazine is full, and then it swaps out the whole
+ * magazine at once with a central depot. Most calls thus only take the latch of their shard, which few other threads
+ * share, instead of a latch that all threads share.
+ *
+ * The size limit and the reuse limit hold for the pool as a whole, just as they do for ObjectPool. When the size limit
+ * is reached, a thread takes reusable objects from the magazines of other shards before it gives up.
+ *
+ * @tparam T the type of objects in the pool.
+ * @tparam Allocator the allocator to use when constructing and destructing a new object. See ObjectPool.
+ */
+template <typename T, class Allocator = ByteAlignedAllocator<T>>
+class ShardedObjectPool {
+ public:
+  /**
+   * Number of shards the pool is split into. More shards than threads using the pool do not help, but keep more
+   * objects out of reach of the threads that need them when the pool nears its size limit.
+   */
+  static constexpr uint32_t NUM_SHARDS = 32;
+
+  /**
+   * Number of objects in a full magazine. A thread takes the latch of the depot at most once every MAGAZINE_SIZE calls.
+   */
+  static constexpr uint32_t MAGAZINE_SIZE = 16;
+
+  /**
+   * Initializes a new object pool with the supplied limit to the number of objects reused.
+   *
+   * @param size_limit the maximum number of objects the object pool controls
+   * @param reuse_limit the maximum number of reusable objects
+   * @param alloc the allocator to construct and destruct objects with
+   */
+  ShardedObjectPool(uint64_t size_limit, uint64_t reuse_limit, Allocator alloc = Allocator())
+      : alloc_(std::move(alloc)), size_limit_(size_limit), reuse_limit_(reuse_limit) {}
+
+  /**
+   * Destructs the memory pool. Frees any memory it holds.
+   *
+   * Beware that the object pool will not deallocate some piece of memory not explicitly released via a Release call.
+   */
+  ~ShardedObjectPool() {
+    for (auto &shard : shards_)
+      for (T *obj : shard.magazine_) alloc_.Delete(obj);
+    for (auto &magazine : depot_)
+      for (T *obj : magazine) alloc_.Delete(obj);
+  }
+
+  DISALLOW_COPY_AND_MOVE(ShardedObjectPool);
+
+  /**
+   * Returns a piece of memory to hold an object of T.
+   * @throw NoMoreObjectException if the object pool has reached the limit of how many objects it may hand out.
+   * @throw AllocatorFailureException if the allocator fails to return a valid memory address.
+   * @return pointer to memory that can hold T
+   */
+  T *Get() {
+    T *result = TakeFromShard(&shards_[ThreadShard()]);
+    if (result == nullptr) {
+      result = Allocate();
+      if (result != nullptr) return result;
+      result = Steal();
+    }
+    alloc_.Reuse(result);
+    return result;
+  }
+
+  /**
+   * Set the object pool's size limit.
+   *
+   * The operation fails if the object pool has already allocated more objects than the size limit.
+   *
+   * @param new_size the new object pool size
+   * @return true if new_size is successfully set and false the operation fails
+   */
+  bool SetSizeLimit(uint64_t new_size) {
+    // Objects are only allocated under this latch, so current_size_ cannot grow past new_size in the meantime
+    SpinLatch::ScopedSpinLatch guard(&size_latch_);
+    if (new_size < current_size_) return false;
+    size_limit_ = new_size;
+    return true;
+  }
+
+  /**
+   * Set the reuse limit to a new value. This function always succeed and immediately changes reuse limit. Reusable
+   * objects beyond the new limit are freed, taken from the depot before the magazines of the shards.
+   *
+   * @param new_reuse_limit the maximum number of reusable objects
+   */
+  void SetReuseLimit(uint64_t new_reuse_limit) {
+    reuse_limit_ = new_reuse_limit;
+    std::vector<T *> excess;
+    auto take_excess = [&](std::vector<T *> *magazine) {
+      while (!magazine->empty() && num_reusable_ > reuse_limit_) {
+        excess.push_back(magazine->back());
+        magazine->pop_back();
+        num_reusable_--;
+      }
+    };
+    {
+      SpinLatch::ScopedSpinLatch guard(&depot_latch_);
+      for (auto &magazine : depot_) take_excess(&magazine);
+      depot_.erase(std::remove_if(depot_.begin(), depot_.end(), [](const auto &m) { return m.empty(); }), depot_.end());
+    }
+    for (auto &shard : shards_) {
+      if (num_reusable_ <= reuse_limit_) break;
+      SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+      take_excess(&shard.magazine_);
+    }
+    for (T *obj : excess) alloc_.Delete(obj);
+    current_size_ -= excess.size();
+  }
+
+  /**
+   * Releases the piece of memory given, allowing it to be freed or reused for later. Although the memory is not
+   * necessarily immediately reclaimed, it will be unsafe to access after entering this call.
+   *
+   * @param obj pointer to object to release
+   */
+  void Release(T *obj) {
+    TERRIER_ASSERT(obj != nullptr, "releasing a null pointer");
+    if (num_reusable_++ >= reuse_limit_) {
+      num_reusable_--;
+      alloc_.Delete(obj);
+      current_size_--;
+      return;
+    }
+    Shard &shard = shards_[ThreadShard()];
+    SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (shard.magazine_.size() >= MAGAZINE_SIZE) {
+      // Hand the full magazine over to the depot, where threads that ran out of objects can pick it up
+      std::vector<T *> full;
+      full.reserve(MAGAZINE_SIZE);
+      full.swap(shard.magazine_);
+      SpinLatch::ScopedSpinLatch depot_guard(&depot_latch_);
+      depot_.emplace_back(std::move(full));
+    }
+    shard.magazine_.push_back(obj);
+  }
+
+  /**
+   * @return size limit of the object pool
+   */
+  uint64_t GetSizeLimit() const { return size_limit_; }
+
+  /**
+   * @return number of objects handed out by the object pool that have not been released back to it. Only exact when
+   * no other thread is using the pool at the same time.
+   */
+  uint64_t GetNumObjectsInUse() const { return current_size_ - num_reusable_; }
+
+  /**
+   * @return number of objects allocated by the object pool, including those kept around for reuse, which is what the
+   * size limit bounds
+   */
+  uint64_t GetNumObjectsAllocated() const { return current_size_; }
+
+ private:
+  /**
+   * Reusable objects of the threads assigned to this shard
+   */
+  struct alignas(Constants::CACHELINE_SIZE) Shard {
+    // Protects magazine_
+    SpinLatch latch_;
+    // Stack of reusable objects, which is refilled from and emptied into the depot one magazine at a time
+    std::vector<T *> magazine_;
+  };
+
+  Allocator alloc_;
+  std::array<Shard, NUM_SHARDS> shards_;
+  // Protects depot_
+  SpinLatch depot_latch_;
+  // Full magazines
+  std::vector<std::vector<T *>> depot_;
+  // Protects the size limit from changing while objects are being allocated
+  SpinLatch size_latch_;
+  std::atomic<uint64_t> size_limit_;
+  std::atomic<uint64_t> reuse_limit_;
+  // Number of objects the pool has allocated, including objects that have been given out to callers and reusable ones
+  std::atomic<uint64_t> current_size_{0};
+  // Number of reusable objects in the magazines of the shards and the depot
+  std::atomic<uint64_t> num_reusable_{0};
+
+  /**
+   * @return index of the shard the calling thread uses. Threads are assigned shards round-robin the first time they
+   * use a pool of this type.
+   */
+  static uint32_t ThreadShard() {
+    static std::atomic<uint32_t> next_shard{0};
+    thread_local const uint32_t shard = next_shard++ % NUM_SHARDS;
+    return shard;
+  }
+
+  // Takes a reusable object from the given shard, refilling its magazine from the depot if it is empty. Returns nullptr
+  // if neither has any.
+  T *TakeFromShard(Shard *const shard) {
+    SpinLatch::ScopedSpinLatch guard(&shard->latch_);
+    if (shard->magazine_.empty()) {
+      SpinLatch::ScopedSpinLatch depot_guard(&depot_latch_);
+      if (depot_.empty()) return nullptr;
+      shard->magazine_.swap(depot_.back());
+      depot_.pop_back();
+    }
+    T *result = shard->magazine_.back();
+    shard->magazine_.pop_back();
+    num_reusable_--;
+    return result;
+  }
+
+  // Allocates a new object, or returns nullptr if the pool has reached its size limit
+  T *Allocate() {
+    {
+      SpinLatch::ScopedSpinLatch guard(&size_latch_);
+      if (current_size_ >= size_limit_) return nullptr;
+      current_size_++;
+    }
+    T *result = alloc_.New();  // result could be null because the allocator may not find enough memory space
+    if (result != nullptr) return result;
+    current_size_--;
+    throw AllocatorFailureException();
+  }
+
+  // Takes a reusable object from the first shard that has one, once the pool cannot allocate any more objects
+  T *Steal() {
+    for (auto &shard : shards_) {
+      T *result = TakeFromShard(&shard);
+      if (result != nullptr) return result;
+    }
+    throw NoMoreObjectException(size_limit_);
+  }
+};
+}  // namespace terrier::common
@@ -49,6 +49,7 @@ namespace terrier::execution::ast {
   F(TableIterAdvance, tableIterAdvance)                                 \
   F(TableIterGetVPI, tableIterGetVPI)                                   \
   F(TableIterClose, tableIterClose)                                     \
+  F(TableIterAddZoneFilter, tableIterAddZoneFilter)                     \
   F(TableIterParallel, iterateTableParallel)                            \
                                                                         \
   /* VPI */                                                             \
@@ -190,6 +191,9 @@ namespace terrier::execution::ast {
   F(IndexIteratorScanAscending, indexIteratorScanAscending)             \
   F(IndexIteratorScanDescending, indexIteratorScanDescending)           \
   F(IndexIteratorScanLimitDescending, indexIteratorScanLimitDescending) \
+  F(IndexIteratorAddBatchKey, indexIteratorAddBatchKey)                 \
+  F(IndexIteratorScanKeyBatch, indexIteratorScanKeyBatch)               \
+  F(IndexIteratorSelectBatchKey, indexIteratorSelectBatchKey)           \
   F(IndexIteratorAdvance, indexIteratorAdvance)                         \
   F(IndexIteratorGetPR, indexIteratorGetPR)                             \
   F(IndexIteratorGetLoPR, indexIteratorGetLoPR)                         \
@@ -256,6 +260,9 @@ namespace terrier::execution::ast {
   F(IndexInsert, indexInsert)                                           \
   F(IndexInsertUnique, indexInsertUnique)                               \
   F(IndexInsertWithSlot, indexInsertWithSlot)                           \
+  F(IndexBulkLoadAdd, indexBulkLoadAdd)                                 \
+  F(IndexBulkLoad, indexBulkLoad)                                       \
+  F(IndexBulkLoadParallel, indexBulkLoadParallel)                       \
   F(IndexDelete, indexDelete)                                           \
   F(StorageInterfaceFree, storageInterfaceFree)                         \
   /* Trig */                                                            \
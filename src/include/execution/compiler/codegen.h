@@ -210,9 +210,17 @@ class CodeGen {
    */
   ast::Expr *ArrayType(uint64_t num_elems, ast::BuiltinType::Kind kind);
 
+  /**
+   * @return A type representation expression that is "[num_elems]elem_type".
+   */
+  ast::Expr *ArrayType(uint64_t num_elems, ast::Expr *elem_type);
+
   /** @return An expression representing "arr[idx]". */
   ast::Expr *ArrayAccess(ast::Identifier arr, uint64_t idx);
 
+  /** @return An expression representing "arr[idx]". */
+  ast::Expr *ArrayAccess(ast::Expr *arr, ast::Expr *idx);
+
   /**
    * Convert a SQL type into a type representation expression.
    * @param type The SQL type.
@@ -568,6 +576,18 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *TableIterClose(ast::Expr *table_iter);
 
+  /**
+   * Call \@tableIterAddZoneFilter(). Add a filter that lets a table vector iterator skip frozen blocks whose zone maps
+   * rule out any match.
+   * @param table_iter The table vector iterator.
+   * @param comp_type The comparison type.
+   * @param col_idx The index of the column in the iterator's column OIDs to apply the filter on.
+   * @param filter_val The filtering value.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *TableIterAddZoneFilter(ast::Expr *table_iter, parser::ExpressionType comp_type,
+                                                  uint32_t col_idx, ast::Expr *filter_val);
+
   /**
    * Call \@iterateTableParallel(). Performs a parallel scan over the table with the provided name,
    * using the provided query state and thread-state container and calling the provided scan
@@ -603,6 +623,19 @@ class CodeGen {
   [[nodiscard]] ast::Expr *IndexIteratorInit(ast::Identifier iter, ast::Expr *exec_ctx_var, uint32_t num_attrs,
                                              uint32_t table_oid, uint32_t index_oid, ast::Identifier col_oids);
 
+  /**
+   * Call \@indexIteratorInit(iter, execCtx, table_oid, index_oid, col_oids)
+   * @param iter A pointer to the index iterator.
+   * @param exec_ctx_var The execution context variable.
+   * @param num_attrs Number of attributes
+   * @param table_oid The oid of the index's table.
+   * @param index_oid The oid the index.
+   * @param col_oids The identifier of the array of column oids to read.
+   * @return The expression corresponding to the builtin call.
+   */
+  [[nodiscard]] ast::Expr *IndexIteratorInit(ast::Expr *iter, ast::Expr *exec_ctx_var, uint32_t num_attrs,
+                                             uint32_t table_oid, uint32_t index_oid, ast::Identifier col_oids);
+
   /**
    * Call \@indexIteratorScanType(&iter[, limit])
    * @param iter The identifier of the index iterator.
@@ -1283,6 +1316,18 @@ class CodeGen {
   ast::Expr *StorageInterfaceInit(ast::Identifier si, ast::Expr *exec_ctx, uint32_t table_oid, ast::Identifier col_oids,
                                   bool need_indexes);
 
+  /**
+   * Call storageInterfaceInit(storage_interface, execCtx, table_oid, col_oids, need_indexes)
+   * @param si A pointer to the storage interface to initialize
+   * @param exec_ctx The execution context that we are running in.
+   * @param table_oid The oid of the table being accessed.
+   * @param col_oids The identifier of the array of column oids to access.
+   * @param need_indexes Whether the storage interface will need to use indexes
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *StorageInterfaceInit(ast::Expr *si, ast::Expr *exec_ctx, uint32_t table_oid, ast::Identifier col_oids,
+                                  bool need_indexes);
+
   // ---------------------------------------------------------------------------
   //
   // Identifiers
@@ -39,12 +39,45 @@ class IndexCreateTranslator : public OperatorTranslator, public PipelineDriver {
   DISALLOW_COPY_AND_MOVE(IndexCreateTranslator);
 
   /**
-   * Implement create index logic where it fills in the scanned tuples obtained from the StorageInterface struct
+   * Initialize the inserter that loads the index.
+   * @param function The function being built.
+   */
+  void InitializeQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * Free the inserter that loads the index.
+   * @param function The function being built.
+   */
+  void TearDownQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * Initialize the thread-local inserter, if the pipeline is parallel.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Free the thread-local inserter, if the pipeline is parallel.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Implement create index logic where it stages the keys of the scanned tuples in the StorageInterface struct
    * @param context The context of the work.
    * @param function The pipeline generating function.
    */
   void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
+  /**
+   * Load the staged keys into the index, merging the keys staged by every thread if the pipeline is parallel.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
   /**
    * @return The child's output at the given index.
    */
@@ -57,37 +90,41 @@ class IndexCreateTranslator : public OperatorTranslator, public PipelineDriver {
    */
   ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override { UNREACHABLE("Not implemented"); };
 
-  /** @return Throw an error, this is serial for now. */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("index create is serial."); };
+  /** @return The pipeline work function parameters. Just the *TVI. */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override;
 
-  /** @return Throw an error, this is serial for now. */
-  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("index create is serial.");
-  };
+  /**
+   * Launch a parallel table scan.
+   * @param function The pipeline generating function.
+   * @param work_func_name Name of the worker function that'll be called during the parallel scan.
+   */
+  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override;
 
  private:
-  void InitScan(FunctionBuilder *function) const;
-  void DeclareInserter(FunctionBuilder *function) const;
-  void DeclareIndexPR(FunctionBuilder *function) const;
+  void InitializeInserter(FunctionBuilder *function, ast::Expr *inserter) const;
+  void DeclareIndexPR(FunctionBuilder *function, ast::Expr *inserter) const;
   void DeclareTVI(FunctionBuilder *function) const;
   void DeclareSlot(FunctionBuilder *function) const;
 
   // Perform a table scan using the provided table vector iterator pointer.
-  void ScanTable(WorkContext *ctx, FunctionBuilder *function) const;
+  void ScanTable(WorkContext *ctx, FunctionBuilder *function, ast::Expr *inserter) const;
 
   // Generate a scan over the VPI.
-  void ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast::Expr *vpi) const;
-  void IndexInsert(WorkContext *ctx, FunctionBuilder *function) const;
+  void ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast::Expr *vpi, ast::Expr *inserter) const;
+  void IndexInsert(WorkContext *ctx, FunctionBuilder *function, ast::Expr *inserter) const;
 
-  void FreeInserter(FunctionBuilder *function) const;
+  void FreeInserter(FunctionBuilder *function, ast::Expr *inserter) const;
 
   void SetOids(FunctionBuilder *function) const;
   std::vector<catalog::col_oid_t> AllColOids(const catalog::Schema &table_schema) const;
 
   CodeGen *codegen_;
-  ast::Identifier inserter_;
   ast::Identifier index_pr_;
 
+  // The inserter that loads the index, and the thread-local inserters that parallel workers stage keys in.
+  StateDescriptor::Entry global_inserter_;
+  StateDescriptor::Entry local_inserter_;
+
   // The name of the declared TVI and VPI.
   ast::Identifier tvi_var_;
   ast::Identifier vpi_var_;
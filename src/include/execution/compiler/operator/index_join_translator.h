@@ -6,6 +6,7 @@
 
 #include "execution/ast/identifier.h"
 #include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/pipeline.h"
 #include "execution/compiler/pipeline_driver.h"
 #include "planner/plannodes/plan_node_defs.h"
 #include "storage/storage_defs.h"
@@ -33,13 +34,36 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   /** This class cannot be copied or moved. */
   DISALLOW_COPY_AND_MOVE(IndexJoinTranslator);
 
+  /**
+   * If the join probes the index in batches, define the struct that holds the outer tuples of a batch.
+   * @param decls The top-level declarations.
+   */
+  void DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) override;
+
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override {}
 
-  void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override {}
+  /**
+   * If the join probes the index in batches, initialize the index iterator and the batch of outer tuples.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
   void PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const override;
 
-  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *func) const override {}
+  /**
+   * If the join probes the index in batches, probe the last, partial batch of outer tuples.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * If the join probes the index in batches, free the index iterator.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
 
   /**
    * @return The value (or value vector) of the column with the provided column OID in the table
@@ -47,6 +71,15 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
    */
   ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override;
 
+  /**
+   * While the matches of a batch are pushed, the outer tuples are read from the batch rather than from the child.
+   * @param context The context of the work.
+   * @param child_idx The index of the child to read the attribute from.
+   * @param attr_idx The index of the attribute.
+   * @return The value of the attribute.
+   */
+  ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
+
   ast::Expr *GetSlotAddress() const override;
 
   /** @return Throw an error, this is serial for now. */
@@ -58,11 +91,22 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   };
 
  private:
+  // Probe the index with the current outer tuple and push every match.
+  void ProbeTuple(WorkContext *context, FunctionBuilder *function) const;
+  // Add the current outer tuple and its key to the batch, and probe the batch once it is full.
+  void AddToBatch(WorkContext *context, FunctionBuilder *function) const;
+  // Generate the function that probes the index with the keys of the batch and pushes every match.
+  ast::FunctionDecl *GenerateProbeBatchFunction(WorkContext *context) const;
+  // Position the iterator with loop_init and push every match.
+  void PushMatches(WorkContext *context, FunctionBuilder *function, ast::Stmt *loop_init) const;
+  // Get a pointer to the index iterator.
+  ast::Expr *GetIteratorPtr() const;
+
   void DeclareIterator(FunctionBuilder *builder) const;
   void SetOids(FunctionBuilder *builder) const;
   void FillKey(WorkContext *context, FunctionBuilder *builder, ast::Identifier pr,
                const std::unordered_map<catalog::indexkeycol_oid_t, planner::IndexExpression> &index_exprs) const;
-  void FreeIterator(FunctionBuilder *builder) const;
+  void FreeIterator(FunctionBuilder *builder, ast::Expr *iter) const;
   void DeclareIndexPR(FunctionBuilder *builder) const;
   void DeclareTablePR(FunctionBuilder *builder) const;
   void DeclareSlot(FunctionBuilder *builder) const;
@@ -74,6 +118,10 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   const catalog::IndexSchema &index_schema_;
   const std::unordered_map<catalog::indexkeycol_oid_t, uint16_t> &index_pm_;
 
+  // Exact lookups are batched: the outer tuples are collected and the index is probed with all of their keys at once,
+  // which lets the index share the work of lookups. Other scan types probe the index once per outer tuple.
+  const bool batched_;
+
   // Structs and local variables
   ast::Identifier index_iter_;
   ast::Identifier col_oids_;
@@ -81,5 +129,16 @@ class IndexJoinTranslator : public OperatorTranslator, public PipelineDriver {
   ast::Identifier hi_index_pr_;
   ast::Identifier table_pr_;
   ast::Identifier slot_;
+  ast::Identifier outer_row_;
+  ast::Identifier outer_row_type_;
+  ast::Identifier probe_batch_fn_;
+
+  // The index iterator, the outer tuples of the batch and how many there are, if the join is batched.
+  StateDescriptor::Entry batch_iter_;
+  StateDescriptor::Entry batch_;
+  StateDescriptor::Entry batch_size_;
+
+  // Set while the matches of a batch are generated, when outer attributes are read from the batch.
+  mutable bool reading_batch_ = false;
 };
 }  // namespace terrier::execution::compiler
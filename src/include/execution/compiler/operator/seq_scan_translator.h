@@ -108,6 +108,12 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
                                      common::ManagedPointer<parser::AbstractExpression> predicate,
                                      std::vector<ast::Identifier> *curr_clause, bool seen_conjunction);
 
+  // Generate the value the column is compared with in a column-const or column-param comparison.
+  ast::Expr *GetComparedValue(common::ManagedPointer<parser::AbstractExpression> predicate, ast::Expr *exec_ctx) const;
+
+  // Add zone filters to the table vector iterator for the comparisons every tuple matching the predicate passes.
+  void AddZoneFilters(FunctionBuilder *function, common::ManagedPointer<parser::AbstractExpression> predicate) const;
+
   // Perform a table scan using the provided table vector iterator pointer.
   void ScanTable(WorkContext *ctx, FunctionBuilder *function) const;
 
@@ -108,6 +108,14 @@ class Pipeline {
    */
   StateDescriptor::Entry DeclarePipelineStateEntry(const std::string &name, ast::Expr *type_repr);
 
+  /**
+   * Declare a function that an operator generates while the work function of this pipeline is being generated, e.g. one
+   * that the work function calls. Such functions are declared ahead of the work function. They can take the pipeline
+   * parameters, see PipelineParams().
+   * @param function The function to declare.
+   */
+  void DeclareWorkHelperFunction(ast::FunctionDecl *function);
+
   /**
    * Register the provided pipeline as a dependency for this pipeline. In other words, this pipeline
    * cannot begin until the provided pipeline completes.
@@ -171,6 +179,12 @@ class Pipeline {
    */
   util::RegionVector<ast::FieldDecl *> PipelineParams() const;
 
+  /**
+   * @return A pointer to the state of this pipeline. Valid in functions taking the pipeline parameters and, if the
+   *         pipeline is serial, in the operators' BeginPipelineWork() and FinishPipelineWork().
+   */
+  ast::Expr *GetPipelineStatePtr() const;
+
   /**
    * @return A unique name for a function local to this pipeline.
    */
@@ -239,6 +253,8 @@ class Pipeline {
   ast::Identifier state_var_;
   // The pipeline state.
   StateDescriptor state_;
+  // Functions declared while generating the work function, see DeclareWorkHelperFunction().
+  std::vector<ast::FunctionDecl *> work_helper_functions_;
 };
 
 }  // namespace terrier::execution::compiler
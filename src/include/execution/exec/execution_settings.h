@@ -30,6 +30,9 @@ class EXPORT ExecutionSettings {
     return adaptive_predicate_order_sampling_frequency_;
   }
 
+  /** @return The most memory, in bytes, that a storage interface stages index keys in for a bulk load. */
+  constexpr uint64_t GetIndexBulkLoadMemoryLimit() const { return index_bulk_load_memory_limit_; }
+
   /** @return True if parallel query execution is enabled. */
   constexpr bool GetIsParallelQueryExecutionEnabled() const { return is_parallel_execution_enabled_; }
 
@@ -38,6 +41,7 @@ class EXPORT ExecutionSettings {
   double arithmetic_full_compute_opt_threshold_{common::Constants::ARITHMETIC_FULL_COMPUTE_THRESHOLD};
   float min_bit_density_threshold_for_avx_index_decode_{common::Constants::BIT_DENSITY_THRESHOLD_FOR_AVX_INDEX_DECODE};
   float adaptive_predicate_order_sampling_frequency_{common::Constants::ADAPTIVE_PRED_ORDER_SAMPLE_FREQ};
+  uint64_t index_bulk_load_memory_limit_{common::Constants::INDEX_BULK_LOAD_MEMORY_LIMIT};
   bool is_parallel_execution_enabled_{common::Constants::IS_PARALLEL_EXECUTION_ENABLED};
 
   // MiniRunners needs to set query_identifier and pipeline_operating_units_.
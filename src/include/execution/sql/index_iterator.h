@@ -45,6 +45,25 @@ class EXPORT IndexIterator {
    */
   void ScanKey();
 
+  /**
+   * Adds a key to the batch probed by the next ScanKeyBatch.
+   * @return The projected row to fill the key into. It stays valid until the batch is probed.
+   */
+  storage::ProjectedRow *AddBatchKey();
+
+  /**
+   * Probe the index for every key in the batch at once, then start a new, empty batch. The results of each key are
+   * kept until the next call, and SelectBatchKey moves the iterator onto them.
+   */
+  void ScanKeyBatch();
+
+  /**
+   * Position the iterator before the results of a key probed by the last ScanKeyBatch, as if ScanKey had just been
+   * called with that key.
+   * @param key_idx The position of the key in its batch.
+   */
+  void SelectBatchKey(uint32_t key_idx);
+
   /**
    * Perform an ascending scan
    * @param scan_type Type of Scan
@@ -84,7 +103,7 @@ class EXPORT IndexIterator {
   storage::ProjectedRow *HiPR() { return hi_index_pr_; }
 
   /**
-   * Perform a select.
+   * Perform a select. The columns come straight from the index instead when the last ScanKey found them there.
    * @return The resulting projected row.
    */
   storage::ProjectedRow *TablePR();
@@ -95,9 +114,20 @@ class EXPORT IndexIterator {
   storage::TupleSlot CurrentSlot() { return tuples_[curr_index_ - 1]; }
 
  private:
+  // A column read by the iterator that the index stores too
+  struct CoveredColumn {
+    uint16_t table_offset_;
+    uint16_t index_offset_;
+    uint16_t size_;
+  };
+
+  // Sets up covered_columns_ if the index stores every column read
+  void CoverColumns();
+
   exec::ExecutionContext *exec_ctx_;
   uint32_t num_attrs_;
   std::vector<catalog::col_oid_t> col_oids_;
+  uint32_t index_oid_;
   common::ManagedPointer<storage::index::Index> index_;
   common::ManagedPointer<storage::SqlTable> table_;
 
@@ -109,6 +139,19 @@ class EXPORT IndexIterator {
   storage::ProjectedRow *hi_index_pr_;
   storage::ProjectedRow *table_pr_;
   std::vector<storage::TupleSlot> tuples_{};
+
+  // Keys added since the last ScanKeyBatch and the results of the keys it probed. The key buffers are allocated on the
+  // first AddBatchKey and reused by later batches.
+  std::vector<void *> batch_key_buffers_{};
+  std::vector<const storage::ProjectedRow *> batch_keys_{};
+  uint32_t num_batch_keys_ = 0;
+  std::vector<std::vector<storage::TupleSlot>> batch_tuples_{};
+
+  // Where to copy every column read from the rows the index returns for ScanKey. Empty if some column must be read from
+  // the table. The rows are only used for the results that covered_ marks, the others are still read from the table.
+  std::vector<CoveredColumn> covered_columns_{};
+  std::vector<byte> covered_rows_{};
+  std::vector<bool> covered_{};
 };
 
 }  // namespace terrier::execution::sql
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
@@ -25,6 +26,8 @@ class ExecutionContext;
 
 namespace sql {
 
+class ThreadStateContainer;
+
 /**
  * Base class to interact with the storage layer (tables and indexes).
  */
@@ -103,7 +106,52 @@ class EXPORT StorageInterface {
    */
   bool IndexInsertWithTuple(storage::TupleSlot table_tuple_slot, bool unique);
 
+  /**
+   * Stage a copy of the current index PR and the given tuple slot for a bulk load into the current index. Once the
+   * staged keys would take up more than the bulk load memory limit, they and all keys after them are inserted into the
+   * index one at a time instead.
+   * @param table_tuple_slot tuple slot
+   */
+  void IndexBulkLoadAdd(storage::TupleSlot table_tuple_slot);
+
+  /**
+   * Bulk load everything staged by IndexBulkLoadAdd into the current index, which must be empty and not yet visible
+   * to other transactions. If IndexBulkLoadAdd went over the memory limit, the index holds the keys already.
+   * @return Whether the load was successful.
+   */
+  bool IndexBulkLoad();
+
+  /**
+   * Bulk load everything staged by this and all thread-local storage interfaces into the current index, which must be
+   * empty and not yet visible to other transactions. If any of them went over the memory limit, the index is not empty
+   * anymore, and the keys staged by the others are inserted one at a time instead.
+   * @param thread_state_container The container of the thread-local states.
+   * @param si_offset The offset of the storage interface in each thread-local state.
+   * @return Whether the load was successful.
+   */
+  bool IndexBulkLoadParallel(const ThreadStateContainer *thread_state_container, std::size_t si_offset);
+
  protected:
+  /**
+   * Append the keys staged in this storage interface to the given entries.
+   * @param[out] entries The keys and their tuple slots.
+   */
+  void CollectBulkLoadEntries(std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> *entries) const;
+
+  /**
+   * Drop the keys staged in this storage interface, and start staging again.
+   */
+  void ClearBulkLoadEntries();
+
+  /**
+   * Load the given keys into the current index.
+   * @param entries The keys and their tuple slots.
+   * @param one_at_a_time Whether the keys must be inserted one at a time, because the index is not empty.
+   * @return Whether the load was successful.
+   */
+  bool LoadBulkLoadEntries(const std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> &entries,
+                           bool one_at_a_time);
+
   /**
    * Oid of the table being accessed.
    */
@@ -154,6 +202,27 @@ class EXPORT StorageInterface {
    * Current index being accessed.
    */
   common::ManagedPointer<storage::index::Index> curr_index_{nullptr};
+
+  /**
+   * Copies of the staged index PRs, each padded to a multiple of 8 bytes to keep them aligned.
+   */
+  std::vector<uint64_t> bulk_load_keys_;
+  /**
+   * Tuple slots of the staged index PRs.
+   */
+  std::vector<storage::TupleSlot> bulk_load_slots_;
+  /**
+   * The most memory, in bytes, that the staged index PRs and their tuple slots may take up.
+   */
+  uint64_t bulk_load_memory_limit_;
+  /**
+   * Whether the staged keys went over the memory limit, so that keys are inserted one at a time.
+   */
+  bool bulk_load_one_at_a_time_{false};
+  /**
+   * Whether a key inserted one at a time was rejected by the index.
+   */
+  bool bulk_load_failed_{false};
 };
 }  // namespace sql
 }  // namespace terrier::execution
@@ -18,6 +18,12 @@ class SqlTable;
 namespace terrier::execution::sql {
 
 class ThreadStateContainer;
+struct Val;
+
+/**
+ * The comparisons between a column and a constant that zone filters can check against the zone maps of frozen blocks.
+ */
+enum class ZoneFilterComparison : uint32_t { Equal, LessThan, LessThanEqual, GreaterThan, GreaterThanEqual };
 
 /**
  * An iterator over a table's data in vector-wise fashion.
@@ -67,6 +73,17 @@ class EXPORT TableVectorIterator {
    */
   bool Init(uint32_t block_start, uint32_t block_end);
 
+  /**
+   * Add a filter on a column that is checked against the zone maps of frozen blocks, so that blocks that cannot hold a
+   * matching tuple are skipped as a whole. Zone filters never filter out individual tuples, so the predicate still has
+   * to be evaluated on the vectors the iterator produces. Only filters that are part of a conjunction making up the
+   * whole predicate may be added. Filters on columns of types without zone maps are ignored.
+   * @param col_idx The index of the column in the column OIDs the iterator was created with.
+   * @param comparison The comparison between the column and the value, with the column on the left-hand side.
+   * @param val The value to compare the column with. Its type must match the type of the column.
+   */
+  void AddZoneFilter(uint32_t col_idx, ZoneFilterComparison comparison, const Val &val);
+
   /**
    * Advance the iterator by a vector of input.
    * @return True if there is more data in the iterator; false otherwise.
@@ -114,6 +131,19 @@ class EXPORT TableVectorIterator {
                            uint32_t min_grain_size = K_MIN_BLOCK_RANGE_SIZE);
 
  private:
+  // A filter on a column that rules out frozen blocks from the column's zone map
+  struct ZoneFilter {
+    storage::col_id_t col_id_;
+    TypeId type_;
+    ZoneFilterComparison comparison_;
+    // The value to compare with, in the interpretation of the zone map that matches the type of the column
+    int64_t int_val_;
+    double real_val_;
+  };
+
+  // Check whether a frozen block can hold a tuple that passes all zone filters.
+  bool BlockMayMatch(const storage::ArrowBlockMetadata &metadata) const;
+
   exec::ExecutionContext *exec_ctx_;
   const catalog::table_oid_t table_oid_;
   std::vector<catalog::col_oid_t> col_oids_{};
@@ -128,6 +158,10 @@ class EXPORT TableVectorIterator {
   // An iterator over the currently active projection.
   VectorProjectionIterator vector_projection_iterator_;
 
+  // Filters checked against zone maps, and the block filter checking them that is handed to the table.
+  std::vector<ZoneFilter> zone_filters_;
+  storage::DataTable::FrozenBlockFilter block_filter_;
+
   // True if the iterator has been initialized.
   bool initialized_{false};
 };
@@ -275,6 +275,9 @@ VM_OP_HOT void OpTableVectorIteratorGetVPI(terrier::execution::sql::VectorProjec
   *vpi = iter->GetVectorProjectionIterator();
 }
 
+VM_OP void OpTableVectorIteratorAddZoneFilter(terrier::execution::sql::TableVectorIterator *iter, uint32_t col_idx,
+                                              uint32_t comparison, const terrier::execution::sql::Val *val);
+
 VM_OP_HOT void OpParallelScanTable(uint32_t table_oid, uint32_t *col_oids, uint32_t num_oids, void *const query_state,
                                    terrier::execution::exec::ExecutionContext *exec_ctx,
                                    const terrier::execution::sql::TableVectorIterator::ScanFn scanner) {
@@ -1640,6 +1643,17 @@ VM_OP_WARM void OpIndexIteratorScanLimitDescending(terrier::execution::sql::Inde
   iter->ScanLimitDescending(limit);
 }
 
+VM_OP_WARM void OpIndexIteratorAddBatchKey(terrier::storage::ProjectedRow **pr,
+                                           terrier::execution::sql::IndexIterator *iter) {
+  *pr = iter->AddBatchKey();
+}
+
+VM_OP_WARM void OpIndexIteratorScanKeyBatch(terrier::execution::sql::IndexIterator *iter) { iter->ScanKeyBatch(); }
+
+VM_OP_WARM void OpIndexIteratorSelectBatchKey(terrier::execution::sql::IndexIterator *iter, uint32_t key_idx) {
+  iter->SelectBatchKey(key_idx);
+}
+
 VM_OP_WARM void OpIndexIteratorAdvance(bool *has_more, terrier::execution::sql::IndexIterator *iter) {
   *has_more = iter->Advance();
 }
@@ -1852,6 +1866,15 @@ VM_OP void OpStorageInterfaceIndexInsertWithSlot(bool *result,
                                                  terrier::execution::sql::StorageInterface *storage_interface,
                                                  terrier::storage::TupleSlot *tuple_slot, bool unique);
 
+VM_OP void OpStorageInterfaceIndexBulkLoadAdd(terrier::execution::sql::StorageInterface *storage_interface,
+                                              terrier::storage::TupleSlot *tuple_slot);
+
+VM_OP void OpStorageInterfaceIndexBulkLoad(bool *result, terrier::execution::sql::StorageInterface *storage_interface);
+
+VM_OP void OpStorageInterfaceIndexBulkLoadParallel(
+    bool *result, terrier::execution::sql::StorageInterface *storage_interface,
+    terrier::execution::sql::ThreadStateContainer *thread_state_container, uint32_t si_offset);
+
 VM_OP void OpStorageInterfaceIndexDelete(terrier::execution::sql::StorageInterface *storage_interface,
                                          terrier::storage::TupleSlot *tuple_slot);
 
@@ -119,6 +119,7 @@ namespace terrier::execution::vm {
   F(TableVectorIteratorNext, OperandType::Local, OperandType::Local)                                                  \
   F(TableVectorIteratorFree, OperandType::Local)                                                                      \
   F(TableVectorIteratorGetVPI, OperandType::Local, OperandType::Local)                                                \
+  F(TableVectorIteratorAddZoneFilter, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local) \
   F(ParallelScanTable, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local,                \
     OperandType::Local, OperandType::FunctionId)                                                                      \
                                                                                                                       \
@@ -469,6 +470,9 @@ namespace terrier::execution::vm {
   F(IndexIteratorScanAscending, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(IndexIteratorScanDescending, OperandType::Local)                                                                  \
   F(IndexIteratorScanLimitDescending, OperandType::Local, OperandType::Local)                                         \
+  F(IndexIteratorAddBatchKey, OperandType::Local, OperandType::Local)                                                 \
+  F(IndexIteratorScanKeyBatch, OperandType::Local)                                                                    \
+  F(IndexIteratorSelectBatchKey, OperandType::Local, OperandType::Local)                                              \
   F(IndexIteratorFree, OperandType::Local)                                                                            \
   F(IndexIteratorAdvance, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetPR, OperandType::Local, OperandType::Local)                                                       \
@@ -541,6 +545,10 @@ namespace terrier::execution::vm {
   F(StorageInterfaceIndexInsertUnique, OperandType::Local, OperandType::Local)                                        \
   F(StorageInterfaceIndexInsertWithSlot, OperandType::Local, OperandType::Local, OperandType::Local,                  \
     OperandType::Local)                                                                                               \
+  F(StorageInterfaceIndexBulkLoadAdd, OperandType::Local, OperandType::Local)                                         \
+  F(StorageInterfaceIndexBulkLoad, OperandType::Local, OperandType::Local)                                            \
+  F(StorageInterfaceIndexBulkLoadParallel, OperandType::Local, OperandType::Local, OperandType::Local,                \
+    OperandType::Local)                                                                                               \
   F(StorageInterfaceIndexDelete, OperandType::Local, OperandType::Local)                                              \
   F(StorageInterfaceFree, OperandType::Local)                                                                         \
                                                                                                                       \
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -9,13 +14,24 @@
 #include "common/action_context.h"
 #include "common/managed_pointer.h"
 #include "metrics/metrics_thread.h"
+#include "network/itp/itp_command_factory.h"
+#include "network/itp/itp_protocol_interpreter.h"
 #include "network/postgres/postgres_command_factory.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
 #include "network/terrier_server.h"
 #include "optimizer/statistics/stats_storage.h"
 #include "settings/settings_manager.h"
 #include "settings/settings_param.h"
+#include "storage/access_observer.h"
+#include "storage/arrow_export_thread.h"
+#include "storage/block_compactor_thread.h"
+#include "storage/block_evictor.h"
 #include "storage/garbage_collector_thread.h"
+#include "storage/recovery/merging_log_provider.h"
+#include "storage/recovery/recovery_manager.h"
+#include "storage/recovery/replication_log_provider.h"
+#include "storage/write_ahead_log/log_manager.h"
+#include "storage/write_ahead_log/log_shipper.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/transaction_manager.h"
 
@@ -119,17 +135,45 @@ class DBMain {
      * @param block_store_reuse_limit argument to the BlockStore
      * @param use_gc enable GarbageCollector
      * @param log_manager needed for safe destruction of StorageLayer
+     * @param gc_num_threads argument to the GarbageCollector
+     * @param use_compaction enable AccessObserver and BlockCompactor
+     * @param block_placement argument to the BlockStore
+     * @param compaction_swap_file_path argument to the BlockEvictor of the BlockCompactor, or empty to disable it
      */
     StorageLayer(const common::ManagedPointer<TransactionLayer> txn_layer, const uint64_t block_store_size_limit,
                  const uint64_t block_store_reuse_limit, const bool use_gc,
-                 const common::ManagedPointer<storage::LogManager> log_manager)
+                 const common::ManagedPointer<storage::LogManager> log_manager, const uint32_t gc_num_threads = 1,
+                 const bool use_compaction = false,
+                 const storage::BlockPlacement block_placement = storage::BlockPlacement::LOCAL,
+                 const std::string &compaction_swap_file_path = "")
         : deferred_action_manager_(txn_layer->GetDeferredActionManager()), log_manager_(log_manager) {
+      if (use_compaction) {
+        TERRIER_ASSERT(use_gc, "The AccessObserver is fed by the GarbageCollector.");
+        access_observer_ = std::make_unique<storage::AccessObserver>();
+        if (!compaction_swap_file_path.empty())
+          block_evictor_ = std::make_unique<storage::BlockEvictor>(compaction_swap_file_path, block_store_size_limit);
+        block_compactor_ = std::make_unique<storage::BlockCompactor>(block_evictor_.get());
+      }
       if (use_gc)
-        garbage_collector_ = std::make_unique<storage::GarbageCollector>(txn_layer->GetTimestampManager(),
-                                                                         txn_layer->GetDeferredActionManager(),
-                                                                         txn_layer->GetTransactionManager(), DISABLED);
-
-      block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit);
+        garbage_collector_ = std::make_unique<storage::GarbageCollector>(
+            txn_layer->GetTimestampManager(), txn_layer->GetDeferredActionManager(),
+            txn_layer->GetTransactionManager(), access_observer_.get(), gc_num_threads);
+
+      // Blocks are placed in the arena of the BlockEvictor, so that they can be evicted. Blocks beyond the initial size
+      // limit are placed on the heap, should the limit be raised.
+      block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit,
+                                                           block_placement, common::NumaUtil::NumNodes(),
+                                                           block_evictor_.get());
+      // Varlen arenas are given back when the BlockCompactor freezes their blocks
+      block_store_->SetUseVarlenArenas(use_compaction);
+      if (use_compaction) {
+        // The AccessObserver must forget the blocks of dropped tables before the BlockCompactor purges them, or it
+        // could hand them to the compactor again
+        block_store_->RegisterReleaseListener(access_observer_.get());
+        block_store_->RegisterReleaseListener(block_compactor_.get());
+        // The BlockCompactor waits for itself to stop evicting the blocks before the BlockEvictor discards them
+        if (block_evictor_ != DISABLED) block_store_->RegisterReleaseListener(block_evictor_.get());
+      }
     }
 
     ~StorageLayer() {
@@ -141,6 +185,11 @@ class DBMain {
         // stop the LogManager and make sure all buffers are released
         log_manager_->PersistAndStop();
       }
+      if (block_compactor_ != DISABLED) {
+        if (block_evictor_ != DISABLED) block_store_->UnregisterReleaseListener(block_evictor_.get());
+        block_store_->UnregisterReleaseListener(block_compactor_.get());
+        block_store_->UnregisterReleaseListener(access_observer_.get());
+      }
     }
 
     /**
@@ -155,9 +204,27 @@ class DBMain {
      */
     common::ManagedPointer<storage::BlockStore> GetBlockStore() const { return common::ManagedPointer(block_store_); }
 
+    /**
+     * @return ManagedPointer to the component, can be nullptr if disabled
+     */
+    common::ManagedPointer<storage::AccessObserver> GetAccessObserver() const {
+      return common::ManagedPointer(access_observer_);
+    }
+
+    /**
+     * @return ManagedPointer to the component, can be nullptr if disabled
+     */
+    common::ManagedPointer<storage::BlockCompactor> GetBlockCompactor() const {
+      return common::ManagedPointer(block_compactor_);
+    }
+
    private:
-    // Order currently does not matter in this layer
+    // Order matters here for destruction order. The GarbageCollector notifies the AccessObserver, and runs deferred
+    // actions that enqueue blocks into the BlockCompactor. The BlockStore frees its blocks into the BlockEvictor.
+    std::unique_ptr<storage::BlockEvictor> block_evictor_;
     std::unique_ptr<storage::BlockStore> block_store_;
+    std::unique_ptr<storage::AccessObserver> access_observer_;
+    std::unique_ptr<storage::BlockCompactor> block_compactor_;
     std::unique_ptr<storage::GarbageCollector> garbage_collector_;
 
     // External dependencies for this layer
@@ -219,6 +286,65 @@ class DBMain {
     const common::ManagedPointer<storage::LogManager> log_manager_;
   };
 
+  /**
+   * ReplicationLogProvider and the RecoveryManager that continuously replays the logs a primary ships to this replica
+   */
+  class ReplicationLayer {
+   public:
+    /**
+     * @param thread_registry argument to the RecoveryManager
+     * @param txn_layer arguments to the RecoveryManager
+     * @param storage_layer arguments to the RecoveryManager
+     * @param catalog_layer arguments to the RecoveryManager
+     */
+    ReplicationLayer(const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
+                     const common::ManagedPointer<TransactionLayer> txn_layer,
+                     const common::ManagedPointer<StorageLayer> storage_layer,
+                     const common::ManagedPointer<CatalogLayer> catalog_layer) {
+      replication_log_provider_ = std::make_unique<storage::ReplicationLogProvider>();
+      recovery_manager_ = std::make_unique<storage::RecoveryManager>(
+          common::ManagedPointer(replication_log_provider_).CastManagedPointerTo<storage::AbstractLogProvider>(),
+          catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(), txn_layer->GetDeferredActionManager(),
+          thread_registry, storage_layer->GetBlockStore());
+      recovery_manager_->StartRecovery();
+    }
+
+    ~ReplicationLayer() {
+      // Replay whatever the primary shipped before we went down
+      replication_log_provider_->EndReplication();
+      WaitForReplicationToFinish();
+    }
+
+    /**
+     * Blocks until the primary stops replication and all the logs it shipped are replayed
+     */
+    void WaitForReplicationToFinish() {
+      if (finished_) return;
+      recovery_manager_->WaitForRecoveryToFinish();
+      finished_ = true;
+    }
+
+    /**
+     * @return ManagedPointer to the component
+     */
+    common::ManagedPointer<storage::ReplicationLogProvider> GetReplicationLogProvider() const {
+      return common::ManagedPointer(replication_log_provider_);
+    }
+
+    /**
+     * @return ManagedPointer to the component
+     */
+    common::ManagedPointer<storage::RecoveryManager> GetRecoveryManager() const {
+      return common::ManagedPointer(recovery_manager_);
+    }
+
+   private:
+    // Order matters here for destruction order
+    std::unique_ptr<storage::ReplicationLogProvider> replication_log_provider_;
+    std::unique_ptr<storage::RecoveryManager> recovery_manager_;
+    bool finished_ = false;
+  };
+
   /**
    * ConnectionHandleFactory, CommandFactory, ProtocolInterpreter::Provider, Server
    */
@@ -229,10 +355,13 @@ class DBMain {
      * @param traffic_cop argument to the ConnectionHandleFactor
      * @param port argument to TerrierServer
      * @param connection_thread_count argument to TerrierServer
+     * @param use_replication whether to also run a server that receives logs from a primary over ITP
+     * @param replication_port argument to the replication TerrierServer
      */
     NetworkLayer(const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
                  const common::ManagedPointer<trafficcop::TrafficCop> traffic_cop, const uint16_t port,
-                 const uint16_t connection_thread_count) {
+                 const uint16_t connection_thread_count, const bool use_replication = false,
+                 const uint16_t replication_port = 0) {
       connection_handle_factory_ = std::make_unique<network::ConnectionHandleFactory>(traffic_cop);
       command_factory_ = std::make_unique<network::PostgresCommandFactory>();
       provider_ =
@@ -240,6 +369,15 @@ class DBMain {
       server_ = std::make_unique<network::TerrierServer>(common::ManagedPointer(provider_),
                                                          common::ManagedPointer(connection_handle_factory_),
                                                          thread_registry, port, connection_thread_count);
+      if (use_replication) {
+        // The primary ships its logs over a single connection
+        itp_command_factory_ = std::make_unique<network::ITPCommandFactory>();
+        itp_provider_ =
+            std::make_unique<network::ITPProtocolInterpreter::Provider>(common::ManagedPointer(itp_command_factory_));
+        replication_server_ = std::make_unique<network::TerrierServer>(
+            common::ManagedPointer(itp_provider_), common::ManagedPointer(connection_handle_factory_), thread_registry,
+            replication_port, 1);
+      }
     }
 
     /**
@@ -247,12 +385,22 @@ class DBMain {
      */
     common::ManagedPointer<network::TerrierServer> GetServer() const { return common::ManagedPointer(server_); }
 
+    /**
+     * @return ManagedPointer to the component, can be nullptr if replication is disabled
+     */
+    common::ManagedPointer<network::TerrierServer> GetReplicationServer() const {
+      return common::ManagedPointer(replication_server_);
+    }
+
    private:
     // Order matters here for destruction order
     std::unique_ptr<network::ConnectionHandleFactory> connection_handle_factory_;
     std::unique_ptr<network::PostgresCommandFactory> command_factory_;
     std::unique_ptr<network::ProtocolInterpreter::Provider> provider_;
     std::unique_ptr<network::TerrierServer> server_;
+    std::unique_ptr<network::ITPCommandFactory> itp_command_factory_;
+    std::unique_ptr<network::ProtocolInterpreter::Provider> itp_provider_;
+    std::unique_ptr<network::TerrierServer> replication_server_;
   };
 
   /**
@@ -273,6 +421,7 @@ class DBMain {
     /**
      * Validate configuration and construct requested DBMain.
      * @return DBMain that you get to own. YES, YOU! We're just giving away DBMains over here!
+     * @throws runtime_error if logs are to be shipped to a replica from more than one log stream
      */
     std::unique_ptr<DBMain> Build() {
       // Order matters through the Build() function and reflects the dependency ordering. It should match the member
@@ -294,18 +443,37 @@ class DBMain {
       }
 
       std::unique_ptr<common::DedicatedThreadRegistry> thread_registry = DISABLED;
-      if (use_thread_registry_ || use_logging_ || use_network_)
+      if (use_thread_registry_ || use_logging_ || use_network_ || use_replication_)
         thread_registry = std::make_unique<common::DedicatedThreadRegistry>(common::ManagedPointer(metrics_manager));
 
       auto buffer_segment_pool =
           std::make_unique<storage::RecordBufferSegmentPool>(record_buffer_segment_size_, record_buffer_segment_reuse_);
 
+      std::unique_ptr<storage::LogShipper> log_shipper = DISABLED;
+      if (use_logging_ && !replication_replica_host_.empty()) {
+        // The replica replays the log in the order it arrives, which only a single log stream writes in commit order
+        if (wal_num_streams_ != 1) {
+          throw std::runtime_error("Log shipping needs a single log stream, but wal_num_streams is " +
+                                   std::to_string(wal_num_streams_));
+        }
+        log_shipper = std::make_unique<storage::LogShipper>(replication_replica_host_, replication_port_,
+                                                            std::chrono::milliseconds{replication_send_timeout_});
+      }
+
+      // The log of the previous run is moved aside before the LogManager starts new log files, see RecoverFromLog
+      uint32_t num_recovered_log_streams = 0;
+      if (use_logging_ && wal_recovery_) {
+        TERRIER_ASSERT(!use_replication_, "A replica gets its databases from the primary.");
+        num_recovered_log_streams = MoveLogAsideForRecovery();
+      }
+
       std::unique_ptr<storage::LogManager> log_manager = DISABLED;
       if (use_logging_) {
         log_manager = std::make_unique<storage::LogManager>(
             wal_file_path_, wal_num_buffers_, std::chrono::microseconds{wal_serialization_interval_},
             std::chrono::microseconds{wal_persist_interval_}, wal_persist_threshold_,
-            common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(thread_registry));
+            common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(thread_registry), wal_num_streams_,
+            wal_compression_, common::ManagedPointer(log_shipper));
         log_manager->Start();
       }
 
@@ -314,14 +482,35 @@ class DBMain {
 
       auto storage_layer =
           std::make_unique<StorageLayer>(common::ManagedPointer(txn_layer), block_store_size_, block_store_reuse_,
-                                         use_gc_, common::ManagedPointer(log_manager));
+                                         use_gc_, common::ManagedPointer(log_manager), gc_num_threads_,
+                                         use_compaction_thread_,
+                                         block_store_interleave_ ? storage::BlockPlacement::INTERLEAVED
+                                                                 : storage::BlockPlacement::LOCAL,
+                                         compaction_swap_file_path_);
 
       std::unique_ptr<CatalogLayer> catalog_layer = DISABLED;
       if (use_catalog_) {
         TERRIER_ASSERT(use_gc_ && storage_layer->GetGarbageCollector() != DISABLED, "Catalog needs GarbageCollector.");
-        catalog_layer =
-            std::make_unique<CatalogLayer>(common::ManagedPointer(txn_layer), common::ManagedPointer(storage_layer),
-                                           common::ManagedPointer(log_manager), create_default_database_);
+        // A recovered log creates its databases itself
+        catalog_layer = std::make_unique<CatalogLayer>(
+            common::ManagedPointer(txn_layer), common::ManagedPointer(storage_layer),
+            common::ManagedPointer(log_manager), create_default_database_ && num_recovered_log_streams == 0);
+      }
+
+      if (num_recovered_log_streams > 0) {
+        TERRIER_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED, "Recovery needs the Catalog.");
+        RecoverFromLog(num_recovered_log_streams, common::ManagedPointer(thread_registry),
+                       common::ManagedPointer(txn_layer), common::ManagedPointer(storage_layer),
+                       common::ManagedPointer(catalog_layer), common::ManagedPointer(log_manager));
+      }
+
+      std::unique_ptr<ReplicationLayer> replication_layer = DISABLED;
+      if (use_replication_) {
+        TERRIER_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED, "ReplicationLayer needs the Catalog.");
+        TERRIER_ASSERT(!create_default_database_, "A replica gets its databases from the primary.");
+        replication_layer = std::make_unique<ReplicationLayer>(
+            common::ManagedPointer(thread_registry), common::ManagedPointer(txn_layer),
+            common::ManagedPointer(storage_layer), common::ManagedPointer(catalog_layer));
       }
 
       std::unique_ptr<storage::GarbageCollectorThread> gc_thread = DISABLED;
@@ -333,6 +522,27 @@ class DBMain {
                                                                       common::ManagedPointer(metrics_manager));
       }
 
+      std::unique_ptr<storage::BlockCompactorThread> compaction_thread = DISABLED;
+      if (use_compaction_thread_) {
+        TERRIER_ASSERT(use_gc_ && storage_layer->GetGarbageCollector() != DISABLED,
+                       "BlockCompactorThread needs GarbageCollector.");
+        storage::CompactionPolicy policy;
+        policy.cold_threshold_ = std::chrono::milliseconds{compaction_cold_threshold_};
+        policy.pressured_cold_threshold_ = std::min(policy.pressured_cold_threshold_, policy.cold_threshold_);
+        policy.max_blocks_per_round_ = compaction_max_blocks_;
+        compaction_thread = std::make_unique<storage::BlockCompactorThread>(
+            storage_layer->GetBlockCompactor(), storage_layer->GetAccessObserver(), storage_layer->GetBlockStore(),
+            txn_layer->GetDeferredActionManager(), txn_layer->GetTransactionManager(), policy,
+            std::chrono::microseconds{compaction_interval_});
+      }
+
+      std::unique_ptr<storage::ArrowExportThread> arrow_export_thread = DISABLED;
+      if (use_arrow_export_) {
+        TERRIER_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED, "ArrowExportThread needs the Catalog.");
+        arrow_export_thread = std::make_unique<storage::ArrowExportThread>(
+            arrow_export_socket_path_, catalog_layer->GetCatalog(), txn_layer->GetTransactionManager());
+      }
+
       std::unique_ptr<optimizer::StatsStorage> stats_storage = DISABLED;
       if (use_stats_storage_) {
         stats_storage = std::make_unique<optimizer::StatsStorage>();
@@ -350,9 +560,10 @@ class DBMain {
         TERRIER_ASSERT(use_stats_storage_ && stats_storage != DISABLED, "TrafficCopLayer needs StatsStorage.");
         TERRIER_ASSERT(use_execution_ && execution_layer != DISABLED, "TrafficCopLayer needs ExecutionLayer.");
         traffic_cop = std::make_unique<trafficcop::TrafficCop>(
-            txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(), DISABLED,
+            txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(),
+            use_replication_ ? replication_layer->GetReplicationLogProvider() : DISABLED,
             common::ManagedPointer(settings_manager), common::ManagedPointer(stats_storage), optimizer_timeout_,
-            use_query_cache_, execution_mode_);
+            use_query_cache_, execution_mode_, synchronous_commit_);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -360,7 +571,8 @@ class DBMain {
         TERRIER_ASSERT(use_traffic_cop_ && traffic_cop != DISABLED, "NetworkLayer needs TrafficCopLayer.");
         network_layer =
             std::make_unique<NetworkLayer>(common::ManagedPointer(thread_registry), common::ManagedPointer(traffic_cop),
-                                           network_port_, connection_thread_count_);
+                                           network_port_, connection_thread_count_, use_replication_,
+                                           replication_port_);
       }
 
       db_main->settings_manager_ = std::move(settings_manager);
@@ -368,11 +580,15 @@ class DBMain {
       db_main->metrics_thread_ = std::move(metrics_thread);
       db_main->thread_registry_ = std::move(thread_registry);
       db_main->buffer_segment_pool_ = std::move(buffer_segment_pool);
+      db_main->log_shipper_ = std::move(log_shipper);
       db_main->log_manager_ = std::move(log_manager);
       db_main->txn_layer_ = std::move(txn_layer);
       db_main->storage_layer_ = std::move(storage_layer);
       db_main->catalog_layer_ = std::move(catalog_layer);
+      db_main->replication_layer_ = std::move(replication_layer);
       db_main->gc_thread_ = std::move(gc_thread);
+      db_main->compaction_thread_ = std::move(compaction_thread);
+      db_main->arrow_export_thread_ = std::move(arrow_export_thread);
       db_main->stats_storage_ = std::move(stats_storage);
       db_main->execution_layer_ = std::move(execution_layer);
       db_main->traffic_cop_ = std::move(traffic_cop);
@@ -453,6 +669,33 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalNumStreams(const uint32_t value) {
+      wal_num_streams_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value whether to recover from the log files at startup
+     * @return self reference for chaining
+     */
+    Builder &SetWalRecovery(const bool value) {
+      wal_recovery_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalCompression(const bool value) {
+      wal_compression_ = value;
+      return *this;
+    }
+
     /**
      * @param value LogManager argument
      * @return self reference for chaining
@@ -489,6 +732,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value GarbageCollector argument
+     * @return self reference for chaining
+     */
+    Builder &SetGCNumThreads(const uint32_t value) {
+      gc_num_threads_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -516,6 +768,42 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseCompactionThread(const bool value) {
+      use_compaction_thread_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value BlockEvictor argument, or empty to not release the raw values of compressed columns
+     * @return self reference for chaining
+     */
+    Builder &SetCompactionSwapFilePath(const std::string &value) {
+      compaction_swap_file_path_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseArrowExport(const bool value) {
+      use_arrow_export_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value ArrowExportThread argument
+     * @return self reference for chaining
+     */
+    Builder &SetArrowExportSocketPath(const std::string &value) {
+      arrow_export_socket_path_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -552,6 +840,42 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value use component, makes this database a read-only replica
+     * @return self reference for chaining
+     */
+    Builder &SetUseReplication(const bool value) {
+      use_replication_ = value;
+      return *this;
+    }
+
+    /**
+     * @param port port a replica receives logs on, and a primary ships logs to
+     * @return self reference for chaining
+     */
+    Builder &SetReplicationPort(const uint16_t port) {
+      replication_port_ = port;
+      return *this;
+    }
+
+    /**
+     * @param value LogShipper argument, empty to not ship logs
+     * @return self reference for chaining
+     */
+    Builder &SetReplicationReplicaHost(const std::string &value) {
+      replication_replica_host_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogShipper argument, in milliseconds
+     * @return self reference for chaining
+     */
+    Builder &SetReplicationSendTimeout(const int32_t value) {
+      replication_send_timeout_ = value;
+      return *this;
+    }
+
     /**
      * @param value RecordBufferSegmentPool argument
      * @return self reference for chaining
@@ -588,6 +912,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value BlockStore argument
+     * @return self reference for chaining
+     */
+    Builder &SetBlockStoreInterleave(const bool value) {
+      block_store_interleave_ = value;
+      return *this;
+    }
+
     /**
      * @param value TrafficCop argument
      * @return self reference for chaining
@@ -606,6 +939,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetSynchronousCommit(const bool value) {
+      synchronous_commit_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -645,6 +987,9 @@ class DBMain {
     uint64_t record_buffer_segment_reuse_ = 1e4;
     std::string wal_file_path_ = "wal.log";
     uint64_t wal_num_buffers_ = 100;
+    uint32_t wal_num_streams_ = 1;
+    bool wal_recovery_ = false;
+    bool wal_compression_ = false;
     int32_t wal_serialization_interval_ = 100;
     int32_t wal_persist_interval_ = 100;
     uint64_t wal_persist_threshold_ = static_cast<uint64_t>(1 << 20);
@@ -654,17 +999,31 @@ class DBMain {
     bool create_default_database_ = true;
     uint64_t block_store_size_ = 1e5;
     uint64_t block_store_reuse_ = 1e3;
+    bool block_store_interleave_ = false;
     int32_t gc_interval_ = 1000;
+    uint32_t gc_num_threads_ = 1;
     bool use_gc_thread_ = false;
+    bool use_compaction_thread_ = false;
+    int32_t compaction_interval_ = 10000;
+    int32_t compaction_cold_threshold_ = 1000;
+    uint32_t compaction_max_blocks_ = 64;
+    std::string compaction_swap_file_path_;
+    bool use_arrow_export_ = false;
+    std::string arrow_export_socket_path_ = "terrier_arrow_export.sock";
     bool use_stats_storage_ = false;
     bool use_execution_ = false;
     bool use_traffic_cop_ = false;
     uint64_t optimizer_timeout_ = 5000;
     bool use_query_cache_ = true;
+    bool synchronous_commit_ = true;
     execution::vm::ExecutionMode execution_mode_ = execution::vm::ExecutionMode::Interpret;
     uint16_t network_port_ = 15721;
     uint16_t connection_thread_count_ = 4;
     bool use_network_ = false;
+    bool use_replication_ = false;
+    uint16_t replication_port_ = 15722;
+    std::string replication_replica_host_;
+    int32_t replication_send_timeout_ = 10000;
 
     /**
      * Instantiates the SettingsManager and reads all of the settings to override the Builder's settings.
@@ -681,11 +1040,15 @@ class DBMain {
           static_cast<uint64_t>(settings_manager->GetInt(settings::Param::record_buffer_segment_reuse));
       block_store_size_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::block_store_size));
       block_store_reuse_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::block_store_reuse));
+      block_store_interleave_ = settings_manager->GetBool(settings::Param::block_store_interleave);
 
       use_logging_ = settings_manager->GetBool(settings::Param::wal_enable);
       if (use_logging_) {
         wal_file_path_ = settings_manager->GetString(settings::Param::wal_file_path);
         wal_num_buffers_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_num_buffers));
+        wal_num_streams_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::wal_num_streams));
+        wal_recovery_ = settings_manager->GetBool(settings::Param::wal_recovery);
+        wal_compression_ = settings_manager->GetBool(settings::Param::wal_compression);
         wal_serialization_interval_ = settings_manager->GetInt(settings::Param::wal_serialization_interval);
         wal_persist_interval_ = settings_manager->GetInt(settings::Param::wal_persist_interval);
         wal_persist_threshold_ =
@@ -695,12 +1058,27 @@ class DBMain {
       use_metrics_ = use_metrics_thread_ = settings_manager->GetBool(settings::Param::metrics);
 
       gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
+      gc_num_threads_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::gc_num_threads));
+
+      use_compaction_thread_ = settings_manager->GetBool(settings::Param::compaction_enable);
+      compaction_interval_ = settings_manager->GetInt(settings::Param::compaction_interval);
+      compaction_cold_threshold_ = settings_manager->GetInt(settings::Param::compaction_cold_threshold);
+      compaction_max_blocks_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::compaction_max_blocks));
+      compaction_swap_file_path_ = settings_manager->GetString(settings::Param::compaction_swap_file_path);
+      use_arrow_export_ = settings_manager->GetBool(settings::Param::arrow_export_enable);
+      arrow_export_socket_path_ = settings_manager->GetString(settings::Param::arrow_export_socket_path);
 
       network_port_ = static_cast<uint16_t>(settings_manager->GetInt(settings::Param::port));
       connection_thread_count_ =
           static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_thread_count));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
       use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
+      synchronous_commit_ = settings_manager->GetBool(settings::Param::synchronous_commit);
+
+      use_replication_ = settings_manager->GetBool(settings::Param::replication_enable);
+      replication_port_ = static_cast<uint16_t>(settings_manager->GetInt(settings::Param::replication_port));
+      replication_replica_host_ = settings_manager->GetString(settings::Param::replication_replica_host);
+      replication_send_timeout_ = settings_manager->GetInt(settings::Param::replication_send_timeout);
 
       execution_mode_ = settings_manager->GetBool(settings::Param::compiled_query_execution)
                             ? execution::vm::ExecutionMode::Compiled
@@ -716,6 +1094,81 @@ class DBMain {
       return settings_manager;
     }
 
+    /**
+     * @return path the log files of the previous run are moved to while they are recovered
+     */
+    std::string RecoveryLogFilePath() const { return wal_file_path_ + ".recovering"; }
+
+    /**
+     * Moves the log files of the previous run to RecoveryLogFilePath, so that the LogManager starts new ones. If moved
+     * log files are already there, a previous startup failed while recovering them. The log files that startup started
+     * only hold part of the replay, so they are deleted instead, and the moved ones are recovered again.
+     * @throws runtime_error if a log file could not be moved
+     * @return number of log streams to recover, 0 if there is nothing to recover
+     */
+    uint32_t MoveLogAsideForRecovery() {
+      const auto recovery_path = RecoveryLogFilePath();
+      const auto log_file = [](const std::string &path, const uint32_t stream) {
+        return storage::LogManager::LogStreamFilePath(path, stream);
+      };
+      const auto exists = [](const std::string &path) { return access(path.c_str(), F_OK) == 0; };
+
+      if (exists(log_file(recovery_path, 0))) {
+        for (uint32_t i = 0; exists(log_file(wal_file_path_, i)); i++) std::remove(log_file(wal_file_path_, i).c_str());
+      } else {
+        for (uint32_t i = 0; exists(log_file(wal_file_path_, i)); i++) {
+          if (std::rename(log_file(wal_file_path_, i).c_str(), log_file(recovery_path, i).c_str()) != 0) {
+            throw std::runtime_error("Failed to move log file for recovery with errno " + std::to_string(errno));
+          }
+        }
+      }
+
+      uint32_t num_streams = 0;
+      uint64_t log_size = 0;
+      struct stat file_stat;
+      for (; stat(log_file(recovery_path, num_streams).c_str(), &file_stat) == 0; num_streams++)
+        log_size += static_cast<uint64_t>(file_stat.st_size);
+      if (log_size == 0) {
+        // The previous run did not log anything, not even its databases
+        for (uint32_t i = 0; i < num_streams; i++) std::remove(log_file(recovery_path, i).c_str());
+        return 0;
+      }
+      return num_streams;
+    }
+
+    /**
+     * Replays the log files moved aside by MoveLogAsideForRecovery, which may have been written to several log
+     * streams. The replayed transactions are logged to the new log files, so once those are persisted, the moved log
+     * files are deleted.
+     * @param num_log_streams number of log streams to recover
+     * @param thread_registry argument to the RecoveryManager
+     * @param txn_layer arguments to the RecoveryManager
+     * @param storage_layer arguments to the RecoveryManager
+     * @param catalog_layer arguments to the RecoveryManager
+     * @param log_manager log manager writing the new log files
+     */
+    void RecoverFromLog(const uint32_t num_log_streams,
+                        const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
+                        const common::ManagedPointer<TransactionLayer> txn_layer,
+                        const common::ManagedPointer<StorageLayer> storage_layer,
+                        const common::ManagedPointer<CatalogLayer> catalog_layer,
+                        const common::ManagedPointer<storage::LogManager> log_manager) {
+      const auto recovery_path = RecoveryLogFilePath();
+      {
+        storage::MergingLogProvider log_provider(recovery_path, num_log_streams);
+        storage::RecoveryManager recovery_manager(
+            common::ManagedPointer<storage::AbstractLogProvider>(&log_provider), catalog_layer->GetCatalog(),
+            txn_layer->GetTransactionManager(), txn_layer->GetDeferredActionManager(), thread_registry,
+            storage_layer->GetBlockStore());
+        recovery_manager.StartRecovery();
+        recovery_manager.WaitForRecoveryToFinish();
+      }
+      log_manager->ForceFlush();
+      for (uint32_t i = 0; i < num_log_streams; i++) {
+        std::remove(storage::LogManager::LogStreamFilePath(recovery_path, i).c_str());
+      }
+    }
+
     /**
      * Instantiate the MetricsManager and enable metrics for components arrocding to the Builder's settings.
      * @return
@@ -768,6 +1221,11 @@ class DBMain {
     return common::ManagedPointer(buffer_segment_pool_);
   }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<storage::LogShipper> GetLogShipper() const { return common::ManagedPointer(log_shipper_); }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -788,6 +1246,13 @@ class DBMain {
    */
   common::ManagedPointer<CatalogLayer> GetCatalogLayer() const { return common::ManagedPointer(catalog_layer_); }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<ReplicationLayer> GetReplicationLayer() const {
+    return common::ManagedPointer(replication_layer_);
+  }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -795,6 +1260,20 @@ class DBMain {
     return common::ManagedPointer(gc_thread_);
   }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<storage::BlockCompactorThread> GetBlockCompactorThread() const {
+    return common::ManagedPointer(compaction_thread_);
+  }
+
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<storage::ArrowExportThread> GetArrowExportThread() const {
+    return common::ManagedPointer(arrow_export_thread_);
+  }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -824,12 +1303,16 @@ class DBMain {
   std::unique_ptr<metrics::MetricsThread> metrics_thread_;
   std::unique_ptr<common::DedicatedThreadRegistry> thread_registry_;
   std::unique_ptr<storage::RecordBufferSegmentPool> buffer_segment_pool_;
+  std::unique_ptr<storage::LogShipper> log_shipper_;
   std::unique_ptr<storage::LogManager> log_manager_;
   std::unique_ptr<TransactionLayer> txn_layer_;
   std::unique_ptr<StorageLayer> storage_layer_;
   std::unique_ptr<CatalogLayer> catalog_layer_;
+  std::unique_ptr<ReplicationLayer> replication_layer_;
   std::unique_ptr<storage::GarbageCollectorThread>
       gc_thread_;  // thread needs to die before manual invocations of GC in CatalogLayer and others
+  std::unique_ptr<storage::BlockCompactorThread> compaction_thread_;  // compacts blocks of tables in CatalogLayer
+  std::unique_ptr<storage::ArrowExportThread> arrow_export_thread_;  // exports tables in CatalogLayer
   std::unique_ptr<optimizer::StatsStorage> stats_storage_;
   std::unique_ptr<ExecutionLayer> execution_layer_;
   std::unique_ptr<trafficcop::TrafficCop> traffic_cop_;
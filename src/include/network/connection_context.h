@@ -32,6 +32,7 @@ class ConnectionContext {
     db_oid_ = catalog::INVALID_DATABASE_OID;
     db_name_.clear();
     temp_namespace_oid_ = catalog::INVALID_NAMESPACE_OID;
+    synchronous_commit_ = true;
     txn_ = nullptr;
     accessor_ = nullptr;
     callback_ = nullptr;
@@ -72,6 +73,17 @@ class ConnectionContext {
    */
   void SetTempNamespaceOid(const catalog::namespace_oid_t ns_oid) { temp_namespace_oid_ = ns_oid; }
 
+  /**
+   * @return true if this connection's commits wait for their log records to be persisted before they are acknowledged
+   */
+  bool SynchronousCommit() const { return synchronous_commit_; }
+
+  /**
+   * @param synchronous_commit whether this connection's commits wait for their log records to be persisted
+   * @warning only to be used by the protocol interpreter during startup, and by TrafficCop::ExecuteSetStatement
+   */
+  void SetSynchronousCommit(const bool synchronous_commit) { synchronous_commit_ = synchronous_commit; }
+
   /**
    * @param db_name database name. It should be in cmdline_args_ as well, this just makes it quicker to find
    * @warning only to be used by the protocol interpreter during startup
@@ -194,6 +206,12 @@ class ConnectionContext {
    */
   catalog::namespace_oid_t temp_namespace_oid_ = catalog::INVALID_NAMESPACE_OID;
 
+  /**
+   * Whether commits wait for their log records to be persisted. Starts out as the server-wide synchronous_commit
+   * setting, and is changed for this connection alone by SET synchronous_commit.
+   */
+  bool synchronous_commit_ = true;
+
   /**
    * In theory the ConnectionContext owns this too, but for legacy reasons (and safety about who can delete them) we
    * don't use unique_ptrs for txns. If that ever changes, then the ConnectionContext should probably own it and
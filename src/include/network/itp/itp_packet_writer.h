@@ -27,7 +27,21 @@ class ITPPacketWriter : public PacketWriter {
    * bytes to the packet and call EndReplicationCommand when we want to finish the current command.
    * @param message_id message id
    */
-  void BeginReplicationCommand(uint64_t message_id) { BeginPacket(NetworkMessageType::ITP_REPLICATION_COMMAND); }
+  void BeginReplicationCommand(uint64_t message_id) {
+    BeginPacket(NetworkMessageType::ITP_REPLICATION_COMMAND).AppendValue<uint64_t>(message_id);
+  }
+
+  /**
+   * Writes a Replication command carrying the given replication data
+   * @param message_id message id, incremented by one for every Replication command sent over a connection
+   * @param data replication data
+   * @param size number of bytes of replication data
+   */
+  void WriteReplicationCommand(uint64_t message_id, const void *data, uint64_t size) {
+    BeginReplicationCommand(message_id);
+    AppendValue<uint64_t>(size).AppendRaw(data, size);
+    EndReplicationCommand();
+  }
 
   /**
    * End the Replication command
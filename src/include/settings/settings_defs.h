@@ -66,6 +66,16 @@ SETTING_int(
     terrier::settings::Callbacks::BlockStoreReuseLimit
 )
 
+// BlockStore placement of blocks on NUMA nodes
+SETTING_bool(
+    block_store_interleave,
+    "Whether storage blocks are spread round-robin over NUMA nodes instead of placed on the node of the inserting "
+    "thread (default: false)",
+    false,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // Garbage collector thread interval
 SETTING_int(
     gc_interval,
@@ -77,6 +87,89 @@ SETTING_int(
     terrier::settings::Callbacks::NoOp
 )
 
+// Garbage collector worker threads
+SETTING_int(
+    gc_num_threads,
+    "Number of worker threads the garbage collector splits unlinking and index GC across (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Block compaction thread
+SETTING_bool(
+    compaction_enable,
+    "Whether cold blocks are compacted and frozen into Arrow format by a background thread (default: false)",
+    false,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Block compaction thread interval
+SETTING_int(
+    compaction_interval,
+    "Block compaction thread interval (us) (default: 10000)",
+    10000,
+    1,
+    10000000,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Time after the last write that a full block is compacted
+SETTING_int(
+    compaction_cold_threshold,
+    "Time a full block must go without writes before it is compacted (ms) (default: 1000)",
+    1000,
+    0,
+    3600000,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Blocks compacted per round
+SETTING_int(
+    compaction_max_blocks,
+    "Maximum number of cold blocks the compaction thread compacts per round (default: 64)",
+    64,
+    1,
+    1000000,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Swap file for the raw values of compressed columns
+SETTING_string(
+    compaction_swap_file_path,
+    "The path to the swap file that the raw values of compressed columns of frozen blocks are released to, or empty to "
+    "not compress columns (default: empty)",
+    "",
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Arrow export endpoint
+SETTING_bool(
+    arrow_export_enable,
+    "Whether clients can read the frozen blocks of tables in Arrow IPC format over a UNIX domain socket "
+    "(default: false)",
+    false,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Socket of the Arrow export endpoint
+SETTING_string(
+    arrow_export_socket_path,
+    "The path to the UNIX domain socket that tables are exported on in Arrow IPC format "
+    "(default: terrier_arrow_export.sock)",
+    "terrier_arrow_export.sock",
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // Write ahead logging
 SETTING_bool(
     wal_enable,
@@ -106,6 +199,37 @@ SETTING_int64(
     terrier::settings::Callbacks::WalNumBuffers
 )
 
+// Number of log files the log manager writes to in parallel
+SETTING_int(
+    wal_num_streams,
+    "The number of log files the log manager writes to in parallel, each with its own serializer and consumer "
+    "(default: 1)",
+    1,
+    1,
+    64,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Whether to recover from the WAL at startup
+SETTING_bool(
+    wal_recovery,
+    "Whether to recover the database from the log files at startup. The recovered log is moved aside while it is "
+    "replayed, and the replayed transactions are logged to new log files (default: false)",
+    false,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Whether the WAL is written in the compact, compressed log format
+SETTING_bool(
+    wal_compression,
+    "Whether the log manager writes log records with compact encoding in compressed frames (default: false)",
+    false,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // Log Serialization interval
 SETTING_int(
     wal_serialization_interval,
@@ -128,6 +252,58 @@ SETTING_int(
     terrier::settings::Callbacks::NoOp
 )
 
+// Asynchronous commit
+SETTING_bool(
+    synchronous_commit,
+    "Whether a commit waits for its log records to be persisted before it is acknowledged, for new connections. "
+    "Connections change it for themselves with SET. If false, a crash can lose transactions committed within the last "
+    "wal_serialization_interval + wal_persist_interval (default: true)",
+    true,
+    true,
+    terrier::settings::Callbacks::SynchronousCommit
+)
+
+// Run as a replica of another database
+SETTING_bool(
+    replication_enable,
+    "Whether this database is a replica that replays the log shipped from a primary and only serves read-only queries "
+    "(default: false)",
+    false,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Replication port
+SETTING_int(
+    replication_port,
+    "Port a replica receives the log from its primary on (default: 15722)",
+    15722,
+    1024,
+    65535,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Replica to ship the log to
+SETTING_string(
+    replication_replica_host,
+    "IPv4 address of a replica to ship the write-ahead log to, empty to not replicate (default: \"\")",
+    "",
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Time to wait for a replica to read the log before giving up on it
+SETTING_int(
+    replication_send_timeout,
+    "Time the primary waits for a replica to read shipped log before it stops replicating to it (ms) (default: 10000)",
+    10000,
+    1,
+    3600000,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // Optimizer timeout
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task execution step of optimizer, "
@@ -143,6 +143,16 @@ class SettingsManager {
   void SetParameter(const std::string &name,
                     const std::vector<common::ManagedPointer<parser::AbstractExpression>> &values);
 
+  /**
+   * Parse the value given for a boolean parameter without setting it, for parameters that connections set for
+   * themselves.
+   * @param name The parameter name.
+   * @param values The parameter's new value(s).
+   * @return The parsed value.
+   */
+  bool ParseBoolParameter(const std::string &name,
+                          const std::vector<common::ManagedPointer<parser::AbstractExpression>> &values) const;
+
   /**
    * Construct settings param map from settings_defs.h
    * @param param_map
@@ -1,48 +1,45 @@
 #pragma once
 
+#include <chrono>  // NOLINT
 #include <unordered_map>
+#include <vector>
+
+#include "common/spin_latch.h"
+#include "storage/storage_defs.h"
 
 namespace terrier::storage {
-class DataTable;
-class BlockCompactor;
-class RawBlock;
-
-// TODO(Tianyu): Probably need to be smarter than this to identify true hot or cold data, but this
-// will do for now.
-// Specifically, when the system is under load, and the GC does not get its own dedicated physical core,
-// GC epoch can be a very inaccurate representation of time, as the interval between invocations become
-// hard to predict. An easy fix to this would be to substitute a count with real time (taken from the
-// system clock), that is recorded at the beginning of every GC invocation. The threshold will then be
-// expressed in physical time. This fix does not address the issue that detection may be slow
-// (GC is still invoked less frequently), but at least it lowers the impact because the access observer
-// will not wait for some fixed number of invocations.
-#define COLD_DATA_EPOCH_THRESHOLD 10
+
 /**
- * The access observer is attached to the storage engine's garbage collector in order to make decisions about
- * whether a block is cooling down from frequent access. Its observe methods are invoked from the garbage collector
- * when relavent events fire. It is then free to make a decision whether to send a block into the compactor's queue
- * to freeze asynchronously.
+ * The access observer is attached to the storage engine's garbage collector in order to keep track of when full blocks
+ * were last written to. Its observe methods are invoked from the garbage collector when relevant events fire. The
+ * compaction thread then asks the observer for blocks that have cooled down from frequent access, and decides which of
+ * them to send into the compactor's queue (see CompactionPolicy).
  *
- * Notice that although the observation step is light weight, it does happen on the garbage collection thread and thus
- * has some minor performance impact on GC and consequently the rest of the system. Care should be taken to not do
- * any computationally-intensive work here to figure out whether a block is cold. The entire hot-cold mechanism is
- * designed to be lightweight on the cold->hot transition so we can afford to be wrong in the observation phase.
+ * Observation happens on the garbage collection thread, so it is kept as light weight as possible. The observer reads
+ * the clock once per GC invocation and stamps every write observed during that invocation with it, instead of reading
+ * the clock on every write. The time of a write is thus only known up to the GC interval, which is plenty accurate
+ * for telling hot from cold data. The entire hot-cold mechanism is designed to be lightweight on the cold->hot
+ * transition so we can afford to be wrong in the observation phase.
+ *
+ * Thread-safe. Observations come from the GC thread, while cold blocks are collected from the compaction thread. The
+ * observer must be registered as a release listener with the BlockStore, so that it forgets the blocks of dropped
+ * tables, ahead of the BlockCompactor that it hands blocks to.
  */
-class AccessObserver {
+class AccessObserver : public BlockReleaseListener {
  public:
   /**
-   * Constructs a new AccessObserver that will send its observations to the given block compactor
-   * @param compactor the compactor to use after identifying a cold block
+   * Clock used to measure how long blocks have gone without writes
    */
-  explicit AccessObserver(BlockCompactor *compactor) : compactor_(compactor) {}
+  using Clock = std::chrono::steady_clock;
 
   /**
-   * Signals to the AccessObserver that a new GC run has begun. This is useful as a measurement of time to the
-   * AccessObserver as it uses the number of GC invocations as an approximate clock.
+   * Signals to the AccessObserver that a new GC run has begun. Writes observed until the next invocation are
+   * considered to have happened now.
    */
   void ObserveGCInvocation();
+
   /**
-   * Observe a write to the given tuple slot from the given data table.
+   * Observe a write to the given block.
    *
    * Notice that not all writes will be captured in this case. For example, an aborted transaction might not show up
    * here. All committed transactions are guaranteed to show up here.
@@ -50,12 +47,36 @@ class AccessObserver {
    */
   void ObserveWrite(RawBlock *block);
 
+  /**
+   * @param threshold how long a block must have gone without writes to be considered cold
+   * @return the observed blocks that have not been written to for at least the given amount of time
+   */
+  std::vector<RawBlock *> ColdBlocks(Clock::duration threshold) const;
+
+  /**
+   * Stops tracking the given block until it is written to again, typically because it has been sent off to the
+   * compactor.
+   * @param block the block to forget about
+   */
+  void Forget(RawBlock *block);
+
+  /**
+   * Stops tracking the given blocks, as they are released by their table
+   * @param blocks the blocks about to be released
+   */
+  void OnRelease(const std::vector<RawBlock *> &blocks) override;
+
+  /**
+   * @return number of blocks currently tracked by the observer
+   */
+  uint32_t NumObservedBlocks() const;
+
  private:
-  uint64_t gc_epoch_ = 0;  // estimate time using the number of times GC has run
+  mutable common::SpinLatch latch_;
+  // Time of the last GC invocation, which is taken as the time of every write observed since
+  Clock::time_point now_ = Clock::now();
   // Here RawBlock * should suffice as a unique identifier of the block. Although a block can be
-  // reused, that process should only be triggered through compaction, which happens only if the
-  // reference to said block is identified as cold and leaves the table.
-  std::unordered_map<RawBlock *, uint64_t> last_touched_;
-  BlockCompactor *compactor_;
+  // reused, that only happens after its table released it, at which point the observer forgets it.
+  std::unordered_map<RawBlock *, Clock::time_point> last_touched_;
 };
 }  // namespace terrier::storage
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <map>
 #include <unordered_set>
 #include <utility>
 
 #include "storage/block_layout.h"
+#include "storage/compressed_column.h"
 #include "storage/storage_defs.h"
 #include "storage/storage_util.h"
 
@@ -137,7 +142,10 @@ class ArrowColumnInfo {
    * @param other the object to move from
    */
   ArrowColumnInfo(ArrowColumnInfo &&other) noexcept
-      : type_(other.type_), varlen_column_(std::move(other.varlen_column_)), indices_(other.indices_) {
+      : type_(other.type_),
+        varlen_column_(std::move(other.varlen_column_)),
+        indices_(other.indices_),
+        compressed_column_(std::move(other.compressed_column_)) {
     other.indices_ = nullptr;
   }
 
@@ -158,6 +166,7 @@ class ArrowColumnInfo {
       delete[] indices_;
       indices_ = other.indices_;
       other.indices_ = nullptr;
+      compressed_column_ = std::move(other.compressed_column_);
     }
     return *this;
   }
@@ -183,11 +192,22 @@ class ArrowColumnInfo {
   }
 
   /**
-   * Deallocates all associated buffers in the ArrowVarlenColumn
+   * @return compressed copy of the column, which is only meaningful for fixed-length columns of frozen blocks
+   */
+  CompressedColumn &Compressed() { return compressed_column_; }
+
+  /**
+   * @return compressed copy of the column, which is only meaningful for fixed-length columns of frozen blocks
+   */
+  const CompressedColumn &Compressed() const { return compressed_column_; }
+
+  /**
+   * Deallocates all associated buffers in the ArrowVarlenColumn and the compressed copy of the column
    */
   void Deallocate() {
     delete[] indices_;
     varlen_column_.Deallocate();
+    compressed_column_.Deallocate();
   }
 
  private:
@@ -198,6 +218,98 @@ class ArrowColumnInfo {
   ArrowVarlenColumn varlen_column_;  // For varlen and dictionary
   // TODO(Tianyu): Add null bitmap
   uint64_t *indices_ = nullptr;  // for dictionary
+  CompressedColumn compressed_column_;  // for fixed-length
+};
+
+/**
+ * An ArrowZoneMap holds the smallest and largest non-null value of a fixed-length column in a frozen block, so that
+ * scans can tell from the block header alone that no tuple in the block can satisfy a predicate.
+ *
+ * The storage layer does not know the SQL type of a column, so the bounds are kept for the values read as signed
+ * integers of the column's size, and, for 8-byte columns, also for the values read as doubles. It is up to the reader
+ * to pick the interpretation that matches the type of the column. Both pairs of bounds are inverted (min > max) if
+ * the column holds no non-null values, and the bounds cover every value if no meaningful bound exists.
+ */
+class ArrowZoneMap {
+ public:
+  /**
+   * Resets the zone map to describe an empty column
+   */
+  void Reset() {
+    min_ = std::numeric_limits<int64_t>::max();
+    max_ = std::numeric_limits<int64_t>::min();
+    min_real_ = std::numeric_limits<double>::infinity();
+    max_real_ = -std::numeric_limits<double>::infinity();
+  }
+
+  /**
+   * Widens the bounds to include the given value
+   * @param value pointer to the non-null value
+   * @param attr_size size of the column the value comes from
+   */
+  void Update(const byte *value, uint8_t attr_size) {
+    int64_t int_value;
+    switch (attr_size) {
+      case 1:
+        int_value = *reinterpret_cast<const int8_t *>(value);
+        break;
+      case 2:
+        int_value = *reinterpret_cast<const int16_t *>(value);
+        break;
+      case 4:
+        int_value = *reinterpret_cast<const int32_t *>(value);
+        break;
+      case 8:
+        int_value = *reinterpret_cast<const int64_t *>(value);
+        break;
+      default:
+        // Not a number under any interpretation, so nothing can be ruled out
+        min_ = std::numeric_limits<int64_t>::min();
+        max_ = std::numeric_limits<int64_t>::max();
+        min_real_ = -std::numeric_limits<double>::infinity();
+        max_real_ = std::numeric_limits<double>::infinity();
+        return;
+    }
+    min_ = std::min(min_, int_value);
+    max_ = std::max(max_, int_value);
+
+    double real_value = std::numeric_limits<double>::quiet_NaN();
+    if (attr_size == sizeof(double)) std::memcpy(&real_value, value, sizeof(double));
+    if (std::isnan(real_value)) {
+      // NaNs do not order with anything, and narrower columns are never doubles, so rule out nothing
+      min_real_ = -std::numeric_limits<double>::infinity();
+      max_real_ = std::numeric_limits<double>::infinity();
+      return;
+    }
+    min_real_ = std::min(min_real_, real_value);
+    max_real_ = std::max(max_real_, real_value);
+  }
+
+  /**
+   * @return smallest value in the column read as a signed integer
+   */
+  int64_t Min() const { return min_; }
+
+  /**
+   * @return largest value in the column read as a signed integer
+   */
+  int64_t Max() const { return max_; }
+
+  /**
+   * @return smallest value in the column read as a double
+   */
+  double MinReal() const { return min_real_; }
+
+  /**
+   * @return largest value in the column read as a double
+   */
+  double MaxReal() const { return max_real_; }
+
+ private:
+  int64_t min_;
+  int64_t max_;
+  double min_real_;
+  double max_real_;
 };
 
 /**
@@ -219,7 +331,7 @@ class ArrowBlockMetadata {
    */
   static uint32_t Size(uint16_t num_cols) {
     return StorageUtil::PadUpToSize(sizeof(uint64_t), static_cast<uint32_t>(sizeof(uint32_t)) * (num_cols + 1)) +
-           num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo));
+           num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo) + sizeof(ArrowZoneMap));
   }
 
   /**
@@ -280,9 +392,31 @@ class ArrowBlockMetadata {
     return reinterpret_cast<ArrowColumnInfo *>(null_count_end)[col_id.UnderlyingValue()];
   }
 
+  /**
+   * @param layout layout object of the Block
+   * @param col_id the column of interest
+   * @return zone map of the given column. Only meaningful for fixed-length columns of frozen blocks.
+   */
+  ArrowZoneMap &GetZoneMap(const BlockLayout &layout, col_id_t col_id) {
+    auto *zone_maps = reinterpret_cast<ArrowZoneMap *>(&GetColumnInfo(layout, col_id_t(0)) + layout.NumColumns());
+    return zone_maps[col_id.UnderlyingValue()];
+  }
+
+  /**
+   * @param layout layout object of the Block
+   * @param col_id the column of interest
+   * @return zone map of the given column. Only meaningful for fixed-length columns of frozen blocks.
+   */
+  const ArrowZoneMap &GetZoneMap(const BlockLayout &layout, col_id_t col_id) const {
+    auto *zone_maps =
+        reinterpret_cast<const ArrowZoneMap *>(&GetColumnInfo(layout, col_id_t(0)) + layout.NumColumns());
+    return zone_maps[col_id.UnderlyingValue()];
+  }
+
  private:
   uint32_t num_records_;  // number of actual records
   // null_count[num_cols] (32-bit) | padding up to 8 byte-aligned | arrow_varlen_buffers[num_cols] |
+  // zone_maps[num_cols] |
   byte varlen_content_[];
 };
 }  // namespace terrier::storage
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "storage/data_table.h"
+#include "type/type_id.h"
+
+namespace terrier::catalog {
+class Catalog;
+}  // namespace terrier::catalog
+
+namespace terrier::transaction {
+class TransactionManager;
+}  // namespace terrier::transaction
+
+namespace terrier::storage {
+
+/**
+ * An export endpoint serves tables in arrow IPC stream format to external processes on the same machine, such as
+ * analytics jobs reading a table into pandas. It listens on a UNIX domain socket, and every client that connects is
+ * sent one table through ArrowSerializer, after which the connection is closed. Blocks are sent as their Arrow buffers,
+ * which makes this far cheaper than pulling the same data row by row over the postgres wire protocol.
+ *
+ * A client names the table it wants (see ServeRequestedTable), and then reads the table with e.g.
+ * pyarrow.ipc.open_stream on the connected socket. DBMain serves clients this way from an ArrowExportThread.
+ *
+ * Not thread-safe. Connections are served one at a time by the thread calling ServeTable or ServeRequestedTable.
+ */
+class ArrowExportEndpoint {
+ public:
+  /**
+   * Starts listening for clients.
+   * @param socket_path path of the UNIX domain socket to listen on. An existing socket at this path is replaced.
+   * @throws runtime_error if the socket could not be set up
+   */
+  explicit ArrowExportEndpoint(const std::string &socket_path);
+
+  /**
+   * Stops listening and removes the socket file.
+   */
+  ~ArrowExportEndpoint();
+
+  DISALLOW_COPY_AND_MOVE(ArrowExportEndpoint);
+
+  /**
+   * Waits for the next client to connect and streams the given table to it. Only the frozen blocks of the table are
+   * exported, see ArrowSerializer.
+   * @param table the table to export
+   * @param col_types the types of the columns of the table
+   * @throws runtime_error if no client could be accepted or the client went away before reading the whole table
+   */
+  void ServeTable(const DataTable &table, std::vector<type::TypeId> *col_types);
+
+  /**
+   * Waits for the next client to connect and streams the table it asks for. The client first sends the database and
+   * the table on a single line, separated by a space, e.g. "terrier public.foo\n". The database is given by its name
+   * or its oid, and the table by its name, which may be qualified by its namespace and is otherwise looked up in the
+   * public namespace. The connection is closed without sending anything if there is no such table.
+   *
+   * The table is exported within a transaction, so that it cannot be deleted from under the export. Only its frozen
+   * blocks are exported, see ArrowSerializer.
+   * @param catalog the catalog to look the table up in
+   * @param txn_manager the transaction manager to start the transaction with
+   * @param timeout how long to wait for a client to connect, and then for its request
+   * @throws runtime_error if no client could be accepted or the client went away before reading the whole table
+   * @return false if no client connected before the timeout
+   */
+  bool ServeRequestedTable(common::ManagedPointer<catalog::Catalog> catalog,
+                           common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                           std::chrono::milliseconds timeout);
+
+  /**
+   * @return path of the socket the endpoint listens on
+   */
+  const std::string &SocketPath() const { return socket_path_; }
+
+ private:
+  const std::string socket_path_;
+  int listen_fd_;
+
+  /**
+   * Waits for the next client to connect
+   * @param timeout how long to wait, or a negative duration to wait indefinitely
+   * @throws runtime_error if no client could be accepted
+   * @return descriptor of the connection to the client, or -1 if no client connected before the timeout
+   */
+  int AcceptClient(std::chrono::milliseconds timeout);
+
+  /**
+   * Streams a table to a client and closes the connection
+   * @param client_fd descriptor of the connection to the client
+   * @param table the table to export
+   * @param col_types the types of the columns of the table
+   * @throws runtime_error if the client went away before reading the whole table
+   */
+  static void ExportTo(int client_fd, const DataTable &table, std::vector<type::TypeId> *col_types);
+};
+}  // namespace terrier::storage
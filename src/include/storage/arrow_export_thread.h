@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>  //NOLINT
+#include <stdexcept>
+#include <string>
+#include <thread>  //NOLINT
+
+#include "catalog/catalog.h"
+#include "common/managed_pointer.h"
+#include "loggers/storage_logger.h"
+#include "storage/arrow_export_endpoint.h"
+#include "transaction/transaction_manager.h"
+
+namespace terrier::storage {
+
+/**
+ * Class for spinning off a thread that serves the tables clients ask for on an ArrowExportEndpoint. Clients are served
+ * one at a time. A client that goes away in the middle of an export does not stop the thread.
+ */
+class ArrowExportThread {
+ public:
+  /**
+   * @param socket_path path of the UNIX domain socket to listen on
+   * @param catalog the catalog to look tables up in
+   * @param txn_manager the transaction manager that exports are run with
+   * @throws runtime_error if the socket could not be set up
+   */
+  ArrowExportThread(const std::string &socket_path, common::ManagedPointer<catalog::Catalog> catalog,
+                    common::ManagedPointer<transaction::TransactionManager> txn_manager)
+      : endpoint_(socket_path), catalog_(catalog), txn_manager_(txn_manager), run_export_(true) {
+    export_thread_ = std::thread([this] { ExportThreadLoop(); });
+  }
+
+  ~ArrowExportThread() {
+    run_export_ = false;
+    export_thread_.join();
+  }
+
+  /**
+   * @return path of the socket clients connect to
+   */
+  const std::string &SocketPath() const { return endpoint_.SocketPath(); }
+
+ private:
+  // How often the thread checks whether it should stop while no client connects
+  static constexpr std::chrono::milliseconds POLL_PERIOD{100};
+
+  ArrowExportEndpoint endpoint_;
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  volatile bool run_export_;
+  std::thread export_thread_;
+
+  void ExportThreadLoop() {
+    while (run_export_) {
+      try {
+        endpoint_.ServeRequestedTable(catalog_, txn_manager_, POLL_PERIOD);
+      } catch (std::runtime_error &e) {
+        STORAGE_LOG_WARN("Arrow export failed: {}", e.what());
+      }
+    }
+  }
+};
+
+}  // namespace terrier::storage
@@ -54,44 +54,69 @@ class ArrowSerializer {
    * block and is exactly the same concept as the Buffer above. Therefore, by parsing the metadata_flatbuffer, we can
    * pinpoint and read the corresponding data.
    *
+   * Only frozen blocks are exported, see below.
+   *
    * @param file_name the file that the table will be exported to
    * @param col_types since in the data table level, we don't know the type of each column. We need to use this
    *        parameter that is provided to get the types of columns.
+   * @throws runtime_error if the file could not be written
+   * @return number of blocks that were left out because they were not frozen
+   */
+  uint32_t ExportTable(const std::string &file_name, std::vector<terrier::type::TypeId> *col_types);
+
+  /**
+   * Stream a table in arrow IPC format (see above) to a file descriptor, which is typically a connected UNIX or TCP
+   * socket of an external process reading the table. The descriptor is written to in blocking mode and left open.
+   *
+   * Blocks are exported one at a time. The messages of a block are copied out of it while it is read in place, and
+   * written once the block is released, so a slow reader never keeps a block from being thawed for an update. Blocks
+   * that are not frozen cannot be read in place, such as the last block of a table that is still being inserted into,
+   * and are left out rather than waited for.
+   *
+   * @param fd the file descriptor to write the table to
+   * @param col_types the types of columns, as above
+   * @throws runtime_error if writing to the file descriptor failed, e.g. because the reader went away
+   * @return number of blocks that were left out because they were not frozen
    */
-  void ExportTable(const std::string &file_name, std::vector<terrier::type::TypeId> *col_types);
+  uint32_t ExportTable(int fd, std::vector<terrier::type::TypeId> *col_types);
 
  private:
   const DataTable &data_table_;
+
   /**
-   * WriteDataBlock write a memory block to file. Such a memory block can be: offsets of varlen column,
-   * data of a fixed-size column, bitmap of a column, etc.
-   * @param outfile the output file
-   * @param src the memory block
-   * @param len the size, will be padded to arrow alignment according to the specification
+   * Where an export is written to
    */
-  void WriteDataBlock(std::ofstream &outfile, const char *src, size_t len);
+  struct Output {
+    int fd_;
+    // Sockets are written to with send, so that a reader hanging up does not raise SIGPIPE
+    bool is_socket_;
+  };
 
   /**
-   * AddBufferInfo adds a buffer info to the buffers array. A buffer is a continuous memory region defined by its
-   * length and offset.
+   * AddBuffer adds a buffer to the body of a message, both as buffer info in the metadata and as a copy of its memory.
+   * A buffer is a continuous memory region defined by its length and offset.
    * @param offset the offset of current buffer. It will be updated by adding current len when return from this
    *               function
-   * @param len the length of the buffer, will be padded to arrow alignment
+   * @param src the memory block
+   * @param len the size, will be padded to arrow alignment according to the specification
    * @param buffers the array that gathers the buffer info
+   * @param body the message body to append the buffer to
    */
-  void AddBufferInfo(size_t *offset, size_t len, std::vector<flatbuf::Buffer> *buffers);
+  void AddBuffer(size_t *offset, const void *src, size_t len, std::vector<flatbuf::Buffer> *buffers,
+                 std::vector<byte> *body);
 
   /**
-   * Build the metadata_flatbuffer from all its components and export it to the file.
-   * @param outfile the output file
+   * Build the metadata_flatbuffer from all its components and write it, followed by the message body, to the messages
+   * to be sent. The flatbuffer builder is cleared afterwards for the next message.
+   * @param messages the messages to write to
    * @param header_type one of MessageHeader_Schema, MessageHeader_RecordBatch, or MessageHeader_DictionaryBatch
    * @param header the auto-generated offset of the header
    * @param body_len the length of follwoing message body (not the length of this metadata_flatbuffer)
+   * @param body the message body
    * @param flatbuf_builder flatbuffer builder
    */
-  void AssembleMetadataBuffer(std::ofstream &outfile, flatbuf::MessageHeader header_type,
-                              flatbuffers::Offset<void> header, int64_t body_len,
-                              flatbuffers::FlatBufferBuilder *flatbuf_builder);
+  void WriteMessage(std::vector<byte> *messages, flatbuf::MessageHeader header_type, flatbuffers::Offset<void> header,
+                    int64_t body_len, const std::vector<byte> &body, flatbuffers::FlatBufferBuilder *flatbuf_builder);
 
   /**
    * This function write a Schema message. The Schema message provides metadata describing the following RecordBatch
@@ -105,13 +130,13 @@ class ArrowSerializer {
    * For the flatbuffer schema of Schema message, please refer to:
    *    https://github.com/apache/arrow/blob/master/format/Schema.fbs
    *
-   * @param outfile the output file
+   * @param messages the messages to write to
    * @param dictionary_ids The dictionary entries and the indices for a batch of rows are written seperately.
    *                       Therefore, when a column is dictionary-compressed, we need to assign an id to it,
    *                       so that the dictionary and the indices can be paired.
    * @param flatbuf_builder flatbuffer builder
    */
-  void WriteSchemaMessage(std::ofstream &outfile, std::unordered_map<col_id_t, int64_t> *dictionary_ids,
+  void WriteSchemaMessage(std::vector<byte> *messages, std::unordered_map<col_id_t, int64_t> *dictionary_ids,
                           std::vector<type::TypeId> *col_types, flatbuffers::FlatBufferBuilder *flatbuf_builder);
 
   /**
@@ -124,12 +149,19 @@ class ArrowSerializer {
    * For the flatbuffer schema of Dictionary message, please refer to:
    *    https://github.com/apache/arrow/blob/master/format/Message.fbs
    *
-   * @param outfile the output file
+   * @param messages the messages to write to
    * @param dictionary_id id of this dictionary, should have been assigned previously when writing the schema message.
    * @param varlen_col varlen_col stores the dictionray for a dictionary compressed column
    * @param flatbuf_builder flatbuffer builder
    */
-  void WriteDictionaryMessage(std::ofstream &outfile, int64_t dictionary_id, const ArrowVarlenColumn &varlen_col,
+  void WriteDictionaryMessage(std::vector<byte> *messages, int64_t dictionary_id, const ArrowVarlenColumn &varlen_col,
                               flatbuffers::FlatBufferBuilder *flatbuf_builder);
+
+  /**
+   * Write all of the given messages to the output, retrying on partial writes.
+   * @param output the output
+   * @param messages the messages to write
+   */
+  static void WriteFully(const Output &output, const std::vector<byte> &messages);
 };
 }  // namespace terrier::storage
@@ -102,7 +102,8 @@ class BlockAccessController {
           // wait until the compactor finishes before doing anything
           // intentional fall through
         case BlockState::FROZEN:
-          GetBlockState()->store(BlockState::HOT);
+          // The BlockEvictor can take a frozen block back to freezing while it writes it out
+          if (!GetBlockState()->compare_exchange_strong(current_state, BlockState::HOT)) continue;
           // intentional fall through
         case BlockState::HOT:
           // Although the block is already hot, we may need to wait for any straggling readers to finish
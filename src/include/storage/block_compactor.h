@@ -1,13 +1,75 @@
 #pragma once
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <mutex>  // NOLINT
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
+#include "common/spin_latch.h"
 #include "storage/arrow_block_metadata.h"
 #include "storage/data_table.h"
 #include "storage/storage_defs.h"
 #include "transaction/transaction_manager.h"
 namespace terrier::storage {
+class AccessObserver;
+class BlockEvictor;
+
+/**
+ * Decides which blocks the compactor freezes, and how many at a time. Only full blocks are ever compacted. Of those,
+ * a block becomes a candidate once it has not been written to for a while, and candidates with the most empty slots
+ * are compacted first, as they have the most space to give back.
+ */
+struct CompactionPolicy {
+  /**
+   * How long a full block must go without writes before it is compacted
+   */
+  std::chrono::milliseconds cold_threshold_{1000};
+  /**
+   * How long a full block must go without writes before it is compacted while memory is scarce
+   */
+  std::chrono::milliseconds pressured_cold_threshold_{100};
+  /**
+   * Fraction of the block store's size limit in use at which memory is considered scarce
+   */
+  double memory_pressure_ratio_ = 0.8;
+  /**
+   * Maximum number of cold blocks sent into the compaction queue per round, which bounds the amount of work a round
+   * does. Blocks left over are picked up in later rounds.
+   */
+  uint32_t max_blocks_per_round_ = 64;
+};
+
+/**
+ * Running counts of the work done by a BlockCompactor
+ */
+struct CompactionStatistics {
+  /**
+   * Number of cold blocks the compaction policy sent into the compaction queue
+   */
+  uint64_t blocks_enqueued_ = 0;
+  /**
+   * Number of blocks that had their gaps eliminated and started cooling
+   */
+  uint64_t blocks_compacted_ = 0;
+  /**
+   * Number of blocks frozen into Arrow format
+   */
+  uint64_t blocks_frozen_ = 0;
+  /**
+   * Number of compaction transactions that were aborted because of contention with user transactions
+   */
+  uint64_t compactions_aborted_ = 0;
+  /**
+   * Number of times a cooling block could not be frozen yet because versions were still alive
+   */
+  uint64_t freezes_postponed_ = 0;
+  /**
+   * Number of bytes of raw column values released after their columns were compressed
+   */
+  uint64_t bytes_released_ = 0;
+};
 
 /**
  * Typedef for a standard hash map with varlen entry as the key. The map uses deep equality checks (whether
@@ -21,8 +83,11 @@ using VarlenEntryMap = std::unordered_map<VarlenEntry, T, VarlenContentHasher, V
  * arrow-compatible. In the process, any gaps resulting from deletes or aborted transactions are also eliminated.
  * If the compaction is successful, the block is considered to be fully cold and will be accessed mostly as read-only
  * data.
+ *
+ * The compactor must be registered as a release listener with the BlockStore, so that the blocks of dropped tables are
+ * purged from its queue before they are released.
  */
-class BlockCompactor {
+class BlockCompactor : public BlockReleaseListener {
  private:
   // A Compaction group is a series of blocks all belonging to the same data table. We compact them together
   // so slots can be freed up. If we only compact single block at a time, deleted slots will never be reclaimed.
@@ -49,6 +114,12 @@ class BlockCompactor {
   };
 
  public:
+  /**
+   * @param evictor the evictor to release the raw values of compressed columns of frozen blocks through, or nullptr to
+   *                not compress columns, as that would only add to the memory they take up
+   */
+  explicit BlockCompactor(BlockEvictor *evictor = nullptr) : evictor_(evictor) {}
+
   FAKED_IN_TEST ~BlockCompactor() = default;
 
   /**
@@ -63,9 +134,37 @@ class BlockCompactor {
    * Adds a block associated with a data table to the compaction to be processed in the future.
    * @param block the block that needs to be processed by the compactor
    */
-  FAKED_IN_TEST void PutInQueue(RawBlock *block) { compaction_queue_.push(block); }
+  FAKED_IN_TEST void PutInQueue(RawBlock *block) {
+    common::SpinLatch::ScopedSpinLatch guard(&queue_latch_);
+    compaction_queue_.push(block);
+  }
+
+  /**
+   * Purges the given blocks from the compaction queue, as they are released by their table. Waits for the compactor to
+   * finish what it is working on, which may include the given blocks.
+   * @param blocks the blocks about to be released
+   */
+  void OnRelease(const std::vector<RawBlock *> &blocks) override;
+
+  /**
+   * Sends the blocks that the given policy considers cold into the compaction queue, up to the policy's budget.
+   * @param observer the access observer that tracks writes to blocks
+   * @param policy the policy that decides which blocks are cold
+   * @param block_store the block store to measure memory pressure by, or nullptr to never consider memory scarce
+   * @return number of blocks sent into the compaction queue
+   */
+  uint32_t EnqueueColdBlocks(AccessObserver *observer, const CompactionPolicy &policy,
+                             common::ManagedPointer<BlockStore> block_store);
+
+  /**
+   * @return counts of the work done by the compactor so far
+   */
+  CompactionStatistics GetStatistics() const;
 
  private:
+  // Puts the block back into the queue once the GC has run, if its table has not released it by then
+  void RequeueAfterGC(transaction::DeferredActionManager *deferred_action_manager, RawBlock *block);
+
   bool EliminateGaps(CompactionGroup *cg);
 
   bool CheckForVersionsAndGaps(const TupleAccessStrategy &accessor, RawBlock *block);
@@ -75,6 +174,15 @@ class BlockCompactor {
 
   void GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlock *block, DataTable *table);
 
+  // Replace the compressed copy of a fixed-length column with one of its current contents, if the evictor can release
+  // the raw values of the column once the block is frozen
+  void CompressColumn(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata, col_id_t col_id,
+                      common::RawConcurrentBitmap *column_bitmap, uint8_t attr_size, const byte *column_start,
+                      ArrowColumnInfo *col, RawBlock *block);
+
+  // Release the pages of raw values of the compressed columns of a freshly frozen block, which scans do not read
+  void ReleaseCompressedColumns(RawBlock *block);
+
   void CopyToArrowVarlen(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata, col_id_t col_id,
                          common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col, VarlenEntry *values);
 
@@ -94,6 +202,20 @@ class BlockCompactor {
     }
   }
 
+  BlockEvictor *const evictor_;
+  // Held while the compactor works on blocks, so that their table cannot release them in the meantime
+  std::mutex compaction_latch_;
+  // Blocks come in from deferred actions on the GC thread as well as from the compaction thread
+  common::SpinLatch queue_latch_;
   std::queue<RawBlock *> compaction_queue_;
+  // Blocks that deferred actions will put back into the queue, unless their table releases them first
+  std::unordered_set<RawBlock *> awaiting_requeue_;
+
+  std::atomic<uint64_t> blocks_enqueued_{0};
+  std::atomic<uint64_t> blocks_compacted_{0};
+  std::atomic<uint64_t> blocks_frozen_{0};
+  std::atomic<uint64_t> compactions_aborted_{0};
+  std::atomic<uint64_t> freezes_postponed_{0};
+  std::atomic<uint64_t> bytes_released_{0};
 };
 }  // namespace terrier::storage
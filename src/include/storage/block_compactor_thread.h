@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>  //NOLINT
+#include <thread>  //NOLINT
+
+#include "common/managed_pointer.h"
+#include "storage/access_observer.h"
+#include "storage/block_compactor.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace terrier::storage {
+
+/**
+ * Class for spinning off a thread that compacts and freezes cold blocks at a fixed interval, so that the work of
+ * compaction stays off the garbage collector's thread. Every round, the thread asks the compaction policy which of the
+ * blocks tracked by the access observer to compact, and then runs the compactor over its queue.
+ *
+ * Freezing a block takes two rounds. The first compacts the block, which counts as a write to it. The block is frozen
+ * once it has gone cold again and the GC pruned the versions created by the compaction.
+ */
+class BlockCompactorThread {
+ public:
+  /**
+   * @param compactor the compactor to run on this thread
+   * @param observer the access observer attached to the garbage collector, which tracks writes to blocks
+   * @param block_store the block store to measure memory pressure by, or nullptr to never consider memory scarce
+   * @param deferred_action_manager the deferred action manager the compactor defers freeing memory to
+   * @param txn_manager the transaction manager that compaction transactions are run with
+   * @param policy the policy that decides which blocks to compact
+   * @param compaction_period sleep time between compaction rounds
+   */
+  BlockCompactorThread(common::ManagedPointer<BlockCompactor> compactor,
+                       common::ManagedPointer<AccessObserver> observer, common::ManagedPointer<BlockStore> block_store,
+                       common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
+                       common::ManagedPointer<transaction::TransactionManager> txn_manager, CompactionPolicy policy,
+                       std::chrono::microseconds compaction_period);
+
+  ~BlockCompactorThread() {
+    if (run_compaction_) StopCompaction();
+  }
+
+  /**
+   * Kill the compaction thread. Blocks in the middle of being frozen are left cooling, which is safe.
+   */
+  void StopCompaction() {
+    TERRIER_ASSERT(run_compaction_, "Compaction should already be running.");
+    run_compaction_ = false;
+    compaction_thread_.join();
+  }
+
+  /**
+   * Spawn the compaction thread if it has been previously stopped.
+   */
+  void StartCompaction() {
+    TERRIER_ASSERT(!run_compaction_, "Compaction should not already be running.");
+    run_compaction_ = true;
+    compaction_paused_ = false;
+    compaction_thread_ = std::thread([this] { CompactionThreadLoop(); });
+  }
+
+  /**
+   * Pause compaction, typically for use in tests when the state of tables need to be fixed.
+   */
+  void PauseCompaction() {
+    TERRIER_ASSERT(!compaction_paused_, "Compaction should not already be paused.");
+    compaction_paused_ = true;
+  }
+
+  /**
+   * Resume compaction after being paused.
+   */
+  void ResumeCompaction() {
+    TERRIER_ASSERT(compaction_paused_, "Compaction should already be paused.");
+    compaction_paused_ = false;
+  }
+
+  /**
+   * @return counts of the work done by the compactor so far
+   */
+  CompactionStatistics GetStatistics() const { return compactor_->GetStatistics(); }
+
+ private:
+  const common::ManagedPointer<BlockCompactor> compactor_;
+  const common::ManagedPointer<AccessObserver> observer_;
+  const common::ManagedPointer<BlockStore> block_store_;
+  const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const CompactionPolicy policy_;
+  volatile bool run_compaction_;
+  volatile bool compaction_paused_;
+  std::chrono::microseconds compaction_period_;
+  std::thread compaction_thread_;
+
+  void CompactionThreadLoop() {
+    while (run_compaction_) {
+      std::this_thread::sleep_for(compaction_period_);
+      if (compaction_paused_) continue;
+      compactor_->EnqueueColdBlocks(observer_.Get(), policy_, block_store_);
+      compactor_->ProcessCompactionQueue(deferred_action_manager_.Get(), txn_manager_.Get());
+    }
+  }
+};
+
+}  // namespace terrier::storage
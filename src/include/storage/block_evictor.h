@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/numa.h"
+#include "common/spin_latch.h"
+#include "storage/data_table.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::storage {
+
+/**
+ * The block evictor moves frozen blocks out of memory so that tables can grow larger than RAM. Frozen blocks are
+ * immutable in Arrow format (see BlockCompactor), which makes them the natural eviction candidates.
+ *
+ * TupleSlots embed the address of their block, so a block cannot be replaced by a stub at a different address.
+ * Instead, the evictor is the BlockArena of the BlockStore: blocks are placed in a single private mapping of its swap
+ * file, with every block backed by its own range of the file. Until a block is evicted, writes give it private
+ * in-memory copies of its pages, so it takes up memory like a block on the heap. Evicting a block writes it to its
+ * range of the file and drops those copies. Only the first page of the block, which holds its header and access
+ * controller, stays in memory. All other pages are faulted back in from the file by the OS when the block is scanned or
+ * read, and can be dropped again under memory pressure because they are clean. Writes to an evicted block make private
+ * copies of the pages they touch again, so evicted blocks need no special treatment on the access path.
+ *
+ * Eviction never changes the mapping itself, so it costs no kernel mappings per block, and the number of blocks that
+ * can be evicted is not bounded by the limit on the number of mappings of a process. The arena reserves address space
+ * and swap file space (as a sparse file) for a fixed number of blocks. Blocks allocated once it is full are placed on
+ * the heap, and cannot be evicted.
+ *
+ * Varlen values gathered into Arrow buffers live outside of the block and are not evicted.
+ *
+ * The swap file is unlinked as soon as it is created. The evictor must outlive the BlockStore whose blocks it holds,
+ * and must be registered as a release listener with it, so that it frees up the space in the swap file of the blocks
+ * of dropped tables. Like the BlockCompactor, the evictor is meant to be driven by a single background thread.
+ * Releases may come in from other threads at any time.
+ */
+class BlockEvictor : public BlockReleaseListener, public BlockArena {
+ public:
+  /**
+   * Creates the swap file, and maps the arena.
+   * @param swap_file_path path of the swap file to create. An existing file at this path is overwritten.
+   * @param max_blocks number of blocks the arena holds
+   * @param num_nodes number of NUMA nodes to spread the arena over
+   * @throws runtime_error if the swap file could not be created or mapped
+   */
+  BlockEvictor(const std::string &swap_file_path, uint64_t max_blocks,
+               uint16_t num_nodes = common::NumaUtil::NumNodes());
+
+  /**
+   * Unmaps the arena, and closes the swap file.
+   */
+  ~BlockEvictor() override;
+
+  DISALLOW_COPY_AND_MOVE(BlockEvictor);
+
+  /**
+   * Writes a frozen block out to the swap file and releases the memory backing it. Writers to the block wait until
+   * eviction completes, while readers proceed as usual. Evicting a block that was evicted before writes it out again,
+   * which releases the pages modified since.
+   * @param block the block to evict
+   * @return true if the block was evicted, false if it is not frozen or not placed in the arena
+   * @throws runtime_error if the block could not be written to the swap file
+   */
+  bool Evict(RawBlock *block);
+
+  /**
+   * Releases the memory backing the given byte ranges of a frozen block, after writing them out to the swap file. The
+   * BlockCompactor uses this to drop the raw values of columns it has compressed, which scans no longer read. Only
+   * whole pages inside of the ranges are written and released (see ReleasableBytes). Unlike Evict, this does not wait
+   * for the pages to reach the disk, as it runs every time a block is frozen. The OS writes them back in the
+   * background, after which it can drop them from the page cache. Writers to the block wait until eviction completes,
+   * while readers proceed as usual. A block evicted this way counts as evicted, and can still be evicted as a whole.
+   * @param block the block to evict parts of
+   * @param ranges begin and end offsets of the ranges to release, relative to the start of the block
+   * @return number of bytes released, which is 0 if the block is not frozen or not placed in the arena
+   * @throws runtime_error if the block could not be written to the swap file
+   */
+  uint64_t EvictRanges(RawBlock *block, const std::vector<std::pair<uint32_t, uint32_t>> &ranges);
+
+  /**
+   * @param begin begin offset of a range of a block
+   * @param end end offset of the range
+   * @return number of bytes of the range that EvictRanges releases
+   */
+  uint64_t ReleasableBytes(const uint32_t begin, const uint32_t end) const {
+    const auto pages = ReleasablePages(begin, end);
+    return pages.second - pages.first;
+  }
+
+  /**
+   * Evicts all frozen blocks of a table that are not evicted as a whole yet
+   * @param table the table to evict blocks of
+   * @return number of blocks evicted
+   */
+  uint32_t EvictFrozenBlocks(DataTable *table);
+
+  /**
+   * Copies a frozen block back into memory and frees up its space in the swap file. This is never needed for
+   * correctness, but is useful to prefetch a block that is about to be heavily accessed. Writers to the block wait
+   * until the block is restored, while readers proceed as usual. Does nothing if the block is not evicted.
+   * @param block the block to bring back into memory
+   * @return true if the block is not evicted anymore, false if it is evicted but not frozen, in which case it stays
+   *         evicted until it is frozen again
+   */
+  bool Restore(RawBlock *block);
+
+  /**
+   * Frees up the space in the swap file of the evicted ones among the given blocks. Their contents are discarded.
+   * @param blocks the blocks about to be released
+   */
+  void OnRelease(const std::vector<RawBlock *> &blocks) override;
+
+  /**
+   * @param numa_node the NUMA node to place the block on
+   * @return memory for a block from the part of the arena placed on the node, or nullptr if that part is full
+   */
+  void *AllocateBlock(uint16_t numa_node) override;
+
+  /**
+   * Discards the contents of a block, and puts its memory up for reuse
+   * @param memory memory handed out by AllocateBlock
+   */
+  void FreeBlock(void *memory) override;
+
+  /**
+   * @param memory start of the memory of a block
+   * @return true if the block is placed in the arena, and can thus be evicted
+   */
+  bool Contains(const void *const memory) const override {
+    const auto *const address = reinterpret_cast<const byte *>(memory);
+    return address >= blocks_ && address < blocks_ + max_blocks_ * common::Constants::BLOCK_SIZE;
+  }
+
+  /**
+   * @param block the block to check
+   * @return true if the block is currently evicted to the swap file
+   */
+  bool IsEvicted(RawBlock *const block) const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return evicted_blocks_.find(block) != evicted_blocks_.end();
+  }
+
+  /**
+   * @return number of blocks currently evicted to the swap file
+   */
+  uint32_t NumEvictedBlocks() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return static_cast<uint32_t>(evicted_blocks_.size());
+  }
+
+ private:
+  // File descriptor of the swap file
+  int fd_;
+  // Size of a memory page. The first page of every block stays in memory.
+  const uint64_t page_size_;
+  const uint64_t max_blocks_;
+  // Size of the mapping of the swap file, which is one block larger than the blocks it holds so they can be aligned
+  uint64_t arena_size_;
+  // Start of the mapping of the swap file, and of the first block in it
+  byte *arena_;
+  byte *blocks_;
+  // Protects the bookkeeping below, which is also updated when blocks are allocated and released
+  mutable common::SpinLatch latch_;
+  // Every NUMA node gets an equal share of the blocks in the arena. Per node, the number of blocks handed out so far
+  // and the blocks freed since.
+  std::vector<uint64_t> num_allocated_;
+  std::vector<std::vector<byte *>> free_blocks_;
+  // Blocks with pages that read from the swap file
+  std::unordered_set<RawBlock *> evicted_blocks_;
+  // Evicted blocks of which only some ranges read from the swap file
+  std::unordered_set<RawBlock *> partially_evicted_blocks_;
+
+  // Begin and end offset of the pages EvictRanges releases of the given range of a block. The first page holds the
+  // header of the block, which must stay in memory.
+  std::pair<uint64_t, uint64_t> ReleasablePages(const uint32_t begin, const uint32_t end) const {
+    const uint64_t pages_begin = std::max((begin + page_size_ - 1) / page_size_ * page_size_, page_size_);
+    return {pages_begin, std::max(pages_begin, end / page_size_ * page_size_)};
+  }
+
+  // Number of blocks of the arena placed on the given node, and index of the first of them
+  uint64_t NodeShare(uint16_t numa_node) const {
+    const auto num_nodes = static_cast<uint16_t>(num_allocated_.size());
+    return max_blocks_ / num_nodes + (numa_node < max_blocks_ % num_nodes ? 1 : 0);
+  }
+
+  uint64_t NodeStart(uint16_t numa_node) const {
+    const auto num_nodes = static_cast<uint16_t>(num_allocated_.size());
+    return numa_node * (max_blocks_ / num_nodes) + std::min<uint64_t>(numa_node, max_blocks_ % num_nodes);
+  }
+
+  // Offset of a block in the swap file
+  uint64_t FileOffset(const RawBlock *const block) const {
+    return static_cast<uint64_t>(reinterpret_cast<const byte *>(block) - arena_);
+  }
+
+  // Records that some ranges of the block read from the swap file, unless the block was evicted before
+  void TrackPartialEviction(RawBlock *block, uint64_t num_released);
+
+  // Writes the given pages of a block to the swap file and drops the copies in memory, after which they read from the
+  // file. If told to wait, returns once they are on disk, and drops them from the page cache.
+  void WritePages(RawBlock *block, uint64_t begin, uint64_t end, bool wait);
+
+  // Drops the private copies of the given pages of a block, after which they read from the swap file. Sets errno and
+  // returns false on failure.
+  bool DropPages(RawBlock *block, uint64_t begin, uint64_t end);
+
+  // Frees up the space in the swap file of the given pages of a block, which read as zeros afterwards unless they have
+  // private copies
+  void PunchHole(RawBlock *block, uint64_t begin, uint64_t end);
+};
+}  // namespace terrier::storage
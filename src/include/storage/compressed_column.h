@@ -0,0 +1,161 @@
+#pragma once
+
+#include <vector>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+
+namespace terrier::storage {
+
+/**
+ * Encoding of a compressed fixed-length column
+ */
+enum class ColumnEncoding : uint8_t {
+  /** The column is not compressed */
+  UNCOMPRESSED = 0,
+  /** Values are stored as bit-packed offsets from the smallest value */
+  FRAME_OF_REFERENCE,
+  /** Values are stored as bit-packed differences from the previous value, with a full value every so often */
+  DELTA,
+  /** Values are stored as runs of equal values */
+  RUN_LENGTH
+};
+
+/**
+ * A compressed copy of a fixed-length column of a frozen block. The block compactor picks whichever encoding stores
+ * the values of a column in the least amount of space when it freezes a block, and releases the raw values of the
+ * column in the block to the swap file of its BlockEvictor. Vectorized scans of frozen blocks decode the compressed
+ * copy instead of faulting the raw values back in.
+ *
+ * Values are encoded as signed integers of the size of the column, whatever their SQL type. The values of null
+ * attributes are not preserved.
+ */
+class CompressedColumn {
+ public:
+  /**
+   * Number of values between two full values stored in a delta encoded column. Decoding a value never needs to sum up
+   * more deltas than this.
+   */
+  static constexpr uint32_t DELTA_CHECKPOINT_INTERVAL = 1024;
+
+  /**
+   * Constructs an uncompressed column
+   */
+  CompressedColumn() = default;
+
+  DISALLOW_COPY(CompressedColumn)
+
+  /**
+   * Move constructor
+   * @param other object to move from
+   */
+  CompressedColumn(CompressedColumn &&other) noexcept
+      : encoding_(other.encoding_),
+        bit_width_(other.bit_width_),
+        num_values_(other.num_values_),
+        num_runs_(other.num_runs_),
+        base_(other.base_),
+        size_(other.size_),
+        buffer_(other.buffer_) {
+    other.buffer_ = nullptr;
+  }
+
+  /**
+   * Move-assignment operator
+   * @param other object to move from
+   * @return self-reference
+   */
+  CompressedColumn &operator=(CompressedColumn &&other) noexcept {
+    if (this != &other) {
+      delete[] buffer_;
+      encoding_ = other.encoding_;
+      bit_width_ = other.bit_width_;
+      num_values_ = other.num_values_;
+      num_runs_ = other.num_runs_;
+      base_ = other.base_;
+      size_ = other.size_;
+      buffer_ = other.buffer_;
+      other.buffer_ = nullptr;
+    }
+    return *this;
+  }
+
+  /**
+   * Destructs a CompressedColumn
+   */
+  ~CompressedColumn() { Deallocate(); }
+
+  /**
+   * Compresses the values of a column with the encoding that takes the least space
+   * @param values values of the column, sign-extended to 64 bits. Null attributes should hold the value of a neighbor
+   *               to not get in the way of compression.
+   * @param attr_size size of the column the values come from
+   * @return the compressed column, which is uncompressed if no encoding saves space
+   */
+  static CompressedColumn Encode(const std::vector<int64_t> &values, uint8_t attr_size);
+
+  /**
+   * @return encoding of the column
+   */
+  ColumnEncoding Encoding() const { return encoding_; }
+
+  /**
+   * @return number of values in the column
+   */
+  uint32_t NumValues() const { return num_values_; }
+
+  /**
+   * @return number of bytes the compressed values take up
+   */
+  uint64_t Size() const { return size_; }
+
+  /**
+   * Decodes a range of values of the column
+   * @param start index of the first value to decode
+   * @param count number of values to decode
+   * @param attr_size size of the column the values come from
+   * @param out location to write the values to, as an array of attr_size-wide values
+   */
+  void Decode(uint32_t start, uint32_t count, uint8_t attr_size, byte *out) const;
+
+  /**
+   * Gives up ownership of the compressed values, for the caller to free them once no reader can be decoding them.
+   * The column is uncompressed afterwards.
+   * @return the buffer holding the compressed values, which must be freed with delete[]
+   */
+  const byte *Release() {
+    const byte *result = buffer_;
+    buffer_ = nullptr;
+    *this = CompressedColumn();
+    return result;
+  }
+
+  /**
+   * Deallocates the compressed values, after which the column is uncompressed
+   */
+  void Deallocate() {
+    delete[] buffer_;
+    buffer_ = nullptr;
+    encoding_ = ColumnEncoding::UNCOMPRESSED;
+  }
+
+ private:
+  ColumnEncoding encoding_ = ColumnEncoding::UNCOMPRESSED;
+  // Number of bits of every bit-packed value
+  uint8_t bit_width_ = 0;
+  uint32_t num_values_ = 0;
+  uint32_t num_runs_ = 0;
+  // The smallest value for frame-of-reference, the smallest difference for delta encoding
+  int64_t base_ = 0;
+  uint64_t size_ = 0;
+  // frame-of-reference: packed offsets[num_values]
+  // delta: full values[num_checkpoints] | packed differences[num_values]
+  // run-length: run values[num_runs] | run ends[num_runs] (32-bit)
+  byte *buffer_ = nullptr;
+
+  template <class T>
+  void DecodeInto(uint32_t start, uint32_t count, T *out) const;
+
+  uint64_t Unpack(const uint64_t *words, uint32_t index) const;
+};
+}  // namespace terrier::storage
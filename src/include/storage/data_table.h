@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstring>
+#include <functional>
 #include <limits>
 #include <unordered_map>
 #include <vector>
@@ -28,6 +29,8 @@ template <typename KeyType>
 class BwTreeIndex;
 template <typename KeyType>
 class HashIndex;
+template <typename KeyType>
+class ArtIndex;
 }  // namespace index
 
 /**
@@ -114,6 +117,13 @@ class DataTable {
     int32_t num_advances_;
     TupleSlot current_slot_;
   };
+
+  /**
+   * Decides from the Arrow metadata of a frozen block, and in particular its zone maps, whether the block can hold any
+   * tuple a scan is interested in. Returns false if the scan can skip the block.
+   */
+  using FrozenBlockFilter = std::function<bool(const ArrowBlockMetadata &)>;
+
   /**
    * Constructs a new DataTable with the given layout, using the given BlockStore as the source
    * of its storage blocks. The first column must be size 8 and is effectively hidden from upper levels.
@@ -168,12 +178,17 @@ class DataTable {
    * to fill the buffer, unless there are no more tuples. The given iterator is mutated to point to one slot passed the
    * last slot scanned in the invocation.
    *
+   * If a block filter is given, frozen blocks that the filter rejects are skipped as a whole. This is safe because a
+   * frozen block holds no versions, and so looks the same to every transaction. For the same reason, the tuples of
+   * frozen blocks are copied into the buffer column by column instead of one tuple at a time.
+   *
    * @param txn The calling transaction.
    * @param start_pos Iterator to the starting location for the sequential scan.
    * @param out_buffer Output buffer. This buffer is always cleared of old values.
+   * @param block_filter Optional filter to skip frozen blocks with.
    */
   void Scan(common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *start_pos,
-            execution::sql::VectorProjection *out_buffer) const;
+            execution::sql::VectorProjection *out_buffer, const FrozenBlockFilter &block_filter = nullptr) const;
 
   /**
    * @return the first tuple slot contained in the data table
@@ -210,7 +225,8 @@ class DataTable {
    * @param txn the calling transaction
    * @param slot the slot of the tuple to update.
    * @param redo the desired change to be applied. This should be the after-image of the attributes of interest. Should
-   * not reference col_id 0
+   * not reference col_id 0. Varlen values the redo owns are handed over to the table. The contents of varlen values it
+   * does not own are copied into the varlen arena of the tuple's block.
    * @return true if successful, false otherwise
    */
   bool Update(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot, const ProjectedRow &redo);
@@ -220,12 +236,35 @@ class DataTable {
    * delta record. The slot allocated for the tuple is returned.
    *
    * @param txn the calling transaction
-   * @param redo after-image of the inserted tuple. Should not reference col_id 0
+   * @param redo after-image of the inserted tuple. Should not reference col_id 0. Varlen values are treated the same
+   * as by Update.
    * @return the TupleSlot allocated for this insert, used to identify this tuple's physical location for indexes and
    * such.
    */
   TupleSlot Insert(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo);
 
+  /**
+   * Inserts a batch of tuples, as given column-wise in the buffer. Unlike calling Insert for every tuple, consecutive
+   * slots are claimed from a block all at once, and every column is copied into the block in one go. Tuples are
+   * inserted in order, and the slots allocated for them are written to the TupleSlots of the buffer.
+   *
+   * @param txn the calling transaction
+   * @param columns after-images of the inserted tuples, in the first NumTuples() rows. Should reference every column
+   * but col_id 0. Varlen values are treated the same as by Update, and the varlen entries of the buffer are pointed at
+   * the copies the table made of them.
+   */
+  void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn, ProjectedColumns *columns);
+
+  /**
+   * Points the varlen entries of the given row that do not own their contents at the copies the table made of them
+   * when the row was written to the given slot, so that the row no longer depends on the memory of whoever wrote it.
+   * Used to keep redo records valid until they are logged.
+   *
+   * @param slot the slot the row was just written to by the calling transaction
+   * @param row the row written to the slot
+   */
+  void RepointVarlens(TupleSlot slot, ProjectedRow *row) const;
+
   /**
    * Deletes the given TupleSlot, this will call StageDelete on the provided txn to generate the RedoRecord for delete.
    * The rest of the behavior follows Update's behavior.
@@ -245,6 +284,17 @@ class DataTable {
    */
   uint32_t GetNumBlocks() const { return blocks_.size(); }
 
+  /**
+   * Blocks can be frozen or thawed concurrently, so the count is only a snapshot.
+   * @return Number of blocks in the data table that are frozen. The rest are hot, or on their way to being frozen.
+   */
+  uint32_t GetNumFrozenBlocks() const;
+
+  /**
+   * @return the NUMA node each block of the data table is placed on, in the same order as the blocks are iterated
+   */
+  std::vector<uint16_t> GetBlockNumaNodes() const;
+
   /** @return Maximum number of blocks in the data table. */
   static uint32_t GetMaxBlocks() { return std::numeric_limits<uint32_t>::max(); }
 
@@ -275,9 +325,16 @@ class DataTable {
   friend class index::BwTreeIndex;
   template <typename KeyType>
   friend class index::HashIndex;
+  template <typename KeyType>
+  friend class index::ArtIndex;
   // The block compactor elides transactional protection in the gather/compression phase and
   // needs raw access to the underlying table.
   friend class BlockCompactor;
+  // The block evictor needs to find the frozen blocks of the table
+  friend class BlockEvictor;
+
+  // Number of records PruneVersionChain looks at before leaving a chain to the GC
+  static constexpr uint32_t MAX_INLINE_PRUNE_DEPTH = 8;
 
   const common::ManagedPointer<BlockStore> block_store_;
   const layout_version_t layout_version_;
@@ -302,8 +359,45 @@ class DataTable {
   bool SelectIntoBuffer(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
                         RowType *out_buffer) const;
 
+  // Copy the given number of tuples of a frozen block, starting at the given slot, into the output buffer at the given
+  // row, decoding compressed columns along the way. Returns false without copying if the block is not frozen with at
+  // least that many records anymore.
+  bool CopyFrozenTuples(TupleSlot start, uint32_t num_tuples, execution::sql::VectorProjection *out_buffer,
+                        uint32_t row) const;
+
+  // Copy the visible tuples among the given number of slots of a block without versions, starting at the given slot,
+  // into the output buffer at row *filled, and advance *filled past them. Returns false without touching *filled if a
+  // writer installed a version in the block while copying, in which case the copied values cannot be trusted.
+  bool CopyCleanTuples(TupleSlot start, uint32_t num_slots, ProjectedColumns *out_buffer, uint32_t *filled) const;
+  bool CopyCleanTuples(TupleSlot start, uint32_t num_slots, execution::sql::VectorProjection *out_buffer,
+                       uint32_t *filled) const;
+
+  // Number of slots from the given one up to the insert head of its block that a scan can copy from a block without
+  // versions, given the room left in its output buffer. 0 if the block has versions, or the slot is past the insert
+  // head.
+  uint32_t NumCleanSlots(TupleSlot start, uint32_t room) const;
+
+  // Moves the iterator to the given offset of the block it points to, or on to the next block if that is past the end
+  void AdvanceInBlock(SlotIterator *it, uint32_t offset) const;
+
+  // Finds the first block from the insertion head that is not full and no one else is inserting into, or makes a new
+  // one, and claims up to the given number of consecutive slots in it. Returns the first slot claimed.
+  TupleSlot ClaimSlots(uint32_t max_slots, uint32_t *num_claimed);
+
   void InsertInto(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo,
                   TupleSlot dest);
+
+  // Copies the contents of the given varlen into the varlen arena of the block if the entry does not own them, and
+  // points the entry at the copy. Values that do not fit in the arena anymore, or all values if the block store does
+  // not use varlen arenas, are copied into memory of their own.
+  void InternVarlen(RawBlock *block, VarlenEntry *entry);
+
+  // Interns the varlens of the given row after it was written to the given slot
+  void InternVarlens(TupleSlot slot, const ProjectedRow &row);
+
+  // Inserts the given number of rows of the buffer, starting at the given row, into consecutive slots starting at dest
+  void InsertRangeInto(common::ManagedPointer<transaction::TransactionContext> txn, ProjectedColumns *columns,
+                       uint32_t first_row, TupleSlot dest, uint32_t num_tuples);
   // Atomically read out the version pointer value.
   UndoRecord *AtomicallyReadVersionPtr(TupleSlot slot, const TupleAccessStrategy &accessor) const;
 
@@ -331,6 +425,13 @@ class DataTable {
   // Allocates a new block to be used as insertion head.
   RawBlock *NewBlock();
 
+  // Cuts off the part of a version chain that no running transaction can see, starting the search at the given record.
+  // Only ever stores nullptr into the next pointer of a record that stays in the chain, just like the GC's truncation,
+  // so it is safe to race with the GC and with other transactions pruning the same chain. The cut records are still
+  // owned by their transactions and freed by the GC. Gives up after MAX_INLINE_PRUNE_DEPTH records to keep the access
+  // path cheap, leaving longer chains to the GC.
+  void PruneVersionChain(UndoRecord *start, transaction::timestamp_t prune_horizon) const;
+
   /**
    * Determine if a Tuple is visible (present and not deleted) to the given transaction. It's effectively Select's logic
    * (follow a version chain if present) without the materialization. If the logic of Select changes, this should change
@@ -340,5 +441,13 @@ class DataTable {
    * @return true if tuple is visible to this txn, false otherwise
    */
   bool IsVisible(const transaction::TransactionContext &txn, TupleSlot slot) const;
+
+  /**
+   * Determine if a Tuple is visible (present and not deleted) and has no other versions, so that every running
+   * transaction reads the values stored in place.
+   * @param slot the slot of the tuple to check visibility on
+   * @return true if tuple is visible to every txn and has no version chain, false otherwise
+   */
+  bool IsVisibleToAll(TupleSlot slot) const;
 };
 }  // namespace terrier::storage
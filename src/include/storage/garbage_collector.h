@@ -1,11 +1,14 @@
 #pragma once
 
+#include <memory>
 #include <queue>
 #include <tuple>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/shared_latch.h"
+#include "common/worker_pool.h"
 #include "storage/storage_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -31,6 +34,10 @@ class Index;
  * Based on the contents of this queue, it unlinks the UndoRecords from their version chains when no running
  * transactions can view those versions anymore. It then stores those transactions to attempt to deallocate on the next
  * iteration if no running transactions can still hold references to them.
+ *
+ * With more than one GC thread, the GC splits the work of an invocation across a pool of worker threads. Version chains
+ * are partitioned by tuple slot, so that every chain is still truncated by a single thread, and the indexes are
+ * garbage collected concurrently. The queues and deferred actions are still processed by the calling thread.
  */
 class GarbageCollector {
  public:
@@ -44,12 +51,15 @@ class GarbageCollector {
    *                 it is not null. The observer can then gain insight invoke other components to perform actions.
    *                 The observer's function implementation needs to be lightweight because it is called on the GC
    *                 thread.
+   * @param num_gc_threads number of worker threads to split unlinking and index GC across. With a single thread, all
+   *                       of the work is done on the thread that invokes the GC
    */
   // TODO(Tianyu): Eventually the GC will be re-written to be purely on the deferred action manager. which will
   //  eliminate this perceived redundancy of taking in a transaction manager.
   GarbageCollector(common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
                    common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer);
+                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+                   uint32_t num_gc_threads = 1);
 
   ~GarbageCollector() {
     TERRIER_ASSERT(txns_to_deallocate_.empty(), "Not all txns have been deallocated");
@@ -107,6 +117,20 @@ class GarbageCollector {
    */
   void ProcessDeferredActions(transaction::timestamp_t oldest_txn);
 
+  /**
+   * Unlinks the UndoRecords of the given txns on the calling thread
+   * @return number of UndoRecords processed
+   */
+  uint32_t UnlinkTransactions(const std::vector<transaction::TransactionContext *> &txns,
+                              transaction::timestamp_t oldest_txn);
+
+  /**
+   * Unlinks the UndoRecords of the given txns on the worker threads
+   * @return number of UndoRecords processed
+   */
+  uint32_t UnlinkTransactionsInParallel(const std::vector<transaction::TransactionContext *> &txns,
+                                        transaction::timestamp_t oldest_txn);
+
   void ReclaimSlotIfDeleted(UndoRecord *undo_record) const;
 
   void ReclaimBufferIfVarlen(transaction::TransactionContext *txn, UndoRecord *undo_record) const;
@@ -129,6 +153,12 @@ class GarbageCollector {
   std::unordered_set<common::ManagedPointer<index::Index>> indexes_;
   common::SharedLatch indexes_latch_;
 
+  // Fewest txns to unlink in an invocation for the work to be split across the worker threads. Handing off smaller
+  // amounts of work costs more than it saves.
+  static constexpr uint32_t PARALLEL_UNLINK_THRESHOLD = 64;
+  // Worker threads the GC splits its work across, nullptr if the GC is single-threaded
+  std::unique_ptr<common::WorkerPool> gc_pool_;
+
   uint64_t gc_interval_{0};
 };
 
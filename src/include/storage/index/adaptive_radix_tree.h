@@ -0,0 +1,271 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+
+namespace terrier::storage::index {
+
+/**
+ * Adaptive radix tree (Leis et al., "The Adaptive Radix Tree: ARTful Indexing for Main-Memory Databases", ICDE 2013)
+ * over fixed-length, binary-comparable keys, i.e. keys whose order is the order of std::memcmp on their bytes, such as
+ * CompactIntsKey.
+ *
+ * Inner nodes grow and shrink between 4, 16, 48 and 256 children as keys come and go. Paths without branches are
+ * compressed into the prefix of the node below them, of which the first MAX_PREFIX_LENGTH bytes are stored; the rest
+ * is checked against a leaf when needed. Subtrees holding a single key are replaced by the leaf itself, which stores
+ * the whole key.
+ *
+ * The tree is a set of keys. Callers that need several values per key append the value to the key, see ArtIndex.
+ *
+ * Not thread-safe. Readers may run concurrently with each other, but not with writers.
+ */
+class AdaptiveRadixTree {
+ public:
+  /**
+   * Number of prefix bytes stored in an inner node
+   */
+  static constexpr uint32_t MAX_PREFIX_LENGTH = 8;
+
+  /**
+   * @param key_size size of every key in the tree in bytes
+   */
+  explicit AdaptiveRadixTree(uint16_t key_size) : key_size_(key_size) {}
+
+  /**
+   * Frees all nodes and leaves of the tree.
+   */
+  ~AdaptiveRadixTree() { Free(root_); }
+
+  DISALLOW_COPY_AND_MOVE(AdaptiveRadixTree);
+
+  /**
+   * @param key key to insert, of key_size bytes
+   * @return true if the key was inserted, false if it was already in the tree
+   */
+  bool Insert(const byte *key);
+
+  /**
+   * @param key key to delete, of key_size bytes
+   * @return true if the key was deleted, false if it was not in the tree
+   */
+  bool Delete(const byte *key);
+
+  /**
+   * Builds the tree bottom-up from sorted keys. Every node is allocated once at its final size, instead of growing
+   * through the smaller node types as it would with one insert per key. The tree must be empty.
+   * @param keys num_keys keys of key_size bytes each, back to back, in ascending order and without duplicates
+   * @param num_keys number of keys
+   */
+  void BulkLoad(const byte *keys, uint64_t num_keys);
+
+  /**
+   * Calls the visitor on every key between low and high, inclusive, in ascending or descending order, until the visitor
+   * returns false.
+   * @tparam Visitor callable taking const byte * and returning bool
+   * @param low smallest key to visit, of key_size bytes
+   * @param high largest key to visit, of key_size bytes
+   * @param ascending whether to visit the keys in ascending order
+   * @param visitor callback for every key visited
+   */
+  template <class Visitor>
+  void Scan(const byte *low, const byte *high, const bool ascending, const Visitor &visitor) const {
+    if (root_ != nullptr && std::memcmp(low, high, key_size_) <= 0)
+      Scan(root_, 0, reinterpret_cast<const uint8_t *>(low), reinterpret_cast<const uint8_t *>(high), true, true,
+           ascending, visitor);
+  }
+
+  /**
+   * Calls the visitor on every key that starts with one of the given prefixes, in ascending order for each prefix. The
+   * lookups of all prefixes go down the tree together, one level at a time, and the node that each lookup reads next is
+   * prefetched before any of them is read. That way the cache misses of different lookups overlap instead of being paid
+   * one after the other.
+   * @tparam Visitor callable taking the position of the prefix (uint32_t) and a key (const byte *)
+   * @param prefixes num_prefixes prefixes of prefix_size bytes each, back to back
+   * @param prefix_size size of every prefix in bytes, at most key_size
+   * @param num_prefixes number of prefixes
+   * @param visitor callback for every key visited
+   */
+  template <class Visitor>
+  void ScanPrefixes(const byte *prefixes, const uint16_t prefix_size, const uint32_t num_prefixes,
+                    const Visitor &visitor) const {
+    TERRIER_ASSERT(prefix_size <= key_size_, "Prefixes cannot be longer than the keys.");
+    const auto *const prefix_bytes = reinterpret_cast<const uint8_t *>(prefixes);
+    std::vector<const Node *> nodes(num_prefixes, root_);
+    std::vector<uint32_t> depths(num_prefixes, 0);
+    std::vector<uint32_t> active(num_prefixes);
+    for (uint32_t i = 0; i < num_prefixes; i++) active[i] = i;
+
+    while (!active.empty()) {
+      uint32_t num_active = 0;
+      for (const uint32_t i : active) {
+        if (DescendPrefix(&nodes[i], &depths[i], prefix_bytes + i * prefix_size, prefix_size)) active[num_active++] = i;
+      }
+      active.resize(num_active);
+    }
+
+    for (uint32_t i = 0; i < num_prefixes; i++) {
+      if (nodes[i] == nullptr) continue;
+      // Every key below the node starts with the prefix, so the whole subtree is visited
+      Scan(nodes[i], depths[i], nullptr, nullptr, false, false, true, [&](const byte *const key) {
+        visitor(i, key);
+        return true;
+      });
+    }
+  }
+
+  /**
+   * @return number of keys in the tree
+   */
+  uint64_t Size() const { return size_; }
+
+  /**
+   * @return number of bytes allocated for the nodes and leaves of the tree. Safe to call concurrently with writers.
+   */
+  uint64_t HeapUsage() const { return heap_usage_.load(); }
+
+ private:
+  enum class NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+  struct Node {
+    NodeType type_;
+    uint16_t num_children_;
+    uint32_t prefix_length_;
+    uint8_t prefix_[MAX_PREFIX_LENGTH];
+  };
+
+  // Children are sorted by their key byte
+  struct Node4 : Node {
+    uint8_t keys_[4];
+    Node *children_[4];
+  };
+
+  struct Node16 : Node {
+    uint8_t keys_[16];
+    Node *children_[16];
+  };
+
+  // child_index_ holds one plus the position of the child for a key byte, or 0 if there is none
+  struct Node48 : Node {
+    uint8_t child_index_[256];
+    Node *children_[48];
+  };
+
+  struct Node256 : Node {
+    Node *children_[256];
+  };
+
+  const uint16_t key_size_;
+  Node *root_ = nullptr;
+  uint64_t size_ = 0;
+  std::atomic<uint64_t> heap_usage_{0};
+
+  // Leaves are the key bytes themselves, told apart from inner nodes by the lowest bit of the pointer
+  static bool IsLeaf(const Node *node) { return (reinterpret_cast<uintptr_t>(node) & 1) != 0; }
+  static const uint8_t *LeafKey(const Node *node) {
+    return reinterpret_cast<const uint8_t *>(reinterpret_cast<uintptr_t>(node) & ~static_cast<uintptr_t>(1));
+  }
+
+  Node *NewLeaf(const uint8_t *key);
+  template <class NodeT>
+  NodeT *NewNode(NodeType type);
+  static void CopyHeader(Node *to, const Node *from);
+  void FreeNode(Node *node);
+  void Free(Node *node);
+
+  // Leftmost leaf below the given node, which is used to recover the prefix bytes that are not stored in a node
+  static const Node *Minimum(const Node *node);
+  // Number of bytes of the prefix of the node that match the key from the given depth on
+  static uint32_t PrefixMismatch(const Node *node, const uint8_t *key, uint32_t depth);
+  static Node **FindChild(Node *node, uint8_t key_byte);
+  void AddChild(Node **ref, uint8_t key_byte, Node *child);
+  void RemoveChild(Node **ref, uint8_t key_byte);
+
+  bool Insert(Node **ref, const uint8_t *key, uint32_t depth);
+  bool Delete(Node **ref, const uint8_t *key, uint32_t depth);
+  // Subtree holding the given sorted keys, all of which share their first depth bytes
+  Node *Build(const uint8_t *keys, uint64_t num_keys, uint32_t depth);
+  // One step of a lookup in ScanPrefixes: moves the node to its child on the path of the prefix and prefetches it.
+  // Returns false once the lookup is done, leaving the subtree of the keys that start with the prefix in the node, or
+  // nullptr if there are none.
+  static bool DescendPrefix(const Node **node, uint32_t *depth, const uint8_t *prefix, uint16_t prefix_size);
+
+  // low_tight and high_tight say whether the path to the node equals the first depth bytes of low and high, in which
+  // case the node can hold keys out of range
+  template <class Visitor>
+  bool Scan(const Node *node, uint32_t depth, const uint8_t *low, const uint8_t *high, bool low_tight, bool high_tight,
+            const bool ascending, const Visitor &visitor) const {
+    if (IsLeaf(node)) {
+      const uint8_t *key = LeafKey(node);
+      if (low_tight && std::memcmp(key, low, key_size_) < 0) return true;
+      if (high_tight && std::memcmp(key, high, key_size_) > 0) return true;
+      return visitor(reinterpret_cast<const byte *>(key));
+    }
+
+    if (node->prefix_length_ > 0 && (low_tight || high_tight)) {
+      const uint8_t *prefix =
+          node->prefix_length_ <= MAX_PREFIX_LENGTH ? node->prefix_ : LeafKey(Minimum(node)) + depth;
+      if (low_tight) {
+        const int cmp = std::memcmp(prefix, low + depth, node->prefix_length_);
+        if (cmp < 0) return true;
+        low_tight = cmp == 0;
+      }
+      if (high_tight) {
+        const int cmp = std::memcmp(prefix, high + depth, node->prefix_length_);
+        if (cmp > 0) return true;
+        high_tight = cmp == 0;
+      }
+    }
+    depth += node->prefix_length_;
+
+    const uint8_t low_byte = low_tight ? low[depth] : 0;
+    const uint8_t high_byte = high_tight ? high[depth] : UINT8_MAX;
+    auto visit_child = [&](const uint8_t key_byte, const Node *child) {
+      return Scan(child, depth + 1, low, high, low_tight && key_byte == low_byte, high_tight && key_byte == high_byte,
+                  ascending, visitor);
+    };
+
+    switch (node->type_) {
+      case NodeType::NODE4:
+        return ScanSorted(static_cast<const Node4 *>(node), low_byte, high_byte, ascending, visit_child);
+      case NodeType::NODE16:
+        return ScanSorted(static_cast<const Node16 *>(node), low_byte, high_byte, ascending, visit_child);
+      case NodeType::NODE48: {
+        const auto *node48 = static_cast<const Node48 *>(node);
+        for (uint32_t i = 0; i <= static_cast<uint32_t>(high_byte - low_byte); i++) {
+          const auto key_byte = static_cast<uint8_t>(ascending ? low_byte + i : high_byte - i);
+          const uint8_t index = node48->child_index_[key_byte];
+          if (index != 0 && !visit_child(key_byte, node48->children_[index - 1])) return false;
+        }
+        return true;
+      }
+      default: {
+        const auto *node256 = static_cast<const Node256 *>(node);
+        for (uint32_t i = 0; i <= static_cast<uint32_t>(high_byte - low_byte); i++) {
+          const auto key_byte = static_cast<uint8_t>(ascending ? low_byte + i : high_byte - i);
+          const Node *child = node256->children_[key_byte];
+          if (child != nullptr && !visit_child(key_byte, child)) return false;
+        }
+        return true;
+      }
+    }
+  }
+
+  template <class SortedNode, class VisitChild>
+  static bool ScanSorted(const SortedNode *node, const uint8_t low_byte, const uint8_t high_byte, const bool ascending,
+                         const VisitChild &visit_child) {
+    for (uint16_t i = 0; i < node->num_children_; i++) {
+      const uint16_t pos = ascending ? i : node->num_children_ - 1 - i;
+      const uint8_t key_byte = node->keys_[pos];
+      if (key_byte < low_byte || key_byte > high_byte) continue;
+      if (!visit_child(key_byte, node->children_[pos])) return false;
+    }
+    return true;
+  }
+};
+
+}  // namespace terrier::storage::index
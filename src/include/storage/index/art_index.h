@@ -0,0 +1,96 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/managed_pointer.h"
+#include "common/shared_latch.h"
+#include "storage/index/adaptive_radix_tree.h"
+#include "storage/index/index.h"
+#include "storage/index/index_defs.h"
+
+namespace terrier::transaction {
+class TransactionContext;
+}
+
+namespace terrier::storage::index {
+template <uint8_t KeySize>
+class CompactIntsKey;
+
+/**
+ * Index on an adaptive radix tree. The MVCC logic is the same as in our reference index (BwTreeIndex).
+ *
+ * The tree needs keys that compare like their bytes, so only CompactIntsKey is supported. The tree holds every
+ * (key, TupleSlot) pair as one entry: the bytes of the key followed by the TupleSlot in big-endian order. That makes
+ * entries unique even when keys are not, and keeps the entries of a key next to each other for range scans.
+ *
+ * INCLUDE columns are stored in the key after the key columns, so they are part of the entry without being part of the
+ * prefix that lookups search for. Since an entry holds every column of the index, lookups can return the columns of
+ * tuples that have no other versions without reading them from the table (see ScanKeyCovered).
+ *
+ * The tree itself is not thread-safe, so writers latch it exclusively and readers latch it shared.
+ * @tparam KeyType the type of keys stored in the tree
+ */
+template <typename KeyType>
+class ArtIndex final : public Index {
+  friend class IndexBuilder;
+
+ private:
+  explicit ArtIndex(IndexMetadata metadata);
+
+  const std::unique_ptr<AdaptiveRadixTree> art_;
+  mutable common::SharedLatch latch_;
+  // How many bytes at the start of an entry hold the key columns. The INCLUDE columns and the TupleSlot follow them.
+  const uint16_t key_bytes_;
+
+  // Collects the locations between two entries that are visible to the txn, in entry order, until there are limit of
+  // them. A limit of 0 means no limit.
+  void ScanRange(const transaction::TransactionContext &txn, const byte *low, const byte *high, bool ascending,
+                 uint32_t limit, std::vector<TupleSlot> *value_list) const;
+
+ public:
+  IndexType Type() const final { return IndexType::ART; }
+
+  size_t EstimateHeapUsage() const final;
+
+  bool Insert(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+              TupleSlot location) final;
+
+  bool InsertUnique(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+                    TupleSlot location) final;
+
+  bool BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) final;
+
+  void Delete(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+              TupleSlot location) final;
+
+  void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
+               std::vector<TupleSlot> *value_list) final;
+
+  void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                    std::vector<std::vector<TupleSlot>> *value_lists) final;
+
+  bool StoresColumns() const final { return true; }
+
+  void ScanKeyCovered(const transaction::TransactionContext &txn, const ProjectedRow &key,
+                      std::vector<TupleSlot> *value_list, std::vector<byte> *rows, std::vector<bool> *covered) final;
+
+  void ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type, uint32_t num_attrs,
+                     ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
+                     std::vector<TupleSlot> *value_list) final;
+
+  void ScanDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                      const ProjectedRow &high_key, std::vector<TupleSlot> *value_list) final;
+
+  void ScanLimitDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                           const ProjectedRow &high_key, std::vector<TupleSlot> *value_list, uint32_t limit) final;
+};
+
+extern template class ArtIndex<CompactIntsKey<8>>;
+extern template class ArtIndex<CompactIntsKey<16>>;
+extern template class ArtIndex<CompactIntsKey<24>>;
+extern template class ArtIndex<CompactIntsKey<32>>;
+
+}  // namespace terrier::storage::index
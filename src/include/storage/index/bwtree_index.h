@@ -55,12 +55,18 @@ class BwTreeIndex final : public Index {
   bool InsertUnique(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
                     TupleSlot location) final;
 
+  bool BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) final;
+
   void Delete(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
               TupleSlot location) final;
 
   void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                std::vector<TupleSlot> *value_list) final;
 
+  void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                    std::vector<std::vector<TupleSlot>> *value_lists) final;
+
   void ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type, uint32_t num_attrs,
                      ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
                      std::vector<TupleSlot> *value_list) final;
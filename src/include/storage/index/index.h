@@ -47,6 +47,17 @@ class Index {
     return data_table->IsVisible(txn, slot);
   }
 
+  /**
+   * Determine if a tuple is visible to every txn alive and has no other versions by asking the DataTable associated
+   * with the TupleSlot. Used by scans that return the index's copy of a tuple's columns instead of reading the table.
+   * @param slot the slot of the tuple to check visibility on
+   * @return true if the tuple's values in place are the ones every txn alive sees, false otherwise
+   */
+  static bool IsVisibleToAll(const TupleSlot slot) {
+    const auto *const data_table = slot.GetBlock()->data_table_;
+    return data_table->IsVisibleToAll(slot);
+  }
+
   /**
    * Creates a new index wrapper.
    * @param metadata index description
@@ -93,6 +104,35 @@ class Index {
   virtual bool InsertUnique(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
                             TupleSlot location) = 0;
 
+  /**
+   * Inserts a batch of key-value pairs into an empty index that no other txn can see yet, like the one being built by
+   * CREATE INDEX. Indexes that can do better than one insert at a time (e.g. by sorting the keys and building the
+   * structure in key order) override this; the default just calls Insert or InsertUnique on every pair.
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param entries keys initialized with this index's ProjectedRowInitializer and their values. Varlens must stay valid
+   * until the call returns.
+   * @return false if the index is unique and two of the keys are equal, true otherwise
+   */
+  virtual bool BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                        const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+    for (const auto &entry : entries) {
+      if (!InsertEntry(txn, *entry.first, entry.second)) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Inserts a key-value pair with InsertUnique if the index is unique, and with Insert otherwise
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param tuple key
+   * @param location value
+   * @return true if the value was inserted, false otherwise
+   */
+  bool InsertEntry(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+                   TupleSlot location) {
+    return metadata_.GetSchema().Unique() ? InsertUnique(txn, tuple, location) : Insert(txn, tuple, location);
+  }
+
   /**
    * Doesn't immediately call delete on the index. Registers a commit action in the txn that will eventually register a
    * deferred action for the GC to safely call delete on the index when no more transactions need to access the key.
@@ -112,6 +152,49 @@ class Index {
   virtual void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                        std::vector<TupleSlot> *value_list) = 0;
 
+  /**
+   * Finds all the values associated with each of the given keys, as ScanKey would for every one of them. Indexes that
+   * can do better than one lookup at a time (e.g. by looking the keys up in key order, so that consecutive lookups share
+   * the top of the structure, or by overlapping the cache misses of several lookups) override this; the default just
+   * calls ScanKey on every key.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for, which may repeat
+   * @param[out] value_lists the values associated with each key, in the order of the keys. Resized to the number of
+   * keys.
+   */
+  virtual void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                            std::vector<std::vector<TupleSlot>> *value_lists) {
+    value_lists->resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      (*value_lists)[i].clear();
+      ScanKey(txn, *keys[i], &(*value_lists)[i]);
+    }
+  }
+
+  /**
+   * @return true if the index stores its columns alongside its keys, so that ScanKeyCovered can return them
+   */
+  virtual bool StoresColumns() const { return false; }
+
+  /**
+   * Finds all the values associated with the given key, as ScanKey does, along with the index's own copy of the columns
+   * of every value whose tuple is known to hold the same values for the calling txn. The columns of the other values
+   * must be read from the table. Indexes that store their columns (see StoresColumns) override this; the default just
+   * calls ScanKey and covers no values.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param key the key to look for
+   * @param[out] value_list the values associated with the key
+   * @param[out] rows the columns of the covered values, one row laid out by this index's ProjectedRowInitializer for
+   * each value in value_list, in the same order. Resized to fit every value.
+   * @param[out] covered whether rows holds the columns of each value in value_list
+   */
+  virtual void ScanKeyCovered(const transaction::TransactionContext &txn, const ProjectedRow &key,
+                              std::vector<TupleSlot> *value_list, std::vector<byte> *rows,
+                              std::vector<bool> *covered) {
+    ScanKey(txn, key, value_list);
+    covered->assign(value_list->size(), false);
+  }
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -33,6 +33,8 @@ class IndexBuilder {
 
   Index *BuildBwTreeGenericKey(IndexMetadata metadata) const;
 
+  Index *BuildArtIntsKey(IndexMetadata metadata) const;
+
   Index *BuildHashIntsKey(IndexMetadata metadata) const;
 
   Index *BuildHashGenericKey(IndexMetadata metadata) const;
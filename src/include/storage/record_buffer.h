@@ -2,7 +2,7 @@
 #include <vector>
 
 #include "common/constants.h"
-#include "common/object_pool.h"
+#include "common/sharded_object_pool.h"
 #include "common/strong_typedef.h"
 #include "storage/undo_record.h"
 
@@ -180,7 +180,7 @@ class RecordBufferSegmentAllocator {
 /**
  * Type alias for an object pool handing out buffer segments
  */
-using RecordBufferSegmentPool = common::ObjectPool<RecordBufferSegment, RecordBufferSegmentAllocator>;
+using RecordBufferSegmentPool = common::ShardedObjectPool<RecordBufferSegment, RecordBufferSegmentAllocator>;
 
 // TODO(Tianyu): Not thread-safe. We can probably just allocate thread-local buffers (or segments) if we ever want
 // multiple workers on the same transaction.
@@ -17,14 +17,18 @@ namespace terrier::storage {
  */
 class AbstractLogProvider {
  public:
+  virtual ~AbstractLogProvider() = default;
+
   /**
-   * Provide next available log record
+   * Provide next available log record. Providers that combine the records of other providers can override this instead
+   * of reading raw bytes.
    * @warning Can be a blocking call if provider is waiting to receive more logs
    * @return next log record along with vector of varlen entry pointers. nullptr log record if no more logs will be
    * provided.
    */
-  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
-    return HasMoreRecords() ? ReadNextRecord() : std::make_pair(nullptr, std::vector<byte *>());
+  virtual std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
+    return (frame_offset_ < frame_.size() || HasMoreRecords()) ? ReadNextRecord()
+                                                                 : std::make_pair(nullptr, std::vector<byte *>());
   }
 
  protected:
@@ -47,6 +51,13 @@ class AbstractLogProvider {
   virtual bool Read(void *dest, uint32_t size) = 0;
 
  private:
+  // Decompressed contents of the compressed frame records are currently read from, see COMPRESSED_LOG_FRAME_MARKER
+  std::vector<byte> frame_;
+  // Position of the next record in frame_
+  uint32_t frame_offset_ = 0;
+  // Offset into frame_ and size of every varlen value written out in full in the current frame, in order
+  std::vector<std::pair<uint32_t, uint32_t>> frame_varlens_;
+
   // TODO(Gus): Support a more fail-safe way than just throwing an exception
   /**
    * Read a value of the specified type from log provider. An exception is thrown if the reading failed
@@ -62,10 +73,52 @@ class AbstractLogProvider {
   }
 
   /**
-   * Reads in the next log record from the log provider
-   * @warning If the serialization format of logs ever changes, this function will need to be updated.
+   * Reads a value of the specified type from the current record
+   * @tparam COMPACT true if the record is in the compact format, i.e. read from the current frame
+   * @tparam T type of value to read
+   * @return the value read
+   */
+  template <bool COMPACT, class T>
+  T ReadField();
+
+  /**
+   * Reads the specified number of bytes of the current record into the target location
+   * @tparam COMPACT true if the record is in the compact format, i.e. read from the current frame
+   * @param dest pointer location to read into
+   * @param size number of bytes to read
+   */
+  template <bool COMPACT>
+  void ReadBytes(void *dest, uint32_t size);
+
+  /**
+   * Reads a varlen value of the current record
+   * @tparam COMPACT true if the record is in the compact format, i.e. read from the current frame
+   * @param[out] varlen_contents vector to add the contents to if they were allocated
+   * @return varlen entry holding the value
+   */
+  template <bool COMPACT>
+  VarlenEntry ReadVarlen(std::vector<byte *> *varlen_contents);
+
+  /**
+   * Reads in the next compressed frame from the log provider and decompresses it into frame_
+   * @throws runtime_error if the frame is corrupted
+   */
+  void ReadFrame();
+
+  /**
+   * Reads in the next log record from the log provider, in whichever format it was written out in
    * @return next log record, along with vector of varlen entry pointers
    */
   std::pair<LogRecord *, std::vector<byte *>> ReadNextRecord();
+
+  /**
+   * Reads in the rest of a log record after its size
+   * @warning If the serialization format of logs ever changes, this function will need to be updated.
+   * @tparam COMPACT true if the record is in the compact format, i.e. read from the current frame
+   * @param size in-memory size of the record
+   * @return the log record, along with vector of varlen entry pointers
+   */
+  template <bool COMPACT>
+  std::pair<LogRecord *, std::vector<byte *>> DeserializeRecord(uint32_t size);
 };
 }  // namespace terrier::storage
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "storage/sql_table.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "transaction/transaction_defs.h"
+
+namespace terrier::transaction {
+class TimestampManager;
+class TransactionContext;
+class TransactionManager;
+}  // namespace terrier::transaction
+
+namespace terrier::catalog {
+class DatabaseCatalog;
+}  // namespace terrier::catalog
+
+namespace terrier::storage {
+class LogManager;
+
+/**
+ * A CheckpointManager takes consistent snapshots of the database, so that recovery only has to replay the part of the
+ * log written after the latest snapshot instead of the whole log, and truncates the log the snapshot covers.
+ *
+ * A checkpoint is a file of log records in the same format as the write ahead log, so the RecoveryManager can load it
+ * through a DiskLogProvider. It replays as a sequence of transactions that recreate every database, its catalog, and
+ * the visible contents of every table as of the checkpoint timestamp. Redo records in the checkpoint carry the tuple
+ * slots the tuples currently live in, so records in the log tail that refer to those tuples map onto the recovered
+ * tuples just as they would had the whole log been replayed.
+ */
+class CheckpointManager {
+ public:
+  /**
+   * @param checkpoint_file_path path to write the checkpoint to. A previous checkpoint at this path is replaced
+   * atomically once the new one is durable
+   * @param catalog catalog to read the databases and tables to checkpoint from
+   * @param txn_manager transaction manager used to take the snapshot
+   * @param timestamp_manager timestamp manager of txn_manager, used to wait for transactions to finish
+   * @param log_manager log manager whose log the checkpoint truncates
+   */
+  CheckpointManager(std::string checkpoint_file_path, const common::ManagedPointer<catalog::Catalog> catalog,
+                    const common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                    const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
+                    const common::ManagedPointer<LogManager> log_manager)
+      : checkpoint_file_path_(std::move(checkpoint_file_path)),
+        catalog_(catalog),
+        txn_manager_(txn_manager),
+        timestamp_manager_(timestamp_manager),
+        log_manager_(log_manager) {}
+
+  /**
+   * Takes a checkpoint and truncates the log it covers. This does the following in order:
+   *    1. Moves the current log files to log_archive_path (see LogManager::RotateLogFile), and continues logging to new
+   *       log files
+   *    2. Waits for every transaction that started before the move to finish
+   *    3. Writes out a snapshot of the database using a read-only transaction
+   *    4. Replaces the previous checkpoint with the new one, and deletes the moved log files
+   * To recover, load the checkpoint and then replay the log files, skipping transactions that committed before the
+   * checkpoint timestamp. Transactions are not blocked while the checkpoint is taken.
+   * @param log_archive_path path to temporarily move the current log files to
+   * @throws runtime_error if any of the file operations fail
+   * @return the checkpoint timestamp. The checkpoint holds the changes of all transactions that committed before it
+   */
+  transaction::timestamp_t TakeCheckpoint(const std::string &log_archive_path);
+
+ private:
+  // Number of rows of a table written out per transaction. Recovery buffers the records of a transaction until it sees
+  // its commit record, so this bounds the memory needed to load a checkpoint.
+  static constexpr uint32_t ROWS_PER_CHECKPOINT_TXN = 1 << 14;
+
+  const std::string checkpoint_file_path_;
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
+  const common::ManagedPointer<LogManager> log_manager_;
+
+  /**
+   * Writes out every database visible to the snapshot transaction
+   * @param txn snapshot transaction
+   * @param out writer for the checkpoint file
+   */
+  void WriteCheckpoint(transaction::TransactionContext *txn, BufferedLogWriter *out);
+
+  /**
+   * Writes out a database: its catalog tables, the pg_class updates that make recovery recreate its tables and
+   * indexes, and the contents of its tables
+   * @param txn snapshot transaction
+   * @param db_oid oid of the database
+   * @param out writer for the checkpoint file
+   */
+  void WriteDatabase(transaction::TransactionContext *txn, catalog::db_oid_t db_oid, BufferedLogWriter *out);
+
+  /**
+   * Writes out every visible row of a table as an insert
+   * @param txn snapshot transaction
+   * @param db_oid oid of the database the table is in
+   * @param table_oid oid of the table
+   * @param table the table
+   * @param schema schema of the table
+   * @param split_txns true if the rows should be split into transactions of at most ROWS_PER_CHECKPOINT_TXN rows, false
+   * if they are part of a transaction the caller commits
+   * @param out writer for the checkpoint file
+   * @param on_row if not empty, called with every redo record written out
+   */
+  void WriteTable(transaction::TransactionContext *txn, catalog::db_oid_t db_oid, catalog::table_oid_t table_oid,
+                  SqlTable *table, const catalog::Schema &schema, bool split_txns, BufferedLogWriter *out,
+                  const std::function<void(const RedoRecord &)> &on_row);
+
+  /**
+   * Writes out a commit record for the checkpoint transaction written out so far
+   * @param txn snapshot transaction
+   * @param out writer for the checkpoint file
+   */
+  void WriteCommit(transaction::TransactionContext *txn, BufferedLogWriter *out);
+};
+}  // namespace terrier::storage
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "storage/recovery/abstract_log_provider.h"
+#include "storage/recovery/disk_log_provider.h"
+#include "transaction/transaction_defs.h"
+
+namespace terrier::storage {
+
+/**
+ * @brief Log provider for logs written to multiple log streams
+ * The LogManager can write to several log files in parallel. Each transaction's records are in one file, but the files
+ * are not ordered with respect to each other. Neither is a single file: a transaction takes its commit timestamp before
+ * its commit record is handed to the log, so two transactions on the same stream can reach the file in the opposite
+ * order of their commits. This provider merges the files and hands out the records of committed transactions in commit
+ * order, so the recovery manager sees them as if they had been written to a single log file in commit order.
+ *
+ * Every commit record links to the commit right before it (see DurableWatermark), and the provider follows these links
+ * instead of sorting. The files are merged as a stream: a cursor reads each file a transaction at a time, and the
+ * cursor that is furthest behind in commit order is advanced until the next commit turns up. Only the transactions
+ * read ahead of the next commit are held in memory. If the next commit is in none of the files, its commit record was
+ * lost in a crash. No commit after it was durable, so replay stops there instead of replaying past the gap.
+ *
+ * Records of aborted transactions and of transactions that never committed are discarded, as recovery has nothing to
+ * replay for them.
+ */
+class MergingLogProvider : public AbstractLogProvider {
+ public:
+  /**
+   * @param log_file_path path of the log file passed to the LogManager
+   * @param num_log_streams number of log streams the LogManager wrote to
+   */
+  MergingLogProvider(const std::string &log_file_path, uint32_t num_log_streams);
+
+  /**
+   * Deletes the records read ahead but not handed out
+   */
+  ~MergingLogProvider() override;
+
+  /**
+   * @return next log record in commit order, along with vector of varlen entry pointers. nullptr log record if all log
+   * files are exhausted, or the next commit is missing from them
+   */
+  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() override;
+
+  /**
+   * @return true if the log files hold commits that were not handed out because a commit before them is missing
+   */
+  bool StoppedAtGap() const { return stopped_at_gap_; }
+
+ private:
+  using Record = std::pair<LogRecord *, std::vector<byte *>>;
+
+  /**
+   * Reads the transactions of one log file in the order their last records were written out
+   */
+  struct StreamCursor {
+    explicit StreamCursor(const std::string &file_path) : provider_(file_path) {}
+
+    DiskLogProvider provider_;
+    // Records of transactions that have not finished yet, by start timestamp
+    std::unordered_map<transaction::timestamp_t, std::vector<Record>> unfinished_;
+    // Commit timestamp of the last commit read from the file
+    transaction::timestamp_t position_ = transaction::INITIAL_TXN_TIMESTAMP;
+  };
+
+  /**
+   * Puts the cursor that is furthest behind on top of the heap
+   */
+  struct CursorBehind {
+    bool operator()(const StreamCursor *lhs, const StreamCursor *rhs) const { return lhs->position_ > rhs->position_; }
+  };
+
+  std::vector<std::unique_ptr<StreamCursor>> cursors_;
+  // Cursors of the files that have records left
+  std::priority_queue<StreamCursor *, std::vector<StreamCursor *>, CursorBehind> cursor_heap_;
+  // Committed transactions read ahead, by the commit they link to. Equal keys are only possible for the first commits
+  // of several chains, and stay in the order they were read.
+  std::multimap<transaction::timestamp_t, std::vector<Record>> read_ahead_;
+  // Commit timestamp of the last transaction handed out
+  transaction::timestamp_t last_commit_ = transaction::INVALID_TXN_TIMESTAMP;
+  // Records of the transaction being handed out, and the position of the next one
+  std::vector<Record> current_;
+  size_t current_record_ = 0;
+  bool stopped_at_gap_ = false;
+
+  /**
+   * Finds the transaction that committed right after the last one handed out, reading ahead in the files as needed
+   * @return true if it was found and moved to current_
+   */
+  bool NextTransaction();
+
+  /**
+   * Reads the file of a cursor until a transaction finishes. Committed transactions are added to read_ahead_.
+   * @param cursor cursor to advance
+   * @return false if the file has no records left
+   */
+  bool ReadTransaction(StreamCursor *cursor);
+
+  /**
+   * Frees the memory of records that are not handed out
+   * @param records records to free
+   */
+  static void DeleteRecords(std::vector<Record> *records);
+
+  /**
+   * All records are handed out by GetNextRecord
+   * @return true if there are records left to hand out
+   */
+  bool HasMoreRecords() override;
+
+  /**
+   * All records are handed out by GetNextRecord, which reads from the individual log files
+   * @return false
+   */
+  bool Read(void *dest, uint32_t size) override {
+    TERRIER_ASSERT(false, "MergingLogProvider does not read raw bytes");
+    return false;
+  }
+};
+
+}  // namespace terrier::storage
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -18,6 +20,7 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_owner.h"
+#include "common/worker_pool.h"
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/sql_table.h"
 
@@ -69,19 +72,28 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param deferred_action_manager manager to use for deferred deletes
    * @param thread_registry thread registry to register tasks
    * @param store block store used for SQLTable creation during recovery
+   * @param num_replay_threads number of worker threads used to replay changes to non-catalog tables. With a single
+   *                           thread, every transaction is replayed serially on the recovery task's thread
+   * @param checkpoint_provider provider for a checkpoint taken by the CheckpointManager, nullptr if there is none.
+   *                            The checkpoint is loaded first, and transactions in the log that it covers are skipped
    */
   explicit RecoveryManager(const common::ManagedPointer<AbstractLogProvider> log_provider,
                            const common::ManagedPointer<catalog::Catalog> catalog,
                            const common::ManagedPointer<transaction::TransactionManager> txn_manager,
                            const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
                            const common::ManagedPointer<terrier::common::DedicatedThreadRegistry> thread_registry,
-                           const common::ManagedPointer<BlockStore> store)
+                           const common::ManagedPointer<BlockStore> store, const uint32_t num_replay_threads = 1,
+                           const common::ManagedPointer<AbstractLogProvider> checkpoint_provider = nullptr)
       : DedicatedThreadOwner(thread_registry),
         log_provider_(log_provider),
+        checkpoint_provider_(checkpoint_provider),
         catalog_(catalog),
         txn_manager_(txn_manager),
         deferred_action_manager_(deferred_action_manager),
         block_store_(store),
+        replay_pool_(num_replay_threads > 1 ? std::make_unique<common::WorkerPool>(num_replay_threads,
+                                                                                  common::TaskQueue())
+                                            : nullptr),
         recovered_txns_(0) {
     // Initialize catalog_table_schemas_ map
     catalog_table_schemas_[catalog::postgres::CLASS_TABLE_OID] = catalog::postgres::Builder::GetClassTableSchema();
@@ -112,6 +124,12 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // Log provider for reading in logs
   const common::ManagedPointer<AbstractLogProvider> log_provider_;
 
+  // Log provider for reading in the checkpoint, nullptr if we recover from the logs alone
+  const common::ManagedPointer<AbstractLogProvider> checkpoint_provider_;
+
+  // Timestamp of the loaded checkpoint. Transactions that committed before it are already reflected in the checkpoint.
+  transaction::timestamp_t checkpoint_timestamp_ = transaction::INITIAL_TXN_TIMESTAMP;
+
   // Catalog to fetch table pointers
   const common::ManagedPointer<catalog::Catalog> catalog_;
 
@@ -145,6 +163,40 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // Background recovery task
   common::ManagedPointer<RecoveryTask> recovery_task_ = nullptr;
 
+  /**
+   * Everything a replay worker needs to apply changes to a non-catalog table without going through the catalog. The
+   * catalog is looked up once by the recovery task before the work is handed out, so that workers never contend on the
+   * database catalog's DDL lock.
+   */
+  struct PartitionedTableReplay {
+    // Table to replay changes into
+    common::ManagedPointer<SqlTable> table_;
+    // Oids of every column in the table, used to materialize deleted tuples for index maintenance
+    std::vector<catalog::col_oid_t> all_col_oids_;
+    // Indexes on the table and their schemas
+    std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> indexes_;
+    // Changes to this table, grouped by the committed txn they belong to, in serial order
+    std::vector<std::vector<LogRecord *>> txn_changes_;
+    // Tuple slot mappings created (or erased, if mapped to TupleSlot(nullptr, 0)) while replaying this table. Merged
+    // into tuple_slot_map_ once all workers are done, as tuple_slot_map_ is not safe for concurrent modification.
+    std::unordered_map<TupleSlot, TupleSlot> tuple_slot_changes_;
+  };
+
+  // Number of buffered records at which the pending batch of partitionable txns is replayed
+  static constexpr uint64_t PARTITIONED_REPLAY_BATCH_SIZE = 1 << 14;
+
+  // Worker pool used to replay changes to different tables in parallel, nullptr if replay is serial
+  std::unique_ptr<common::WorkerPool> replay_pool_;
+
+  // Committed transactions, in serial order, that only modify non-catalog tables and are waiting to be replayed in
+  // parallel. Catalog changes act as a barrier: the pending batch is replayed before any transaction that must be
+  // replayed serially.
+  std::vector<std::pair<transaction::timestamp_t, std::vector<std::pair<LogRecord *, std::vector<byte *>>>>>
+      pending_partitioned_txns_;
+
+  // Number of log records in pending_partitioned_txns_
+  uint64_t num_pending_partitioned_records_ = 0;
+
   // Its possible during recovery that the schemas for catalog tables may not yet exist in pg_class. Thus, we hardcode
   // them here
   std::unordered_map<catalog::table_oid_t, catalog::Schema> catalog_table_schemas_;
@@ -159,17 +211,58 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   void Recover() { RecoverFromLogs(); }
 
   /**
-   * Recovers the databases from the logs.
-   * @note this is a separate method so in the future, we can also have a RecoverFromCheckpoint method
+   * Recovers the databases from the checkpoint, if there is one, and then the logs.
    */
   void RecoverFromLogs();
 
+  /**
+   * Replays all the records from the given provider
+   * @param provider provider to read records from
+   * @return commit timestamp of the latest committed transaction read from the provider
+   */
+  transaction::timestamp_t ReplayLogRecords(common::ManagedPointer<AbstractLogProvider> provider);
+
   /**
    * @brief Replay a committed transaction corresponding to txn_id.
    * @param txn_id start timestamp for committed transaction
    */
   void ProcessCommittedTransaction(transaction::timestamp_t txn_id);
 
+  /**
+   * @param txn_id start timestamp for committed transaction
+   * @return true if the changes of the transaction can be replayed concurrently with other transactions' changes to
+   * different tables, i.e. the transaction only modifies non-catalog tables
+   */
+  bool IsPartitionableTransaction(transaction::timestamp_t txn_id);
+
+  /**
+   * Queues a committed transaction for parallel replay, replaying the pending batch if it has grown large enough
+   * @param txn_id start timestamp for committed transaction
+   */
+  void DeferPartitionedTransaction(transaction::timestamp_t txn_id);
+
+  /**
+   * Replays all the transactions queued for parallel replay. Changes are partitioned by table and each table is handed
+   * to a worker, which replays its changes in serial order. A committed transaction is replayed as one transaction per
+   * table it modified.
+   */
+  void ReplayPartitionedTransactions();
+
+  /**
+   * Replays all of a table's share of the pending batch. Called by replay workers.
+   * @param table_replay table to replay changes into
+   */
+  void ReplayPartitionedTable(PartitionedTableReplay *table_replay);
+
+  /**
+   * Looks up the new tuple slot for an old one on behalf of a replay worker, taking the worker's own changes to the
+   * mapping into account
+   * @param table_replay the worker's table
+   * @param slot old tuple slot
+   * @return new tuple slot, or TupleSlot(nullptr, 0) if there is no mapping
+   */
+  TupleSlot GetPartitionedTupleSlotMapping(const PartitionedTableReplay &table_replay, TupleSlot slot) const;
+
   /**
    * Defers log records deletes with the transaction manager
    * @param txn_id txn_id for txn who's records to delete
@@ -235,6 +328,22 @@ class RecoveryManager : public common::DedicatedThreadOwner {
                             catalog::table_oid_t table_oid, common::ManagedPointer<storage::SqlTable> table_ptr,
                             const TupleSlot &tuple_slot, ProjectedRow *table_pr, bool insert);
 
+  /**
+   * Inserts or deletes a tuple slot from the given indexes. Does not touch the catalog.
+   * @param txn transaction to update indexes with
+   * @param index_objects indexes to update and their schemas
+   * @param table_ptr pointer to sql table
+   * @param all_table_oids oids of all columns in the table, in the order of table_pr
+   * @param tuple_slot tuple slot to insert or delete
+   * @param table_pr pointer to PR with values of all columns for index update
+   * @param insert true if we should insert into indexes, false for delete
+   */
+  void UpdateIndexes(
+      transaction::TransactionContext *txn,
+      const std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> &index_objects,
+      common::ManagedPointer<storage::SqlTable> table_ptr, const std::vector<catalog::col_oid_t> &all_table_oids,
+      const TupleSlot &tuple_slot, ProjectedRow *table_pr, bool insert);
+
   /**
    * NYS = Not yet supported
    * Returns whether a delete or redo record is a special case catalog record. The special cases we consider are:
@@ -1,19 +1,58 @@
 #pragma once
 
+#include <condition_variable>  // NOLINT
+#include <deque>
 #include <memory>
+#include <mutex>  // NOLINT
+
+#include "network/network_io_utils.h"
 #include "storage/recovery/abstract_log_provider.h"
 
 namespace terrier::storage {
 
 /**
- * TODO(Tianlei/Gus): Replace this file with Gus's version
+ * @brief Log provider for logs shipped from a primary
+ * Provides the logs a primary's LogShipper sends over ITP to the recovery manager of a replica, which replays them as
+ * they arrive. Buffers are handed to the provider by the traffic cop in the order they were received, and together
+ * they form the primary's log file. Reads block until enough of the log has arrived, so recovery keeps running until
+ * the primary stops replication.
  */
-class ReplicationLogProvider {
+class ReplicationLogProvider : public AbstractLogProvider {
  public:
   /**
-   * Passes the content of the buffer to traffic cop
-   * @param buffer content to pass to traffic cop
+   * Appends a buffer of log data received from the primary to the log
+   * @param buffer content to pass to recovery
    */
   virtual void HandBufferToReplication(std::unique_ptr<network::ReadBuffer> buffer);
+
+  /**
+   * Signals that the primary will not ship any more logs. Recovery finishes once it has replayed the logs received so
+   * far.
+   */
+  void EndReplication();
+
+ private:
+  // Protects the fields below. Held while reading, so that Read can copy straight out of the received buffers.
+  std::mutex latch_;
+  // Notified when a buffer arrives or replication ends
+  std::condition_variable cv_;
+  // Received buffers that have not been read completely, in the order they were received
+  std::deque<std::unique_ptr<network::ReadBuffer>> buffers_;
+  // False once the primary has stopped replication
+  bool replication_active_ = true;
+
+  /**
+   * Blocks until more logs arrive or replication ends
+   * @return true if there are logs left to read, false if replication has ended and everything was read
+   */
+  bool HasMoreRecords() override;
+
+  /**
+   * Read data from the received logs into the destination provided, blocking until enough of the log has arrived
+   * @param dest pointer to location to read into
+   * @param size number of bytes to read
+   * @return true if we read the given number of bytes, false if replication ended before they arrived
+   */
+  bool Read(void *dest, uint32_t size) override;
 };
 }  // namespace terrier::storage
@@ -81,7 +81,8 @@ class SqlTable {
    *
    * @param txn the calling transaction
    * @param redo the desired change to be applied. This should be the after-image of the attributes of interest. The
-   * TupleSlot in this RedoRecord must be set to the intended tuple.
+   * TupleSlot in this RedoRecord must be set to the intended tuple. Varlen values the redo does not own only need to
+   * live until this call returns. See DataTable::Update.
    * @return true if successful, false otherwise
    */
   bool Update(const common::ManagedPointer<transaction::TransactionContext> txn, RedoRecord *const redo) const {
@@ -95,7 +96,9 @@ class SqlTable {
       // For MVCC correctness, this txn must now abort for the GC to clean up the version chain in the DataTable
       // correctly.
       txn->SetMustAbort();
+      return result;
     }
+    table_.data_table_->RepointVarlens(redo->GetTupleSlot(), redo->Delta());
     return result;
   }
 
@@ -104,7 +107,7 @@ class SqlTable {
    * called as well in order for the operation to be logged.
    *
    * @param txn the calling transaction
-   * @param redo after-image of the inserted tuple.
+   * @param redo after-image of the inserted tuple. Varlen values are treated the same as by Update.
    * @return TupleSlot for the inserted tuple
    */
   TupleSlot Insert(const common::ManagedPointer<transaction::TransactionContext> txn, RedoRecord *const redo) const {
@@ -114,10 +117,25 @@ class SqlTable {
                    "This RedoRecord is not the most recent entry in the txn's RedoBuffer. Was StageWrite called "
                    "immediately before?");
     const auto slot = table_.data_table_->Insert(txn, *(redo->Delta()));
+    table_.data_table_->RepointVarlens(slot, redo->Delta());
     redo->SetTupleSlot(slot);
     return slot;
   }
 
+  /**
+   * Inserts a batch of tuples, as given column-wise in the buffer, and writes the slots allocated for them to the
+   * TupleSlots of the buffer. See DataTable::InsertBatch. Unlike Insert, the RedoRecords of the tuples are staged by
+   * this method, one per tuple, so StageWrite must not be called for them.
+   *
+   * @param txn the calling transaction
+   * @param db_oid the database this table belongs to, for logging
+   * @param table_oid the oid of this table, for logging
+   * @param columns after-images of the inserted tuples, in the first NumTuples() rows. Should reference every column.
+   * Values of varlen columns are treated the same as by Insert.
+   */
+  void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn, catalog::db_oid_t db_oid,
+                   catalog::table_oid_t table_oid, ProjectedColumns *columns) const;
+
   /**
    * Deletes the given TupleSlot. StageDelete must have been called as well in order for the operation to be logged.
    * @param txn the calling transaction
@@ -169,10 +187,12 @@ class SqlTable {
    * @param txn The calling transaction.
    * @param start_pos Iterator to the starting location for the sequential scan.
    * @param out_buffer Output buffer. This buffer is always cleared of old values.
+   * @param block_filter Optional filter to skip frozen blocks with. See DataTable::Scan.
    */
   void Scan(const common::ManagedPointer<transaction::TransactionContext> txn, DataTable::SlotIterator *const start_pos,
-            execution::sql::VectorProjection *const out_buffer) const {
-    return table_.data_table_->Scan(txn, start_pos, out_buffer);
+            execution::sql::VectorProjection *const out_buffer,
+            const DataTable::FrozenBlockFilter &block_filter = nullptr) const {
+    return table_.data_table_->Scan(txn, start_pos, out_buffer, block_filter);
   }
 
   /**
@@ -243,6 +263,7 @@ class SqlTable {
 
  private:
   friend class RecoveryManager;  // Needs access to OID and ID mappings
+  friend class ArrowExportEndpoint;  // Exports the DataTable, with the types of its columns
   friend class terrier::RandomSqlTableTransaction;
   friend class terrier::LargeSqlTableTestObject;
   friend class RecoveryTests;
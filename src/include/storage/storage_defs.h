@@ -1,7 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <string_view>  // NOLINT
@@ -14,7 +16,10 @@
 #include "common/container/bitmap.h"
 #include "common/hash_util.h"
 #include "common/macros.h"
-#include "common/object_pool.h"
+#include "common/numa.h"
+#include "common/shared_latch.h"
+#include "common/spin_latch.h"
+#include "common/sharded_object_pool.h"
 #include "common/strong_typedef.h"
 #include "storage/block_access_controller.h"
 #include "transaction/transaction_defs.h"
@@ -45,6 +50,7 @@ constexpr col_id_t VERSION_POINTER_COLUMN_ID = col_id_t(0);
 constexpr uint8_t NUM_RESERVED_COLUMNS = 1;
 
 class DataTable;
+class VarlenArena;
 
 /**
  * A block is a chunk of memory used for storage. It does not have any meaning
@@ -61,10 +67,10 @@ class alignas(common::Constants::BLOCK_SIZE) RawBlock {
   DataTable *data_table_;
 
   /**
-   * Padding for flags or whatever we may want in the future. Determined by size of layout_version below. See
-   * tuple_access_strategy.h for more details on Block header layout.
+   * NUMA node the memory of this block is placed on, and the node of the BlockStore pool it returns to. Determined by
+   * size of layout_version below. See tuple_access_strategy.h for more details on Block header layout.
    */
-  uint16_t padding_;
+  uint16_t numa_node_;
 
   /**
    * Layout version.
@@ -85,11 +91,24 @@ class alignas(common::Constants::BLOCK_SIZE) RawBlock {
    */
   BlockAccessController controller_;
 
+  /**
+   * Arena holding the contents of varlen values the table copied into this block, or nullptr if it has not copied any
+   * since the block was last frozen. See VarlenArena.
+   */
+  std::atomic<VarlenArena *> varlen_arena_;
+
+  /**
+   * Number of slots in this block whose version pointer is not nullptr. Writers count a slot when they install the
+   * first version of its chain, and the GC stops counting it when it unlinks the whole chain. While this is 0, every
+   * transaction sees the current contents of the block, and scans can copy them without looking at version chains.
+   */
+  std::atomic<uint64_t> num_versioned_slots_;
+
   /**
    * Contents of the raw block.
    */
   byte content_[common::Constants::BLOCK_SIZE - sizeof(uintptr_t) - sizeof(uint16_t) - sizeof(layout_version_t) -
-                sizeof(uint32_t) - sizeof(BlockAccessController)];
+                sizeof(uint32_t) - sizeof(BlockAccessController) - sizeof(uintptr_t) - sizeof(uint64_t)];
   // A Block needs to always be aligned to 1 MB, so we can get free bytes to
   // store offsets within a block in one 8-byte word
 
@@ -170,15 +189,48 @@ class TupleSlot {
 };
 
 /**
- * Allocator that allocates a block
+ * Interface of components that provide the memory blocks are placed in, in place of the heap. See BlockEvictor, which
+ * places blocks in a single mapping of its swap file.
+ */
+class BlockArena {
+ public:
+  virtual ~BlockArena() = default;
+
+  /**
+   * @param numa_node the NUMA node to place the block on
+   * @return memory for a block, aligned to the block size, or nullptr if the arena is full
+   */
+  virtual void *AllocateBlock(uint16_t numa_node) = 0;
+
+  /**
+   * Gives back the memory of a block. Its contents are discarded.
+   * @param memory memory handed out by AllocateBlock
+   */
+  virtual void FreeBlock(void *memory) = 0;
+
+  /**
+   * @param memory start of the memory of a block
+   * @return true if the memory was handed out by AllocateBlock
+   */
+  virtual bool Contains(const void *memory) const = 0;
+};
+
+/**
+ * Allocator that allocates a block on a NUMA node, from a BlockArena if it has one and the arena is not full
  */
 class BlockAllocator {
  public:
+  /**
+   * @param numa_node the NUMA node to place blocks on
+   * @param arena the arena to allocate blocks from, or nullptr to allocate them on the heap
+   */
+  explicit BlockAllocator(uint16_t numa_node = 0, BlockArena *arena = nullptr) : numa_node_(numa_node), arena_(arena) {}
+
   /**
    * Allocates a new object by calling its constructor.
    * @return a pointer to the allocated object.
    */
-  RawBlock *New() { return new RawBlock(); }
+  RawBlock *New();
 
   /**
    * Reuse a reused chunk of memory to be handed out again
@@ -191,7 +243,11 @@ class BlockAllocator {
    * Deletes the object by calling its destructor.
    * @param ptr a pointer to the object to be deleted.
    */
-  void Delete(RawBlock *const ptr) { delete ptr; }
+  void Delete(RawBlock *ptr);
+
+ private:
+  uint16_t numa_node_;
+  BlockArena *arena_;
 };
 
 /** ColumnMapInfo maps between col_oids in Schema and useful information that we need about a Column in SqlTable. */
@@ -203,11 +259,177 @@ struct ColumnMapInfo {
 };
 
 /**
- * A block store is essentially an object pool. However, all blocks should be
- * aligned, so we will need to use the default constructor instead of raw
- * malloc.
+ * Where a BlockStore places the blocks it hands out
+ */
+enum class BlockPlacement : uint8_t {
+  /** On the NUMA node of the thread asking for the block, which is typically the one filling it */
+  LOCAL,
+  /** Round-robin over all NUMA nodes, to spread the memory bandwidth of tables every node scans over all of them */
+  INTERLEAVED
+};
+
+/**
+ * Interface of components that hold on to blocks of tables, and need to let go of them before the blocks are released
+ * back to their BlockStore and possibly handed out to another table. See BlockStore::RegisterReleaseListener.
  */
-using BlockStore = common::ObjectPool<RawBlock, BlockAllocator>;
+class BlockReleaseListener {
+ public:
+  virtual ~BlockReleaseListener() = default;
+
+  /**
+   * Invoked when a table releases its blocks, once no transaction can access them anymore and their contents are no
+   * longer needed. The blocks must not be referenced after this returns.
+   * @param blocks the blocks about to be released
+   */
+  virtual void OnRelease(const std::vector<RawBlock *> &blocks) = 0;
+};
+
+/**
+ * A block store is essentially an object pool. However, all blocks should be aligned, so we will need to use the
+ * default constructor instead of raw malloc.
+ *
+ * On NUMA machines, the block store keeps one pool per node, each of which gets an equal share of the size and reuse
+ * limits. Blocks return to the pool of the node they were placed on. A node that runs out of its share of blocks
+ * borrows from the other nodes, so the limits hold for the store as a whole.
+ */
+class BlockStore {
+ public:
+  /**
+   * @param size_limit the maximum number of blocks the block store hands out
+   * @param reuse_limit the maximum number of released blocks the block store keeps around for reuse
+   * @param placement where to place blocks that are not asked for on a particular node
+   * @param num_nodes number of NUMA nodes to spread blocks over
+   * @param arena the arena to allocate blocks from, or nullptr to allocate them on the heap. The arena must outlive the
+   *        block store.
+   */
+  BlockStore(uint64_t size_limit, uint64_t reuse_limit, BlockPlacement placement = BlockPlacement::LOCAL,
+             uint16_t num_nodes = common::NumaUtil::NumNodes(), BlockArena *arena = nullptr);
+
+  DISALLOW_COPY_AND_MOVE(BlockStore);
+
+  /**
+   * @throw NoMoreObjectException if the block store has reached the limit of how many blocks it may hand out.
+   * @throw AllocatorFailureException if the allocator fails to return a valid memory address.
+   * @return a block placed according to the placement policy of the block store
+   */
+  RawBlock *Get() { return Get(PlacementNode()); }
+
+  /**
+   * @param numa_node the NUMA node to place the block on, if it has any blocks left
+   * @throw NoMoreObjectException if the block store has reached the limit of how many blocks it may hand out.
+   * @throw AllocatorFailureException if the allocator fails to return a valid memory address.
+   * @return a block
+   */
+  RawBlock *Get(uint16_t numa_node);
+
+  /**
+   * Releases the given block, allowing it to be freed or reused for later.
+   * @param block the block to release
+   */
+  void Release(RawBlock *const block) {
+    TERRIER_ASSERT(block->numa_node_ < pools_.size(), "block was not handed out by this block store");
+    pools_[block->numa_node_]->Release(block);
+  }
+
+  /**
+   * Notifies the release listeners of the given blocks, and then releases them, allowing them to be freed or reused for
+   * later.
+   * @param blocks the blocks to release
+   */
+  void Release(const std::vector<RawBlock *> &blocks);
+
+  /**
+   * Registers a listener to notify whenever blocks are released in bulk, which is how tables give back their blocks.
+   * Listeners are notified in the order they were registered. The listener must be unregistered before it is destroyed.
+   * @param listener the listener to register
+   */
+  void RegisterReleaseListener(BlockReleaseListener *listener);
+
+  /**
+   * Stops notifying the given listener of released blocks. Once this returns, the listener is not invoked anymore.
+   * @param listener the listener to unregister
+   */
+  void UnregisterReleaseListener(BlockReleaseListener *listener);
+
+  /**
+   * Set the block store's size limit. The operation fails if the block store has already handed out more blocks than
+   * the size limit, counting released blocks it keeps around for reuse. Blocks spill over between NUMA nodes, so only
+   * the total counts: nodes that hold more than their share of the new limit keep their blocks, and the other nodes get
+   * correspondingly less.
+   * @param new_size the new size limit
+   * @return true if new_size is successfully set and false the operation fails
+   */
+  bool SetSizeLimit(uint64_t new_size);
+
+  /**
+   * Set the reuse limit to a new value. This function always succeeds and immediately changes reuse limit.
+   * @param new_reuse_limit the new reuse limit
+   */
+  void SetReuseLimit(uint64_t new_reuse_limit);
+
+  /**
+   * Sets whether tables copy the varlen values they are handed into per-block arenas (see VarlenArena), rather than
+   * allocating every value separately. Arenas are only reclaimed when their blocks are frozen, so this should only be
+   * turned on when the BlockCompactor runs. Off by default.
+   * @param value whether to use varlen arenas
+   */
+  void SetUseVarlenArenas(const bool value) { use_varlen_arenas_ = value; }
+
+  /**
+   * @return whether tables copy varlen values into per-block arenas
+   */
+  bool UseVarlenArenas() const { return use_varlen_arenas_; }
+
+  /**
+   * @return size limit of the block store
+   */
+  uint64_t GetSizeLimit() const { return size_limit_; }
+
+  /**
+   * @return number of blocks handed out by the block store that have not been released back to it
+   */
+  uint64_t GetNumObjectsInUse() const;
+
+  /**
+   * @return number of NUMA nodes the block store spreads blocks over
+   */
+  uint16_t NumNodes() const { return static_cast<uint16_t>(pools_.size()); }
+
+  /**
+   * @return the NUMA node whose blocks the calling thread should insert into, or NumaUtil::ANY_NODE if it does not
+   * matter because there is only one node, blocks are interleaved anyway, or the node of the thread has handed out its
+   * share of blocks and new blocks come from other nodes
+   */
+  uint16_t InsertionNode() const {
+    if (placement_ != BlockPlacement::LOCAL || pools_.size() == 1) return common::NumaUtil::ANY_NODE;
+    const auto numa_node = static_cast<uint16_t>(common::NumaUtil::CurrentNode() % pools_.size());
+    const auto &pool = pools_[numa_node];
+    return pool->GetNumObjectsInUse() < pool->GetSizeLimit() ? numa_node : common::NumaUtil::ANY_NODE;
+  }
+
+ private:
+  const BlockPlacement placement_;
+  std::vector<std::unique_ptr<common::ShardedObjectPool<RawBlock, BlockAllocator>>> pools_;
+  std::atomic<uint64_t> size_limit_;
+  // Serializes changes to the size limit
+  common::SpinLatch size_latch_;
+  std::atomic<uint16_t> next_node_{0};
+  std::atomic<bool> use_varlen_arenas_{false};
+  // Taken exclusively to change the listeners, and shared while notifying them
+  common::SharedLatch listeners_latch_;
+  std::vector<BlockReleaseListener *> release_listeners_;
+
+  uint16_t PlacementNode() {
+    if (pools_.size() == 1) return 0;
+    if (placement_ == BlockPlacement::INTERLEAVED) return static_cast<uint16_t>(next_node_++ % pools_.size());
+    return static_cast<uint16_t>(common::NumaUtil::CurrentNode() % pools_.size());
+  }
+
+  // Share of the given limit the pool of the given node gets
+  uint64_t NodeShare(uint64_t limit, uint16_t numa_node) const {
+    return limit / pools_.size() + (numa_node < limit % pools_.size() ? 1 : 0);
+  }
+};
 /**
  * Used by SqlTable to map between col_oids in Schema and useful necessary information.
  */
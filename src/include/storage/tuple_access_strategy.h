@@ -45,9 +45,11 @@ class TupleAccessStrategy {
   /*
    * Block Header layout:
    * -----------------------------------------------------------------------------------------------------------------
-   * | data_table *(64) | padding (16) | layout_version (16) | insert_head (32) |        control_block (64)          |
+   * | data_table *(64) | numa_node (16) | layout_version (16) | insert_head (32) | control_block (64) | arena *(64) |
    * -----------------------------------------------------------------------------------------------------------------
-   * | ArrowBlockMetadata | attr_offsets[num_col] (32) | bitmap for slots (64-bit aligned) | data (64-bit aligned)   |
+   * | num_versioned_slots (64) | ArrowBlockMetadata | attr_offsets[num_col] (32) | bitmap for slots (64-bit aligned) |
+   * -----------------------------------------------------------------------------------------------------------------
+   * | data (64-bit aligned)                                                                                         |
    * -----------------------------------------------------------------------------------------------------------------
    *
    * Note that we will never need to span a tuple across multiple pages if we enforce
@@ -221,6 +223,15 @@ class TupleAccessStrategy {
    */
   bool Allocate(RawBlock *block, TupleSlot *slot) const;
 
+  /**
+   * Allocates up to the given number of consecutive slots for new tuples, starting at the insertion head of the block.
+   * @param block block to allocate slots in.
+   * @param max_slots the maximum number of slots to allocate
+   * @param[out] start offset of the first allocated slot
+   * @return the number of slots allocated, which is 0 if the block is full.
+   */
+  uint32_t AllocateRange(RawBlock *block, uint32_t max_slots, uint32_t *start) const;
+
   /**
    * @param block the block to access
    * @return pointer to the allocation bitmap of the block
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+
+#include "common/macros.h"
+#include "common/spin_latch.h"
+#include "common/strong_typedef.h"
+
+namespace terrier::storage {
+
+/**
+ * Bump allocator for the contents of the varlen values of one block. Values are never freed individually. The whole
+ * arena is freed at once, when the block is frozen and its values are gathered into Arrow buffers, or when its table
+ * is dropped. Tables only use arenas if their BlockStore says so, which it should only when the BlockCompactor runs.
+ *
+ * Values are packed into chunks of CHUNK_SIZE bytes, except values too large to share a chunk, which get a chunk of
+ * their own. Since the space of overwritten values is only reclaimed along with the whole arena, an arena stops
+ * handing out memory once it holds MAX_SIZE bytes, and the table falls back to allocating values separately.
+ *
+ * Thread-safe. Transactions writing to different tuples of a block allocate from the same arena.
+ */
+class VarlenArena {
+ public:
+  /**
+   * Size of a chunk that values are packed into
+   */
+  static constexpr uint32_t CHUNK_SIZE = 1 << 16;
+
+  /**
+   * Largest value packed into shared chunks. Larger values get a chunk of their own, so that they do not waste the
+   * remainder of the current chunk.
+   */
+  static constexpr uint32_t MAX_PACKED_SIZE = CHUNK_SIZE / 4;
+
+  /**
+   * Most bytes of values an arena holds before it refuses to allocate any more
+   */
+  static constexpr uint64_t MAX_SIZE = 1 << 22;
+
+  VarlenArena() = default;
+
+  /**
+   * Frees all chunks of the arena, and with them every value ever allocated from it.
+   */
+  ~VarlenArena() {
+    for (byte *chunk : chunks_) delete[] chunk;
+  }
+
+  DISALLOW_COPY_AND_MOVE(VarlenArena);
+
+  /**
+   * @param size size of the value in bytes
+   * @return pointer to size bytes of memory, aligned to 8 bytes, that lives as long as the arena, or nullptr if the
+   * arena has reached MAX_SIZE
+   */
+  byte *Allocate(uint32_t size);
+
+  /**
+   * @param ptr pointer to check
+   * @return whether the pointer points into memory handed out by this arena
+   */
+  bool Contains(const byte *ptr) const;
+
+  /**
+   * @return number of bytes held by the chunks of the arena, including unused space at the end of chunks
+   */
+  uint64_t Size() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return size_;
+  }
+
+ private:
+  mutable common::SpinLatch latch_;
+  // Chunks in allocation order, along with their sizes. The last shared chunk is the one values are packed into.
+  std::vector<byte *> chunks_;
+  std::vector<uint32_t> chunk_sizes_;
+  byte *current_chunk_ = nullptr;
+  uint32_t current_used_ = CHUNK_SIZE;
+  uint64_t size_ = 0;
+
+  byte *NewChunk(uint32_t size);
+};
+
+}  // namespace terrier::storage
@@ -5,8 +5,11 @@
 #include "common/container/concurrent_blocking_queue.h"
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
+#include "common/managed_pointer.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/durable_watermark.h"
 #include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_shipper.h"
 
 namespace terrier::storage {
 
@@ -23,18 +26,25 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
    * @param buffers pointer to list of all buffers used by log manager, used to persist log file
    * @param empty_buffer_queue pointer to queue to push empty buffers to
    * @param filled_buffer_queue pointer to queue to pop filled buffers from
+   * @param durable_watermark tracks the commits persisted by every log stream, which decides when commit callbacks are
+   * invoked
+   * @param log_shipper if given, everything written to the log file is shipped to a replica once it is persisted
    */
   explicit DiskLogConsumerTask(const std::chrono::microseconds persist_interval, uint64_t persist_threshold,
                                std::vector<BufferedLogWriter> *buffers,
                                common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
-                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue)
+                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
+                               const common::ManagedPointer<DurableWatermark> durable_watermark,
+                               const common::ManagedPointer<LogShipper> log_shipper = nullptr)
       : run_task_(false),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
         current_data_written_(0),
         buffers_(buffers),
         empty_buffer_queue_(empty_buffer_queue),
-        filled_buffer_queue_(filled_buffer_queue) {}
+        filled_buffer_queue_(filled_buffer_queue),
+        durable_watermark_(durable_watermark),
+        log_shipper_(log_shipper) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -52,6 +62,8 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   bool run_task_;
   // Stores callbacks for commit records written to disk but not yet persisted
   std::vector<storage::CommitCallback> commit_callbacks_;
+  // Filled buffers dequeued in the current round, flushed to the log file together in one vectored write
+  std::vector<BufferedLogWriter *> write_batch_;
 
   // Interval time for when to persist log file
   const std::chrono::microseconds persist_interval_;
@@ -66,9 +78,20 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue_;
   // The queue containing filled buffers. Task should dequeue filled buffers from this queue to flush
   common::ConcurrentQueue<SerializedLogs> *filled_buffer_queue_;
+  // Invokes the commit callbacks once the commits before them are persisted by every log stream
+  const common::ManagedPointer<DurableWatermark> durable_watermark_;
+  // Ships the log to a replica, nullptr if the log is not replicated
+  const common::ManagedPointer<LogShipper> log_shipper_;
+  // Log data written to the log file since the last persist, shipped to the replica once it is persisted
+  std::vector<byte> unshipped_logs_;
+  // Log data persisted by the last persist, shipped to the replica once persist_lock_ is released
+  std::vector<byte> persisted_logs_;
 
   // Flag used by the serializer thread to signal the disk log consumer task thread to persist the data on disk
   volatile bool do_persist_;
+  // File descriptor of the log file to switch over to after the next persist, set by the LogManager when it rotates the
+  // log file. -1 if no switch is pending. Protected by persist_lock_
+  int new_log_file_fd_ = -1;
 
   // Synchronisation primitives to synchronise persisting buffers to disk
   std::mutex persist_lock_;
@@ -84,15 +107,23 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   void DiskLogConsumerTaskLoop();
 
   /**
-   * Flush all buffers in the filled buffers queue to the log file
+   * Flush all buffers in the filled buffers queue to the log file. Buffers available at the same time are grouped into
+   * a single vectored write.
    */
   void WriteBuffersToLogFile();
 
   /*
-   * Persists the log file on disk by calling fsync, as well as calling callbacks for all committed transactions that
-   * were persisted
+   * Persists the log file on disk by calling fsync, as well as handing the commits that were persisted to the
+   * DurableWatermark, which calls their callbacks once they are durable, and handing the persisted logs over to
+   * ShipPersistedLogs
    * @return number of buffers persisted, used for metrics
    */
   uint64_t PersistLogFile();
+
+  /**
+   * Ships the logs persisted by the last call to PersistLogFile to the replica. Must not be called while holding
+   * persist_lock_, since shipping waits on the replica.
+   */
+  void ShipPersistedLogs();
 };
 }  // namespace terrier::storage
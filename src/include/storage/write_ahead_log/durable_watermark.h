@@ -0,0 +1,69 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "common/spin_latch.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "transaction/transaction_defs.h"
+
+namespace terrier::transaction {
+class TimestampManager;
+}  // namespace terrier::transaction
+
+namespace terrier::storage {
+
+/**
+ * Tracks which commits are durable across all the log streams of a LogManager. Every stream persists its log file on
+ * its own schedule, so a transaction's commit record can be persisted before the commit record of a transaction it read
+ * from, which went to another stream. A commit is durable only once the commit records of all transactions that
+ * committed before it are persisted, whichever stream they went to. Commit callbacks are held back until then.
+ *
+ * Updating transactions check out their commit timestamps through the DurableWatermark, which remembers them until
+ * their commit records are persisted. It also links every commit to the commit before it, so that recovery can tell
+ * whether a commit record is missing from the log (see MergingLogProvider).
+ */
+class DurableWatermark {
+ public:
+  /**
+   * Checks out the commit timestamp of an updating transaction. Its commit record must be handed to the log, and
+   * eventually passed to Persisted, or no later commit ever becomes durable.
+   * @param timestamp_manager timestamp manager to check out the timestamp from
+   * @param[out] previous_commit commit timestamp of the updating transaction that committed right before, or
+   * INVALID_TXN_TIMESTAMP if this is the first commit since the last call to StartNewChain
+   * @return the commit timestamp
+   */
+  transaction::timestamp_t CheckOutCommitTimestamp(transaction::TimestampManager *timestamp_manager,
+                                                   transaction::timestamp_t *previous_commit);
+
+  /**
+   * Marks the given commits as persisted, and invokes the callbacks of every persisted commit that is now durable. This
+   * includes commits persisted by other streams earlier, which were waiting on the given ones. Called by the consumer
+   * tasks of all log streams.
+   * @param commits commits whose commit records were just persisted. Cleared once they are handed over.
+   */
+  void Persisted(std::vector<CommitCallback> *commits);
+
+  /**
+   * Starts a new chain of commits. The next commit is not linked to the commits before it, so that a log file started
+   * afterwards can be replayed on its own.
+   */
+  void StartNewChain() {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    last_commit_ = transaction::INVALID_TXN_TIMESTAMP;
+  }
+
+ private:
+  // Protects all of the members below
+  common::SpinLatch latch_;
+  // Commit timestamps of updating transactions whose commit records are not persisted yet
+  std::set<transaction::timestamp_t> unpersisted_commits_;
+  // Callbacks of persisted commits that wait for an earlier commit to be persisted, by commit timestamp
+  std::multimap<transaction::timestamp_t, std::pair<transaction::callback_fn, void *>> waiting_callbacks_;
+  // Commit timestamp of the last commit checked out
+  transaction::timestamp_t last_commit_ = transaction::INVALID_TXN_TIMESTAMP;
+};
+
+}  // namespace terrier::storage
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/hash_util.h"
+#include "common/strong_typedef.h"
+#include "storage/storage_defs.h"
+#include "storage/write_ahead_log/log_record.h"
+
+namespace terrier::storage {
+
+/**
+ * Marks the start of a compressed frame in the log. A record in the regular log format starts with its size, which can
+ * never be this large, so a reader can tell frames and regular records apart and read logs that mix the two.
+ *
+ * A frame is laid out as follows:
+ *  | COMPRESSED_LOG_FRAME_MARKER (32) | raw size (32) | compressed size (32) | compressed bytes |
+ * If the compressed size equals the raw size, the bytes are stored uncompressed. Once decompressed, a frame holds a
+ * sequence of whole records in the compact format written by CompactLogEncoder.
+ */
+constexpr uint32_t COMPRESSED_LOG_FRAME_MARKER = UINT32_MAX;
+
+/**
+ * Static utility class for the compact log format
+ */
+class LogCompressionUtil {
+ public:
+  LogCompressionUtil() = delete;
+
+  /**
+   * Compresses the given bytes with a fast LZ77 codec in the style of LZ4. The output is a sequence of literal runs,
+   * each followed by a back-reference of at least 4 bytes into the last 64KB of output, except for the last run.
+   * @param src bytes to compress
+   * @param size number of bytes to compress
+   * @param[out] out vector to append the compressed bytes to
+   */
+  static void Compress(const byte *src, uint32_t size, std::vector<byte> *out);
+
+  /**
+   * Decompresses bytes compressed by Compress
+   * @param src compressed bytes
+   * @param size number of compressed bytes
+   * @param[out] dest location to decompress to, must be at least raw_size bytes
+   * @param raw_size number of bytes the input decompresses to
+   * @return false if the input is corrupted, i.e. it does not decompress to exactly raw_size bytes
+   */
+  static bool Decompress(const byte *src, uint32_t size, byte *dest, uint32_t raw_size);
+
+  /**
+   * Appends an unsigned integer in LEB128 variable length encoding: 7 bits per byte, with the high bit set on every
+   * byte but the last. Small values, such as oids and timestamps early in the life of the database, take only a few
+   * bytes.
+   * @param value value to append
+   * @param[out] out vector to append to
+   */
+  static void AppendVarint(uint64_t value, std::vector<byte> *out) {
+    while (value >= 0x80) {
+      out->push_back(static_cast<byte>((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    out->push_back(static_cast<byte>(value));
+  }
+
+  /**
+   * Reads an unsigned integer appended by AppendVarint
+   * @param src bytes to read from
+   * @param size number of bytes in src
+   * @param[in,out] offset position to read at, advanced past the integer
+   * @param[out] value the integer read
+   * @return false if src ends before the integer does
+   */
+  static bool ReadVarint(const byte *src, const uint32_t size, uint32_t *const offset, uint64_t *const value) {
+    *value = 0;
+    for (uint32_t shift = 0; *offset < size && shift < 64; shift += 7) {
+      const auto next = static_cast<uint8_t>(src[(*offset)++]);
+      *value |= static_cast<uint64_t>(next & 0x7F) << shift;
+      if ((next & 0x80) == 0) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @tparam T integral, enum or strong typedef type
+   * @param value value to convert
+   * @return value as an unsigned integer for varint encoding
+   */
+  template <class T>
+  static uint64_t ToVarint(const T &value) {
+    if constexpr (std::is_enum_v<T>) {
+      return static_cast<uint64_t>(value);
+    } else if constexpr (std::is_integral_v<T>) {
+      return static_cast<uint64_t>(value);
+    } else {
+      return static_cast<uint64_t>(value.UnderlyingValue());
+    }
+  }
+
+  /**
+   * @tparam T integral, enum or strong typedef type
+   * @param value unsigned integer read from a varint
+   * @return value converted back to T
+   */
+  template <class T>
+  static T FromVarint(const uint64_t value) {
+    if constexpr (std::is_enum_v<T> || std::is_integral_v<T>) {
+      return static_cast<T>(value);
+    } else {
+      return T(static_cast<std::decay_t<decltype(std::declval<T>().UnderlyingValue())>>(value));
+    }
+  }
+};
+
+/**
+ * Encodes log records in the compact log format and groups them into compressed frames. Compared to the regular log
+ * format, the compact format:
+ *    1. Writes integer header fields (sizes, timestamps, oids, column ids) as varints instead of at fixed width
+ *    2. Writes a varlen value that is repeated within a frame as a reference to its first occurrence
+ *    3. Compresses each frame as a whole with LogCompressionUtil::Compress
+ * Every frame is self-contained, so a reader does not need to have seen earlier frames to decode one.
+ *
+ * Not thread-safe.
+ */
+class CompactLogEncoder {
+ public:
+  /**
+   * Appends a record to the current frame
+   * @param record the record to encode
+   * @return bytes encoded, before compression. Used for metrics
+   */
+  uint64_t Encode(const LogRecord &record);
+
+  /**
+   * @return size of the current frame before compression
+   */
+  uint32_t FrameSize() const { return static_cast<uint32_t>(frame_.size()); }
+
+  /**
+   * Compresses the current frame and writes it out, then starts a new frame. Does nothing if the frame is empty.
+   * @tparam Sink type of the destination to write to. Must provide uint32_t WriteValue(const void *val, uint32_t size)
+   * @param sink the destination to write to
+   * @return bytes written
+   */
+  template <class Sink>
+  uint64_t WriteFrame(Sink *const sink) {
+    if (frame_.empty()) return 0;
+    LogCompressionUtil::Compress(frame_.data(), FrameSize(), &compressed_);
+    // Store the frame as is if it doesn't compress
+    const bool compressed = compressed_.size() < frame_.size();
+    const auto &contents = compressed ? compressed_ : frame_;
+    const uint32_t header[3] = {COMPRESSED_LOG_FRAME_MARKER, FrameSize(), static_cast<uint32_t>(contents.size())};
+    uint64_t num_bytes = sink->WriteValue(header, sizeof(header));
+    num_bytes += sink->WriteValue(contents.data(), static_cast<uint32_t>(contents.size()));
+
+    frame_.clear();
+    compressed_.clear();
+    varlens_.clear();
+    varlen_index_.clear();
+    return num_bytes;
+  }
+
+ private:
+  // Compact records of the current frame
+  std::vector<byte> frame_;
+  // Scratch space to compress the frame into
+  std::vector<byte> compressed_;
+  // Offset into frame_ and size of every varlen value written out in full in the current frame, in order. A repeated
+  // value is encoded as its index in this list.
+  std::vector<std::pair<uint32_t, uint32_t>> varlens_;
+  // Hash of a varlen value to its index in varlens_. Only the latest value with a given hash is kept, and a match is
+  // confirmed by comparing the contents.
+  std::unordered_map<common::hash_t, uint32_t> varlen_index_;
+
+  template <class T>
+  void AppendField(const T &value) {
+    LogCompressionUtil::AppendVarint(LogCompressionUtil::ToVarint(value), &frame_);
+  }
+
+  void AppendBytes(const void *src, const uint32_t size) {
+    const auto *bytes = reinterpret_cast<const byte *>(src);
+    frame_.insert(frame_.end(), bytes, bytes + size);
+  }
+
+  void AppendVarlen(const VarlenEntry &entry);
+};
+
+}  // namespace terrier::storage
@@ -73,6 +73,27 @@ struct PosixIoWrappers {
    * @throws runtime_error if the underlying posix call failed
    */
   static void WriteFully(int fd, const void *buf, size_t nbyte);
+
+  /**
+   * Wrapper around the posix writev call, where a single function call will always write all of the given buffers out.
+   * (unlike posix writev, which can write arbitrarily many bytes less than the given amount, and which is limited to
+   * IOV_MAX buffers per call)
+   * @param fd posix fildes arg
+   * @param iov posix iov arg. The array is modified in place to keep track of partial writes, and its contents are
+   *            unspecified after the call returns
+   * @param iovcnt posix iovcnt arg
+   * @throws runtime_error if the underlying posix call failed
+   * @return total number of bytes written
+   */
+  static uint64_t WriteVectorFully(int fd, struct iovec *iov, size_t iovcnt);
+
+  /**
+   * Wrapper around the posix fdatasync call (fsync on platforms without fdatasync). File data and the metadata needed
+   * to read it back (i.e. the file size) are on stable storage when this call returns.
+   * @param fd posix fildes arg
+   * @throws runtime_error if the underlying posix call failed
+   */
+  static void SyncData(int fd);
 };
 // TODO(Tianyu):  we need control over when and what to flush as the log manager. Thus, we need to write our
 // own wrapper around lower level I/O functions. I could be wrong, and in that case we should
@@ -119,12 +140,27 @@ class BufferedLogWriter {
   }
 
   /**
-   * Call fsync to make sure that all writes are consistent.
+   * Write to the log file the given amount of bytes from the given location in memory. Unlike BufferWrite, the buffer
+   * is flushed whenever it fills up, so the whole value is always written. Only safe to use when this writer is the
+   * only one writing to the file, e.g. when writing out a checkpoint.
+   * @param val memory location of the bytes to write
+   * @param size number of bytes to write
+   * @return number of bytes written
    */
-  void Persist() {
-    if (fsync(out_) == -1) throw std::runtime_error("fsync failed with errno " + std::to_string(errno));
+  uint32_t WriteValue(const void *val, uint32_t size) {
+    uint32_t size_written = 0;
+    while (size_written < size) {
+      size_written += BufferWrite(reinterpret_cast<const char *>(val) + size_written, size - size_written);
+      if (IsBufferFull()) FlushBuffer();
+    }
+    return size;
   }
 
+  /**
+   * Call fdatasync to make sure that all writes are consistent.
+   */
+  void Persist() { PosixIoWrappers::SyncData(out_); }
+
   /**
    * Flush any buffered writes.
    * @return amount of data flushed
@@ -136,11 +172,36 @@ class BufferedLogWriter {
     return size;
   }
 
+  /**
+   * Flush the buffered writes of all the given writers with a single vectored write, in the order they are given. All
+   * writers must be writing to the same log file. This amortizes the cost of the write syscall across a group of
+   * filled buffers instead of paying it once per buffer.
+   * @param writers writers whose buffers to flush. Must not be empty
+   * @return amount of data flushed
+   */
+  static uint64_t FlushBuffers(const std::vector<BufferedLogWriter *> &writers);
+
+  /**
+   * Switch this writer over to the given file. Buffered writes that have not been flushed yet will go to the new file.
+   * @param fd file descriptor of the new file. The writer keeps its own duplicate, so the caller still owns fd
+   * @throws runtime_error if the underlying posix call failed
+   */
+  void SwitchLogFile(int fd);
+
   /**
    * @return if the buffer is full
    */
   bool IsBufferFull() { return buffer_size_ == common::Constants::LOG_BUFFER_SIZE; }
 
+  /**
+   * Copies the buffered writes that have not been flushed yet to the end of the given vector
+   * @param[out] out vector to append to
+   */
+  void CopyBufferTo(std::vector<byte> *const out) const {
+    const auto *const begin = reinterpret_cast<const byte *>(buffer_);
+    out->insert(out->end(), begin, begin + buffer_size_);
+  }
+
  private:
   int out_;  // fd of the output files
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
@@ -217,9 +278,23 @@ class BufferedLogReader {
 };
 
 /**
- * Callback function and arguments to be called when record is persisted
+ * Callback function and arguments to be called when a commit record is durable, along with the commit timestamp of the
+ * transaction
  */
-using CommitCallback = std::pair<transaction::callback_fn, void *>;
+struct CommitCallback {
+  /**
+   * Function to call
+   */
+  transaction::callback_fn callback_;
+  /**
+   * Argument to pass to the function
+   */
+  void *callback_arg_;
+  /**
+   * Commit timestamp of the transaction
+   */
+  transaction::timestamp_t commit_time_;
+};
 
 /**
  * A BufferedLogWriter containing serialized logs, as well as all commit callbacks for transaction's whose commit are
@@ -14,8 +14,10 @@
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/record_buffer.h"
+#include "storage/write_ahead_log/durable_watermark.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
+#include "storage/write_ahead_log/log_shipper.h"
 
 namespace terrier::storage {
 
@@ -37,7 +39,12 @@ class DiskLogConsumerTask;
  *          b) Periodically
  *          c) A sufficient amount of data has been written since the last persist
  *      5. When the persist is done, the `DiskLogConsumerTask` will call the commit callbacks for any CommitRecords that
- * were just persisted.
+ * were just persisted, once every transaction that committed before them is persisted too (see DurableWatermark).
+ *
+ * The LogManager can write to multiple log files (streams) in parallel, each with its own buffers, serializer task and
+ * consumer task, so that a single serializer thread does not bound the logging throughput. All the records of a
+ * transaction go to the same stream, picked by a hash of its start timestamp. Records are ordered within a stream but
+ * not across streams; the MergingLogProvider puts them back into commit order at recovery time.
  */
 class LogManager : public common::DedicatedThreadOwner {
  public:
@@ -53,11 +60,19 @@ class LogManager : public common::DedicatedThreadOwner {
    * @param buffer_pool the object pool to draw log buffers from. This must be the same pool transactions draw their
    *                    buffers from
    * @param thread_registry DedicatedThreadRegistry dependency injection
+   * @param num_log_streams Number of log files to write to in parallel. The first stream is written to log_file_path,
+   *                        the others to the paths given by LogStreamFilePath
+   * @param compress_logs true if records should be written in the compact log format, in compressed frames. Log
+   *                      providers read either format
+   * @param log_shipper if given, the log is shipped to a replica as it is persisted. Requires a single log stream, as the
+   *                    replica replays the log in the order it is received
    */
   LogManager(std::string log_file_path, uint64_t num_buffers, std::chrono::microseconds serialization_interval,
              std::chrono::microseconds persist_interval, uint64_t persist_threshold,
              common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
-             common::ManagedPointer<terrier::common::DedicatedThreadRegistry> thread_registry)
+             common::ManagedPointer<terrier::common::DedicatedThreadRegistry> thread_registry,
+             uint32_t num_log_streams = 1, bool compress_logs = false,
+             common::ManagedPointer<LogShipper> log_shipper = nullptr)
       : DedicatedThreadOwner(thread_registry),
         run_log_manager_(false),
         log_file_path_(std::move(log_file_path)),
@@ -65,9 +80,17 @@ class LogManager : public common::DedicatedThreadOwner {
         buffer_pool_(buffer_pool.Get()),
         serialization_interval_(serialization_interval),
         persist_interval_(persist_interval),
-        persist_threshold_(persist_threshold) {}
+        persist_threshold_(persist_threshold),
+        compress_logs_(compress_logs),
+        log_shipper_(log_shipper) {
+    TERRIER_ASSERT(num_log_streams > 0, "LogManager needs at least one log stream");
+    TERRIER_ASSERT(log_shipper == nullptr || num_log_streams == 1, "Log shipping needs a single log stream");
+    for (uint32_t i = 0; i < num_log_streams; i++)
+      streams_.emplace_back(std::make_unique<LogStream>(LogStreamFilePath(log_file_path_, i)));
+  }
+
   /**
-   * Starts log manager. Does the following in order:
+   * Starts log manager. Does the following in order for every log stream:
    *    1. Initialize buffers to pass serialized logs to log consumers
    *    2. Starts up DiskLogConsumerTask
    *    3. Starts up LogSerializerTask
@@ -83,7 +106,19 @@ class LogManager : public common::DedicatedThreadOwner {
   void ForceFlush();
 
   /**
-   * Persists all unpersisted logs and stops the log manager. Does what Start() does in reverse order:
+   * Moves the current log file to the given path and continues logging to a new, empty log file at the original path.
+   * With multiple log streams, the file of every stream is moved to the matching LogStreamFilePath of archive_path.
+   * Every log record handed to the consumer tasks before this call returns is persisted in the moved files. This is
+   * used by checkpointing to truncate the log: once a checkpoint covers all the transactions in the moved files, they
+   * can be deleted.
+   * @param archive_path path to move the current log file to. An existing file at this path is replaced
+   * @throws runtime_error if the log file could not be moved or the new log file could not be created
+   */
+  void RotateLogFile(const std::string &archive_path);
+
+  /**
+   * Persists all unpersisted logs and stops the log manager. Does what Start() does in reverse order for every log
+   * stream:
    *    1. Stops LogSerializerTask
    *    2. Stops DiskLogConsumerTask
    *    3. Closes all open buffers
@@ -100,25 +135,55 @@ class LogManager : public common::DedicatedThreadOwner {
    */
   void AddBufferToFlushQueue(RecordBufferSegment *buffer_segment);
 
+  /**
+   * Checks out the commit timestamp of an updating transaction, see DurableWatermark::CheckOutCommitTimestamp. The
+   * transaction's commit record must be handed to the log manager afterwards.
+   * @param timestamp_manager timestamp manager to check out the timestamp from
+   * @param[out] previous_commit commit timestamp of the updating transaction that committed right before, to be
+   * written out in the commit record
+   * @return the commit timestamp
+   */
+  transaction::timestamp_t CheckOutCommitTimestamp(transaction::TimestampManager *timestamp_manager,
+                                                   transaction::timestamp_t *previous_commit) {
+    return durable_watermark_.CheckOutCommitTimestamp(timestamp_manager, previous_commit);
+  }
+
   /**
    * For testing only
-   * @return number of buffers used for logging
+   * @return number of buffers used for logging by each log stream
    */
   uint64_t TestGetNumBuffers() { return num_buffers_; }
 
   /**
-   * Set the number of buffers used for buffering logs. The operation fails if the LogManager has already allocated more
-   * buffers than the new size
+   * @return number of log files the log manager writes to in parallel
+   */
+  uint32_t NumLogStreams() const { return static_cast<uint32_t>(streams_.size()); }
+
+  /**
+   * @param log_file_path path of the log file passed to the LogManager
+   * @param stream index of a log stream
+   * @return path of the log file the given stream writes to. The first stream writes to log_file_path itself, so a
+   * single stream log is read back as before
+   */
+  static std::string LogStreamFilePath(const std::string &log_file_path, const uint32_t stream) {
+    return stream == 0 ? log_file_path : log_file_path + "." + std::to_string(stream);
+  }
+
+  /**
+   * Set the number of buffers used by each log stream for buffering logs. The operation fails if the LogManager has
+   * already allocated more buffers than the new size
    *
-   * @param new_num_buffers the new number of buffers the log manager can use
+   * @param new_num_buffers the new number of buffers each log stream can use
    * @return true if new_num_buffers is successfully set and false the operation fails
    */
   bool SetNumBuffers(uint64_t new_num_buffers) {
     if (new_num_buffers >= num_buffers_) {
       // Add in new buffers
-      for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
-        buffers_.emplace_back(BufferedLogWriter(log_file_path_.c_str()));
-        empty_buffer_queue_.Enqueue(&buffers_[num_buffers_ + i]);
+      for (auto &stream : streams_) {
+        for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
+          stream->buffers_.emplace_back(BufferedLogWriter(stream->file_path_.c_str()));
+          stream->empty_buffer_queue_.Enqueue(&stream->buffers_[num_buffers_ + i]);
+        }
       }
       num_buffers_ = new_num_buffers;
       return true;
@@ -127,42 +192,58 @@ class LogManager : public common::DedicatedThreadOwner {
   }
 
  private:
+  /**
+   * The buffers, queues and tasks that serialize and write out the records handed to one log stream
+   */
+  struct LogStream {
+    explicit LogStream(std::string file_path) : file_path_(std::move(file_path)) {}
+
+    // System path for the log file of this stream
+    const std::string file_path_;
+    // This stores a reference to all the buffers the serializer or the log consumer threads use
+    std::vector<BufferedLogWriter> buffers_;
+    // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
+    // serializer thread should block when requesting a new buffer until it receives an empty buffer
+    common::ConcurrentBlockingQueue<BufferedLogWriter *> empty_buffer_queue_;
+    // The queue containing filled buffers pending flush to the disk
+    common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+    // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
+    common::ManagedPointer<LogSerializerTask> log_serializer_task_ =
+        common::ManagedPointer<LogSerializerTask>(nullptr);
+    // The log consumer task which flushes filled buffers to the disk
+    common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
+        common::ManagedPointer<DiskLogConsumerTask>(nullptr);
+  };
+
   // Flag to tell us when the log manager is running or during termination
   bool run_log_manager_;
 
   // System path for log file
   std::string log_file_path_;
 
-  // Number of buffers to use for buffering and serializing logs
+  // Number of buffers each log stream uses for buffering and serializing logs
   uint64_t num_buffers_;
 
-  // TODO(Tianyu): This can be changed later to be include things that are not necessarily backed by a disk
-  //  (e.g. logs can be streamed out to the network for remote replication)
   RecordBufferSegmentPool *buffer_pool_;
 
-  // This stores a reference to all the buffers the serializer or the log consumer threads use
-  std::vector<BufferedLogWriter> buffers_;
-  // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
-  // serializer thread should block when requesting a new buffer until it receives an empty buffer
-  common::ConcurrentBlockingQueue<BufferedLogWriter *> empty_buffer_queue_;
-  // The queue containing filled buffers pending flush to the disk
-  common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+  // Log streams written to in parallel. Streams are heap allocated because the tasks keep pointers to their queues
+  std::vector<std::unique_ptr<LogStream>> streams_;
 
-  // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
-  common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
   // Interval used by log serialization task
   const std::chrono::microseconds serialization_interval_;
-
-  // The log consumer task which flushes filled buffers to the disk
-  common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
-      common::ManagedPointer<DiskLogConsumerTask>(nullptr);
   // Interval used by disk consumer task
   const std::chrono::microseconds persist_interval_;
   // Threshold used by disk consumer task
   uint64_t persist_threshold_;
+  // Whether log serialization tasks write the compact log format
+  const bool compress_logs_;
+  // Ships the log to a replica, nullptr if the log is not replicated
+  const common::ManagedPointer<LogShipper> log_shipper_;
+  // Holds back commit callbacks until the commits before them are persisted by every stream
+  DurableWatermark durable_watermark_;
 
   /**
-   * If the central registry wants to removes our thread used for the disk log consumer task, we only allow removal if
+   * If the central registry wants to removes our threads used for the log stream tasks, we only allow removal if
    * we are in shut down, else we need to keep the task, so we reject the removal
    * @return true if we allowed thread to be removed, else false
    */
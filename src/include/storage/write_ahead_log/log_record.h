@@ -287,6 +287,8 @@ class CommitRecord {
    * @param txn pointer to the committing transaction
    * @param timestamp_manager pointer to timestamp manager who provided timestamp to txn. Used to notify of
    * serialization
+   * @param previous_commit commit timestamp of the updating txn that committed right before this one, see
+   * DurableWatermark
    * @return pointer to the initialized log record, always equal in value to the given head
    */
   // TODO(Tianyu): txn should contain a lot of the information here. Maybe we can simplify the function.
@@ -295,13 +297,15 @@ class CommitRecord {
                                const transaction::timestamp_t txn_commit, transaction::callback_fn commit_callback,
                                void *commit_callback_arg, const transaction::timestamp_t oldest_active_txn,
                                const bool is_read_only, transaction::TransactionContext *const txn,
-                               transaction::TimestampManager *const timestamp_manager) {
+                               transaction::TimestampManager *const timestamp_manager,
+                               const transaction::timestamp_t previous_commit = transaction::INVALID_TXN_TIMESTAMP) {
     auto *result = LogRecord::InitializeHeader(head, LogRecordType::COMMIT, Size(), txn_begin);
     auto *body = result->GetUnderlyingRecordBodyAs<CommitRecord>();
     body->txn_commit_ = txn_commit;
     body->commit_callback_ = commit_callback;
     body->commit_callback_arg_ = commit_callback_arg;
     body->oldest_active_txn_ = oldest_active_txn;
+    body->previous_commit_ = previous_commit;
     body->timestamp_manager_ = timestamp_manager;
     body->txn_ = txn;
     body->is_read_only_ = is_read_only;
@@ -318,6 +322,12 @@ class CommitRecord {
    */
   transaction::timestamp_t OldestActiveTxn() const { return oldest_active_txn_; }
 
+  /**
+   * @return the commit time of the updating transaction that committed right before this one, whichever log stream it
+   * went to. INVALID_TXN_TIMESTAMP if it starts a new chain of commits (see DurableWatermark)
+   */
+  transaction::timestamp_t PreviousCommit() const { return previous_commit_; }
+
   /**
    * @return function pointer of the transaction commit callback. Not necessarily populated if read back in from disk.
    */
@@ -348,6 +358,7 @@ class CommitRecord {
   transaction::callback_fn commit_callback_;
   void *commit_callback_arg_;
   transaction::timestamp_t oldest_active_txn_;
+  transaction::timestamp_t previous_commit_;
   // TODO(TIanyu): Can replace the other arguments
   // More specifically, commit timestamp and read_only can be inferred from looking inside the transaction context
   transaction::TransactionContext *txn_;
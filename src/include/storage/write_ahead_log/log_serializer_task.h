@@ -10,6 +10,7 @@
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
 #include "storage/record_buffer.h"
+#include "storage/write_ahead_log/log_compression.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
 
@@ -27,15 +28,17 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    * @param empty_buffer_queue pointer to queue to pop empty buffers from
    * @param filled_buffer_queue pointer to queue to push filled buffers to
    * @param disk_log_writer_thread_cv pointer to condition variable to notify consumer when a new buffer has handed over
+   * @param compress_logs true if records should be written in the compact log format (see CompactLogEncoder)
    */
   explicit LogSerializerTask(const std::chrono::microseconds serialization_interval,
                              RecordBufferSegmentPool *buffer_pool,
                              common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
                              common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
-                             std::condition_variable *disk_log_writer_thread_cv)
+                             std::condition_variable *disk_log_writer_thread_cv, const bool compress_logs = false)
       : run_task_(false),
         serialization_interval_(serialization_interval),
         buffer_pool_(buffer_pool),
+        compress_logs_(compress_logs),
         filled_buffer_(nullptr),
         empty_buffer_queue_(empty_buffer_queue),
         filled_buffer_queue_(filled_buffer_queue),
@@ -59,6 +62,17 @@ class LogSerializerTask : public common::DedicatedThreadTask {
     run_task_ = false;
   }
 
+  /**
+   * Serialize out the record in the on-disk log format
+   * @tparam Sink type of the destination to serialize to. Must provide uint32_t WriteValue(const void *val, uint32_t
+   *              size), which writes out size bytes starting at val.
+   * @param record the record to serialize
+   * @param sink the destination to serialize to
+   * @return bytes serialized, used for metrics
+   */
+  template <class Sink>
+  static uint64_t SerializeRecord(const LogRecord &record, Sink *sink);
+
   /**
    * Hands a (possibly partially) filled buffer to the serializer task to be serialized
    * @param buffer_segment the (perhaps partially) filled log buffer ready to be consumed
@@ -74,6 +88,7 @@ class LogSerializerTask : public common::DedicatedThreadTask {
 
  private:
   friend class LogManager;
+  friend class CompactLogEncoder;
   // Flag to signal task to run or stop
   bool run_task_;
   // Interval for serialization
@@ -82,6 +97,17 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   // Used to release processed buffers
   RecordBufferSegmentPool *buffer_pool_;
 
+  // Size a compressed frame grows to before we write it out. Larger frames compress better, but every frame is written
+  // out at the end of Process anyway so that commits are not held back.
+  static constexpr uint32_t COMPRESSED_FRAME_SIZE = 1 << 15;
+  // Whether records are written in the compact log format
+  const bool compress_logs_;
+  // Encodes records into compressed frames when compress_logs_ is set
+  CompactLogEncoder encoder_;
+  // Commit callbacks for commit records in the current frame. They are moved to commits_in_buffer_ once the frame is
+  // written out, so that they are not invoked before the buffer holding the end of the frame is persisted.
+  std::vector<CommitCallback> commits_in_frame_;
+
   // Ensures only one thread is serializing at a time.
   common::SpinLatch serialization_latch_;
 
@@ -102,7 +128,7 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   // Current buffer we are serializing logs to
   BufferedLogWriter *filled_buffer_;
   // Commit callbacks for commit records currently in filled_buffer
-  std::vector<std::pair<transaction::callback_fn, void *>> commits_in_buffer_;
+  std::vector<CommitCallback> commits_in_buffer_;
 
   // Used by the serializer thread to store buffers it has grabbed from the log manager
   std::queue<RecordBufferSegment *> temp_flush_queue_;
@@ -142,21 +168,16 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   std::tuple<uint64_t, uint64_t, uint64_t> SerializeBuffer(IterableBufferSegment<LogRecord> *buffer_to_serialize);
 
   /**
-   * Serialize out the record to the log
-   * @param record the redo record to serialise
-   * @return bytes serialized, used for metrics
-   */
-  uint64_t SerializeRecord(const LogRecord &record);
-
-  /**
-   * Serialize the data pointed to by val to current serialization buffer
+   * Serialize the data pointed to by val to the given sink
+   * @tparam Sink type of the destination to serialize to
    * @tparam T Type of the value
+   * @param sink the destination to serialize to
    * @param val The value to write to the buffer
    * @return bytes written, used for metrics
    */
-  template <class T>
-  uint32_t WriteValue(const T &val) {
-    return WriteValue(&val, sizeof(T));
+  template <class Sink, class T>
+  static uint32_t SerializeValue(Sink *sink, const T &val) {
+    return sink->WriteValue(&val, sizeof(T));
   }
 
   /**
@@ -167,6 +188,18 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    */
   uint32_t WriteValue(const void *val, uint32_t size);
 
+  /**
+   * Serialize out the record to the current serialization buffer, or to the current frame if logs are compressed
+   * @param record the record to serialize
+   * @return bytes serialized, used for metrics
+   */
+  uint64_t WriteRecord(const LogRecord &record);
+
+  /**
+   * Compresses the current frame and writes it out to the current serialization buffer, along with its commit callbacks
+   */
+  void WriteFrame();
+
   /**
    * Returns the current buffer to serialize logs to
    * @return buffer to write to
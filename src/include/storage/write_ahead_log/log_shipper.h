@@ -0,0 +1,157 @@
+#pragma once
+
+#include <netinet/in.h>
+
+#include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "network/network_io_wrapper.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::storage {
+
+/**
+ * A LogShipper streams the write-ahead log to a replica over the internal (ITP) protocol. The DiskLogConsumerTask hands
+ * it the bytes it writes to the log file once they are persisted, so the replica never sees changes the primary could
+ * lose in a crash. On the replica, ITP replication commands are handed to a ReplicationLogProvider, from which a
+ * RecoveryManager replays the log continuously.
+ *
+ * The replica does not have to be up when the primary starts. The shipper connects to it in the background, retrying
+ * until the replica accepts the connection, and holds back the logs it is handed in the meantime. They are sent ahead
+ * of the next logs shipped once the replica is connected. If the replica does not connect before too much log is held
+ * back, shipping stops.
+ *
+ * Shipping is asynchronous: a commit is acknowledged once it is persisted locally, without waiting for the replica to
+ * receive it. A replica that stops reading stalls the consumer task once the socket buffers are full, but only for up
+ * to the send timeout, after which the shipper gives up on it. If the connection to the replica breaks or times out,
+ * shipping stops and the replica has to be rebuilt from a checkpoint or the primary's log files.
+ *
+ * Not thread-safe. A LogShipper is only used by the consumer task of a single log stream.
+ */
+class LogShipper {
+ public:
+  /**
+   * Starts connecting to the replica in the background
+   * @param replica_host IPv4 address of the replica
+   * @param replica_port port the replica listens on for replication
+   * @param send_timeout how long to wait for the replica to read from a full socket before stopping replication
+   * @param retry_interval how long to wait between attempts to connect to the replica
+   * @param max_backlog most bytes of log to hold back until the replica connects, before stopping replication
+   * @throws runtime_error if the replica address is invalid
+   */
+  LogShipper(const std::string &replica_host, uint16_t replica_port,
+             std::chrono::milliseconds send_timeout = std::chrono::milliseconds(10000),
+             std::chrono::milliseconds retry_interval = std::chrono::milliseconds(1000),
+             uint64_t max_backlog = DEFAULT_MAX_BACKLOG);
+
+  /**
+   * Tells the replica that replication has stopped, if it has not been stopped already
+   */
+  ~LogShipper();
+
+  DISALLOW_COPY_AND_MOVE(LogShipper);
+
+  /**
+   * Sends a chunk of the log to the replica, or holds it back if the replica has not connected yet. Blocks until the
+   * chunk is handed to the socket.
+   * @param data log bytes, as written to the log file
+   * @param size number of bytes
+   */
+  void ShipLogs(const byte *data, uint64_t size);
+
+  /**
+   * Tells the replica that no more logs will follow and closes the connection. If the replica has not connected yet,
+   * it is given one last chance to, so that it gets the logs held back for it. The replica finishes replaying the log
+   * it has received. Logs shipped afterwards are dropped.
+   */
+  void StopReplication();
+
+  /**
+   * @return true if logs are still being shipped to the replica, or held back until it connects
+   */
+  bool Replicating() const { return !stopped_; }
+
+  /**
+   * Safe to call from any thread
+   * @return true if the replica has accepted the connection
+   */
+  bool Connected() const { return connected_; }
+
+ private:
+  // Largest amount of log data sent in a single replication command, well under the packet size limit of the protocol
+  static constexpr uint64_t MAX_COMMAND_SIZE = 1 << 20;
+  // Default for the most log held back for a replica that has not connected yet
+  static constexpr uint64_t DEFAULT_MAX_BACKLOG = 1 << 26;
+
+  struct sockaddr_in replica_addr_;
+  // How long the replica may go without reading from a full socket
+  const std::chrono::milliseconds send_timeout_;
+  const std::chrono::milliseconds retry_interval_;
+  const uint64_t max_backlog_;
+  // Connection to the replica, nullptr until the replica connects and once replication has stopped
+  std::unique_ptr<network::NetworkIoWrapper> io_;
+  // Logs handed to the shipper before the replica connected
+  std::vector<byte> backlog_;
+  // True once replication has stopped, or the shipper gave up on the replica
+  bool stopped_ = false;
+  // Id of the next replication command, see ITPPacketWriter::BeginReplicationCommand
+  uint64_t next_message_id_ = 0;
+
+  // Socket connected to the replica by the connection thread that io_ has not taken over yet, or -1
+  std::atomic<int> connected_fd_{-1};
+  std::atomic<bool> connected_{false};
+  // Protects run_connect_, which tells the connection thread to give up
+  std::mutex connect_latch_;
+  std::condition_variable connect_cv_;
+  bool run_connect_ = true;
+  std::thread connect_thread_;
+
+  /**
+   * Tries to connect to the replica until it succeeds or StopConnecting is called. Run by the connection thread.
+   */
+  void ConnectLoop();
+
+  /**
+   * Tries to connect to the replica once, waiting at most the retry interval for it to accept
+   * @return the connected socket, or -1 if the replica could not be reached
+   */
+  int Connect() const;
+
+  /**
+   * Stops the connection thread and waits for it to finish
+   */
+  void StopConnecting();
+
+  /**
+   * Takes over the socket of the connection thread if the replica has connected, and sends it the logs held back
+   */
+  void AdoptConnection();
+
+  /**
+   * Holds back logs until the replica connects, or stops replication if that would hold back too much
+   * @param data log bytes
+   * @param size number of bytes
+   */
+  void HoldBack(const byte *data, uint64_t size);
+
+  /**
+   * Sends logs on the connection to the replica, in commands of at most MAX_COMMAND_SIZE
+   * @param data log bytes
+   * @param size number of bytes
+   */
+  void Send(const byte *data, uint64_t size);
+
+  /**
+   * Writes out everything queued up on the connection, waiting for the socket to drain as needed. Stops replication if
+   * the replica has gone away, or has not read anything for the send timeout.
+   */
+  void Flush();
+};
+
+}  // namespace terrier::storage
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -67,19 +68,23 @@ class TrafficCop {
   /**
    * @param txn_manager the transaction manager of the system
    * @param catalog the catalog of the system
-   * @param replication_log_provider if given, the tcop will forward replication logs to this provider
+   * @param replication_log_provider if given, the tcop will forward replication logs to this provider, and only serve
+   * read-only queries because the database is a replica
    * @param settings_manager the settings manager
    * @param stats_storage for optimizer calls
    * @param optimizer_timeout for optimizer calls
    * @param use_query_cache whether to cache physical plans and generated code for Extended Query protocol
    * @param execution_mode how to run executable queries after code generation
+   * @param synchronous_commit whether commits of new connections wait for their log records to be persisted before they
+   * are acknowledged
    */
   TrafficCop(common::ManagedPointer<transaction::TransactionManager> txn_manager,
              common::ManagedPointer<catalog::Catalog> catalog,
              common::ManagedPointer<storage::ReplicationLogProvider> replication_log_provider,
              common::ManagedPointer<settings::SettingsManager> settings_manager,
              common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
-             bool use_query_cache, const execution::vm::ExecutionMode execution_mode)
+             bool use_query_cache, const execution::vm::ExecutionMode execution_mode,
+             const bool synchronous_commit = true)
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_log_provider_(replication_log_provider),
@@ -87,7 +92,8 @@ class TrafficCop {
         stats_storage_(stats_storage),
         optimizer_timeout_(optimizer_timeout),
         use_query_cache_(use_query_cache),
-        execution_mode_(execution_mode) {}
+        execution_mode_(execution_mode),
+        synchronous_commit_(synchronous_commit) {}
 
   virtual ~TrafficCop() = default;
 
@@ -98,10 +104,23 @@ class TrafficCop {
   void HandBufferToReplication(std::unique_ptr<network::ReadBuffer> buffer);
 
   /**
-   * Create a temporary namespace for a connection
+   * Tells replication that the primary will not ship any more logs
+   */
+  void StopReplication();
+
+  /**
+   * @return true if the database is a replica that receives its changes from a primary and only serves read-only
+   * queries
+   */
+  bool IsReplica() const { return replication_log_provider_ != DISABLED; }
+
+  /**
+   * Create a temporary namespace for a connection. A read-only replica does not create one, as its catalog only changes
+   * by replaying the log of its primary.
    * @param connection_id the unique connection ID to use for the namespace name
    * @param database_name the name of the database the connection is accessing
-   * @return a pair of OIDs for the database and the temporary namespace
+   * @return a pair of OIDs for the database and the temporary namespace. The namespace OID is INVALID_NAMESPACE_OID
+   * on a replica.
    */
   std::pair<catalog::db_oid_t, catalog::namespace_oid_t> CreateTempNamespace(network::connection_id_t connection_id,
                                                                              const std::string &database_name);
@@ -228,6 +247,19 @@ class TrafficCop {
    */
   void SetOptimizerTimeout(const uint64_t optimizer_timeout) { optimizer_timeout_ = optimizer_timeout; }
 
+  /**
+   * Adjust whether commits of new connections wait for their log records to be persisted (for use by SettingsManager).
+   * Without waiting, a commit is acknowledged as soon as it is visible, and the log manager persists it within its
+   * persist interval. Connections change this for themselves with SET synchronous_commit.
+   * @param synchronous_commit true to wait for the commit to be persisted, false to acknowledge it immediately
+   */
+  void SetSynchronousCommit(const bool synchronous_commit) { synchronous_commit_ = synchronous_commit; }
+
+  /**
+   * @return true if commits of new connections wait for their log records to be persisted before they are acknowledged
+   */
+  bool SynchronousCommit() const { return synchronous_commit_; }
+
   /**
    * @return true if query caching enabled, false otherwise
    */
@@ -243,6 +275,7 @@ class TrafficCop {
   uint64_t optimizer_timeout_;
   const bool use_query_cache_;
   const execution::vm::ExecutionMode execution_mode_;
+  std::atomic<bool> synchronous_commit_;
 };
 
 }  // namespace terrier::trafficcop
@@ -13,6 +13,11 @@ namespace terrier::trafficcop {
  */
 static constexpr std::string_view TEMP_NAMESPACE_PREFIX = "pg_temp_";
 
+/**
+ * Name of the parameter that connections SET for themselves to control whether their commits wait for the log
+ */
+static constexpr std::string_view SYNCHRONOUS_COMMIT_PARAMETER = "synchronous_commit";
+
 enum class ResultType : uint8_t { COMPLETE, ERROR, NOTICE, NOOP, QUEUING, UNKNOWN };
 
 /**
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <algorithm>
-#include <unordered_set>
+#include <array>
+#include <atomic>
+#include <set>
 #include <vector>
 
+#include "common/constants.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "transaction/transaction_defs.h"
@@ -17,12 +19,18 @@ namespace terrier::transaction {
 class TransactionManager;
 /**
  * Generates timestamps, and keeps track of the lifetime of transactions (whether they have entered or left the system)
+ *
+ * The set of running txns is split into shards. A thread begins all of its txns in the same shard, so beginning a txn
+ * only takes a latch that is private to the thread unless the GC or the log serializer is visiting the shard at the
+ * same time.
  */
 class TimestampManager {
  public:
   ~TimestampManager() {
-    TERRIER_ASSERT(curr_running_txns_.empty(),
-                   "Destroying the TimestampManager while txns are still running. That seems wrong.");
+    for (UNUSED_ATTRIBUTE const auto &shard : running_txns_) {
+      TERRIER_ASSERT(shard.txns_.empty(),
+                     "Destroying the TimestampManager while txns are still running. That seems wrong.");
+    }
   }
 
   /**
@@ -39,47 +47,61 @@ class TimestampManager {
    * Get the oldest transaction alive (by start timestamp given out by this timestamp manager at this time)
    * Because of concurrent operations, it is not guaranteed that upon return the txn is still alive. However,
    * it is guaranteed that the return timestamp is older than any transactions live.
-   * @warning If logging is enabled, txns are not removed from the txn set until they are serialized. Thus, the active
-   * txn set can grow greatly in size, making this call expensive. Consider using CachedOldestTransactionStartTime for
-   * better peformance at the cost of a more stale timestamp.
+   * @warning This call takes the latch of every shard of the running txn set in turn. Consider using
+   * CachedOldestTransactionStartTime for better peformance at the cost of a more stale timestamp.
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t OldestTransactionStartTime();
 
   /**
    * Get the cached timestamp of the oldest active txn. The cached timestamp is only refreshed upon every invocation of
-   * OldestTransactionStartTime, so it may be stale. On the other hand, this function does not require taking a latch or
-   * iterating through the running txns set, making it much cheaper than OldestTransactionStartTime. This has the same
-   * correctness guarantee as OldestTransactionStartTime, but may cause performance degradations for processes that rely
-   * on very fresh oldest txn timestamps
+   * OldestTransactionStartTime, so it may be stale. On the other hand, this function does not require taking any
+   * latches, making it much cheaper than OldestTransactionStartTime. This has the same correctness guarantee as
+   * OldestTransactionStartTime, but may cause performance degradations for processes that rely on very fresh oldest txn
+   * timestamps
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t CachedOldestTransactionStartTime();
 
  private:
-  // TransactionManager needs to be able to use the curr_running_txns_latch to guard more than just the
-  // duration of the following method calls --- things such as adding to the GC queue needs to be atomic
-  // along with removing a transaction from the table of active transactions. We need this for correctness
-  // in the deferred action framework when dropping tables.
   friend class TransactionManager;
   friend class storage::LogSerializerTask;
+
+  // Number of shards the running txn set is split into. More shards than threads beginning txns do not help, but
+  // make OldestTransactionStartTime and RemoveTransactions visit more shards.
+  static constexpr uint32_t NUM_RUNNING_TXN_SHARDS = 32;
+
+  /**
+   * Running txns of the threads assigned to this shard
+   */
+  struct alignas(common::Constants::CACHELINE_SIZE) RunningTxnShard {
+    // Protects txns_
+    common::SpinLatch latch_;
+    // Start times of the running txns, ordered so that the oldest one is always at the front
+    std::set<timestamp_t> txns_;
+  };
+
+  /**
+   * @return index of the shard the calling thread begins its txns in. Threads are assigned shards round-robin the
+   * first time they begin a txn.
+   */
+  static uint32_t ThreadShard() {
+    static std::atomic<uint32_t> next_shard{0};
+    thread_local const uint32_t shard = next_shard++ % NUM_RUNNING_TXN_SHARDS;
+    return shard;
+  }
+
   timestamp_t BeginTransaction() {
-    timestamp_t start_time;
-    {
-      common::SpinLatch::ScopedSpinLatch running_guard(&curr_running_txns_latch_);
-      // There is a three-way race that needs to be prevented.  Specifically, we
-      // cannot allow both a transaction to commit and the GC to poll for the
-      // oldest running transaction in between this transaction acquiring its
-      // begin timestamp and getting inserted into the current running
-      // transactions list.  Using the current running transactions latch
-      // prevents the GC from polling and stops the race.  This allows us to
-      // replace acquiring a shared instance of the commit latch with a
-      // read-only spin-latch and move the allocation out of a critical section.
-      start_time = time_++;
-
-      const auto ret UNUSED_ATTRIBUTE = curr_running_txns_.emplace(start_time);
-      TERRIER_ASSERT(ret.second, "commit start time should be globally unique");
-    }  // Release latch on current running transactions
+    RunningTxnShard &shard = running_txns_[ThreadShard()];
+    common::SpinLatch::ScopedSpinLatch running_guard(&shard.latch_);
+    // There is a three-way race that needs to be prevented. Specifically, we cannot allow both a transaction to commit
+    // and the GC to poll for the oldest running transaction in between this transaction acquiring its begin timestamp
+    // and getting inserted into the running transactions set. OldestTransactionStartTime reads the clock before it
+    // visits any shard, so checking out the start time under the shard's latch guarantees that if the GC does not see
+    // this transaction in the shard, it read the clock before this transaction began.
+    const timestamp_t start_time = time_++;
+    // Start times are handed out in increasing order, so this is almost always an append
+    shard.txns_.emplace_hint(shard.txns_.end(), start_time);
     return start_time;
   }
 
@@ -90,7 +112,7 @@ class TimestampManager {
   void RemoveTransaction(timestamp_t timestamp);
 
   /**
-   * Bulk remove a set of timestamps from the active txn set. Only grabs the curr_running_txns_latch_ once for all the
+   * Bulk remove a set of timestamps from the active txn set. Grabs the latch of every shard at most once for all the
    * timestamps.
    * @param timestamps vector of timestamps to remove
    */
@@ -101,11 +123,8 @@ class TimestampManager {
   std::atomic<timestamp_t> time_{INITIAL_TXN_TIMESTAMP};
   // We cache the oldest txn start time
   std::atomic<timestamp_t> cached_oldest_txn_start_time_{INITIAL_TXN_TIMESTAMP};
-  // TODO(Matt): consider a different data structure if this becomes a measured bottleneck
-  // TODO(Gus): This data structure initially only held items in the order of # of workers. With the logging change, it
-  // can hold many more, since txns are only removed when serialized. We should consider if there is a possible better
-  // data structure
-  std::unordered_set<timestamp_t> curr_running_txns_;
-  mutable common::SpinLatch curr_running_txns_latch_;
+  // Start times of the running txns. With logging enabled, txns are only removed once they are serialized, so this can
+  // hold many more txns than there are workers.
+  std::array<RunningTxnShard, NUM_RUNNING_TXN_SHARDS> running_txns_;
 };
 }  // namespace terrier::transaction
@@ -42,12 +42,16 @@ class TransactionContext {
    * MVCC semantics
    * @param buffer_pool the buffer pool to draw this transaction's undo buffer from
    * @param log_manager pointer to log manager in the system, or nullptr, if logging is disabled
+   * @param prune_horizon timestamp older than every transaction alive when this transaction began, see PruneHorizon.
+   * Defaults to the initial timestamp, which turns off pruning on the access path.
    */
   TransactionContext(const timestamp_t start, const timestamp_t finish,
                      const common::ManagedPointer<storage::RecordBufferSegmentPool> buffer_pool,
-                     const common::ManagedPointer<storage::LogManager> log_manager)
+                     const common::ManagedPointer<storage::LogManager> log_manager,
+                     const timestamp_t prune_horizon = INITIAL_TXN_TIMESTAMP)
       : start_time_(start),
         finish_time_(finish),
+        prune_horizon_(prune_horizon),
         undo_buffer_(buffer_pool.Get()),
         redo_buffer_(log_manager.Get(), buffer_pool.Get()) {}
 
@@ -74,6 +78,14 @@ class TransactionContext {
    */
   timestamp_t StartTime() const { return start_time_; }
 
+  /**
+   * Undo records committed before this timestamp are invisible to every transaction that is or will be alive from now
+   * on, because the oldest transaction alive only ever gets younger. DataTable uses it to prune the version chains
+   * this transaction touches without waiting for the garbage collector.
+   * @return a (possibly stale) lower bound on the start time of every running transaction as of this one's start
+   */
+  timestamp_t PruneHorizon() const { return prune_horizon_; }
+
   /**
    * @return finish time of this transaction if it has been aborted or logged as a commit. Otherwise, current
    * MVCC semantics define it as StartTime + INT64_MIN. TransactionContexts generated outside of the TransactionManager
@@ -214,6 +226,7 @@ class TransactionContext {
   friend class storage::RecoveryTests;           // Needs access to redo buffer
   const timestamp_t start_time_;
   std::atomic<timestamp_t> finish_time_;
+  const timestamp_t prune_horizon_;
   storage::UndoBuffer undo_buffer_;
   storage::RedoBuffer redo_buffer_;
   // TODO(Tianyu): Maybe not so much of a good idea to do this. Make explicit queue in GC?
@@ -88,12 +88,14 @@ class TransactionManager {
 
   bool gc_enabled_ = false;
   TransactionQueue completed_txns_;
+  // Protects completed_txns_
+  common::SpinLatch completed_txns_latch_;
   const common::ManagedPointer<storage::LogManager> log_manager_;
 
-  timestamp_t UpdatingCommitCriticalSection(TransactionContext *txn);
+  timestamp_t UpdatingCommitCriticalSection(TransactionContext *txn, timestamp_t *previous_commit);
 
   void LogCommit(TransactionContext *txn, timestamp_t commit_time, transaction::callback_fn commit_callback,
-                 void *commit_callback_arg, timestamp_t oldest_active_txn);
+                 void *commit_callback_arg, timestamp_t oldest_active_txn, timestamp_t previous_commit);
 
   void LogAbort(TransactionContext *txn);
 
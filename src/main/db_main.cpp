@@ -12,7 +12,9 @@ namespace terrier {
 void DBMain::Run() {
   TERRIER_ASSERT(network_layer_ != DISABLED, "Trying to run without a NetworkLayer.");
   const auto server = network_layer_->GetServer();
+  const auto replication_server = network_layer_->GetReplicationServer();
   try {
+    if (replication_server != DISABLED) replication_server->RunServer();
     server->RunServer();
   } catch (NetworkProcessException &e) {
     return;
@@ -27,6 +29,10 @@ void DBMain::ForceShutdown() {
   if (network_layer_ != DISABLED && network_layer_->GetServer()->Running()) {
     network_layer_->GetServer()->StopServer();
   }
+  if (network_layer_ != DISABLED && network_layer_->GetReplicationServer() != DISABLED &&
+      network_layer_->GetReplicationServer()->Running()) {
+    network_layer_->GetReplicationServer()->StopServer();
+  }
 }
 
 DBMain::~DBMain() { ForceShutdown(); }
@@ -17,8 +17,14 @@ Transition ReplicationCommand::Exec(common::ManagedPointer<ProtocolInterpreter>
                                     common::ManagedPointer<ITPPacketWriter> out,
                                     common::ManagedPointer<trafficcop::TrafficCop> t_cop,
                                     common::ManagedPointer<ConnectionContext> connection) {
-  std::unique_ptr<ReadBuffer> buffer;
-  buffer->FillBufferFrom(in_, in_len_);
+  // Packet layout is described in ITPPacketWriter::BeginReplicationCommand. Messages arrive in order over the
+  // connection, so the message id is not needed to put the replication data back together.
+  in_.ReadValue<uint64_t>();
+  const auto data_size = in_.ReadValue<uint64_t>();
+  TERRIER_ASSERT(data_size + 2 * sizeof(uint64_t) == in_len_, "Replication data does not match packet size");
+  // The packet's view points into the connection's read buffer, so the data has to be copied out before handing it off
+  auto buffer = std::make_unique<ReadBuffer>(data_size);
+  buffer->FillBufferFrom(in_, data_size);
   t_cop->HandBufferToReplication(std::move(buffer));
   return Transition::PROCEED;
 }
@@ -27,7 +33,7 @@ Transition StopReplicationCommand::Exec(common::ManagedPointer<ProtocolInterpret
                                         common::ManagedPointer<ITPPacketWriter> out,
                                         common::ManagedPointer<trafficcop::TrafficCop> t_cop,
                                         common::ManagedPointer<ConnectionContext> connection) {
-  // TODO(Tianlei): modify this implementation for the complete ITP protocol
+  t_cop->StopReplication();
   return Transition::PROCEED;
 }
 
@@ -103,7 +103,9 @@ Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPoin
   // at the same time, creating DDL conflicts when creating the temp namespace
   do {
     oids = t_cop->CreateTempNamespace(context->GetConnectionID(), db_name);
-    if (oids.first == catalog::INVALID_DATABASE_OID || oids.second != catalog::INVALID_NAMESPACE_OID) break;
+    if (oids.first == catalog::INVALID_DATABASE_OID || oids.second != catalog::INVALID_NAMESPACE_OID ||
+        t_cop->IsReplica())
+      break;
     std::this_thread::sleep_for(std::chrono::milliseconds{sleep_time});
     sleep_time *= BACKOFF_FACTOR;
   } while (sleep_time <= MAX_BACKOFF_TIME);
@@ -114,7 +116,7 @@ Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPoin
                        common::ErrorCode::ERRCODE_UNDEFINED_DATABASE});
     return Transition::TERMINATE;
   }
-  if (oids.second == catalog::INVALID_NAMESPACE_OID) {
+  if (oids.second == catalog::INVALID_NAMESPACE_OID && !t_cop->IsReplica()) {
     // Failed to create temporary namespace. Client should retry.
     writer.WriteError({common::ErrorSeverity::FATAL,
                        "Failed to create a temporary namespace for this connection. There may be a concurrent "
@@ -127,6 +129,7 @@ Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPoin
   context->SetDatabaseName(std::move(db_name));
   context->SetDatabaseOid(oids.first);
   context->SetTempNamespaceOid(oids.second);
+  context->SetSynchronousCommit(t_cop->SynchronousCommit());
 
   // All done
   writer.WriteStartupResponse();
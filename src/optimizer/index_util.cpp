@@ -27,8 +27,9 @@ bool IndexUtil::SatisfiesSortWithIndex(catalog::CatalogAccessor *accessor, const
     return false;
   }
 
+  // INCLUDE columns are not ordered by the index
   auto sort_col_size = prop->GetSortColumnSize();
-  if (sort_col_size > mapped_cols.size()) {
+  if (sort_col_size > index_schema.NumKeyColumns()) {
     // Sort(a,b,c,d) cannot be satisfied with Index(a,b,c)
     return false;
   }
@@ -69,8 +70,9 @@ bool IndexUtil::SatisfiesPredicateWithIndex(
     return false;
   }
 
+  // Only key columns can bound the scan, INCLUDE columns are left to the scan predicate
   std::unordered_set<catalog::col_oid_t> mapped_set;
-  for (auto col : mapped_cols) mapped_set.insert(col);
+  for (size_t idx = 0; idx < index_schema.NumKeyColumns(); idx++) mapped_set.insert(mapped_cols[idx]);
 
   return CheckPredicates(index_schema, tbl_oid, tbl_alias, lookup, mapped_set, predicates, allow_cves, scan_type,
                          bounds);
@@ -165,14 +167,14 @@ bool IndexUtil::CheckPredicates(
 
   // Check predicate open/close ordering
   planner::IndexScanType scan_type = planner::IndexScanType::AscendingClosed;
-  if (open_highs.size() == open_lows.size() && open_highs.size() == schema.GetColumns().size()) {
+  if (open_highs.size() == open_lows.size() && open_highs.size() == schema.NumKeyColumns()) {
     // Generally on multi-column indexes, exact would result in comparing against unspecified attribute.
     // Only try to do an exact key lookup if potentially all attributes are specified.
     scan_type = planner::IndexScanType::Exact;
   }
 
-  for (auto &col : schema.GetColumns()) {
-    auto oid = col.Oid();
+  for (uint16_t idx = 0; idx < schema.NumKeyColumns(); idx++) {
+    auto oid = schema.GetColumn(idx).Oid();
     if (open_highs.find(oid) == open_highs.end() && open_lows.find(oid) == open_lows.end()) {
       // Index predicate ordering is busted
       break;
@@ -907,7 +907,8 @@ BaseOperatorNodeContents *CreateIndex::Copy() const {
     columns.emplace_back(col);
   }
   auto schema = std::make_unique<catalog::IndexSchema>(std::move(columns), schema_->Type(), schema_->Unique(),
-                                                       schema_->Primary(), schema_->Exclusion(), schema_->Immediate());
+                                                       schema_->Primary(), schema_->Exclusion(), schema_->Immediate(),
+                                                       schema_->NumIncludeColumns());
 
   auto op = new CreateIndex();
   op->namespace_oid_ = namespace_oid_;
@@ -861,7 +861,8 @@ void PlanGenerator::Visit(const CreateIndex *create_index) {
     cols.emplace_back(col);
   }
   auto idx_schema = std::make_unique<catalog::IndexSchema>(std::move(cols), schema->Type(), schema->Unique(),
-                                                           schema->Primary(), schema->Exclusion(), schema->Immediate());
+                                                           schema->Primary(), schema->Exclusion(), schema->Immediate(),
+                                                           schema->NumIncludeColumns());
   auto out_schema = std::make_unique<planner::OutputSchema>();
 
   output_plan_ = planner::CreateIndexPlanNode::Builder()
@@ -60,6 +60,14 @@ void Callbacks::WalNumBuffers(void *const old_value, void *const new_value, DBMa
     action_context->SetState(common::ActionState::FAILURE);
 }
 
+void Callbacks::SynchronousCommit(void *const old_value, void *const new_value, DBMain *const db_main,
+                                  common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  bool new_status = *static_cast<bool *>(new_value);
+  if (db_main->GetTrafficCop() != DISABLED) db_main->GetTrafficCop()->SetSynchronousCommit(new_status);
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::MetricsLogging(void *const old_value, void *const new_value, DBMain *const db_main,
                                common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
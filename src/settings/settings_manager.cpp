@@ -3,6 +3,8 @@
 #include <gflags/gflags.h>
 
 #include <algorithm>
+#include <cctype>
+#include <string>
 
 #include "common/macros.h"
 #include "execution/sql/value_util.h"
@@ -32,6 +34,24 @@ void CheckActionContextStateForSet(common::ManagedPointer<common::ActionContext>
   }
 }
 
+/**
+ * Parse a boolean given as a string, the way Postgres clients set boolean parameters (e.g. SET x = off).
+ * @return true if the string is one of on/off, true/false, yes/no or 1/0 in any case, false otherwise
+ */
+bool ParseBoolString(const std::string_view &str, bool *const value) {
+  std::string lower(str);
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+  if (lower == "on" || lower == "true" || lower == "yes" || lower == "1") {
+    *value = true;
+    return true;
+  }
+  if (lower == "off" || lower == "false" || lower == "no" || lower == "0") {
+    *value = false;
+    return true;
+  }
+  return false;
+}
+
 }  // namespace
 
 SettingsManager::SettingsManager(const common::ManagedPointer<DBMain> db_main,
@@ -276,8 +296,12 @@ void SettingsManager::SetParameter(const std::string &name,
       "Values should be constant value expressions.");
   const auto &value = values[0].CastManagedPointerTo<parser::ConstantValueExpression>();
 
-  // Check types.
-  if (value->GetReturnValueType() != param_type) {
+  // Check types. Boolean parameters may also be given as strings.
+  bool bool_value = false;
+  const bool is_bool_string = param_type == type::TypeId::BOOLEAN &&
+                              value->GetReturnValueType() == type::TypeId::VARCHAR &&
+                              ParseBoolString(value->GetStringVal().StringView(), &bool_value);
+  if (value->GetReturnValueType() != param_type && !is_bool_string) {
     throw SETTINGS_EXCEPTION(fmt::format("invalid value for parameter \"{}\": \"{}\"", info.name_, value->ToString()),
                              common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
   }
@@ -288,7 +312,7 @@ void SettingsManager::SetParameter(const std::string &name,
   // Set the parameter.
   switch (param_type) {
     case type::TypeId::BOOLEAN:
-      SetBool(param, value->GetBoolVal().val_, common::ManagedPointer(&action_context),
+      SetBool(param, is_bool_string ? bool_value : value->GetBoolVal().val_, common::ManagedPointer(&action_context),
               SettingsManager::EmptySetterCallback);
       break;
     case type::TypeId::TINYINT:
@@ -314,4 +338,23 @@ void SettingsManager::SetParameter(const std::string &name,
   }
 }
 
+bool SettingsManager::ParseBoolParameter(
+    const std::string &name, const std::vector<common::ManagedPointer<parser::AbstractExpression>> &values) const {
+  const ParamInfo &info = GetParamInfo(GetParam(name));
+  TERRIER_ASSERT(info.value_.GetReturnValueType() == type::TypeId::BOOLEAN, "Not a boolean parameter.");
+  TERRIER_ASSERT(values.size() == 1, "The SettingsManager currently assumes that each setting only has one value.");
+  TERRIER_ASSERT(values[0]->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT,
+                 "Values should be constant value expressions.");
+  const auto &value = values[0].CastManagedPointerTo<parser::ConstantValueExpression>();
+
+  // Boolean parameters may also be given as strings
+  bool bool_value = false;
+  if (value->GetReturnValueType() == type::TypeId::BOOLEAN) return value->GetBoolVal().val_;
+  if (value->GetReturnValueType() == type::TypeId::VARCHAR &&
+      ParseBoolString(value->GetStringVal().StringView(), &bool_value))
+    return bool_value;
+  throw SETTINGS_EXCEPTION(fmt::format("invalid value for parameter \"{}\": \"{}\"", info.name_, value->ToString()),
+                           common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+}
+
 }  // namespace terrier::settings
\ No newline at end of file
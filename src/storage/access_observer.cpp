@@ -1,23 +1,46 @@
 #include "storage/access_observer.h"
-#include "storage/block_compactor.h"
+
+#include <vector>
+
+#include "storage/data_table.h"
 
 namespace terrier::storage {
 void AccessObserver::ObserveGCInvocation() {
-  gc_epoch_++;
-  for (auto it = last_touched_.begin(), end = last_touched_.end(); it != end;) {
-    if (it->second + COLD_DATA_EPOCH_THRESHOLD < gc_epoch_) {
-      compactor_->PutInQueue(it->first);
-      it = last_touched_.erase(it);
-    } else {
-      ++it;
-    }
-  }
+  const Clock::time_point now = Clock::now();
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  now_ = now;
 }
 
 void AccessObserver::ObserveWrite(RawBlock *block) {
   // The compactor is only concerned with blocks that are already full. We assume that partially empty blocks are
   // always hot.
-  if (block->GetInsertHead() == block->data_table_->GetBlockLayout().NumSlots()) last_touched_[block] = gc_epoch_;
+  if (block->GetInsertHead() != block->data_table_->GetBlockLayout().NumSlots()) return;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  last_touched_[block] = now_;
+}
+
+std::vector<RawBlock *> AccessObserver::ColdBlocks(const Clock::duration threshold) const {
+  const Clock::time_point now = Clock::now();
+  std::vector<RawBlock *> result;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  for (const auto &entry : last_touched_)
+    if (entry.second + threshold <= now) result.push_back(entry.first);
+  return result;
+}
+
+void AccessObserver::Forget(RawBlock *block) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  last_touched_.erase(block);
+}
+
+void AccessObserver::OnRelease(const std::vector<RawBlock *> &blocks) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  for (RawBlock *const block : blocks) last_touched_.erase(block);
+}
+
+uint32_t AccessObserver::NumObservedBlocks() const {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  return static_cast<uint32_t>(last_touched_.size());
 }
 
 }  // namespace terrier::storage
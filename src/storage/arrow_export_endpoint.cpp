@@ -0,0 +1,153 @@
+#include "storage/arrow_export_endpoint.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/database_catalog.h"
+#include "catalog/postgres/pg_namespace.h"
+#include "loggers/storage_logger.h"
+#include "storage/arrow_serializer.h"
+#include "storage/sql_table.h"
+#include "transaction/transaction_manager.h"
+
+namespace terrier::storage {
+
+namespace {
+// Finds the table a client asks for, see ServeRequestedTable
+common::ManagedPointer<SqlTable> LookUpTable(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                             const common::ManagedPointer<catalog::Catalog> catalog,
+                                             const std::string &request) {
+  const auto database_end = request.find(' ');
+  if (database_end == std::string::npos) return common::ManagedPointer<SqlTable>(nullptr);
+  const auto database = request.substr(0, database_end);
+  auto db_oid = catalog->GetDatabaseOid(txn, database);
+  // Anything short enough to fit an oid that is not the name of a database is taken as an oid
+  if (db_oid == catalog::INVALID_DATABASE_OID && !database.empty() && database.size() < 10 &&
+      database.find_first_not_of("0123456789") == std::string::npos)
+    db_oid = catalog::db_oid_t(static_cast<uint32_t>(std::stoul(database)));
+  const auto db_catalog = catalog->GetDatabaseCatalog(txn, db_oid);
+  if (db_catalog == nullptr) return common::ManagedPointer<SqlTable>(nullptr);
+
+  auto table_name = request.substr(database_end + 1);
+  auto ns_oid = catalog::postgres::NAMESPACE_DEFAULT_NAMESPACE_OID;
+  const auto namespace_end = table_name.find('.');
+  if (namespace_end != std::string::npos) {
+    ns_oid = db_catalog->GetNamespaceOid(txn, table_name.substr(0, namespace_end));
+    if (ns_oid == catalog::INVALID_NAMESPACE_OID) return common::ManagedPointer<SqlTable>(nullptr);
+    table_name = table_name.substr(namespace_end + 1);
+  }
+  const auto table_oid = db_catalog->GetTableOid(txn, ns_oid, table_name);
+  if (table_oid == catalog::INVALID_TABLE_OID) return common::ManagedPointer<SqlTable>(nullptr);
+  return db_catalog->GetTable(txn, table_oid);
+}
+}  // namespace
+
+ArrowExportEndpoint::ArrowExportEndpoint(const std::string &socket_path) : socket_path_(socket_path) {
+  struct sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (socket_path_.size() >= sizeof(addr.sun_path))
+    throw std::runtime_error("Socket path " + socket_path_ + " is too long");
+  std::strncpy(addr.sun_path, socket_path_.c_str(), sizeof(addr.sun_path) - 1);
+
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd_ < 0) throw std::runtime_error("Failed to open socket with errno " + std::to_string(errno));
+  unlink(socket_path_.c_str());
+  if (bind(listen_fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0 || listen(listen_fd_, 1) < 0) {
+    const auto listen_errno = errno;
+    close(listen_fd_);
+    throw std::runtime_error("Failed to listen on " + socket_path_ + " with errno " + std::to_string(listen_errno));
+  }
+}
+
+ArrowExportEndpoint::~ArrowExportEndpoint() {
+  close(listen_fd_);
+  unlink(socket_path_.c_str());
+}
+
+void ArrowExportEndpoint::ServeTable(const DataTable &table, std::vector<type::TypeId> *col_types) {
+  ExportTo(AcceptClient(std::chrono::milliseconds(-1)), table, col_types);
+}
+
+bool ArrowExportEndpoint::ServeRequestedTable(const common::ManagedPointer<catalog::Catalog> catalog,
+                                              const common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                                              const std::chrono::milliseconds timeout) {
+  const int client_fd = AcceptClient(timeout);
+  if (client_fd < 0) return false;
+
+  // Read the request, without waiting on a client that never sends it for longer than on one that never connects
+  struct timeval receive_timeout;
+  receive_timeout.tv_sec = timeout.count() / 1000;
+  receive_timeout.tv_usec = (timeout.count() % 1000) * 1000;
+  setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &receive_timeout, sizeof(receive_timeout));
+  constexpr size_t max_request_size = 1024;
+  std::string request;
+  char c;
+  while (request.size() < max_request_size) {
+    const ssize_t bytes_read = read(client_fd, &c, 1);
+    if (bytes_read < 0 && errno == EINTR) continue;
+    if (bytes_read <= 0 || c == '\n') break;
+    request.push_back(c);
+  }
+
+  auto *const txn = txn_manager->BeginTransaction();
+  const auto table = LookUpTable(common::ManagedPointer(txn), catalog, request);
+  if (table == nullptr) {
+    STORAGE_LOG_WARN("Arrow export of unknown table \"{}\" requested", request);
+    close(client_fd);
+  } else {
+    std::vector<type::TypeId> col_types(table->table_.layout_.NumColumns(), type::TypeId::INVALID);
+    for (const auto &column : table->table_.column_map_)
+      col_types[column.second.col_id_.UnderlyingValue()] = column.second.col_type_;
+    try {
+      ExportTo(client_fd, *table->table_.data_table_, &col_types);
+    } catch (...) {
+      txn_manager->Abort(txn);
+      throw;
+    }
+  }
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  return true;
+}
+
+int ArrowExportEndpoint::AcceptClient(const std::chrono::milliseconds timeout) {
+  struct pollfd listen_poll = {listen_fd_, POLLIN, 0};
+  int ready;
+  do {
+    ready = poll(&listen_poll, 1, static_cast<int>(timeout.count()));
+  } while (ready < 0 && errno == EINTR);
+  if (ready < 0) throw std::runtime_error("Failed to wait for client with errno " + std::to_string(errno));
+  if (ready == 0) return -1;
+
+  int client_fd;
+  do {
+    client_fd = accept(listen_fd_, nullptr, nullptr);
+  } while (client_fd < 0 && errno == EINTR);
+  if (client_fd < 0) throw std::runtime_error("Failed to accept client with errno " + std::to_string(errno));
+  return client_fd;
+}
+
+void ArrowExportEndpoint::ExportTo(const int client_fd, const DataTable &table, std::vector<type::TypeId> *col_types) {
+  ArrowSerializer serializer(table);
+  uint32_t num_skipped_blocks;
+  try {
+    num_skipped_blocks = serializer.ExportTable(client_fd, col_types);
+  } catch (...) {
+    close(client_fd);
+    throw;
+  }
+  close(client_fd);
+  if (num_skipped_blocks > 0) {
+    STORAGE_LOG_DEBUG("Arrow export left out {} blocks that are not frozen", num_skipped_blocks);
+  }
+}
+
+}  // namespace terrier::storage
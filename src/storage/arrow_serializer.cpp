@@ -1,6 +1,9 @@
-#include <cstring>
-#include <fstream>
-#include <list>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
 #include <string>
 #include <vector>
 
@@ -10,37 +13,53 @@ namespace terrier::storage {
 
 constexpr int32_t FLATBUF_CONTINUZATION = -1;
 constexpr uint8_t ARROW_ALIGNMENT = 8;
-constexpr char ALIGNMENT[8] = {0};
 constexpr flatbuf::MetadataVersion METADATA_VERSION = flatbuf::MetadataVersion_V4;
 
-void ArrowSerializer::WriteDataBlock(std::ofstream &outfile, const char *src, size_t len) {
-  len = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, len);
-  outfile.write(src, len);
+void ArrowSerializer::AddBuffer(size_t *offset, const void *src, size_t len, std::vector<flatbuf::Buffer> *buffers,
+                                std::vector<byte> *body) {
+  const size_t padded_len = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, static_cast<uint32_t>(len));
+  buffers->emplace_back(*offset, padded_len);
+  *offset += padded_len;
+  const auto *const bytes = static_cast<const byte *>(src);
+  body->insert(body->end(), bytes, bytes + len);
+  body->resize(body->size() + padded_len - len, byte{0});
 }
 
-void ArrowSerializer::AddBufferInfo(size_t *offset, size_t len, std::vector<flatbuf::Buffer> *buffers) {
-  len = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, len);
-  buffers->emplace_back(*offset, len);
-  *offset += len;
+void ArrowSerializer::WriteFully(const Output &output, const std::vector<byte> &messages) {
+  for (size_t next = 0; next < messages.size();) {
+    ssize_t written;
+    if (output.is_socket_)
+      written = send(output.fd_, &messages[next], messages.size() - next, MSG_NOSIGNAL);
+    else
+      written = write(output.fd_, &messages[next], messages.size() - next);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Failed to export table with errno " + std::to_string(errno));
+    }
+    next += static_cast<size_t>(written);
+  }
 }
 
-void ArrowSerializer::AssembleMetadataBuffer(std::ofstream &outfile, flatbuf::MessageHeader header_type,
-                                             flatbuffers::Offset<void> header, int64_t body_len,
-                                             flatbuffers::FlatBufferBuilder *flatbuf_builder) {
+void ArrowSerializer::WriteMessage(std::vector<byte> *messages, flatbuf::MessageHeader header_type,
+                                   flatbuffers::Offset<void> header, int64_t body_len, const std::vector<byte> &body,
+                                   flatbuffers::FlatBufferBuilder *flatbuf_builder) {
   auto message = flatbuf::CreateMessage(*flatbuf_builder, METADATA_VERSION, header_type, header, body_len);
   flatbuf_builder->Finish(message);
-  int32_t flatbuf_size = flatbuf_builder->GetSize();
-  auto padded_flatbuf_size = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, flatbuf_size);
-  outfile.write(reinterpret_cast<const char *>(&FLATBUF_CONTINUZATION), sizeof(int32_t));
-  outfile.write(reinterpret_cast<const char *>(&padded_flatbuf_size), sizeof(int32_t));
-  outfile.write(reinterpret_cast<const char *>(flatbuf_builder->GetBufferPointer()), flatbuf_size);
-  if (padded_flatbuf_size != static_cast<uint32_t>(flatbuf_size)) {
-    outfile.write(ALIGNMENT, padded_flatbuf_size - flatbuf_size);
-  }
-  outfile.flush();
+  uint32_t flatbuf_size = flatbuf_builder->GetSize();
+  uint32_t padded_flatbuf_size = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, flatbuf_size);
+  const int32_t prefix[2] = {FLATBUF_CONTINUZATION, static_cast<int32_t>(padded_flatbuf_size)};
+
+  const auto *const prefix_bytes = reinterpret_cast<const byte *>(prefix);
+  const auto *const flatbuf_bytes = reinterpret_cast<const byte *>(flatbuf_builder->GetBufferPointer());
+  messages->insert(messages->end(), prefix_bytes, prefix_bytes + sizeof(prefix));
+  messages->insert(messages->end(), flatbuf_bytes, flatbuf_bytes + flatbuf_size);
+  messages->resize(messages->size() + padded_flatbuf_size - flatbuf_size, byte{0});
+  messages->insert(messages->end(), body.begin(), body.end());
+  flatbuf_builder->Clear();
 }
 
-void ArrowSerializer::WriteSchemaMessage(std::ofstream &outfile, std::unordered_map<col_id_t, int64_t> *dictionary_ids,
+void ArrowSerializer::WriteSchemaMessage(std::vector<byte> *messages,
+                                         std::unordered_map<col_id_t, int64_t> *dictionary_ids,
                                          std::vector<type::TypeId> *col_types,
                                          flatbuffers::FlatBufferBuilder *flatbuf_builder) {
   RawBlock *block = data_table_.blocks_.front();
@@ -119,14 +138,15 @@ void ArrowSerializer::WriteSchemaMessage(std::ofstream &outfile, std::unordered_
 
   auto schema =
       flatbuf::CreateSchema(*flatbuf_builder, flatbuf::Endianness_Little, flatbuf_builder->CreateVector(fields));
-  AssembleMetadataBuffer(outfile, flatbuf::MessageHeader_Schema, schema.Union(), 0, flatbuf_builder);
+  WriteMessage(messages, flatbuf::MessageHeader_Schema, schema.Union(), 0, {}, flatbuf_builder);
 }
 
-void ArrowSerializer::WriteDictionaryMessage(std::ofstream &outfile, int64_t dictionary_id,
+void ArrowSerializer::WriteDictionaryMessage(std::vector<byte> *messages, int64_t dictionary_id,
                                              const ArrowVarlenColumn &varlen_col,
                                              flatbuffers::FlatBufferBuilder *flatbuf_builder) {
   std::vector<flatbuf::FieldNode> field_nodes;
   std::vector<flatbuf::Buffer> buffers;
+  std::vector<byte> body;
   uint32_t num_elements = varlen_col.OffsetsLength() - 1;
   size_t buffer_offset = 0;
   field_nodes.emplace_back(num_elements, 0);
@@ -136,30 +156,44 @@ void ArrowSerializer::WriteDictionaryMessage(std::ofstream &outfile, int64_t dic
   // in one RecordBatch. RecordBatch is something requires a validity buffer
   buffers.emplace_back(buffer_offset, 0);
 
-  AddBufferInfo(&buffer_offset, varlen_col.OffsetsLength() * sizeof(uint64_t), &buffers);
+  AddBuffer(&buffer_offset, varlen_col.Offsets(), varlen_col.OffsetsLength() * sizeof(uint64_t), &buffers, &body);
 
-  AddBufferInfo(&buffer_offset, varlen_col.ValuesLength(), &buffers);
+  AddBuffer(&buffer_offset, varlen_col.Values(), varlen_col.ValuesLength(), &buffers, &body);
 
   auto record_batch =
       flatbuf::CreateRecordBatch(*flatbuf_builder, num_elements, flatbuf_builder->CreateVectorOfStructs(field_nodes),
                                  flatbuf_builder->CreateVectorOfStructs(buffers));
   auto dictionary_batch = flatbuf::CreateDictionaryBatch(*flatbuf_builder, dictionary_id, record_batch);
   auto aligned_offset = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, buffer_offset);
-  AssembleMetadataBuffer(outfile, flatbuf::MessageHeader_DictionaryBatch, dictionary_batch.Union(), aligned_offset,
-                         flatbuf_builder);
-  WriteDataBlock(outfile, reinterpret_cast<const char *>(varlen_col.Offsets()),
-                 varlen_col.OffsetsLength() * sizeof(uint64_t));
-
-  WriteDataBlock(outfile, reinterpret_cast<const char *>(varlen_col.Values()), varlen_col.ValuesLength());
+  WriteMessage(messages, flatbuf::MessageHeader_DictionaryBatch, dictionary_batch.Union(), aligned_offset, body,
+               flatbuf_builder);
+}
 
-  outfile.flush();
+uint32_t ArrowSerializer::ExportTable(const std::string &file_name, std::vector<type::TypeId> *col_types) {
+  const int fd = open(file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) throw std::runtime_error("Failed to open " + file_name + " with errno " + std::to_string(errno));
+  uint32_t num_skipped_blocks;
+  try {
+    num_skipped_blocks = ExportTable(fd, col_types);
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+  close(fd);
+  return num_skipped_blocks;
 }
 
-void ArrowSerializer::ExportTable(const std::string &file_name, std::vector<type::TypeId> *col_types) {
+uint32_t ArrowSerializer::ExportTable(const int fd, std::vector<type::TypeId> *col_types) {
+  struct stat fd_stat;
+  if (fstat(fd, &fd_stat) != 0)
+    throw std::runtime_error("Failed to stat export target with errno " + std::to_string(errno));
+  const Output output{fd, S_ISSOCK(fd_stat.st_mode)};
+
   flatbuffers::FlatBufferBuilder flatbuf_builder;
-  std::ofstream outfile(file_name, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
   std::unordered_map<col_id_t, int64_t> dictionary_ids;
-  WriteSchemaMessage(outfile, &dictionary_ids, col_types, &flatbuf_builder);
+  std::vector<byte> messages;
+  WriteSchemaMessage(&messages, &dictionary_ids, col_types, &flatbuf_builder);
+  WriteFully(output, messages);
 
   const BlockLayout &layout = data_table_.accessor_.GetBlockLayout();
   auto column_ids = layout.AllColumns();
@@ -167,12 +201,18 @@ void ArrowSerializer::ExportTable(const std::string &file_name, std::vector<type
   std::vector<RawBlock *> tmp_blocks = data_table_.blocks_;
   data_table_.blocks_latch_.Unlock();
 
+  uint32_t num_skipped_blocks = 0;
   for (RawBlock *block : tmp_blocks) {
     std::vector<flatbuf::FieldNode> field_nodes;
     std::vector<flatbuf::Buffer> buffers;
+    std::vector<byte> body;
+    messages.clear();
 
-    // Make sure varlen columns have correct data when reading
-    while (!block->controller_.TryAcquireInPlaceRead()) {
+    // Make sure varlen columns have correct data when reading. A block that is not frozen may never be, so it is
+    // skipped instead of waited for.
+    if (!block->controller_.TryAcquireInPlaceRead()) {
+      num_skipped_blocks++;
+      continue;
     }
     ArrowBlockMetadata &metadata = data_table_.accessor_.GetArrowBlockMetadata(block);
     uint32_t num_slots = metadata.NumRecords();
@@ -180,105 +220,69 @@ void ArrowSerializer::ExportTable(const std::string &file_name, std::vector<type
     size_t buffer_offset = 0;
     size_t column_id_size = column_ids.size();
 
-    // First pass, write metadata_flatbuffer
-    for (size_t i = 0; i < column_id_size; ++i) {
-      auto col_id = column_ids[i];
-      common::RawConcurrentBitmap *column_bitmap = data_table_.accessor_.ColumnNullBitmap(block, col_id);
-      std::byte *column_start = data_table_.accessor_.ColumnStart(block, col_id);
+    try {
+      for (size_t i = 0; i < column_id_size; ++i) {
+        auto col_id = column_ids[i];
+        common::RawConcurrentBitmap *column_bitmap = data_table_.accessor_.ColumnNullBitmap(block, col_id);
+        std::byte *column_start = data_table_.accessor_.ColumnStart(block, col_id);
 
-      ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
-      field_nodes.emplace_back(num_slots, metadata.NullCount(col_id));
+        ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
+        field_nodes.emplace_back(num_slots, metadata.NullCount(col_id));
 
-      AddBufferInfo(&buffer_offset,
-                    reinterpret_cast<uintptr_t>(column_start) - reinterpret_cast<uintptr_t>(column_bitmap), &buffers);
-      if (layout.IsVarlen(col_id) && !(col_info.Type() == ArrowColumnType::FIXED_LENGTH)) {
-        switch (col_info.Type()) {
-          case ArrowColumnType::GATHERED_VARLEN: {
-            ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
-            AddBufferInfo(&buffer_offset, varlen_col.OffsetsLength() * sizeof(uint64_t), &buffers);
-            AddBufferInfo(&buffer_offset, varlen_col.ValuesLength(), &buffers);
-            break;
-          }
-          case ArrowColumnType::DICTIONARY_COMPRESSED: {
-            ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
-            WriteDictionaryMessage(outfile, dictionary_ids[col_id], varlen_col, &flatbuf_builder);
-            AddBufferInfo(&buffer_offset, num_slots * sizeof(uint64_t), &buffers);
-            break;
+        AddBuffer(&buffer_offset, column_bitmap,
+                  reinterpret_cast<uintptr_t>(column_start) - reinterpret_cast<uintptr_t>(column_bitmap), &buffers,
+                  &body);
+        if (layout.IsVarlen(col_id) && !(col_info.Type() == ArrowColumnType::FIXED_LENGTH)) {
+          switch (col_info.Type()) {
+            case ArrowColumnType::GATHERED_VARLEN: {
+              ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
+              AddBuffer(&buffer_offset, varlen_col.Offsets(), varlen_col.OffsetsLength() * sizeof(uint64_t), &buffers,
+                        &body);
+              AddBuffer(&buffer_offset, varlen_col.Values(), varlen_col.ValuesLength(), &buffers, &body);
+              break;
+            }
+            case ArrowColumnType::DICTIONARY_COMPRESSED: {
+              // The dictionary has to arrive ahead of the record batch that refers to it
+              ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
+              WriteDictionaryMessage(&messages, dictionary_ids[col_id], varlen_col, &flatbuf_builder);
+              AddBuffer(&buffer_offset, col_info.Indices(), num_slots * sizeof(uint64_t), &buffers, &body);
+              break;
+            }
+            default:
+              throw std::runtime_error("unexpected control flow");
           }
-          default:
-            throw std::runtime_error("unexpected control flow");
-        }
-      } else {
-        int32_t cur_buffer_len;
-        // Calculate the length of the data region of current column. For the columns except the last one, we calculate
-        // their length by using the start of next column's bit map - the start of current column's data. For the
-        // last column, we calculate the length by using the beginning address of the next block - the start of current
-        // column data.
-        if (i == column_id_size - 1) {
-          auto casted_column_start = reinterpret_cast<uintptr_t>(column_start);
-          uintptr_t mask = common::Constants::BLOCK_SIZE - 1;
-          cur_buffer_len = ((casted_column_start + mask) & (~mask)) - casted_column_start;
         } else {
-          cur_buffer_len =
-              reinterpret_cast<uintptr_t>(data_table_.accessor_.ColumnNullBitmap(block, column_ids[i + 1])) -
-              reinterpret_cast<uintptr_t>(column_start);
-        }
-        AddBufferInfo(&buffer_offset, cur_buffer_len, &buffers);
-      }
-    }
-    auto record_batch =
-        flatbuf::CreateRecordBatch(flatbuf_builder, num_slots, flatbuf_builder.CreateVectorOfStructs(field_nodes),
-                                   flatbuf_builder.CreateVectorOfStructs(buffers));
-    auto aligned_offset = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, buffer_offset);
-    AssembleMetadataBuffer(outfile, flatbuf::MessageHeader_RecordBatch, record_batch.Union(), aligned_offset,
-                           &flatbuf_builder);
-
-    // Second pass, write data.
-    for (size_t i = 0; i < column_id_size; ++i) {
-      auto col_id = column_ids[i];
-      common::RawConcurrentBitmap *column_bitmap = data_table_.accessor_.ColumnNullBitmap(block, col_id);
-      std::byte *column_start = data_table_.accessor_.ColumnStart(block, col_id);
-
-      ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
-      field_nodes.emplace_back(num_slots, metadata.NullCount(col_id));
-
-      WriteDataBlock(outfile, reinterpret_cast<const char *>(column_bitmap),
-                     reinterpret_cast<uintptr_t>(column_start) - reinterpret_cast<uintptr_t>(column_bitmap));
-
-      if (layout.IsVarlen(col_id) && !(col_info.Type() == ArrowColumnType::FIXED_LENGTH)) {
-        switch (col_info.Type()) {
-          case ArrowColumnType::GATHERED_VARLEN: {
-            ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
-            WriteDataBlock(outfile, reinterpret_cast<const char *>(varlen_col.Offsets()),
-                           varlen_col.OffsetsLength() * sizeof(uint64_t));
-            WriteDataBlock(outfile, reinterpret_cast<const char *>(varlen_col.Values()), varlen_col.ValuesLength());
-            break;
-          }
-          case ArrowColumnType::DICTIONARY_COMPRESSED: {
-            auto indices = col_info.Indices();
-            WriteDataBlock(outfile, reinterpret_cast<const char *>(indices), num_slots * sizeof(uint64_t));
-            break;
+          int32_t cur_buffer_len;
+          // Calculate the length of the data region of current column. For the columns except the last one, we
+          // calculate their length by using the start of next column's bit map - the start of current column's data.
+          // For the last column, we calculate the length by using the beginning address of the next block - the start
+          // of current column data.
+          if (i == column_id_size - 1) {
+            auto casted_column_start = reinterpret_cast<uintptr_t>(column_start);
+            uintptr_t mask = common::Constants::BLOCK_SIZE - 1;
+            cur_buffer_len = ((casted_column_start + mask) & (~mask)) - casted_column_start;
+          } else {
+            cur_buffer_len =
+                reinterpret_cast<uintptr_t>(data_table_.accessor_.ColumnNullBitmap(block, column_ids[i + 1])) -
+                reinterpret_cast<uintptr_t>(column_start);
           }
-          default:
-            throw std::runtime_error("unexpected control flow");
-        }
-      } else {
-        int32_t cur_buffer_len;
-        if (i == column_id_size - 1) {
-          auto casted_column_start = reinterpret_cast<uintptr_t>(column_start);
-          uintptr_t mask = common::Constants::BLOCK_SIZE - 1;
-          cur_buffer_len = ((casted_column_start + mask) & (~mask)) - casted_column_start;
-        } else {
-          cur_buffer_len =
-              reinterpret_cast<uintptr_t>(data_table_.accessor_.ColumnNullBitmap(block, column_ids[i + 1])) -
-              reinterpret_cast<uintptr_t>(column_start);
+          AddBuffer(&buffer_offset, column_start, cur_buffer_len, &buffers, &body);
         }
-        WriteDataBlock(outfile, reinterpret_cast<const char *>(column_start), cur_buffer_len);
       }
+      auto record_batch =
+          flatbuf::CreateRecordBatch(flatbuf_builder, num_slots, flatbuf_builder.CreateVectorOfStructs(field_nodes),
+                                     flatbuf_builder.CreateVectorOfStructs(buffers));
+      auto aligned_offset = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, buffer_offset);
+      WriteMessage(&messages, flatbuf::MessageHeader_RecordBatch, record_batch.Union(), aligned_offset, body,
+                   &flatbuf_builder);
+    } catch (...) {
+      block->controller_.ReleaseInPlaceRead();
+      throw;
     }
-    outfile.flush();
     block->controller_.ReleaseInPlaceRead();
+    // The messages were copied out of the block, so the reader does not hold the block up while they are written
+    WriteFully(output, messages);
   }
-  outfile.close();
+  return num_skipped_blocks;
 }
 }  // namespace terrier::storage
@@ -1,19 +1,104 @@
 #include "storage/block_compactor.h"
 
 #include <algorithm>
+#include <mutex>  // NOLINT
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "storage/access_observer.h"
+#include "storage/block_evictor.h"
 #include "storage/sql_table.h"
+#include "storage/varlen_arena.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/transaction_util.h"
 
 namespace terrier::storage {
+uint32_t BlockCompactor::EnqueueColdBlocks(AccessObserver *const observer, const CompactionPolicy &policy,
+                                           const common::ManagedPointer<BlockStore> block_store) {
+  // The observer may hand out blocks whose table is releasing them, which are purged from the queue once we are done
+  std::lock_guard<std::mutex> compaction_guard(compaction_latch_);
+  bool memory_pressure = false;
+  if (block_store != nullptr && block_store->GetSizeLimit() > 0) {
+    const double usage = static_cast<double>(block_store->GetNumObjectsInUse()) / block_store->GetSizeLimit();
+    memory_pressure = usage >= policy.memory_pressure_ratio_;
+  }
+  std::vector<RawBlock *> cold_blocks =
+      observer->ColdBlocks(memory_pressure ? policy.pressured_cold_threshold_ : policy.cold_threshold_);
+
+  // Compacting a block only gives back the space of its empty slots, so the budget is best spent on the sparsest ones
+  const uint32_t num_enqueued = std::min(static_cast<uint32_t>(cold_blocks.size()), policy.max_blocks_per_round_);
+  if (cold_blocks.size() > num_enqueued) {
+    std::vector<std::pair<uint32_t, RawBlock *>> by_empty_slots;
+    for (RawBlock *block : cold_blocks) {
+      const TupleAccessStrategy &accessor = block->data_table_->accessor_;
+      const common::RawConcurrentBitmap *bitmap = accessor.AllocationBitmap(block);
+      uint32_t num_empty = 0;
+      for (uint32_t offset = 0; offset < accessor.GetBlockLayout().NumSlots(); offset++)
+        if (!bitmap->Test(offset)) num_empty++;
+      by_empty_slots.emplace_back(num_empty, block);
+    }
+    std::partial_sort(by_empty_slots.begin(), by_empty_slots.begin() + num_enqueued, by_empty_slots.end(),
+                      [](const auto &a, const auto &b) { return a.first > b.first; });
+    for (uint32_t i = 0; i < num_enqueued; i++) cold_blocks[i] = by_empty_slots[i].second;
+  }
+
+  for (uint32_t i = 0; i < num_enqueued; i++) {
+    observer->Forget(cold_blocks[i]);
+    PutInQueue(cold_blocks[i]);
+  }
+  blocks_enqueued_ += num_enqueued;
+  return num_enqueued;
+}
+
+void BlockCompactor::OnRelease(const std::vector<RawBlock *> &blocks) {
+  const std::unordered_set<RawBlock *> released(blocks.begin(), blocks.end());
+  std::lock_guard<std::mutex> compaction_guard(compaction_latch_);
+  common::SpinLatch::ScopedSpinLatch guard(&queue_latch_);
+  std::queue<RawBlock *> kept;
+  for (; !compaction_queue_.empty(); compaction_queue_.pop())
+    if (released.count(compaction_queue_.front()) == 0) kept.push(compaction_queue_.front());
+  compaction_queue_ = std::move(kept);
+  for (RawBlock *const block : blocks) awaiting_requeue_.erase(block);
+}
+
+void BlockCompactor::RequeueAfterGC(transaction::DeferredActionManager *const deferred_action_manager,
+                                    RawBlock *const block) {
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&queue_latch_);
+    awaiting_requeue_.insert(block);
+  }
+  deferred_action_manager->RegisterDeferredAction([this, block]() {
+    common::SpinLatch::ScopedSpinLatch guard(&queue_latch_);
+    if (awaiting_requeue_.erase(block) > 0) compaction_queue_.push(block);
+  });
+}
+
+CompactionStatistics BlockCompactor::GetStatistics() const {
+  CompactionStatistics result;
+  result.blocks_enqueued_ = blocks_enqueued_.load();
+  result.blocks_compacted_ = blocks_compacted_.load();
+  result.blocks_frozen_ = blocks_frozen_.load();
+  result.compactions_aborted_ = compactions_aborted_.load();
+  result.freezes_postponed_ = freezes_postponed_.load();
+  result.bytes_released_ = bytes_released_.load();
+  return result;
+}
+
 void BlockCompactor::ProcessCompactionQueue(transaction::DeferredActionManager *deferred_action_manager,
                                             transaction::TransactionManager *txn_manager) {
-  std::queue<RawBlock *> to_process = std::move(compaction_queue_);
+  // Tables wait for us to finish before they release their blocks, so none of the blocks below go away underneath us
+  std::lock_guard<std::mutex> compaction_guard(compaction_latch_);
+  std::queue<RawBlock *> to_process;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&queue_latch_);
+    to_process = std::move(compaction_queue_);
+    compaction_queue_ = std::queue<RawBlock *>();
+  }
+  // Blocks that cannot be frozen yet, to be tried again the next time the queue is processed
+  std::vector<RawBlock *> postponed;
   while (!to_process.empty()) {
     RawBlock *block = to_process.front();
     BlockAccessController &controller = block->controller_;
@@ -34,26 +119,40 @@ void BlockCompactor::ProcessCompactionQueue(transaction::DeferredActionManager *
           // If no compaction was performed, we still need to shut out any potentially racey transactions that
           // are alive at the same time as us flipping the block status flag to cooling. However, we must manually
           // ask the GC to enqueue this block, because no access will be observed from the empty compaction transaction.
-          if (cg.txn_->IsReadOnly())
-            deferred_action_manager->RegisterDeferredAction([this, block]() { PutInQueue(block); });
+          if (cg.txn_->IsReadOnly()) RequeueAfterGC(deferred_action_manager, block);
           txn_manager->Commit(cg.txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+          blocks_compacted_++;
         } else {
           txn_manager->Abort(cg.txn_);
+          compactions_aborted_++;
         }
         break;
       }
       case BlockState::COOLING: {
-        if (!CheckForVersionsAndGaps(block->data_table_->accessor_, block)) continue;
+        if (!CheckForVersionsAndGaps(block->data_table_->accessor_, block)) {
+          // Versions from before the block started cooling may still be visible to running transactions. Unless a
+          // writer has made the block hot again, in which case the access observer hands it back once it cools down,
+          // try again once the GC had a chance to prune them.
+          if (controller.GetBlockState()->load() == BlockState::COOLING) postponed.push_back(block);
+          freezes_postponed_++;
+          break;
+        }
         // This is used to clean up any dangling pointers using a deferred action in GC.
         // We need this piece of memory to live on the heap, so its life time extends to
         // beyond this function call.
         auto *loose_ptrs = new std::vector<const byte *>;
         GatherVarlens(loose_ptrs, block, block->data_table_);
+        // Every value is in the Arrow buffers now, so the varlen arena of the block can go along with the loose values.
+        // Writers that make the block hot again start a new one.
+        VarlenArena *arena = block->varlen_arena_.exchange(nullptr);
         controller.GetBlockState()->store(BlockState::FROZEN);
+        blocks_frozen_++;
+        if (evictor_ != nullptr) ReleaseCompressedColumns(block);
         // When the old variable length values are no longer visible by running transactions, delete them.
         deferred_action_manager->RegisterDeferredAction([=]() {
           for (auto *loose_ptr : *loose_ptrs) delete[] loose_ptr;
           delete loose_ptrs;
+          delete arena;
         });
         break;
       }
@@ -66,6 +165,7 @@ void BlockCompactor::ProcessCompactionQueue(transaction::DeferredActionManager *
     }
     to_process.pop();
   }
+  for (RawBlock *block : postponed) PutInQueue(block);
 }
 
 bool BlockCompactor::EliminateGaps(CompactionGroup *cg) {
@@ -245,9 +345,19 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
     common::RawConcurrentBitmap *column_bitmap = accessor.ColumnNullBitmap(block, col_id);
     if (!layout.IsVarlen(col_id)) {
       metadata.NullCount(col_id) = 0;
-      // Only need to count null for non-varlens
-      for (uint32_t i = 0; i < metadata.NumRecords(); i++)
-        if (!column_bitmap->Test(i)) metadata.NullCount(col_id)++;
+      // Only need to count null and build zone maps for non-varlens
+      ArrowZoneMap &zone_map = metadata.GetZoneMap(layout, col_id);
+      zone_map.Reset();
+      const uint8_t attr_size = layout.AttrSize(col_id);
+      const byte *column_start = accessor.ColumnStart(block, col_id);
+      for (uint32_t i = 0; i < metadata.NumRecords(); i++) {
+        if (column_bitmap->Test(i))
+          zone_map.Update(column_start + i * attr_size, attr_size);
+        else
+          metadata.NullCount(col_id)++;
+      }
+      CompressColumn(loose_ptrs, &metadata, col_id, column_bitmap, attr_size, column_start,
+                     &metadata.GetColumnInfo(layout, col_id), block);
       continue;
     }
 
@@ -267,6 +377,69 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
   }
 }
 
+void BlockCompactor::CompressColumn(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata,
+                                    col_id_t col_id, common::RawConcurrentBitmap *column_bitmap, uint8_t attr_size,
+                                    const byte *column_start, ArrowColumnInfo *col, RawBlock *block) {
+  // Scans may still be decoding the compressed copy from when the block was last frozen
+  if (col->Compressed().Encoding() != ColumnEncoding::UNCOMPRESSED) loose_ptrs->push_back(col->Compressed().Release());
+  if (attr_size != 1 && attr_size != 2 && attr_size != 4 && attr_size != 8) return;
+  if (metadata->NullCount(col_id) == metadata->NumRecords()) return;
+  // The compressed copy only saves memory if the raw values are released once the block is frozen. Otherwise it
+  // would come on top of them, so it is not built.
+  if (evictor_ == nullptr || !evictor_->Contains(block)) return;
+  const auto begin = static_cast<uint32_t>(column_start - reinterpret_cast<const byte *>(block));
+  const uint32_t end = begin + block->data_table_->accessor_.GetBlockLayout().NumSlots() * attr_size;
+  if (evictor_->ReleasableBytes(begin, end) == 0) return;
+
+  std::vector<int64_t> values(metadata->NumRecords());
+  uint32_t num_leading_nulls = 0;
+  for (uint32_t i = 0; i < metadata->NumRecords(); i++) {
+    if (!column_bitmap->Test(i)) {
+      // The value of a null does not matter, so repeat the one before to not break up runs or widen the range
+      if (i == num_leading_nulls)
+        num_leading_nulls++;
+      else
+        values[i] = values[i - 1];
+      continue;
+    }
+    const byte *value = column_start + i * attr_size;
+    switch (attr_size) {
+      case 1:
+        values[i] = *reinterpret_cast<const int8_t *>(value);
+        break;
+      case 2:
+        values[i] = *reinterpret_cast<const int16_t *>(value);
+        break;
+      case 4:
+        values[i] = *reinterpret_cast<const int32_t *>(value);
+        break;
+      default:
+        values[i] = *reinterpret_cast<const int64_t *>(value);
+        break;
+    }
+  }
+  // Nulls at the start of the block have no value before them, so they repeat the first value after them instead
+  std::fill(values.begin(), values.begin() + num_leading_nulls, values[num_leading_nulls]);
+  col->Compressed() = CompressedColumn::Encode(values, attr_size);
+}
+
+void BlockCompactor::ReleaseCompressedColumns(RawBlock *const block) {
+  const TupleAccessStrategy &accessor = block->data_table_->accessor_;
+  const BlockLayout &layout = accessor.GetBlockLayout();
+  const ArrowBlockMetadata &metadata = accessor.GetArrowBlockMetadata(block);
+  std::vector<std::pair<uint32_t, uint32_t>> ranges;
+  for (col_id_t col_id : layout.AllColumns()) {
+    if (layout.IsVarlen(col_id) ||
+        metadata.GetColumnInfo(layout, col_id).Compressed().Encoding() == ColumnEncoding::UNCOMPRESSED)
+      continue;
+    // Transactional reads and Arrow exports still read the raw values, which the evictor faults back in for them
+    const auto begin = static_cast<uint32_t>(accessor.ColumnStart(block, col_id) - reinterpret_cast<byte *>(block));
+    ranges.emplace_back(begin, begin + layout.NumSlots() * layout.AttrSize(col_id));
+  }
+  // A writer may have thawed the block in the meantime, in which case nothing is released
+  if (!ranges.empty()) bytes_released_ += evictor_->EvictRanges(block, ranges);
+}
+
 void BlockCompactor::CopyToArrowVarlen(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata,
                                        col_id_t col_id, common::RawConcurrentBitmap *column_bitmap,
                                        ArrowColumnInfo *col, VarlenEntry *values) {
@@ -0,0 +1,21 @@
+#include "storage/block_compactor_thread.h"
+
+namespace terrier::storage {
+BlockCompactorThread::BlockCompactorThread(
+    common::ManagedPointer<BlockCompactor> compactor, common::ManagedPointer<AccessObserver> observer,
+    common::ManagedPointer<BlockStore> block_store,
+    common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
+    common::ManagedPointer<transaction::TransactionManager> txn_manager, CompactionPolicy policy,
+    std::chrono::microseconds compaction_period)
+    : compactor_(compactor),
+      observer_(observer),
+      block_store_(block_store),
+      deferred_action_manager_(deferred_action_manager),
+      txn_manager_(txn_manager),
+      policy_(policy),
+      run_compaction_(true),
+      compaction_paused_(false),
+      compaction_period_(compaction_period),
+      compaction_thread_(std::thread([this] { CompactionThreadLoop(); })) {}
+
+}  // namespace terrier::storage
@@ -0,0 +1,243 @@
+#include "storage/block_evictor.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/write_ahead_log/log_io.h"
+
+namespace terrier::storage {
+
+BlockEvictor::BlockEvictor(const std::string &swap_file_path, const uint64_t max_blocks, const uint16_t num_nodes)
+    : fd_(PosixIoWrappers::Open(swap_file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR)),
+      page_size_(static_cast<uint64_t>(sysconf(_SC_PAGESIZE))),
+      max_blocks_(max_blocks),
+      arena_size_((max_blocks + 1) * common::Constants::BLOCK_SIZE),
+      num_allocated_(num_nodes, 0),
+      free_blocks_(num_nodes) {
+  TERRIER_ASSERT(common::Constants::BLOCK_SIZE % page_size_ == 0 && page_size_ < common::Constants::BLOCK_SIZE,
+                 "A block must span more than one page");
+  TERRIER_ASSERT(num_nodes > 0, "There is always at least one NUMA node");
+  // The swap file is scratch space that is useless after a restart, so don't leave it behind
+  if (unlink(swap_file_path.c_str()) == -1) {
+    PosixIoWrappers::Close(fd_);
+    throw std::runtime_error("Failed to unlink swap file with errno " + std::to_string(errno));
+  }
+  // The file is sparse, so it only takes up disk space for the pages written to it
+  if (ftruncate(fd_, static_cast<off_t>(arena_size_)) == -1) {
+    PosixIoWrappers::Close(fd_);
+    throw std::runtime_error("Failed to size swap file with errno " + std::to_string(errno));
+  }
+  // Memory for the private copies of pages is only taken as the blocks are written to, as it is on the heap
+  void *const mapped = mmap(nullptr, arena_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_NORESERVE, fd_, 0);
+  if (mapped == MAP_FAILED) {
+    PosixIoWrappers::Close(fd_);
+    throw std::runtime_error("Failed to map swap file with errno " + std::to_string(errno));
+  }
+  arena_ = reinterpret_cast<byte *>(mapped);
+  const uintptr_t misalignment = reinterpret_cast<uintptr_t>(arena_) % common::Constants::BLOCK_SIZE;
+  blocks_ = arena_ + (misalignment == 0 ? 0 : common::Constants::BLOCK_SIZE - misalignment);
+  // Binding the share of every node once splits the mapping into one part per node, rather than one per block
+  for (uint16_t node = 0; node < num_nodes; node++)
+    common::NumaUtil::BindMemory(blocks_ + NodeStart(node) * common::Constants::BLOCK_SIZE,
+                                 NodeShare(node) * common::Constants::BLOCK_SIZE, node);
+}
+
+BlockEvictor::~BlockEvictor() {
+  munmap(arena_, arena_size_);
+  PosixIoWrappers::Close(fd_);
+}
+
+bool BlockEvictor::Evict(RawBlock *const block) {
+  if (!Contains(block)) return false;
+  // Shut out writers while the block is written out, or their changes could be lost when we drop the pages of the
+  // block. Readers do not check the state and go on reading, which is fine since the contents of the block do not
+  // change.
+  std::atomic<BlockState> *const state = block->controller_.GetBlockState();
+  BlockState expected = BlockState::FROZEN;
+  if (!state->compare_exchange_strong(expected, BlockState::FREEZING)) return false;
+
+  try {
+    WritePages(block, page_size_, common::Constants::BLOCK_SIZE, true);
+  } catch (...) {
+    state->store(BlockState::FROZEN);
+    throw;
+  }
+
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    evicted_blocks_.insert(block);
+    partially_evicted_blocks_.erase(block);
+  }
+  state->store(BlockState::FROZEN);
+  return true;
+}
+
+uint64_t BlockEvictor::EvictRanges(RawBlock *const block, const std::vector<std::pair<uint32_t, uint32_t>> &ranges) {
+  if (!Contains(block)) return 0;
+  std::atomic<BlockState> *const state = block->controller_.GetBlockState();
+  BlockState expected = BlockState::FROZEN;
+  if (!state->compare_exchange_strong(expected, BlockState::FREEZING)) return 0;
+
+  uint64_t num_released = 0;
+  try {
+    for (const auto &range : ranges) {
+      const auto pages = ReleasablePages(range.first, range.second);
+      if (pages.first == pages.second) continue;
+      // Only the released pages read from the swap file, so the rest of the block need not be written
+      WritePages(block, pages.first, pages.second, false);
+      num_released += pages.second - pages.first;
+    }
+  } catch (...) {
+    // Ranges released before the failure keep reading from the swap file
+    TrackPartialEviction(block, num_released);
+    state->store(BlockState::FROZEN);
+    throw;
+  }
+  TrackPartialEviction(block, num_released);
+  state->store(BlockState::FROZEN);
+  return num_released;
+}
+
+uint32_t BlockEvictor::EvictFrozenBlocks(DataTable *const table) {
+  std::vector<RawBlock *> blocks;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&table->blocks_latch_);
+    blocks = table->blocks_;
+  }
+  uint32_t num_evicted = 0;
+  for (RawBlock *const block : blocks) {
+    bool evicted_whole;
+    {
+      common::SpinLatch::ScopedSpinLatch guard(&latch_);
+      evicted_whole = evicted_blocks_.count(block) != 0 && partially_evicted_blocks_.count(block) == 0;
+    }
+    if (!evicted_whole && Evict(block)) num_evicted++;
+  }
+  return num_evicted;
+}
+
+bool BlockEvictor::Restore(RawBlock *const block) {
+  if (!IsEvicted(block)) return true;
+  // Shut out writers while the block is restored, or their changes could race with the pages being copied
+  std::atomic<BlockState> *const state = block->controller_.GetBlockState();
+  BlockState expected = BlockState::FROZEN;
+  if (!state->compare_exchange_strong(expected, BlockState::FREEZING)) return false;
+
+  // Writing to a page gives the block a private copy of it, after which the page no longer reads from the swap file.
+  // Concurrent readers see the same contents throughout.
+  byte *const start = reinterpret_cast<byte *>(block);
+  for (uint64_t page = page_size_; page < common::Constants::BLOCK_SIZE; page += page_size_)
+    reinterpret_cast<std::atomic<uint8_t> *>(start + page)->fetch_or(0);
+  PunchHole(block, page_size_, common::Constants::BLOCK_SIZE);
+
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    evicted_blocks_.erase(block);
+    partially_evicted_blocks_.erase(block);
+  }
+  state->store(BlockState::FROZEN);
+  return true;
+}
+
+void BlockEvictor::OnRelease(const std::vector<RawBlock *> &blocks) {
+  std::vector<RawBlock *> evicted;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    for (RawBlock *const block : blocks) {
+      if (evicted_blocks_.erase(block) != 0) evicted.push_back(block);
+      partially_evicted_blocks_.erase(block);
+    }
+  }
+  // Nobody needs the contents anymore. The block store may hand the blocks out again, so the header stays in place.
+  for (RawBlock *const block : evicted) PunchHole(block, page_size_, common::Constants::BLOCK_SIZE);
+}
+
+void *BlockEvictor::AllocateBlock(const uint16_t numa_node) {
+  const auto node = static_cast<uint16_t>(numa_node % num_allocated_.size());
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (!free_blocks_[node].empty()) {
+    byte *const result = free_blocks_[node].back();
+    free_blocks_[node].pop_back();
+    return result;
+  }
+  if (num_allocated_[node] == NodeShare(node)) return nullptr;
+  return blocks_ + (NodeStart(node) + num_allocated_[node]++) * common::Constants::BLOCK_SIZE;
+}
+
+void BlockEvictor::FreeBlock(void *const memory) {
+  auto *const block = reinterpret_cast<RawBlock *>(memory);
+  // Returns the memory of the block, and discards what it may have in the swap file. Should dropping the pages fail,
+  // they stay in memory until the block is handed out again, which does not need their contents.
+  DropPages(block, 0, common::Constants::BLOCK_SIZE);
+  PunchHole(block, 0, common::Constants::BLOCK_SIZE);
+
+  const uint64_t index =
+      static_cast<uint64_t>(reinterpret_cast<byte *>(memory) - blocks_) / common::Constants::BLOCK_SIZE;
+  uint16_t node = 0;
+  while (index >= NodeStart(node) + NodeShare(node)) node++;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  // Blocks released one at a time do not notify the release listeners
+  evicted_blocks_.erase(block);
+  partially_evicted_blocks_.erase(block);
+  free_blocks_[node].push_back(reinterpret_cast<byte *>(memory));
+}
+
+void BlockEvictor::TrackPartialEviction(RawBlock *const block, const uint64_t num_released) {
+  if (num_released == 0) return;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (evicted_blocks_.insert(block).second) partially_evicted_blocks_.insert(block);
+}
+
+void BlockEvictor::WritePages(RawBlock *const block, const uint64_t begin, const uint64_t end, const bool wait) {
+  const auto offset = static_cast<off_t>(FileOffset(block) + begin);
+  const auto size = static_cast<off_t>(end - begin);
+  if (lseek(fd_, offset, SEEK_SET) == -1)
+    throw std::runtime_error("Failed to seek in swap file with errno " + std::to_string(errno));
+  PosixIoWrappers::WriteFully(fd_, reinterpret_cast<byte *>(block) + begin, end - begin);
+  if (wait) {
+    // Make the pages clean so that they can be dropped from the page cache right away. Otherwise, the memory is only
+    // freed once the OS gets around to writing them back.
+    PosixIoWrappers::SyncData(fd_);
+  } else {
+#ifndef __APPLE__
+    // Start writing the pages back, so that they become clean and can be dropped soon, but don't wait for the disk
+    sync_file_range(fd_, offset, size, SYNC_FILE_RANGE_WRITE);
+#endif
+  }
+  // The file now holds the same contents as the private copies, so concurrent readers fault the same contents back in
+  if (!DropPages(block, begin, end))
+    throw std::runtime_error("Failed to drop pages of block with errno " + std::to_string(errno));
+#ifndef __APPLE__
+  if (wait) posix_fadvise(fd_, offset, size, POSIX_FADV_DONTNEED);
+#endif
+}
+
+bool BlockEvictor::DropPages(RawBlock *const block, const uint64_t begin, const uint64_t end) {
+  byte *const start = reinterpret_cast<byte *>(block) + begin;
+#ifdef __APPLE__
+  // madvise does not drop the private copies of a file mapping here, but mapping the file over them again does. Unlike
+  // on Linux, this costs a mapping per range.
+  return mmap(start, end - begin, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd_,
+              static_cast<off_t>(FileOffset(block) + begin)) != MAP_FAILED;
+#else
+  // Leaves the mapping itself alone, so it is never split up
+  return madvise(start, end - begin, MADV_DONTNEED) == 0;
+#endif
+}
+
+void BlockEvictor::PunchHole(RawBlock *const block, const uint64_t begin, const uint64_t end) {
+  // Failure only leaves the space in use until the block is evicted again, or handed out to another table and evicted
+#ifndef __APPLE__
+  fallocate(fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, static_cast<off_t>(FileOffset(block) + begin),
+            static_cast<off_t>(end - begin));
+#endif
+}
+
+}  // namespace terrier::storage
@@ -0,0 +1,174 @@
+#include "storage/compressed_column.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "common/allocator.h"
+
+namespace terrier::storage {
+
+namespace {
+// Number of bits needed to represent the given unsigned value
+uint8_t BitWidth(const uint64_t value) { return value == 0 ? 0 : static_cast<uint8_t>(64 - __builtin_clzll(value)); }
+
+// Number of 64-bit words needed to bit-pack the given number of values. There is always a word to spare so that
+// unpacking a value can read the word after it without checking for the end of the buffer.
+uint64_t PackedWords(const uint32_t num_values, const uint8_t bit_width) {
+  return (static_cast<uint64_t>(num_values) * bit_width + 63) / 64 + 1;
+}
+
+void Pack(uint64_t *const words, const uint32_t index, const uint8_t bit_width, const uint64_t value) {
+  if (bit_width == 0) return;
+  const uint64_t bit = static_cast<uint64_t>(index) * bit_width;
+  const uint64_t word = bit / 64, shift = bit % 64;
+  words[word] |= value << shift;
+  if (shift + bit_width > 64) words[word + 1] |= value >> (64 - shift);
+}
+}  // namespace
+
+CompressedColumn CompressedColumn::Encode(const std::vector<int64_t> &values, const uint8_t attr_size) {
+  CompressedColumn result;
+  const auto num_values = static_cast<uint32_t>(values.size());
+  if (num_values == 0) return result;
+
+  // Gather what it takes to size up every encoding in a single pass. All arithmetic is on unsigned values, so that
+  // differences wrap around instead of overflowing.
+  int64_t min = values[0], max = values[0];
+  int64_t min_delta = 0, max_delta = 0;
+  uint32_t num_runs = 1;
+  for (uint32_t i = 1; i < num_values; i++) {
+    min = std::min(min, values[i]);
+    max = std::max(max, values[i]);
+    const auto delta = static_cast<int64_t>(static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]));
+    min_delta = i == 1 ? delta : std::min(min_delta, delta);
+    max_delta = i == 1 ? delta : std::max(max_delta, delta);
+    if (values[i] != values[i - 1]) num_runs++;
+  }
+
+  const uint8_t for_width = BitWidth(static_cast<uint64_t>(max) - static_cast<uint64_t>(min));
+  const uint8_t delta_width = BitWidth(static_cast<uint64_t>(max_delta) - static_cast<uint64_t>(min_delta));
+  const uint32_t num_checkpoints = (num_values + DELTA_CHECKPOINT_INTERVAL - 1) / DELTA_CHECKPOINT_INTERVAL;
+  const uint64_t uncompressed_size = static_cast<uint64_t>(num_values) * attr_size;
+  const uint64_t for_size = PackedWords(num_values, for_width) * sizeof(uint64_t);
+  const uint64_t delta_size =
+      num_checkpoints * sizeof(int64_t) + PackedWords(num_values, delta_width) * sizeof(uint64_t);
+  const uint64_t rle_size = num_runs * (sizeof(int64_t) + sizeof(uint32_t));
+
+  const uint64_t best_size = std::min({for_size, delta_size, rle_size});
+  if (best_size >= uncompressed_size) return result;
+
+  result.num_values_ = num_values;
+  result.size_ = best_size;
+  result.buffer_ = common::AllocationUtil::AllocateAligned(best_size);
+  std::memset(result.buffer_, 0, best_size);
+  if (best_size == for_size) {
+    result.encoding_ = ColumnEncoding::FRAME_OF_REFERENCE;
+    result.bit_width_ = for_width;
+    result.base_ = min;
+    auto *words = reinterpret_cast<uint64_t *>(result.buffer_);
+    for (uint32_t i = 0; i < num_values; i++)
+      Pack(words, i, for_width, static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(min));
+  } else if (best_size == rle_size) {
+    result.encoding_ = ColumnEncoding::RUN_LENGTH;
+    result.num_runs_ = num_runs;
+    auto *run_values = reinterpret_cast<int64_t *>(result.buffer_);
+    auto *run_ends = reinterpret_cast<uint32_t *>(run_values + num_runs);
+    uint32_t run = 0;
+    for (uint32_t i = 0; i < num_values; i++) {
+      if (i > 0 && values[i] != values[i - 1]) run_ends[run++] = i;
+      run_values[run] = values[i];
+    }
+    run_ends[run] = num_values;
+  } else {
+    result.encoding_ = ColumnEncoding::DELTA;
+    result.bit_width_ = delta_width;
+    result.base_ = min_delta;
+    auto *checkpoints = reinterpret_cast<int64_t *>(result.buffer_);
+    auto *words = reinterpret_cast<uint64_t *>(checkpoints + num_checkpoints);
+    for (uint32_t i = 0; i < num_values; i++) {
+      if (i % DELTA_CHECKPOINT_INTERVAL == 0) {
+        checkpoints[i / DELTA_CHECKPOINT_INTERVAL] = values[i];
+        continue;
+      }
+      const uint64_t delta = static_cast<uint64_t>(values[i]) - static_cast<uint64_t>(values[i - 1]);
+      Pack(words, i, delta_width, delta - static_cast<uint64_t>(min_delta));
+    }
+  }
+  return result;
+}
+
+void CompressedColumn::Decode(const uint32_t start, const uint32_t count, const uint8_t attr_size,
+                              byte *const out) const {
+  TERRIER_ASSERT(encoding_ != ColumnEncoding::UNCOMPRESSED, "Cannot decode an uncompressed column");
+  TERRIER_ASSERT(start + count <= num_values_, "Decoding past the end of the column");
+  switch (attr_size) {
+    case 1:
+      DecodeInto(start, count, reinterpret_cast<int8_t *>(out));
+      break;
+    case 2:
+      DecodeInto(start, count, reinterpret_cast<int16_t *>(out));
+      break;
+    case 4:
+      DecodeInto(start, count, reinterpret_cast<int32_t *>(out));
+      break;
+    case 8:
+      DecodeInto(start, count, reinterpret_cast<int64_t *>(out));
+      break;
+    default:
+      throw std::runtime_error("unexpected control flow");
+  }
+}
+
+template <class T>
+void CompressedColumn::DecodeInto(const uint32_t start, const uint32_t count, T *const out) const {
+  const auto base = static_cast<uint64_t>(base_);
+  switch (encoding_) {
+    case ColumnEncoding::FRAME_OF_REFERENCE: {
+      const auto *words = reinterpret_cast<const uint64_t *>(buffer_);
+      for (uint32_t i = 0; i < count; i++) out[i] = static_cast<T>(base + Unpack(words, start + i));
+      break;
+    }
+    case ColumnEncoding::DELTA: {
+      const uint32_t num_checkpoints = (num_values_ + DELTA_CHECKPOINT_INTERVAL - 1) / DELTA_CHECKPOINT_INTERVAL;
+      const auto *checkpoints = reinterpret_cast<const int64_t *>(buffer_);
+      const auto *words = reinterpret_cast<const uint64_t *>(checkpoints + num_checkpoints);
+      // Sum up the differences since the closest full value before the range, and then through the range
+      const uint32_t checkpoint = start / DELTA_CHECKPOINT_INTERVAL;
+      auto value = static_cast<uint64_t>(checkpoints[checkpoint]);
+      for (uint32_t i = checkpoint * DELTA_CHECKPOINT_INTERVAL + 1; i <= start; i++) value += base + Unpack(words, i);
+      out[0] = static_cast<T>(value);
+      for (uint32_t i = start + 1; i < start + count; i++) {
+        value = i % DELTA_CHECKPOINT_INTERVAL == 0 ? static_cast<uint64_t>(checkpoints[i / DELTA_CHECKPOINT_INTERVAL])
+                                                   : value + base + Unpack(words, i);
+        out[i - start] = static_cast<T>(value);
+      }
+      break;
+    }
+    case ColumnEncoding::RUN_LENGTH: {
+      const auto *run_values = reinterpret_cast<const int64_t *>(buffer_);
+      const auto *run_ends = reinterpret_cast<const uint32_t *>(run_values + num_runs_);
+      // Find the run the range starts in, and then walk the runs along with the range
+      uint32_t run = static_cast<uint32_t>(std::upper_bound(run_ends, run_ends + num_runs_, start) - run_ends);
+      for (uint32_t i = start; i < start + count; i++) {
+        if (i == run_ends[run]) run++;
+        out[i - start] = static_cast<T>(run_values[run]);
+      }
+      break;
+    }
+    default:
+      throw std::runtime_error("unexpected control flow");
+  }
+}
+
+uint64_t CompressedColumn::Unpack(const uint64_t *const words, const uint32_t index) const {
+  if (bit_width_ == 0) return 0;
+  const uint64_t bit = static_cast<uint64_t>(index) * bit_width_;
+  const uint64_t word = bit / 64, shift = bit % 64;
+  uint64_t value = words[word] >> shift;
+  if (shift + bit_width_ > 64) value |= words[word + 1] << (64 - shift);
+  return bit_width_ == 64 ? value : value & ((1ULL << bit_width_) - 1);
+}
+
+}  // namespace terrier::storage
@@ -1,11 +1,14 @@
 #include "storage/data_table.h"
 
+#include <algorithm>
+#include <cstring>
 #include <list>
 
 #include "common/allocator.h"
 #include "execution/sql/vector_projection.h"
 #include "storage/block_access_controller.h"
 #include "storage/storage_util.h"
+#include "storage/varlen_arena.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_util.h"
 
@@ -30,10 +33,12 @@ DataTable::~DataTable() {
   common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
   for (RawBlock *block : blocks_) {
     StorageUtil::DeallocateVarlens(block, accessor_);
-    for (col_id_t i : accessor_.GetBlockLayout().Varlens())
+    delete block->varlen_arena_.load();
+    for (col_id_t i : accessor_.GetBlockLayout().AllColumns())
       accessor_.GetArrowBlockMetadata(block).GetColumnInfo(accessor_.GetBlockLayout(), i).Deallocate();
-    block_store_->Release(block);
   }
+  // Components that keep track of blocks, such as the compactor, let go of them before anyone else can get them
+  block_store_->Release(blocks_);
 }
 
 bool DataTable::Select(const common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
@@ -43,13 +48,16 @@ bool DataTable::Select(const common::ManagedPointer<transaction::TransactionCont
 
 void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *const start_pos,
                      ProjectedColumns *const out_buffer) const {
-  // TODO(Tianyu): So far this is not that much better than tuple-at-a-time access,
-  // but can be improved if block is read-only, or if we implement version synopsis, to just use std::memcpy when it's
-  // safe
   uint32_t filled = 0;
-  while (filled < out_buffer->MaxTuples() && *start_pos != end()) {
-    ProjectedColumns::RowView row = out_buffer->InterpretAsRow(filled);
+  while (filled < out_buffer->MaxTuples() && *start_pos != end() && **start_pos != SlotIterator::InvalidTupleSlot()) {
     const TupleSlot slot = **start_pos;
+    // Blocks without versions look the same to every transaction, so copy as much of them as fits in one go
+    const uint32_t num_slots = NumCleanSlots(slot, out_buffer->MaxTuples() - filled);
+    if (num_slots > 0 && CopyCleanTuples(slot, num_slots, out_buffer, &filled)) {
+      AdvanceInBlock(start_pos, slot.GetOffset() + num_slots);
+      continue;
+    }
+    ProjectedColumns::RowView row = out_buffer->InterpretAsRow(filled);
     // Only fill the buffer with valid, visible tuples
     if (SelectIntoBuffer(txn, slot, &row)) {
       out_buffer->TupleSlots()[filled] = slot;
@@ -61,12 +69,43 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
 }
 
 void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *const start_pos,
-                     execution::sql::VectorProjection *const out_buffer) const {
+                     execution::sql::VectorProjection *const out_buffer, const FrozenBlockFilter &block_filter) const {
   uint32_t filled = 0;
   while (filled < out_buffer->GetTupleCapacity() && *start_pos != end() &&
          **start_pos != SlotIterator::InvalidTupleSlot()) {
     execution::sql::VectorProjection::RowView row = out_buffer->InterpretAsRow(filled);
     const TupleSlot slot = **start_pos;
+    // Frozen blocks are always full, so the end of the table can never be inside of a skipped block
+    if (block_filter && slot.GetOffset() == 0 &&
+        slot.GetBlock()->controller_.GetBlockState()->load() == BlockState::FROZEN &&
+        !block_filter(accessor_.GetArrowBlockMetadata(slot.GetBlock()))) {
+      start_pos->current_slot_ = {slot.GetBlock(), accessor_.GetBlockLayout().NumSlots() - 1};
+      ++(*start_pos);
+      continue;
+    }
+    if (slot.GetBlock()->controller_.GetBlockState()->load() == BlockState::FROZEN) {
+      const uint32_t num_records = accessor_.GetArrowBlockMetadata(slot.GetBlock()).NumRecords();
+      const auto capacity = static_cast<uint32_t>(out_buffer->GetTupleCapacity());
+      const uint32_t num_tuples =
+          slot.GetOffset() < num_records ? std::min(capacity - filled, num_records - slot.GetOffset()) : 0;
+      // Otherwise, a writer got to the block first, and the tuples have to be selected one by one after all
+      if (num_tuples == 0 || CopyFrozenTuples(slot, num_tuples, out_buffer, filled)) {
+        filled += num_tuples;
+        if (slot.GetOffset() + num_tuples < num_records) {
+          start_pos->current_slot_ = {slot.GetBlock(), slot.GetOffset() + num_tuples};
+        } else {
+          // Tuples of a frozen block are contiguous, so there is nothing past them
+          start_pos->current_slot_ = {slot.GetBlock(), accessor_.GetBlockLayout().NumSlots() - 1};
+          ++(*start_pos);
+        }
+        continue;
+      }
+    }
+    const uint32_t num_slots = NumCleanSlots(slot, static_cast<uint32_t>(out_buffer->GetTupleCapacity()) - filled);
+    if (num_slots > 0 && CopyCleanTuples(slot, num_slots, out_buffer, &filled)) {
+      AdvanceInBlock(start_pos, slot.GetOffset() + num_slots);
+      continue;
+    }
     // Only fill the buffer with valid, visible tuples
     if (SelectIntoBuffer(txn, slot, &row)) {
       row.SetTupleSlot(slot);
@@ -77,6 +116,123 @@ void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContex
   out_buffer->Reset(filled);
 }
 
+bool DataTable::CopyFrozenTuples(const TupleSlot start, const uint32_t num_tuples,
+                                 execution::sql::VectorProjection *const out_buffer, const uint32_t row) const {
+  RawBlock *const block = start.GetBlock();
+  // Writers wait for in-place readers to leave before they thaw the block, so nothing changes while we copy
+  if (!block->controller_.TryAcquireInPlaceRead()) return false;
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  const ArrowBlockMetadata &metadata = accessor_.GetArrowBlockMetadata(block);
+  // The block may have been thawed and frozen again with fewer records since the caller looked at it
+  if (start.GetOffset() + num_tuples > metadata.NumRecords()) {
+    block->controller_.ReleaseInPlaceRead();
+    return false;
+  }
+  for (uint16_t i = 0; i < out_buffer->GetColumnCount(); i++) {
+    const col_id_t col_id = out_buffer->ColumnIds()[i];
+    const uint16_t attr_size = layout.AttrSize(col_id);
+    execution::sql::Vector *const column = out_buffer->GetColumn(i);
+    byte *const out = column->GetData() + row * attr_size;
+    const CompressedColumn &compressed = metadata.GetColumnInfo(layout, col_id).Compressed();
+    if (!layout.IsVarlen(col_id) && compressed.Encoding() != ColumnEncoding::UNCOMPRESSED)
+      compressed.Decode(start.GetOffset(), num_tuples, static_cast<uint8_t>(attr_size), out);
+    else
+      std::memcpy(out, accessor_.AccessWithoutNullCheck(start, col_id), num_tuples * attr_size);
+
+    // Columns without nulls leave the null bitmap of the block alone, so that the pages it is on are not touched
+    if (metadata.NullCount(col_id) == 0) {
+      for (uint32_t j = 0; j < num_tuples; j++) column->SetNull(row + j, false);
+    } else {
+      const common::RawConcurrentBitmap *const nulls = accessor_.ColumnNullBitmap(block, col_id);
+      for (uint32_t j = 0; j < num_tuples; j++) column->SetNull(row + j, !nulls->Test(start.GetOffset() + j));
+    }
+  }
+  for (uint32_t j = 0; j < num_tuples; j++) out_buffer->SetTupleSlot({block, start.GetOffset() + j}, row + j);
+  block->controller_.ReleaseInPlaceRead();
+  return true;
+}
+
+uint32_t DataTable::NumCleanSlots(const TupleSlot start, const uint32_t room) const {
+  RawBlock *const block = start.GetBlock();
+  const uint32_t insert_head = block->GetInsertHead();
+  if (block->num_versioned_slots_.load() != 0 || start.GetOffset() >= insert_head) return 0;
+  return std::min(room, insert_head - start.GetOffset());
+}
+
+bool DataTable::CopyCleanTuples(const TupleSlot start, const uint32_t num_slots, ProjectedColumns *const out_buffer,
+                                uint32_t *const filled) const {
+  RawBlock *const block = start.GetBlock();
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  const uint32_t end = start.GetOffset() + num_slots;
+  uint32_t row = *filled;
+  uint32_t offset = start.GetOffset();
+  while (offset < end) {
+    // Deleted and unallocated slots split the range into runs of visible tuples, each copied column by column
+    while (offset < end && !Visible({block, offset}, accessor_)) offset++;
+    const uint32_t run_begin = offset;
+    while (offset < end && Visible({block, offset}, accessor_)) offset++;
+    const uint32_t run_size = offset - run_begin;
+    if (run_size == 0) break;
+    for (uint16_t i = 0; i < out_buffer->NumColumns(); i++) {
+      const col_id_t col_id = out_buffer->ColumnIds()[i];
+      const uint16_t attr_size = layout.AttrSize(col_id);
+      std::memcpy(out_buffer->ColumnStart(i) + row * attr_size,
+                  accessor_.ColumnStart(block, col_id) + run_begin * attr_size, run_size * attr_size);
+      const common::RawConcurrentBitmap *const nulls = accessor_.ColumnNullBitmap(block, col_id);
+      common::RawBitmap *const out_nulls = out_buffer->ColumnNullBitmap(i);
+      for (uint32_t j = 0; j < run_size; j++) out_nulls->Set(row + j, nulls->Test(run_begin + j));
+    }
+    for (uint32_t j = 0; j < run_size; j++) out_buffer->TupleSlots()[row + j] = {block, run_begin + j};
+    row += run_size;
+  }
+  // A writer installs a version before it changes anything in place, so the block staying without versions means
+  // nothing was written while copying
+  if (block->num_versioned_slots_.load() != 0) return false;
+  *filled = row;
+  return true;
+}
+
+bool DataTable::CopyCleanTuples(const TupleSlot start, const uint32_t num_slots,
+                                execution::sql::VectorProjection *const out_buffer, uint32_t *const filled) const {
+  RawBlock *const block = start.GetBlock();
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  const uint32_t end = start.GetOffset() + num_slots;
+  uint32_t row = *filled;
+  uint32_t offset = start.GetOffset();
+  while (offset < end) {
+    // Same as above, only with the column layout of a vector projection
+    while (offset < end && !Visible({block, offset}, accessor_)) offset++;
+    const uint32_t run_begin = offset;
+    while (offset < end && Visible({block, offset}, accessor_)) offset++;
+    const uint32_t run_size = offset - run_begin;
+    if (run_size == 0) break;
+    for (uint16_t i = 0; i < out_buffer->GetColumnCount(); i++) {
+      const col_id_t col_id = out_buffer->ColumnIds()[i];
+      const uint16_t attr_size = layout.AttrSize(col_id);
+      execution::sql::Vector *const column = out_buffer->GetColumn(i);
+      std::memcpy(column->GetData() + row * attr_size, accessor_.ColumnStart(block, col_id) + run_begin * attr_size,
+                  run_size * attr_size);
+      const common::RawConcurrentBitmap *const nulls = accessor_.ColumnNullBitmap(block, col_id);
+      for (uint32_t j = 0; j < run_size; j++) column->SetNull(row + j, !nulls->Test(run_begin + j));
+    }
+    for (uint32_t j = 0; j < run_size; j++) out_buffer->SetTupleSlot({block, run_begin + j}, row + j);
+    row += run_size;
+  }
+  if (block->num_versioned_slots_.load() != 0) return false;
+  *filled = row;
+  return true;
+}
+
+void DataTable::AdvanceInBlock(SlotIterator *const it, const uint32_t offset) const {
+  const uint32_t num_slots = accessor_.GetBlockLayout().NumSlots();
+  if (offset < num_slots) {
+    it->current_slot_ = {it->current_slot_.GetBlock(), offset};
+  } else {
+    it->current_slot_ = {it->current_slot_.GetBlock(), num_slots - 1};
+    ++(*it);
+  }
+}
+
 DataTable::SlotIterator &DataTable::SlotIterator::operator++() {
   // Jump to the next block if already the last slot in the block.
   if (current_slot_.GetOffset() == table_->accessor_.GetBlockLayout().NumSlots() - 1) {
@@ -124,6 +280,14 @@ DataTable::SlotIterator DataTable::end() const {  // NOLINT for STL name compabi
   return {this, last_block_index, SlotIterator::ADVANCE_TO_THE_END, insert_head};
 }
 
+uint32_t DataTable::GetNumFrozenBlocks() const {
+  common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+  uint32_t result = 0;
+  for (RawBlock *block : blocks_)
+    if (block->controller_.GetBlockState()->load() == BlockState::FROZEN) result++;
+  return result;
+}
+
 DataTable::SlotIterator DataTable::GetBlockedSlotIterator(uint32_t start, uint32_t end) const {
   TERRIER_ASSERT(start <= end, "Start index should come before ending index.");
   TERRIER_ASSERT(static_cast<int32_t>(end - start - 1) >= 0, "Too many blocks or sign issue.");
@@ -160,6 +324,10 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     // Update the next pointer of the new head of the version chain
     undo->Next() = version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
+  // Scans stop copying the block in bulk before anything is written in place
+  if (version_ptr == nullptr) slot.GetBlock()->num_versioned_slots_++;
+  // We hold the write lock, so this is as good a time as any to drop the versions nobody can see anymore
+  PruneVersionChain(undo, txn->PruneHorizon());
 
   // Update in place with the new value.
   for (uint16_t i = 0; i < redo.NumColumns(); i++) {
@@ -170,6 +338,7 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     // that's difficult with this implementation
     StorageUtil::CopyAttrFromProjection(accessor_, slot, redo, i);
   }
+  InternVarlens(slot, redo);
 
   return true;
 }
@@ -195,7 +364,28 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
   TERRIER_ASSERT(redo.NumColumns() == accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
                  "The input buffer never changes the version pointer column, so it should have  exactly 1 fewer "
                  "attribute than the DataTable's layout.");
+  uint32_t num_claimed UNUSED_ATTRIBUTE;
+  const TupleSlot result = ClaimSlots(1, &num_claimed);
+  TERRIER_ASSERT(num_claimed == 1, "A slot should always be claimed");
+  InsertInto(txn, redo, result);
+  return result;
+}
 
+void DataTable::InsertBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                            ProjectedColumns *const columns) {
+  TERRIER_ASSERT(columns->NumColumns() == accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
+                 "The input buffer never changes the version pointer column, so it should have  exactly 1 fewer "
+                 "attribute than the DataTable's layout.");
+  const uint32_t num_tuples = columns->NumTuples();
+  for (uint32_t row = 0; row < num_tuples;) {
+    uint32_t num_claimed;
+    const TupleSlot first = ClaimSlots(num_tuples - row, &num_claimed);
+    InsertRangeInto(txn, columns, row, first, num_claimed);
+    row += num_claimed;
+  }
+}
+
+TupleSlot DataTable::ClaimSlots(const uint32_t max_slots, uint32_t *const num_claimed) {
   // Insertion header points to the first block that has free tuple slots
   // Once a txn arrives, it will start from the insertion header to find the first
   // idle (no other txn is trying to get tuple slots in that block) and non-full block.
@@ -204,9 +394,12 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
   // The first bit of block insert_head_ is used to indicate if the block is busy
   // If the first bit is 1, it indicates one txn is writing to the block.
 
-  TupleSlot result;
+  // If the block store places blocks on the node of the thread filling them, only insert into blocks on our node. Once
+  // our node runs out of blocks, inserts go to blocks of any node, including those that spilled over from ours.
+  const uint16_t numa_node = block_store_->InsertionNode();
   auto block_index = insertion_head_.load();
   RawBlock *block;
+  uint32_t start;
 
   while (true) {
     // No free block left
@@ -214,7 +407,7 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
       RawBlock *new_block = NewBlock();
       TERRIER_ASSERT(accessor_.SetBlockBusyStatus(new_block), "Status of new block should not be busy");
       // No need to flip the busy status bit
-      accessor_.Allocate(new_block, &result);
+      *num_claimed = accessor_.AllocateRange(new_block, max_slots, &start);
       // take latch
       common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
       // insert block
@@ -228,9 +421,13 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
       block = blocks_[block_index];
     }
 
-    if (accessor_.SetBlockBusyStatus(block)) {
+    if (numa_node != common::NumaUtil::ANY_NODE && block->numa_node_ != numa_node) {
+      // Leave the block to inserters on its own node, but move the insertion head past it if it is full
+      if (block->GetInsertHead() == accessor_.GetBlockLayout().NumSlots()) CheckMoveHead(block_index);
+    } else if (accessor_.SetBlockBusyStatus(block)) {
       // No one is inserting into this block
-      if (accessor_.Allocate(block, &result)) {
+      *num_claimed = accessor_.AllocateRange(block, max_slots, &start);
+      if (*num_claimed > 0) {
         // The block is not full, succeed
         break;
       }
@@ -245,11 +442,9 @@ TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::Transactio
   }
 
   // Do not need to wait unit finish inserting,
-  // can flip back the status bit once the thread gets the allocated tuple slot
+  // can flip back the status bit once the thread gets the allocated tuple slots
   accessor_.ClearBlockBusyStatus(block);
-  InsertInto(txn, redo, result);
-
-  return result;
+  return {block, start};
 }
 
 void DataTable::InsertInto(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo,
@@ -263,6 +458,7 @@ void DataTable::InsertInto(const common::ManagedPointer<transaction::Transaction
   TERRIER_ASSERT(dest.GetBlock()->controller_.GetBlockState()->load() == BlockState::HOT,
                  "Should only be able to insert into hot blocks");
   AtomicallyWriteVersionPtr(dest, accessor_, undo);
+  dest.GetBlock()->num_versioned_slots_++;
   // Set the logically deleted bit to present as the undo record is ready
   accessor_.AccessForceNotNull(dest, VERSION_POINTER_COLUMN_ID);
   // Update in place with the new value.
@@ -271,6 +467,98 @@ void DataTable::InsertInto(const common::ManagedPointer<transaction::Transaction
                    "Insert buffer should not change the version pointer column.");
     StorageUtil::CopyAttrFromProjection(accessor_, dest, redo, i);
   }
+  InternVarlens(dest, redo);
+}
+
+void DataTable::InternVarlen(RawBlock *const block, VarlenEntry *const entry) {
+  if (entry->IsInlined() || entry->NeedReclaim()) return;
+  if (!block_store_->UseVarlenArenas()) {
+    // Without the compactor, nothing would ever free the space of overwritten values in an arena
+    byte *const copy = common::AllocationUtil::AllocateAligned(entry->Size());
+    std::memcpy(copy, entry->Content(), entry->Size());
+    *entry = VarlenEntry::Create(copy, entry->Size(), true);
+    return;
+  }
+  VarlenArena *arena = block->varlen_arena_.load();
+  if (arena == nullptr) {
+    // First varlen copied into this block since it was frozen. If another writer beats us to it, use theirs.
+    auto *const new_arena = new VarlenArena;
+    if (block->varlen_arena_.compare_exchange_strong(arena, new_arena))
+      arena = new_arena;
+    else
+      delete new_arena;
+  }
+  byte *copy = arena->Allocate(entry->Size());
+  const bool reclaim = copy == nullptr;
+  if (reclaim) copy = common::AllocationUtil::AllocateAligned(entry->Size());
+  std::memcpy(copy, entry->Content(), entry->Size());
+  *entry = VarlenEntry::Create(copy, entry->Size(), reclaim);
+}
+
+void DataTable::InternVarlens(const TupleSlot slot, const ProjectedRow &row) {
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  for (uint16_t i = 0; i < row.NumColumns(); i++) {
+    if (!layout.IsVarlen(row.ColumnIds()[i])) continue;
+    auto *const entry = reinterpret_cast<VarlenEntry *>(accessor_.AccessWithNullCheck(slot, row.ColumnIds()[i]));
+    if (entry != nullptr) InternVarlen(slot.GetBlock(), entry);
+  }
+}
+
+void DataTable::RepointVarlens(const TupleSlot slot, ProjectedRow *const row) const {
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  for (uint16_t i = 0; i < row->NumColumns(); i++) {
+    if (!layout.IsVarlen(row->ColumnIds()[i])) continue;
+    auto *const entry = reinterpret_cast<VarlenEntry *>(row->AccessWithNullCheck(i));
+    if (entry == nullptr || entry->IsInlined() || entry->NeedReclaim()) continue;
+    *entry = *reinterpret_cast<VarlenEntry *>(accessor_.AccessWithNullCheck(slot, row->ColumnIds()[i]));
+  }
+}
+
+void DataTable::InsertRangeInto(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                ProjectedColumns *const columns, const uint32_t first_row, const TupleSlot dest,
+                                const uint32_t num_tuples) {
+  RawBlock *const block = dest.GetBlock();
+  TERRIER_ASSERT(block->controller_.GetBlockState()->load() == BlockState::HOT,
+                 "Should only be able to insert into hot blocks");
+  TupleSlot *const out_slots = columns->TupleSlots() + first_row;
+  block->num_versioned_slots_ += num_tuples;
+  // Same as InsertInto, the tuples stay logically deleted to everyone else until their undo records are installed
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    const TupleSlot slot(block, dest.GetOffset() + i);
+    TERRIER_ASSERT(accessor_.Allocated(slot), "destination slot must already be allocated");
+    TERRIER_ASSERT(accessor_.IsNull(slot, VERSION_POINTER_COLUMN_ID),
+                   "The slot needs to be logically deleted to every running transaction");
+    UndoRecord *undo = txn->UndoRecordForInsert(this, slot);
+    AtomicallyWriteVersionPtr(slot, accessor_, undo);
+    accessor_.AccessForceNotNull(slot, VERSION_POINTER_COLUMN_ID);
+    out_slots[i] = slot;
+  }
+
+  // The slots are consecutive, so each column of the batch lands in one contiguous range of the block's column
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  for (uint16_t i = 0; i < columns->NumColumns(); i++) {
+    const col_id_t col_id = columns->ColumnIds()[i];
+    TERRIER_ASSERT(col_id != VERSION_POINTER_COLUMN_ID, "Insert buffer should not change the version pointer column.");
+    const uint16_t attr_size = layout.AttrSize(col_id);
+    std::memcpy(accessor_.ColumnStart(block, col_id) + dest.GetOffset() * attr_size,
+                columns->ColumnStart(i) + first_row * attr_size, num_tuples * attr_size);
+    common::RawBitmap *const null_bitmap = columns->ColumnNullBitmap(i);
+    for (uint32_t j = 0; j < num_tuples; j++) {
+      const TupleSlot slot(block, dest.GetOffset() + j);
+      if (null_bitmap->Test(first_row + j))
+        accessor_.SetNotNull(slot, col_id);
+      else
+        accessor_.SetNull(slot, col_id);
+    }
+    if (!layout.IsVarlen(col_id)) continue;
+    auto *const entries = reinterpret_cast<VarlenEntry *>(accessor_.ColumnStart(block, col_id)) + dest.GetOffset();
+    auto *const buffer_entries = reinterpret_cast<VarlenEntry *>(columns->ColumnStart(i)) + first_row;
+    for (uint32_t j = 0; j < num_tuples; j++) {
+      if (!null_bitmap->Test(first_row + j)) continue;
+      InternVarlen(block, entries + j);
+      buffer_entries[j] = entries[j];
+    }
+  }
 }
 
 bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot) {
@@ -291,6 +579,10 @@ bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionCont
     // Update the next pointer of the new head of the version chain
     undo->Next() = version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
+  // Scans stop copying the block in bulk before anything is written in place
+  if (version_ptr == nullptr) slot.GetBlock()->num_versioned_slots_++;
+  // We hold the write lock, so this is as good a time as any to drop the versions nobody can see anymore
+  PruneVersionChain(undo, txn->PruneHorizon());
 
   // We have the write lock. Go ahead and flip the logically deleted bit to true
   accessor_.SetNull(slot, VERSION_POINTER_COLUMN_ID);
@@ -375,6 +667,8 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
     }
     version_ptr = version_ptr->Next();
   }
+  // Anything past the version we reconstructed is older still, and may already be invisible to everyone
+  if (version_ptr != nullptr) PruneVersionChain(version_ptr, txn->PruneHorizon());
 
   return visible;
 }
@@ -424,12 +718,36 @@ bool DataTable::CompareAndSwapVersionPtr(const TupleSlot slot, const TupleAccess
   return reinterpret_cast<std::atomic<UndoRecord *> *>(ptr_location)->compare_exchange_strong(expected, desired);
 }
 
+std::vector<uint16_t> DataTable::GetBlockNumaNodes() const {
+  common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+  std::vector<uint16_t> result;
+  result.reserve(blocks_.size());
+  for (const RawBlock *block : blocks_) result.push_back(block->numa_node_);
+  return result;
+}
+
 RawBlock *DataTable::NewBlock() {
   RawBlock *new_block = block_store_->Get();
   accessor_.InitializeRawBlock(this, new_block, layout_version_);
   return new_block;
 }
 
+void DataTable::PruneVersionChain(UndoRecord *const start, const transaction::timestamp_t prune_horizon) const {
+  if (prune_horizon == transaction::INITIAL_TXN_TIMESTAMP) return;
+  UndoRecord *curr = start;
+  for (uint32_t i = 0; i < MAX_INLINE_PRUNE_DEPTH; i++) {
+    UndoRecord *const next = curr->Next().load();
+    if (next == nullptr) return;
+    // Uncommitted timestamps are newer than any start time, so this never cuts off a record that could still be
+    // rolled back. The chain is sorted newest-to-oldest, so everything after next is invisible as well.
+    if (transaction::TransactionUtil::NewerThan(prune_horizon, next->Timestamp().load())) {
+      curr->Next().store(nullptr);
+      return;
+    }
+    curr = next;
+  }
+}
+
 bool DataTable::HasConflict(const transaction::TransactionContext &txn, const TupleSlot slot) const {
   UndoRecord *const version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
   return HasConflict(txn, version_ptr);
@@ -470,4 +788,17 @@ bool DataTable::IsVisible(const transaction::TransactionContext &txn, const Tupl
   return visible;
 }
 
+bool DataTable::IsVisibleToAll(const TupleSlot slot) const {
+  UndoRecord *version_ptr;
+  bool visible;
+  do {
+    version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
+    visible = Visible(slot, accessor_);
+  } while (version_ptr != AtomicallyReadVersionPtr(slot, accessor_));
+
+  // Nullptr in version chain means no other versions visible to any transaction alive at this point. Any later write
+  // installs a version first, so the values in place are the ones every transaction alive at this point sees.
+  return version_ptr == nullptr && visible;
+}
+
 }  // namespace terrier::storage
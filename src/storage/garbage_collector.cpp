@@ -1,7 +1,10 @@
 #include "storage/garbage_collector.h"
 
+#include <algorithm>
+#include <functional>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
 #include "common/thread_context.h"
@@ -21,14 +24,18 @@ namespace terrier::storage {
 GarbageCollector::GarbageCollector(
     const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
     const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer)
+    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+    const uint32_t num_gc_threads)
     : timestamp_manager_(timestamp_manager),
       deferred_action_manager_(deferred_action_manager),
       txn_manager_(txn_manager),
       observer_(observer),
-      last_unlinked_{0} {
+      last_unlinked_{0},
+      gc_pool_(num_gc_threads > 1 ? std::make_unique<common::WorkerPool>(num_gc_threads, common::TaskQueue())
+                                  : nullptr) {
   TERRIER_ASSERT(txn_manager_->GCEnabled(),
                  "The TransactionManager needs to be instantiated with gc_enabled true for GC to work!");
+  if (gc_pool_ != nullptr) gc_pool_->Startup();
 }
 
 std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
@@ -98,10 +105,8 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
   uint32_t txns_processed = 0, buffer_processed = 0, readonly_processed = 0;
   // Certain transactions might not be yet safe to gc. Need to requeue them
   transaction::TransactionQueue requeue;
-  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
-  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
-  // wasteful traversals of the version chain.
-  std::unordered_set<TupleSlot> visited_slots;
+  // Transactions that are safe to garbage collect
+  std::vector<transaction::TransactionContext *> txns_to_process;
 
   // Process every transaction in the unlink queue
   while (!txns_to_unlink_.empty()) {
@@ -115,24 +120,7 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
       readonly_processed++;
     } else if (transaction::TransactionUtil::NewerThan(oldest_txn, txn->FinishTime())) {
       // Safe to garbage collect.
-      for (auto &undo_record : txn->undo_buffer_) {
-        // It is possible for the table field to be null, for aborted transaction's last conflicting record
-        DataTable *&table = undo_record.Table();
-        // Each version chain needs to be traversed and truncated at most once every GC period. Check
-        // if we have already visited this tuple slot; if not, proceed to prune the version chain.
-        if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
-          TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
-        // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
-        // unless the transaction is aborted, and the record holds a version that is still visible.
-        if (!txn->Aborted()) {
-          ReclaimSlotIfDeleted(&undo_record);
-          ReclaimBufferIfVarlen(txn, &undo_record);
-        }
-        if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
-        buffer_processed++;
-      }
-      txns_to_deallocate_.push_front(txn);
-      txns_processed++;
+      txns_to_process.push_back(txn);
     } else {
       // This is a committed txn that is still visible, requeue for next GC run
       requeue.push_front(txn);
@@ -142,9 +130,96 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
   // Requeue any txns that we were still visible to running transactions
   txns_to_unlink_ = transaction::TransactionQueue(std::move(requeue));
 
+  buffer_processed = gc_pool_ != nullptr && txns_to_process.size() >= PARALLEL_UNLINK_THRESHOLD
+                         ? UnlinkTransactionsInParallel(txns_to_process, oldest_txn)
+                         : UnlinkTransactions(txns_to_process, oldest_txn);
+  for (auto *const processed_txn : txns_to_process) txns_to_deallocate_.push_front(processed_txn);
+  txns_processed += static_cast<uint32_t>(txns_to_process.size());
+
   return std::make_tuple(txns_processed, buffer_processed, readonly_processed);
 }
 
+uint32_t GarbageCollector::UnlinkTransactions(const std::vector<transaction::TransactionContext *> &txns,
+                                              const transaction::timestamp_t oldest_txn) {
+  uint32_t buffer_processed = 0;
+  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
+  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
+  // wasteful traversals of the version chain.
+  std::unordered_set<TupleSlot> visited_slots;
+  for (auto *const txn : txns) {
+    for (auto &undo_record : txn->undo_buffer_) {
+      // It is possible for the table field to be null, for aborted transaction's last conflicting record
+      DataTable *&table = undo_record.Table();
+      // Each version chain needs to be traversed and truncated at most once every GC period. Check
+      // if we have already visited this tuple slot; if not, proceed to prune the version chain.
+      if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
+        TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
+      // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
+      // unless the transaction is aborted, and the record holds a version that is still visible.
+      if (!txn->Aborted()) {
+        ReclaimSlotIfDeleted(&undo_record);
+        ReclaimBufferIfVarlen(txn, &undo_record);
+      }
+      if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
+      buffer_processed++;
+    }
+  }
+  return buffer_processed;
+}
+
+uint32_t GarbageCollector::UnlinkTransactionsInParallel(const std::vector<transaction::TransactionContext *> &txns,
+                                                        const transaction::timestamp_t oldest_txn) {
+  const uint32_t num_workers = gc_pool_->NumWorkers();
+  uint32_t buffer_processed = 0;
+
+  // Step 1: Partition the UndoRecords by tuple slot, so that every version chain is truncated by a single worker.
+  // TruncateVersionChain relies on only the head of the chain being contended. The observer is notified here, as the
+  // workers would only contend on its latch.
+  std::vector<std::vector<UndoRecord *>> partitions(num_workers);
+  for (auto *const txn : txns) {
+    for (auto &undo_record : txn->undo_buffer_) {
+      // It is possible for the table field to be null, for aborted transaction's last conflicting record
+      if (undo_record.Table() != nullptr)
+        partitions[std::hash<TupleSlot>()(undo_record.Slot()) % num_workers].push_back(&undo_record);
+      if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
+      buffer_processed++;
+    }
+  }
+
+  // Step 2: Truncate the version chains of each partition
+  for (const auto &partition : partitions) {
+    gc_pool_->SubmitTask([this, &partition, oldest_txn] {
+      std::unordered_set<TupleSlot> visited_slots;
+      for (auto *const undo_record : partition) {
+        if (visited_slots.insert(undo_record->Slot()).second)
+          TruncateVersionChain(undo_record->Table(), undo_record->Slot(), oldest_txn);
+      }
+    });
+  }
+  gc_pool_->WaitUntilAllFinished();
+
+  // Step 3: Reclaim deleted slots and dangling pointers to varlens once the versions that reference them are unlinked.
+  // This only adds to the loose pointers of the txn that owns the record, so txns can be split across workers freely.
+  const size_t batch_size = (txns.size() + num_workers - 1) / num_workers;
+  for (size_t batch_begin = 0; batch_begin < txns.size(); batch_begin += batch_size) {
+    const size_t batch_end = std::min(batch_begin + batch_size, txns.size());
+    gc_pool_->SubmitTask([this, &txns, batch_begin, batch_end] {
+      for (size_t i = batch_begin; i < batch_end; i++) {
+        auto *const txn = txns[i];
+        // Aborted txns hold records whose versions may still be visible
+        if (txn->Aborted()) continue;
+        for (auto &undo_record : txn->undo_buffer_) {
+          ReclaimSlotIfDeleted(&undo_record);
+          ReclaimBufferIfVarlen(txn, &undo_record);
+        }
+      }
+    });
+  }
+  gc_pool_->WaitUntilAllFinished();
+
+  return buffer_processed;
+}
+
 void GarbageCollector::ProcessDeferredActions(transaction::timestamp_t oldest_txn) {
   if (deferred_action_manager_ != DISABLED) {
     // TODO(Tianyu): Eventually we will remove the GC and implement version chain pruning with deferred actions
@@ -164,15 +239,20 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
   // here. Instead of a blind update we will need to CAS and prune the entire version chain if the head of the version
   // chain can be GCed.
   if (transaction::TransactionUtil::NewerThan(oldest, version_ptr->Timestamp().load())) {
-    if (!table->CompareAndSwapVersionPtr(slot, accessor, version_ptr, nullptr))
+    if (table->CompareAndSwapVersionPtr(slot, accessor, version_ptr, nullptr)) {
+      // Once no slot of the block has versions left, scans copy it in bulk again
+      slot.GetBlock()->num_versioned_slots_--;
+    } else {
       // Keep retrying while there are conflicts, since we only invoke truncate once per GC period for every
       // version chain.
       TruncateVersionChain(table, slot, oldest);
+    }
     return;
   }
 
-  // a version chain is guaranteed to not change when not at the head (assuming single-threaded GC), so we are safe
-  // to traverse and update pointers without CAS
+  // a version chain is guaranteed to not change when not at the head (assuming a single GC thread truncates it), so we
+  // are safe to traverse and update pointers without CAS. Transactions pruning the chain on the access path only ever
+  // store nullptr into the same pointers, so they cannot undo our changes either.
   UndoRecord *curr = version_ptr;
   UndoRecord *next;
   // Traverse until we find the earliest UndoRecord that can be unlinked.
@@ -247,7 +327,13 @@ void GarbageCollector::UnregisterIndexForGC(const common::ManagedPointer<index::
 
 void GarbageCollector::ProcessIndexes() {
   common::SharedLatch::ScopedSharedLatch guard(&indexes_latch_);
-  for (const auto &index : indexes_) index->PerformGarbageCollection();
+  if (gc_pool_ == nullptr || indexes_.size() < 2) {
+    for (const auto &index : indexes_) index->PerformGarbageCollection();
+    return;
+  }
+  // Indexes are independent of each other, so they can be garbage collected concurrently
+  for (const auto &index : indexes_) gc_pool_->SubmitTask([index] { index->PerformGarbageCollection(); });
+  gc_pool_->WaitUntilAllFinished();
 }
 
 }  // namespace terrier::storage
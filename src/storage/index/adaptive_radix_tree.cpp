@@ -0,0 +1,478 @@
+#include "storage/index/adaptive_radix_tree.h"
+
+#include <algorithm>
+
+namespace terrier::storage::index {
+
+bool AdaptiveRadixTree::Insert(const byte *const key) {
+  const bool inserted = Insert(&root_, reinterpret_cast<const uint8_t *>(key), 0);
+  if (inserted) size_++;
+  return inserted;
+}
+
+bool AdaptiveRadixTree::Delete(const byte *const key) {
+  if (root_ == nullptr) return false;
+  const auto *key_bytes = reinterpret_cast<const uint8_t *>(key);
+  bool deleted;
+  if (IsLeaf(root_)) {
+    deleted = std::memcmp(LeafKey(root_), key_bytes, key_size_) == 0;
+    if (deleted) {
+      FreeNode(root_);
+      root_ = nullptr;
+    }
+  } else {
+    deleted = Delete(&root_, key_bytes, 0);
+  }
+  if (deleted) size_--;
+  return deleted;
+}
+
+void AdaptiveRadixTree::BulkLoad(const byte *const keys, const uint64_t num_keys) {
+  TERRIER_ASSERT(root_ == nullptr, "Bulk loads build the whole tree.");
+  if (num_keys == 0) return;
+  root_ = Build(reinterpret_cast<const uint8_t *>(keys), num_keys, 0);
+  size_ = num_keys;
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::NewLeaf(const uint8_t *const key) {
+  auto *const leaf = new uint8_t[key_size_];
+  std::memcpy(leaf, key, key_size_);
+  heap_usage_ += key_size_;
+  return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(leaf) | 1);
+}
+
+template <class NodeT>
+NodeT *AdaptiveRadixTree::NewNode(const NodeType type) {
+  auto *const node = new NodeT();
+  node->type_ = type;
+  heap_usage_ += sizeof(NodeT);
+  return node;
+}
+
+void AdaptiveRadixTree::CopyHeader(Node *const to, const Node *const from) {
+  to->num_children_ = from->num_children_;
+  to->prefix_length_ = from->prefix_length_;
+  std::memcpy(to->prefix_, from->prefix_, MAX_PREFIX_LENGTH);
+}
+
+void AdaptiveRadixTree::FreeNode(Node *const node) {
+  if (IsLeaf(node)) {
+    delete[] LeafKey(node);
+    heap_usage_ -= key_size_;
+    return;
+  }
+  switch (node->type_) {
+    case NodeType::NODE4:
+      delete static_cast<Node4 *>(node);
+      heap_usage_ -= sizeof(Node4);
+      break;
+    case NodeType::NODE16:
+      delete static_cast<Node16 *>(node);
+      heap_usage_ -= sizeof(Node16);
+      break;
+    case NodeType::NODE48:
+      delete static_cast<Node48 *>(node);
+      heap_usage_ -= sizeof(Node48);
+      break;
+    case NodeType::NODE256:
+      delete static_cast<Node256 *>(node);
+      heap_usage_ -= sizeof(Node256);
+      break;
+  }
+}
+
+void AdaptiveRadixTree::Free(Node *const node) {
+  if (node == nullptr) return;
+  if (!IsLeaf(node)) {
+    switch (node->type_) {
+      case NodeType::NODE4:
+        for (uint16_t i = 0; i < node->num_children_; i++) Free(static_cast<Node4 *>(node)->children_[i]);
+        break;
+      case NodeType::NODE16:
+        for (uint16_t i = 0; i < node->num_children_; i++) Free(static_cast<Node16 *>(node)->children_[i]);
+        break;
+      case NodeType::NODE48:
+        for (Node *child : static_cast<Node48 *>(node)->children_) Free(child);
+        break;
+      case NodeType::NODE256:
+        for (Node *child : static_cast<Node256 *>(node)->children_) Free(child);
+        break;
+    }
+  }
+  FreeNode(node);
+}
+
+const AdaptiveRadixTree::Node *AdaptiveRadixTree::Minimum(const Node *node) {
+  while (!IsLeaf(node)) {
+    switch (node->type_) {
+      case NodeType::NODE4:
+        node = static_cast<const Node4 *>(node)->children_[0];
+        break;
+      case NodeType::NODE16:
+        node = static_cast<const Node16 *>(node)->children_[0];
+        break;
+      case NodeType::NODE48: {
+        const auto *node48 = static_cast<const Node48 *>(node);
+        uint32_t key_byte = 0;
+        while (node48->child_index_[key_byte] == 0) key_byte++;
+        node = node48->children_[node48->child_index_[key_byte] - 1];
+        break;
+      }
+      case NodeType::NODE256: {
+        const auto *node256 = static_cast<const Node256 *>(node);
+        uint32_t key_byte = 0;
+        while (node256->children_[key_byte] == nullptr) key_byte++;
+        node = node256->children_[key_byte];
+        break;
+      }
+    }
+  }
+  return node;
+}
+
+uint32_t AdaptiveRadixTree::PrefixMismatch(const Node *const node, const uint8_t *const key, const uint32_t depth) {
+  const uint32_t stored = std::min(node->prefix_length_, MAX_PREFIX_LENGTH);
+  uint32_t i = 0;
+  for (; i < stored; i++)
+    if (node->prefix_[i] != key[depth + i]) return i;
+  if (node->prefix_length_ > MAX_PREFIX_LENGTH) {
+    // The rest of the prefix is only in the leaves, all of which share it
+    const uint8_t *const leaf_key = LeafKey(Minimum(node));
+    for (; i < node->prefix_length_; i++)
+      if (leaf_key[depth + i] != key[depth + i]) return i;
+  }
+  return i;
+}
+
+AdaptiveRadixTree::Node **AdaptiveRadixTree::FindChild(Node *const node, const uint8_t key_byte) {
+  switch (node->type_) {
+    case NodeType::NODE4: {
+      auto *const node4 = static_cast<Node4 *>(node);
+      for (uint16_t i = 0; i < node4->num_children_; i++)
+        if (node4->keys_[i] == key_byte) return &node4->children_[i];
+      return nullptr;
+    }
+    case NodeType::NODE16: {
+      auto *const node16 = static_cast<Node16 *>(node);
+      auto *const end = node16->keys_ + node16->num_children_;
+      auto *const pos = std::lower_bound(node16->keys_, end, key_byte);
+      return pos != end && *pos == key_byte ? &node16->children_[pos - node16->keys_] : nullptr;
+    }
+    case NodeType::NODE48: {
+      auto *const node48 = static_cast<Node48 *>(node);
+      const uint8_t index = node48->child_index_[key_byte];
+      return index != 0 ? &node48->children_[index - 1] : nullptr;
+    }
+    default: {
+      auto *const node256 = static_cast<Node256 *>(node);
+      return node256->children_[key_byte] != nullptr ? &node256->children_[key_byte] : nullptr;
+    }
+  }
+}
+
+namespace {
+// Inserts a child into a node that keeps its children sorted by key byte and has room for it
+template <class SortedNode, class Node>
+void InsertSorted(SortedNode *const node, const uint8_t key_byte, Node *const child) {
+  const uint16_t pos = static_cast<uint16_t>(
+      std::upper_bound(node->keys_, node->keys_ + node->num_children_, key_byte) - node->keys_);
+  std::memmove(node->keys_ + pos + 1, node->keys_ + pos, node->num_children_ - pos);
+  std::memmove(node->children_ + pos + 1, node->children_ + pos, (node->num_children_ - pos) * sizeof(Node *));
+  node->keys_[pos] = key_byte;
+  node->children_[pos] = child;
+  node->num_children_++;
+}
+
+// Removes the child at the given position from a node that keeps its children sorted by key byte
+template <class SortedNode, class Node>
+void RemoveSorted(SortedNode *const node, const uint16_t pos) {
+  std::memmove(node->keys_ + pos, node->keys_ + pos + 1, node->num_children_ - pos - 1);
+  std::memmove(node->children_ + pos, node->children_ + pos + 1, (node->num_children_ - pos - 1) * sizeof(Node *));
+  node->num_children_--;
+}
+}  // namespace
+
+void AdaptiveRadixTree::AddChild(Node **const ref, const uint8_t key_byte, Node *const child) {
+  Node *const node = *ref;
+  switch (node->type_) {
+    case NodeType::NODE4: {
+      auto *const node4 = static_cast<Node4 *>(node);
+      if (node4->num_children_ < 4) {
+        InsertSorted(node4, key_byte, child);
+        return;
+      }
+      auto *const node16 = NewNode<Node16>(NodeType::NODE16);
+      CopyHeader(node16, node4);
+      std::memcpy(node16->keys_, node4->keys_, sizeof(node4->keys_));
+      std::memcpy(node16->children_, node4->children_, sizeof(node4->children_));
+      InsertSorted(node16, key_byte, child);
+      *ref = node16;
+      break;
+    }
+    case NodeType::NODE16: {
+      auto *const node16 = static_cast<Node16 *>(node);
+      if (node16->num_children_ < 16) {
+        InsertSorted(node16, key_byte, child);
+        return;
+      }
+      auto *const node48 = NewNode<Node48>(NodeType::NODE48);
+      CopyHeader(node48, node16);
+      std::memcpy(node48->children_, node16->children_, sizeof(node16->children_));
+      for (uint8_t i = 0; i < 16; i++) node48->child_index_[node16->keys_[i]] = static_cast<uint8_t>(i + 1);
+      node48->child_index_[key_byte] = 17;
+      node48->children_[16] = child;
+      node48->num_children_++;
+      *ref = node48;
+      break;
+    }
+    case NodeType::NODE48: {
+      auto *const node48 = static_cast<Node48 *>(node);
+      if (node48->num_children_ < 48) {
+        // Removed children leave holes behind, so look for a free position instead of appending
+        uint8_t pos = 0;
+        while (node48->children_[pos] != nullptr) pos++;
+        node48->children_[pos] = child;
+        node48->child_index_[key_byte] = static_cast<uint8_t>(pos + 1);
+        node48->num_children_++;
+        return;
+      }
+      auto *const node256 = NewNode<Node256>(NodeType::NODE256);
+      CopyHeader(node256, node48);
+      for (uint32_t i = 0; i < 256; i++)
+        if (node48->child_index_[i] != 0) node256->children_[i] = node48->children_[node48->child_index_[i] - 1];
+      node256->children_[key_byte] = child;
+      node256->num_children_++;
+      *ref = node256;
+      break;
+    }
+    case NodeType::NODE256: {
+      auto *const node256 = static_cast<Node256 *>(node);
+      node256->children_[key_byte] = child;
+      node256->num_children_++;
+      return;
+    }
+  }
+  // The node grew into a larger one
+  FreeNode(node);
+}
+
+void AdaptiveRadixTree::RemoveChild(Node **const ref, const uint8_t key_byte) {
+  Node *const node = *ref;
+  switch (node->type_) {
+    case NodeType::NODE4: {
+      auto *const node4 = static_cast<Node4 *>(node);
+      auto *const end = node4->keys_ + node4->num_children_;
+      const auto pos = static_cast<uint16_t>(std::find(node4->keys_, end, key_byte) - node4->keys_);
+      RemoveSorted<Node4, Node>(node4, pos);
+      if (node4->num_children_ > 1) return;
+      // A node with a single child is merged into the child, whose prefix grows by the node's prefix and key byte
+      Node *const child = node4->children_[0];
+      if (!IsLeaf(child)) {
+        uint8_t prefix[MAX_PREFIX_LENGTH];
+        uint32_t length = std::min(node4->prefix_length_, MAX_PREFIX_LENGTH);
+        std::memcpy(prefix, node4->prefix_, length);
+        if (length < MAX_PREFIX_LENGTH) prefix[length++] = node4->keys_[0];
+        if (length < MAX_PREFIX_LENGTH) {
+          const uint32_t from_child = std::min(child->prefix_length_, MAX_PREFIX_LENGTH - length);
+          std::memcpy(prefix + length, child->prefix_, from_child);
+        }
+        std::memcpy(child->prefix_, prefix, MAX_PREFIX_LENGTH);
+        child->prefix_length_ += node4->prefix_length_ + 1;
+      }
+      *ref = child;
+      break;
+    }
+    case NodeType::NODE16: {
+      auto *const node16 = static_cast<Node16 *>(node);
+      auto *const end = node16->keys_ + node16->num_children_;
+      const auto pos = static_cast<uint16_t>(std::find(node16->keys_, end, key_byte) - node16->keys_);
+      RemoveSorted<Node16, Node>(node16, pos);
+      if (node16->num_children_ > 3) return;
+      auto *const node4 = NewNode<Node4>(NodeType::NODE4);
+      CopyHeader(node4, node16);
+      std::memcpy(node4->keys_, node16->keys_, 3);
+      std::memcpy(node4->children_, node16->children_, 3 * sizeof(Node *));
+      *ref = node4;
+      break;
+    }
+    case NodeType::NODE48: {
+      auto *const node48 = static_cast<Node48 *>(node);
+      node48->children_[node48->child_index_[key_byte] - 1] = nullptr;
+      node48->child_index_[key_byte] = 0;
+      node48->num_children_--;
+      if (node48->num_children_ > 12) return;
+      auto *const node16 = NewNode<Node16>(NodeType::NODE16);
+      CopyHeader(node16, node48);
+      uint16_t pos = 0;
+      for (uint32_t i = 0; i < 256; i++) {
+        if (node48->child_index_[i] == 0) continue;
+        node16->keys_[pos] = static_cast<uint8_t>(i);
+        node16->children_[pos++] = node48->children_[node48->child_index_[i] - 1];
+      }
+      *ref = node16;
+      break;
+    }
+    case NodeType::NODE256: {
+      auto *const node256 = static_cast<Node256 *>(node);
+      node256->children_[key_byte] = nullptr;
+      node256->num_children_--;
+      if (node256->num_children_ > 37) return;
+      auto *const node48 = NewNode<Node48>(NodeType::NODE48);
+      CopyHeader(node48, node256);
+      uint8_t pos = 0;
+      for (uint32_t i = 0; i < 256; i++) {
+        if (node256->children_[i] == nullptr) continue;
+        node48->children_[pos++] = node256->children_[i];
+        node48->child_index_[i] = pos;
+      }
+      *ref = node48;
+      break;
+    }
+  }
+  // The node shrank into a smaller one, or into its only child
+  FreeNode(node);
+}
+
+bool AdaptiveRadixTree::Insert(Node **const ref, const uint8_t *const key, uint32_t depth) {
+  Node *const node = *ref;
+  if (node == nullptr) {
+    *ref = NewLeaf(key);
+    return true;
+  }
+
+  if (IsLeaf(node)) {
+    // Replace the leaf by a node that tells it apart from the new key
+    const uint8_t *const leaf_key = LeafKey(node);
+    uint32_t prefix_length = 0;
+    while (depth + prefix_length < key_size_ && leaf_key[depth + prefix_length] == key[depth + prefix_length])
+      prefix_length++;
+    if (depth + prefix_length == key_size_) return false;
+    auto *const node4 = NewNode<Node4>(NodeType::NODE4);
+    node4->prefix_length_ = prefix_length;
+    std::memcpy(node4->prefix_, key + depth, std::min(prefix_length, MAX_PREFIX_LENGTH));
+    InsertSorted(node4, leaf_key[depth + prefix_length], node);
+    InsertSorted(node4, key[depth + prefix_length], NewLeaf(key));
+    *ref = node4;
+    return true;
+  }
+
+  if (node->prefix_length_ > 0) {
+    const uint32_t match = PrefixMismatch(node, key, depth);
+    if (match < node->prefix_length_) {
+      // Split the prefix at the first mismatch, under a new node that tells the old node apart from the new key
+      auto *const node4 = NewNode<Node4>(NodeType::NODE4);
+      node4->prefix_length_ = match;
+      std::memcpy(node4->prefix_, node->prefix_, std::min(match, MAX_PREFIX_LENGTH));
+      uint8_t key_byte;
+      if (node->prefix_length_ <= MAX_PREFIX_LENGTH) {
+        key_byte = node->prefix_[match];
+        node->prefix_length_ -= match + 1;
+        std::memmove(node->prefix_, node->prefix_ + match + 1, node->prefix_length_);
+      } else {
+        const uint8_t *const leaf_key = LeafKey(Minimum(node));
+        key_byte = leaf_key[depth + match];
+        node->prefix_length_ -= match + 1;
+        std::memcpy(node->prefix_, leaf_key + depth + match + 1, std::min(node->prefix_length_, MAX_PREFIX_LENGTH));
+      }
+      InsertSorted(node4, key_byte, node);
+      InsertSorted(node4, key[depth + match], NewLeaf(key));
+      *ref = node4;
+      return true;
+    }
+    depth += node->prefix_length_;
+  }
+
+  Node **const child = FindChild(node, key[depth]);
+  if (child != nullptr) return Insert(child, key, depth + 1);
+  AddChild(ref, key[depth], NewLeaf(key));
+  return true;
+}
+
+bool AdaptiveRadixTree::DescendPrefix(const Node **const node, uint32_t *const depth, const uint8_t *const prefix,
+                                      const uint16_t prefix_size) {
+  const Node *const current = *node;
+  if (current == nullptr) return false;
+  if (IsLeaf(current)) {
+    if (std::memcmp(LeafKey(current), prefix, prefix_size) != 0) *node = nullptr;
+    return false;
+  }
+
+  // Only the part of the node's prefix that overlaps the searched prefix has to match
+  const uint32_t compared = std::min(current->prefix_length_, static_cast<uint32_t>(prefix_size - *depth));
+  const uint8_t *const node_prefix =
+      current->prefix_length_ <= MAX_PREFIX_LENGTH ? current->prefix_ : LeafKey(Minimum(current)) + *depth;
+  if (std::memcmp(node_prefix, prefix + *depth, compared) != 0) {
+    *node = nullptr;
+    return false;
+  }
+  *depth += current->prefix_length_;
+  if (*depth >= prefix_size) return false;
+
+  Node **const child = FindChild(const_cast<Node *>(current), prefix[*depth]);
+  if (child == nullptr) {
+    *node = nullptr;
+    return false;
+  }
+  *node = *child;
+  (*depth)++;
+  __builtin_prefetch(IsLeaf(*node) ? static_cast<const void *>(LeafKey(*node)) : *node);
+  return true;
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::Build(const uint8_t *const keys, const uint64_t num_keys,
+                                                  const uint32_t depth) {
+  if (num_keys == 1) return NewLeaf(keys);
+
+  // The keys are sorted, so the bytes shared by the first and the last key are shared by all of them
+  const uint8_t *const last = keys + (num_keys - 1) * key_size_;
+  uint32_t prefix_length = 0;
+  while (depth + prefix_length < key_size_ && keys[depth + prefix_length] == last[depth + prefix_length])
+    prefix_length++;
+  TERRIER_ASSERT(depth + prefix_length < key_size_, "Bulk loaded keys must be unique.");
+  const uint32_t split = depth + prefix_length;
+
+  uint32_t num_children = 1;
+  for (uint64_t i = 1; i < num_keys; i++)
+    if (keys[i * key_size_ + split] != keys[(i - 1) * key_size_ + split]) num_children++;
+
+  Node *node;
+  if (num_children <= 4)
+    node = NewNode<Node4>(NodeType::NODE4);
+  else if (num_children <= 16)
+    node = NewNode<Node16>(NodeType::NODE16);
+  else if (num_children <= 48)
+    node = NewNode<Node48>(NodeType::NODE48);
+  else
+    node = NewNode<Node256>(NodeType::NODE256);
+  node->prefix_length_ = prefix_length;
+  std::memcpy(node->prefix_, keys + depth, std::min(prefix_length, MAX_PREFIX_LENGTH));
+
+  // Every run of keys with the same byte after the prefix becomes a child. The node is already large enough for all of
+  // them, so adding them never grows it.
+  uint64_t begin = 0;
+  for (uint64_t i = 1; i <= num_keys; i++) {
+    const uint8_t key_byte = keys[begin * key_size_ + split];
+    if (i < num_keys && keys[i * key_size_ + split] == key_byte) continue;
+    AddChild(&node, key_byte, Build(keys + begin * key_size_, i - begin, split + 1));
+    begin = i;
+  }
+  return node;
+}
+
+bool AdaptiveRadixTree::Delete(Node **const ref, const uint8_t *const key, uint32_t depth) {
+  Node *const node = *ref;
+  if (node->prefix_length_ > 0) {
+    if (PrefixMismatch(node, key, depth) != node->prefix_length_) return false;
+    depth += node->prefix_length_;
+  }
+
+  Node **const child = FindChild(node, key[depth]);
+  if (child == nullptr) return false;
+  if (!IsLeaf(*child)) return Delete(child, key, depth + 1);
+  if (std::memcmp(LeafKey(*child), key, key_size_) != 0) return false;
+  FreeNode(*child);
+  RemoveChild(ref, key[depth]);
+  return true;
+}
+
+}  // namespace terrier::storage::index
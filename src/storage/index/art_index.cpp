@@ -0,0 +1,354 @@
+#include "storage/index/art_index.h"
+
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <array>
+#include <cstring>
+
+#include "portable_endian/portable_endian.h"
+#include "storage/index/compact_ints_key.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_context.h"
+
+namespace terrier::storage::index {
+
+namespace {
+// The bytes of a key followed by the TupleSlot it points to, in big-endian order
+template <typename KeyType>
+using Entry = std::array<byte, sizeof(KeyType) + sizeof(uint64_t)>;
+
+template <typename KeyType>
+Entry<KeyType> MakeEntry(const KeyType &key, const TupleSlot location) {
+  Entry<KeyType> entry;
+  std::memcpy(entry.data(), key.KeyData(), sizeof(KeyType));
+  const uint64_t value = htobe64(reinterpret_cast<uintptr_t>(location.GetBlock()) | location.GetOffset());
+  std::memcpy(entry.data() + sizeof(KeyType), &value, sizeof(uint64_t));
+  return entry;
+}
+
+// Entry that sorts before (after, for a high bound) every entry starting with the first key_bytes bytes of the key
+template <typename KeyType>
+Entry<KeyType> MakeBound(const KeyType &key, const uint16_t key_bytes, const bool high) {
+  Entry<KeyType> entry;
+  std::memcpy(entry.data(), key.KeyData(), key_bytes);
+  std::memset(entry.data() + key_bytes, high ? UINT8_MAX : 0, entry.size() - key_bytes);
+  return entry;
+}
+
+// How many bytes at the start of a key hold its first num_attrs attributes
+uint16_t KeyBytes(const IndexMetadata &metadata, const uint32_t num_attrs) {
+  const auto &attr_sizes = metadata.GetAttributeSizes();
+  const auto &compact_ints_offsets = metadata.GetCompactIntsOffsets();
+  return static_cast<uint16_t>(compact_ints_offsets[num_attrs - 1] + attr_sizes[num_attrs - 1]);
+}
+
+template <typename KeyType>
+TupleSlot EntryLocation(const byte *const entry) {
+  uint64_t value;
+  std::memcpy(&value, entry + sizeof(KeyType), sizeof(uint64_t));
+  value = be64toh(value);
+  const auto offset_mask = static_cast<uint64_t>(common::Constants::BLOCK_SIZE) - 1;
+  const auto *const block = reinterpret_cast<const RawBlock *>(value & ~offset_mask);
+  return TupleSlot(block, static_cast<uint32_t>(value & offset_mask));
+}
+}  // namespace
+
+template <typename KeyType>
+ArtIndex<KeyType>::ArtIndex(IndexMetadata metadata)
+    : Index(std::move(metadata)),
+      art_(std::make_unique<AdaptiveRadixTree>(sizeof(Entry<KeyType>))),
+      key_bytes_(KeyBytes(metadata_, metadata_.GetSchema().NumKeyColumns())) {}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanRange(const transaction::TransactionContext &txn, const byte *const low,
+                                  const byte *const high, const bool ascending, const uint32_t limit,
+                                  std::vector<TupleSlot> *const value_list) const {
+  common::SharedLatch::ScopedSharedLatch guard(&latch_);
+  art_->Scan(low, high, ascending, [&](const byte *const entry) {
+    const TupleSlot location = EntryLocation<KeyType>(entry);
+    // Perform visibility check on result
+    if (IsVisible(txn, location)) value_list->emplace_back(location);
+    return limit == 0 || value_list->size() < limit;
+  });
+}
+
+template <typename KeyType>
+size_t ArtIndex<KeyType>::EstimateHeapUsage() const {
+  return art_->HeapUsage();
+}
+
+template <typename KeyType>
+bool ArtIndex<KeyType>::Insert(const common::ManagedPointer<transaction::TransactionContext> txn,
+                               const ProjectedRow &tuple, const TupleSlot location) {
+  TERRIER_ASSERT(!(metadata_.GetSchema().Unique()),
+                 "This Insert is designed for secondary indexes with no uniqueness constraints.");
+  KeyType index_key;
+  index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+  const auto entry = MakeEntry(index_key, location);
+  bool result;
+  {
+    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+    result = art_->Insert(entry.data());
+  }
+
+  TERRIER_ASSERT(result, "non-unique index shouldn't fail to insert. The same TupleSlot was inserted twice.");
+  // Register an abort action with the txn context in case of rollback
+  txn->RegisterAbortAction([=]() {
+    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+    const bool UNUSED_ATTRIBUTE result = art_->Delete(entry.data());
+    TERRIER_ASSERT(result, "Delete on the index failed.");
+  });
+  return result;
+}
+
+template <typename KeyType>
+bool ArtIndex<KeyType>::InsertUnique(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                     const ProjectedRow &tuple, const TupleSlot location) {
+  TERRIER_ASSERT(metadata_.GetSchema().Unique(), "This Insert is designed for indexes with uniqueness constraints.");
+  KeyType index_key;
+  index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+  const auto entry = MakeEntry(index_key, location);
+  const auto low = MakeBound(index_key, key_bytes_, false);
+  const auto high = MakeBound(index_key, key_bytes_, true);
+
+  bool result;
+  {
+    // Hold the latch across the check and the insert, so that no other txn can insert the key in between
+    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+    // A key is taken if any of its entries have write-write conflicts or are still visible to the calling txn.
+    bool predicate_satisfied = false;
+    art_->Scan(low.data(), high.data(), true, [&](const byte *const existing) {
+      const TupleSlot slot = EntryLocation<KeyType>(existing);
+      const auto *const data_table = slot.GetBlock()->data_table_;
+      predicate_satisfied = data_table->HasConflict(*txn, slot) || data_table->IsVisible(*txn, slot);
+      return !predicate_satisfied;
+    });
+    result = !predicate_satisfied && art_->Insert(entry.data());
+  }
+
+  if (result) {
+    // Register an abort action with the txn context in case of rollback
+    txn->RegisterAbortAction([=]() {
+      common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+      const bool UNUSED_ATTRIBUTE result = art_->Delete(entry.data());
+      TERRIER_ASSERT(result, "Delete on the index failed.");
+    });
+  } else {
+    // Presumably you've already made modifications to a DataTable (the source of the TupleSlot argument to this
+    // function) however, the index found a constraint violation and cannot allow that operation to succeed. For MVCC
+    // correctness, this txn must now abort for the GC to clean up the version chain in the DataTable correctly.
+    txn->SetMustAbort();
+  }
+
+  return result;
+}
+
+template <typename KeyType>
+bool ArtIndex<KeyType>::BulkLoad(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                 const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+  // Entries are unique even when keys are not, so the sorted entries can be handed to the tree as they are
+  std::vector<Entry<KeyType>> sorted(entries.size());
+  const auto num_attrs = metadata_.GetSchema().GetColumns().size();
+  tbb::parallel_for(size_t(0), entries.size(), [&](const size_t i) {
+    KeyType index_key;
+    index_key.SetFromProjectedRow(*entries[i].first, metadata_, num_attrs);
+    sorted[i] = MakeEntry(index_key, entries[i].second);
+  });
+  tbb::parallel_sort(sorted.begin(), sorted.end(), [](const Entry<KeyType> &lhs, const Entry<KeyType> &rhs) {
+    return std::memcmp(lhs.data(), rhs.data(), lhs.size()) < 0;
+  });
+
+  if (metadata_.GetSchema().Unique()) {
+    // Every key is visible to the calling txn, so two equal keys are a constraint violation. See InsertUnique.
+    for (size_t i = 1; i < sorted.size(); i++) {
+      if (std::memcmp(sorted[i - 1].data(), sorted[i].data(), key_bytes_) == 0) {
+        txn->SetMustAbort();
+        return false;
+      }
+    }
+  }
+
+  {
+    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+    art_->BulkLoad(reinterpret_cast<const byte *>(sorted.data()), sorted.size());
+  }
+
+  // Register an abort action with the txn context in case of rollback
+  txn->RegisterAbortAction([=, sorted{std::move(sorted)}]() {
+    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+    for (const auto &entry : sorted) {
+      const bool UNUSED_ATTRIBUTE result = art_->Delete(entry.data());
+      TERRIER_ASSERT(result, "Delete on the index failed.");
+    }
+  });
+  return true;
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::Delete(const common::ManagedPointer<transaction::TransactionContext> txn,
+                               const ProjectedRow &tuple, const TupleSlot location) {
+  KeyType index_key;
+  index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+  const auto entry = MakeEntry(index_key, location);
+
+  TERRIER_ASSERT(!(location.GetBlock()->data_table_->HasConflict(*txn, location)) &&
+                     !(location.GetBlock()->data_table_->IsVisible(*txn, location)),
+                 "Called index delete on a TupleSlot that has a conflict with this txn or is still visible.");
+
+  // Register a deferred action for the GC with txn manager. See base function comment.
+  txn->RegisterCommitAction([=](transaction::DeferredActionManager *deferred_action_manager) {
+    deferred_action_manager->RegisterDeferredAction([=]() {
+      common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+      const bool UNUSED_ATTRIBUTE result = art_->Delete(entry.data());
+      TERRIER_ASSERT(result, "Deferred delete on the index failed.");
+    });
+  });
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
+                                std::vector<TupleSlot> *value_list) {
+  TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+
+  // Build search key
+  KeyType index_key;
+  index_key.SetFromProjectedRow(key, metadata_, metadata_.GetSchema().NumKeyColumns());
+
+  const auto low = MakeBound(index_key, key_bytes_, false);
+  const auto high = MakeBound(index_key, key_bytes_, true);
+  ScanRange(txn, low.data(), high.data(), true, 0, value_list);
+
+  TERRIER_ASSERT(!(metadata_.GetSchema().Unique()) || (metadata_.GetSchema().Unique() && value_list->size() <= 1),
+                 "Invalid number of results for unique index.");
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanKeyBatch(const transaction::TransactionContext &txn,
+                                     const std::vector<const ProjectedRow *> &keys,
+                                     std::vector<std::vector<TupleSlot>> *value_lists) {
+  value_lists->resize(keys.size());
+
+  // Build search keys, which are the prefixes of the entries that point to their values
+  std::vector<byte> prefixes(keys.size() * key_bytes_);
+  const auto num_attrs = metadata_.GetSchema().NumKeyColumns();
+  for (size_t i = 0; i < keys.size(); i++) {
+    KeyType index_key;
+    index_key.SetFromProjectedRow(*keys[i], metadata_, num_attrs);
+    std::memcpy(prefixes.data() + i * key_bytes_, index_key.KeyData(), key_bytes_);
+    (*value_lists)[i].clear();
+  }
+
+  common::SharedLatch::ScopedSharedLatch guard(&latch_);
+  art_->ScanPrefixes(prefixes.data(), key_bytes_, static_cast<uint32_t>(keys.size()),
+                     [&](const uint32_t i, const byte *const entry) {
+                       const TupleSlot location = EntryLocation<KeyType>(entry);
+                       // Perform visibility check on result
+                       if (IsVisible(txn, location)) (*value_lists)[i].emplace_back(location);
+                     });
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanKeyCovered(const transaction::TransactionContext &txn, const ProjectedRow &key,
+                                       std::vector<TupleSlot> *value_list, std::vector<byte> *rows,
+                                       std::vector<bool> *covered) {
+  TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+  covered->clear();
+
+  // Build search key
+  KeyType index_key;
+  index_key.SetFromProjectedRow(key, metadata_, metadata_.GetSchema().NumKeyColumns());
+
+  const auto low = MakeBound(index_key, key_bytes_, false);
+  const auto high = MakeBound(index_key, key_bytes_, true);
+  const auto &initializer = metadata_.GetProjectedRowInitializer();
+  const auto row_size = initializer.ProjectedRowSize();
+  {
+    common::SharedLatch::ScopedSharedLatch guard(&latch_);
+    art_->Scan(low.data(), high.data(), true, [&](const byte *const entry) {
+      const TupleSlot location = EntryLocation<KeyType>(entry);
+      // Updates to indexed columns move the tuple to a new slot, so a tuple without other versions still holds the
+      // values it was indexed with, and they are the ones the txn would read from the table
+      if (IsVisibleToAll(location)) {
+        rows->resize((value_list->size() + 1) * row_size);
+        auto *const row = initializer.InitializeRow(rows->data() + value_list->size() * row_size);
+        KeyType entry_key;
+        std::memcpy(&entry_key, entry, sizeof(KeyType));
+        entry_key.CopyToProjectedRow(row, metadata_);
+        value_list->emplace_back(location);
+        covered->push_back(true);
+      } else if (IsVisible(txn, location)) {
+        value_list->emplace_back(location);
+        covered->push_back(false);
+      }
+      return true;
+    });
+  }
+  rows->resize(value_list->size() * row_size);
+
+  TERRIER_ASSERT(!(metadata_.GetSchema().Unique()) || (metadata_.GetSchema().Unique() && value_list->size() <= 1),
+                 "Invalid number of results for unique index.");
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
+                                      uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
+                                      uint32_t limit, std::vector<TupleSlot> *value_list) {
+  TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+  TERRIER_ASSERT(scan_type == ScanType::Closed || scan_type == ScanType::OpenLow || scan_type == ScanType::OpenHigh ||
+                     scan_type == ScanType::OpenBoth,
+                 "Invalid scan_type passed into ArtIndex::Scan");
+
+  bool low_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenHigh);
+  bool high_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenLow);
+
+  // Build search keys. Only the first num_attrs attributes are compared, so the bounds cover every key that shares
+  // them, in the same way as PartialLessThan does for BwTreeIndex.
+  const auto key_bytes = KeyBytes(metadata_, num_attrs);
+  KeyType index_low_key, index_high_key;
+  if (low_key_exists) index_low_key.SetFromProjectedRow(*low_key, metadata_, num_attrs);
+  if (high_key_exists) index_high_key.SetFromProjectedRow(*high_key, metadata_, num_attrs);
+
+  const auto low = MakeBound(index_low_key, low_key_exists ? key_bytes : 0, false);
+  const auto high = MakeBound(index_high_key, high_key_exists ? key_bytes : 0, true);
+  ScanRange(txn, low.data(), high.data(), true, limit, value_list);
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                                       const ProjectedRow &high_key, std::vector<TupleSlot> *value_list) {
+  TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+
+  // Build search keys
+  KeyType index_low_key, index_high_key;
+  index_low_key.SetFromProjectedRow(low_key, metadata_, metadata_.GetSchema().NumKeyColumns());
+  index_high_key.SetFromProjectedRow(high_key, metadata_, metadata_.GetSchema().NumKeyColumns());
+
+  const auto low = MakeBound(index_low_key, key_bytes_, false);
+  const auto high = MakeBound(index_high_key, key_bytes_, true);
+  ScanRange(txn, low.data(), high.data(), false, 0, value_list);
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanLimitDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                                            const ProjectedRow &high_key, std::vector<TupleSlot> *value_list,
+                                            const uint32_t limit) {
+  TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+  TERRIER_ASSERT(limit > 0, "Limit must be greater than 0.");
+
+  // Build search keys
+  KeyType index_low_key, index_high_key;
+  index_low_key.SetFromProjectedRow(low_key, metadata_, metadata_.GetSchema().NumKeyColumns());
+  index_high_key.SetFromProjectedRow(high_key, metadata_, metadata_.GetSchema().NumKeyColumns());
+
+  const auto low = MakeBound(index_low_key, key_bytes_, false);
+  const auto high = MakeBound(index_high_key, key_bytes_, true);
+  ScanRange(txn, low.data(), high.data(), false, limit, value_list);
+}
+
+template class ArtIndex<CompactIntsKey<8>>;
+template class ArtIndex<CompactIntsKey<16>>;
+template class ArtIndex<CompactIntsKey<24>>;
+template class ArtIndex<CompactIntsKey<32>>;
+
+}  // namespace terrier::storage::index
@@ -1,5 +1,11 @@
 #include "storage/index/bwtree_index.h"
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+
 #include "bwtree/bwtree.h"
 #include "storage/index/compact_ints_key.h"
 #include "storage/index/generic_key.h"
@@ -8,6 +14,10 @@
 
 namespace terrier::storage::index {
 
+// Number of sorted keys that one thread inserts in a row during a bulk load. Large enough that threads rarely insert
+// into the same leaf.
+constexpr size_t BULK_LOAD_RANGE_SIZE = 1 << 14;
+
 template <typename KeyType>
 BwTreeIndex<KeyType>::BwTreeIndex(IndexMetadata metadata)
     : Index(std::move(metadata)), bwtree_(std::make_unique<third_party::bwtree::BwTree<KeyType, TupleSlot>>(false)) {}
@@ -102,6 +112,52 @@ bool BwTreeIndex<KeyType>::InsertUnique(const common::ManagedPointer<transaction
   return result;
 }
 
+template <typename KeyType>
+bool BwTreeIndex<KeyType>::BulkLoad(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                    const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+  std::vector<std::pair<KeyType, TupleSlot>> sorted(entries.size());
+  const auto num_attrs = metadata_.GetSchema().GetColumns().size();
+  tbb::parallel_for(size_t(0), entries.size(), [&](const size_t i) {
+    sorted[i].first.SetFromProjectedRow(*entries[i].first, metadata_, num_attrs);
+    sorted[i].second = entries[i].second;
+  });
+  tbb::parallel_sort(sorted.begin(), sorted.end(),
+                     [this](const std::pair<KeyType, TupleSlot> &lhs, const std::pair<KeyType, TupleSlot> &rhs) {
+                       return bwtree_->KeyCmpLess(lhs.first, rhs.first);
+                     });
+
+  if (metadata_.GetSchema().Unique()) {
+    // Every key is visible to the calling txn, so two equal keys are a constraint violation. See InsertUnique.
+    for (size_t i = 1; i < sorted.size(); i++) {
+      if (bwtree_->KeyCmpEqual(sorted[i - 1].first, sorted[i].first)) {
+        txn->SetMustAbort();
+        return false;
+      }
+    }
+  }
+
+  // The BwTree cannot be built bottom-up, but inserting in key order only ever appends to the rightmost leaf of the
+  // keys inserted so far, so that leaf and the path to it stay in cache instead of every insert missing on a random
+  // one. The tree is latch-free, so threads can insert disjoint ranges of the sorted keys at the same time; they only
+  // meet where their ranges border each other.
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, sorted.size(), BULK_LOAD_RANGE_SIZE),
+                    [&](const tbb::blocked_range<size_t> &range) {
+                      for (size_t i = range.begin(); i < range.end(); i++) {
+                        const bool UNUSED_ATTRIBUTE result = bwtree_->Insert(sorted[i].first, sorted[i].second, false);
+                        TERRIER_ASSERT(result, "The same TupleSlot was bulk loaded twice.");
+                      }
+                    });
+
+  // Register an abort action with the txn context in case of rollback
+  txn->RegisterAbortAction([=, sorted{std::move(sorted)}]() {
+    for (const auto &entry : sorted) {
+      const bool UNUSED_ATTRIBUTE result = bwtree_->Delete(entry.first, entry.second);
+      TERRIER_ASSERT(result, "Delete on the index failed.");
+    }
+  });
+  return true;
+}
+
 template <typename KeyType>
 void BwTreeIndex<KeyType>::Delete(const common::ManagedPointer<transaction::TransactionContext> txn,
                                   const ProjectedRow &tuple, const TupleSlot location) {
@@ -147,6 +203,50 @@ void BwTreeIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn, c
                  "Invalid number of results for unique index.");
 }
 
+template <typename KeyType>
+void BwTreeIndex<KeyType>::ScanKeyBatch(const transaction::TransactionContext &txn,
+                                        const std::vector<const ProjectedRow *> &keys,
+                                        std::vector<std::vector<TupleSlot>> *value_lists) {
+  value_lists->resize(keys.size());
+
+  // Build search keys
+  std::vector<KeyType> index_keys(keys.size());
+  std::vector<uint32_t> order(keys.size());
+  const auto num_attrs = metadata_.GetSchema().GetColumns().size();
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromProjectedRow(*keys[i], metadata_, num_attrs);
+    order[i] = i;
+  }
+
+  // Look the keys up in key order. Consecutive lookups then go down mostly the same inner nodes, which stay in cache,
+  // and a key that repeats is only looked up once.
+  std::sort(order.begin(), order.end(), [&](const uint32_t lhs, const uint32_t rhs) {
+    return bwtree_->KeyCmpLess(index_keys[lhs], index_keys[rhs]);
+  });
+
+  std::vector<TupleSlot> results;
+  for (uint32_t i = 0; i < order.size(); i++) {
+    auto &value_list = (*value_lists)[order[i]];
+    if (i > 0 && bwtree_->KeyCmpEqual(index_keys[order[i - 1]], index_keys[order[i]])) {
+      value_list = (*value_lists)[order[i - 1]];
+      continue;
+    }
+
+    // Perform lookup in BwTree
+    results.clear();
+    bwtree_->GetValue(index_keys[order[i]], results);
+
+    // Perform visibility check on result
+    value_list.clear();
+    for (const auto &result : results) {
+      if (IsVisible(txn, result)) value_list.emplace_back(result);
+    }
+
+    TERRIER_ASSERT(!(metadata_.GetSchema().Unique()) || (metadata_.GetSchema().Unique() && value_list.size() <= 1),
+                   "Invalid number of results for unique index.");
+  }
+}
+
 template <typename KeyType>
 void BwTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
                                          uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "storage/index/art_index.h"
 #include "storage/index/bwtree_index.h"
 #include "storage/index/compact_ints_key.h"
 #include "storage/index/generic_key.h"
@@ -31,6 +32,13 @@ Index *IndexBuilder::Build() const {
     simple_key = simple_key && (std::count(NUMERIC_KEY_TYPES.cbegin(), NUMERIC_KEY_TYPES.cend(), attr.Type()) > 0);
   }
 
+  // Only the ART stores whole entries that it can leave INCLUDE columns out of when comparing keys. The other indexes
+  // would compare them as part of the key.
+  if (key_schema_.NumIncludeColumns() > 0 &&
+      (key_schema_.Type() != IndexType::ART || !simple_key || metadata.KeySize() > COMPACTINTSKEY_MAX_SIZE)) {
+    return nullptr;
+  }
+
   switch (key_schema_.Type()) {
     case IndexType::BWTREE: {
       if (simple_key && metadata.KeySize() <= COMPACTINTSKEY_MAX_SIZE) return BuildBwTreeIntsKey(std::move(metadata));
@@ -40,6 +48,11 @@ Index *IndexBuilder::Build() const {
       if (simple_key && metadata.KeySize() <= HASHKEY_MAX_SIZE) return BuildHashIntsKey(std::move(metadata));
       return BuildHashGenericKey(std::move(metadata));
     }
+    case IndexType::ART: {
+      // The tree relies on keys comparing like their bytes, which only CompactIntsKey guarantees
+      if (simple_key && metadata.KeySize() <= COMPACTINTSKEY_MAX_SIZE) return BuildArtIntsKey(std::move(metadata));
+      return BuildBwTreeGenericKey(std::move(metadata));
+    }
     default:
       return nullptr;
   }
@@ -89,6 +102,24 @@ Index *IndexBuilder::BuildBwTreeGenericKey(IndexMetadata metadata) const {
   return index;
 }
 
+Index *IndexBuilder::BuildArtIntsKey(IndexMetadata metadata) const {
+  metadata.SetKeyKind(IndexKeyKind::COMPACTINTSKEY);
+  const auto key_size = metadata.KeySize();
+  TERRIER_ASSERT(key_size <= COMPACTINTSKEY_MAX_SIZE, "Key size exceeds maximum for this key type.");
+  Index *index = nullptr;
+  if (key_size <= 8) {
+    index = new ArtIndex<CompactIntsKey<8>>(std::move(metadata));
+  } else if (key_size <= 16) {
+    index = new ArtIndex<CompactIntsKey<16>>(std::move(metadata));
+  } else if (key_size <= 24) {
+    index = new ArtIndex<CompactIntsKey<24>>(std::move(metadata));
+  } else if (key_size <= 32) {
+    index = new ArtIndex<CompactIntsKey<32>>(std::move(metadata));
+  }
+  TERRIER_ASSERT(index != nullptr, "Failed to create an IntsKey index.");
+  return index;
+}
+
 Index *IndexBuilder::BuildHashIntsKey(IndexMetadata metadata) const {
   metadata.SetKeyKind(IndexKeyKind::HASHKEY);
   const auto key_size = metadata.KeySize();
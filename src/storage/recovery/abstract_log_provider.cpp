@@ -1,33 +1,143 @@
 #include "storage/recovery/abstract_log_provider.h"
 
+#include <cstring>
 #include <utility>
 #include <vector>
 
 #include "storage/projected_row.h"
+#include "storage/write_ahead_log/log_compression.h"
 
 namespace terrier::storage {
 
+template <bool COMPACT, class T>
+T AbstractLogProvider::ReadField() {
+  if constexpr (COMPACT) {
+    uint64_t value;
+    if (!LogCompressionUtil::ReadVarint(frame_.data(), static_cast<uint32_t>(frame_.size()), &frame_offset_, &value)) {
+      throw std::runtime_error("Compressed log frame ends in the middle of a record. possible data corruption");
+    }
+    return LogCompressionUtil::FromVarint<T>(value);
+  } else {
+    return ReadValue<T>();
+  }
+}
+
+template <bool COMPACT>
+void AbstractLogProvider::ReadBytes(void *const dest, const uint32_t size) {
+  if constexpr (COMPACT) {
+    if (size > frame_.size() - frame_offset_) {
+      throw std::runtime_error("Compressed log frame ends in the middle of a record. possible data corruption");
+    }
+    std::memcpy(dest, frame_.data() + frame_offset_, size);
+    frame_offset_ += size;
+  } else {
+    Read(dest, size);
+  }
+}
+
+template <bool COMPACT>
+VarlenEntry AbstractLogProvider::ReadVarlen(std::vector<byte *> *const varlen_contents) {
+  // Read how many bytes this varlen actually is, and where its contents are
+  uint32_t varlen_attribute_size;
+  const byte *frame_contents = nullptr;
+  if constexpr (COMPACT) {
+    // The lowest bit of the tag tells a reference to an earlier value of the frame apart from a value written in full
+    const auto tag = ReadField<true, uint64_t>();
+    if ((tag & 1) == 1) {
+      if ((tag >> 1) >= frame_varlens_.size()) {
+        throw std::runtime_error("Compressed log frame refers to unknown varlen. possible data corruption");
+      }
+      const auto &earlier = frame_varlens_[tag >> 1];
+      frame_contents = frame_.data() + earlier.first;
+      varlen_attribute_size = earlier.second;
+    } else {
+      varlen_attribute_size = static_cast<uint32_t>(tag >> 1);
+      if (varlen_attribute_size > frame_.size() - frame_offset_) {
+        throw std::runtime_error("Compressed log frame ends in the middle of a record. possible data corruption");
+      }
+      frame_contents = frame_.data() + frame_offset_;
+      frame_varlens_.emplace_back(frame_offset_, varlen_attribute_size);
+      frame_offset_ += varlen_attribute_size;
+    }
+  } else {
+    varlen_attribute_size = ReadValue<uint32_t>();
+  }
+
+  // Create the varlen entry depending on whether it can be inlined or not
+  if (varlen_attribute_size <= storage::VarlenEntry::InlineThreshold()) {
+    // Because it's inline, we can just read it into a stack object, as the varlen constructor will memcpy it
+    byte varlen_attribute_content[storage::VarlenEntry::InlineThreshold()];
+    if (frame_contents != nullptr) {
+      std::memcpy(varlen_attribute_content, frame_contents, varlen_attribute_size);
+    } else {
+      Read(&varlen_attribute_content, varlen_attribute_size);
+    }
+    return storage::VarlenEntry::CreateInline(varlen_attribute_content, varlen_attribute_size);
+  }
+
+  // Allocate a varlen buffer of this many bytes, and fill it with the contents. Store reference to varlen content to
+  // clean up incase of abort
+  auto *varlen_attribute_content = common::AllocationUtil::AllocateAligned(varlen_attribute_size);
+  if (frame_contents != nullptr) {
+    std::memcpy(varlen_attribute_content, frame_contents, varlen_attribute_size);
+  } else {
+    Read(varlen_attribute_content, varlen_attribute_size);
+  }
+  varlen_contents->push_back(varlen_attribute_content);
+  return storage::VarlenEntry::Create(varlen_attribute_content, varlen_attribute_size, true);
+}
+
+void AbstractLogProvider::ReadFrame() {
+  const auto raw_size = ReadValue<uint32_t>();
+  const auto compressed_size = ReadValue<uint32_t>();
+  frame_.resize(raw_size);
+  frame_offset_ = 0;
+  frame_varlens_.clear();
+
+  // Frames that did not compress are stored as is
+  if (compressed_size == raw_size) {
+    if (!Read(frame_.data(), raw_size)) throw std::runtime_error("Compressed log frame is truncated");
+    return;
+  }
+  std::vector<byte> compressed(compressed_size);
+  if (!Read(compressed.data(), compressed_size)) throw std::runtime_error("Compressed log frame is truncated");
+  if (!LogCompressionUtil::Decompress(compressed.data(), compressed_size, frame_.data(), raw_size)) {
+    throw std::runtime_error("Compressed log frame failed to decompress. possible data corruption");
+  }
+}
+
 std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord() {
+  // Records in the compact format come in compressed frames, which are read in whole once we get to them
+  if (frame_offset_ == frame_.size()) {
+    const auto size = ReadValue<uint32_t>();
+    if (size != COMPRESSED_LOG_FRAME_MARKER) return DeserializeRecord<false>(size);
+    ReadFrame();
+  }
+  return DeserializeRecord<true>(ReadField<true, uint32_t>());
+}
+
+template <bool COMPACT>
+std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::DeserializeRecord(const uint32_t size) {
   // Pointer to buffers for non-aligned varlen entries so we can clean them up down the road
   std::vector<byte *> varlen_contents;
   // Read in LogRecord header data
-  auto size = ReadValue<uint32_t>();
   byte *buf = common::AllocationUtil::AllocateAligned(size);
-  auto record_type = ReadValue<storage::LogRecordType>();
-  auto txn_begin = ReadValue<transaction::timestamp_t>();
+  auto record_type = ReadField<COMPACT, storage::LogRecordType>();
+  auto txn_begin = ReadField<COMPACT, transaction::timestamp_t>();
 
   switch (record_type) {
     case (storage::LogRecordType::COMMIT): {
-      auto txn_commit = ReadValue<transaction::timestamp_t>();
-      auto oldest_active_txn = ReadValue<transaction::timestamp_t>();
+      auto txn_commit = ReadField<COMPACT, transaction::timestamp_t>();
+      auto oldest_active_txn = ReadField<COMPACT, transaction::timestamp_t>();
       TERRIER_ASSERT(oldest_active_txn != transaction::INVALID_TXN_TIMESTAMP,
                      "INVALID_TXN_TIMESTAMP indicates this was a read only txn, which should "
                      "never have been flushed to disk/network");
+      auto previous_commit = ReadField<COMPACT, transaction::timestamp_t>();
       // Okay to fill in null since nobody will invoke the callback.
       // is_read_only argument is set to false, because we do not write out a commit record for a transaction if it is
       // not read-only.
       return {storage::CommitRecord::Initialize(buf, txn_begin, txn_commit, nullptr, nullptr, oldest_active_txn, false,
-                                                nullptr, nullptr),
+                                                nullptr, nullptr, previous_commit),
               varlen_contents};
     }
 
@@ -36,19 +146,22 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
     }
 
     case (storage::LogRecordType::DELETE): {
-      auto database_oid = ReadValue<catalog::db_oid_t>();
-      auto table_oid = ReadValue<catalog::table_oid_t>();
-      auto tuple_slot = ReadValue<storage::TupleSlot>();
+      auto database_oid = ReadField<COMPACT, catalog::db_oid_t>();
+      auto table_oid = ReadField<COMPACT, catalog::table_oid_t>();
+      // Tuple slots are pointers, so they are written out at full width in either format
+      storage::TupleSlot tuple_slot;
+      ReadBytes<COMPACT>(&tuple_slot, sizeof(storage::TupleSlot));
       return {storage::DeleteRecord::Initialize(buf, txn_begin, database_oid, table_oid, tuple_slot), varlen_contents};
     }
 
     case (storage::LogRecordType::REDO): {
-      auto database_oid = ReadValue<catalog::db_oid_t>();
-      auto table_oid = ReadValue<catalog::table_oid_t>();
-      auto tuple_slot = ReadValue<storage::TupleSlot>();
+      auto database_oid = ReadField<COMPACT, catalog::db_oid_t>();
+      auto table_oid = ReadField<COMPACT, catalog::table_oid_t>();
+      storage::TupleSlot tuple_slot;
+      ReadBytes<COMPACT>(&tuple_slot, sizeof(storage::TupleSlot));
 
       // TODO(Gus, PR #468): Future addition of checksums should validate these values in case of data corruption.
-      auto num_cols = ReadValue<uint16_t>();
+      auto num_cols = ReadField<COMPACT, uint16_t>();
       if (num_cols > common::Constants::MAX_COL) {
         throw std::runtime_error("Number of columns deserialized exceeds max columns. possible data corrution");
       }
@@ -58,7 +171,7 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
       std::vector<storage::col_id_t> col_ids;
       col_ids.reserve(num_cols);
       for (uint16_t i = 0; i < num_cols; i++) {
-        const auto col_id = ReadValue<storage::col_id_t>();
+        const auto col_id = ReadField<COMPACT, storage::col_id_t>();
         col_ids.push_back(col_id);
       }
 
@@ -66,7 +179,7 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
       std::vector<uint16_t> attr_size_boundaries;
       attr_size_boundaries.reserve(NUM_ATTR_BOUNDARIES);
       for (uint16_t i = 0; i < NUM_ATTR_BOUNDARIES; i++) {
-        attr_size_boundaries.push_back(ReadValue<uint16_t>());
+        attr_size_boundaries.push_back(ReadField<COMPACT, uint16_t>());
       }
 
       // Compute attr sizes
@@ -78,7 +191,7 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
 
       // Initialize the redo record.
       auto initializer = storage::ProjectedRowInitializer::Create(attr_sizes, col_ids);
-      auto *result = storage::RedoRecord::Initialize(buf, txn_begin, database_oid, table_oid, initializer);
+      LogRecord *result = storage::RedoRecord::Initialize(buf, txn_begin, database_oid, table_oid, initializer);
       auto *record_body = result->GetUnderlyingRecordBodyAs<RedoRecord>();
       record_body->SetTupleSlot(tuple_slot);
       auto *delta = record_body->Delta();
@@ -89,7 +202,7 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
       // read in. It doesn't populate the delta's bitmap yet. This will happen naturally as we proceed column-by-column.
       auto bitmap_num_bytes = common::RawBitmap::SizeInBytes(num_cols);
       auto *bitmap_buffer = new uint8_t[bitmap_num_bytes];
-      Read(bitmap_buffer, bitmap_num_bytes);
+      ReadBytes<COMPACT>(bitmap_buffer, bitmap_num_bytes);
       auto *bitmap = reinterpret_cast<common::RawBitmap *>(bitmap_buffer);
 
       for (uint16_t i = 0; i < num_cols; i++) {
@@ -103,33 +216,13 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
         auto *column_value_address = delta->AccessForceNotNull(i);
         // Need to mask off sign bit from VARLEN_COLUMN to get the varlen size
         if (attr_sizes[i] == AttrSizeBytes(VARLEN_COLUMN)) {
-          // Read how many bytes this varlen actually is.
-          const auto varlen_attribute_size = ReadValue<uint32_t>();
-
-          // Create the varlen entry depending on whether it can be inlined or not
-          storage::VarlenEntry varlen_entry;
-          if (varlen_attribute_size <= storage::VarlenEntry::InlineThreshold()) {
-            // Because it's inline, we can just read it into a stack object, as the varlen constructor will memcpy it
-            byte varlen_attribute_content[varlen_attribute_size];
-            Read(&varlen_attribute_content, varlen_attribute_size);
-            varlen_entry = storage::VarlenEntry::CreateInline(varlen_attribute_content, varlen_attribute_size);
-          } else {
-            // Allocate a varlen buffer of this many bytes.
-            auto *varlen_attribute_content = common::AllocationUtil::AllocateAligned(varlen_attribute_size);
-            // Fill the entry with the next bytes from the log file.
-            Read(varlen_attribute_content, varlen_attribute_size);
-
-            varlen_entry = storage::VarlenEntry::Create(varlen_attribute_content, varlen_attribute_size, true);
-            varlen_contents.push_back(varlen_attribute_content);
-          }
           // The attribute value in the ProjectedRow will be a pointer to this varlen entry.
           auto *dest = reinterpret_cast<storage::VarlenEntry *>(column_value_address);
           // Set the value to be the address of the varlen_entry.
-          *dest = varlen_entry;
-          // Store reference to varlen content to clean up incase of abort
+          *dest = ReadVarlen<COMPACT>(&varlen_contents);
         } else {
           // For inlined attributes, just directly read into the ProjectedRow.
-          Read(column_value_address, attr_sizes[i]);
+          ReadBytes<COMPACT>(column_value_address, attr_sizes[i]);
         }
       }
 
@@ -0,0 +1,201 @@
+#include "storage/recovery/checkpoint_manager.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "catalog/database_catalog.h"
+#include "catalog/postgres/builder.h"
+#include "catalog/postgres/pg_attribute.h"
+#include "catalog/postgres/pg_class.h"
+#include "catalog/postgres/pg_constraint.h"
+#include "catalog/postgres/pg_database.h"
+#include "catalog/postgres/pg_index.h"
+#include "catalog/postgres/pg_language.h"
+#include "catalog/postgres/pg_namespace.h"
+#include "catalog/postgres/pg_proc.h"
+#include "catalog/postgres/pg_type.h"
+#include "common/allocator.h"
+#include "storage/write_ahead_log/log_manager.h"
+#include "storage/write_ahead_log/log_serializer_task.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace terrier::storage {
+
+transaction::timestamp_t CheckpointManager::TakeCheckpoint(const std::string &log_archive_path) {
+  // Step 1: Start new log files. From here on, the records of transactions that begin after the rotation only go to
+  // the new log files.
+  log_manager_->RotateLogFile(log_archive_path);
+
+  // Step 2: Wait for every transaction that began before the rotation to finish. Transactions only leave the timestamp
+  // manager once their records are serialized, so afterwards every transaction with records in the old log files has
+  // committed or aborted, and committed transactions will be visible to the snapshot.
+  const auto rotation_time = timestamp_manager_->CheckOutTimestamp();
+  while (timestamp_manager_->OldestTransactionStartTime() < rotation_time) std::this_thread::yield();
+
+  // Step 3: Write out the snapshot to a temporary file, so a crash while checkpointing leaves the previous checkpoint
+  // intact
+  auto *const txn = txn_manager_->BeginTransaction();
+  const auto checkpoint_timestamp = txn->StartTime();
+  const std::string temp_file_path = checkpoint_file_path_ + ".tmp";
+  std::remove(temp_file_path.c_str());
+  BufferedLogWriter out(temp_file_path.c_str());
+  WriteCheckpoint(txn, &out);
+  out.FlushBuffer();
+  out.Persist();
+  out.Close();
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Step 4: Install the checkpoint. Everything in the old log files committed before the snapshot was taken, so it is
+  // no longer needed for recovery.
+  if (std::rename(temp_file_path.c_str(), checkpoint_file_path_.c_str()) != 0) {
+    throw std::runtime_error("Failed to install checkpoint with errno " + std::to_string(errno));
+  }
+  for (uint32_t i = 0; i < log_manager_->NumLogStreams(); i++) {
+    if (std::remove(LogManager::LogStreamFilePath(log_archive_path, i).c_str()) != 0) {
+      throw std::runtime_error("Failed to truncate log with errno " + std::to_string(errno));
+    }
+  }
+  return checkpoint_timestamp;
+}
+
+void CheckpointManager::WriteCheckpoint(transaction::TransactionContext *const txn, BufferedLogWriter *const out) {
+  // Recovery learns the checkpoint timestamp from the commit records in the checkpoint. We start with an empty
+  // transaction so that this works even if there is nothing else to write.
+  WriteCommit(txn, out);
+
+  // Each database is recreated by an insert into pg_database, followed by the contents of its catalog in the same txn
+  auto *const pg_database = catalog_->databases_;
+  const auto &initializer = catalog_->pg_database_all_cols_pri_;
+  auto *const buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+  auto *const record = RedoRecord::Initialize(buffer, txn->StartTime(), catalog::INVALID_DATABASE_OID,
+                                              catalog::postgres::DATABASE_TABLE_OID, initializer);
+  auto *const redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+  for (auto it = pg_database->begin(); it != pg_database->end(); it++) {
+    if (!pg_database->Select(common::ManagedPointer(txn), *it, redo->Delta())) continue;
+    redo->SetTupleSlot(*it);
+    const auto db_oid = *(reinterpret_cast<const catalog::db_oid_t *>(
+        redo->Delta()->AccessWithNullCheck(catalog_->pg_database_all_cols_prm_[catalog::postgres::DATOID_COL_OID])));
+    LogSerializerTask::SerializeRecord(*record, out);
+    WriteDatabase(txn, db_oid, out);
+  }
+  delete[] buffer;
+}
+
+void CheckpointManager::WriteDatabase(transaction::TransactionContext *const txn, const catalog::db_oid_t db_oid,
+                                      BufferedLogWriter *const out) {
+  auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  TERRIER_ASSERT(db_catalog != nullptr, "Database visible in pg_database must have a catalog");
+
+  // Step 1: Write out the catalog tables. We remember the pg_class entries that point to a table or an index, because
+  // recovery only recreates an object once it sees its pointer being set.
+  std::vector<TupleSlot> table_entries, index_entries;
+  std::vector<std::pair<catalog::table_oid_t, SqlTable *>> user_tables;
+  const std::vector<catalog::col_oid_t> class_oids{catalog::postgres::RELOID_COL_OID,
+                                                   catalog::postgres::RELKIND_COL_OID,
+                                                   catalog::postgres::REL_PTR_COL_OID};
+  const auto class_pr_map = db_catalog->classes_->ProjectionMapForOids(class_oids);
+  const auto on_class_row = [&](const RedoRecord &redo) {
+    const auto *const delta = redo.Delta();
+    const auto *const object_ptr = delta->AccessWithNullCheck(class_pr_map.at(catalog::postgres::REL_PTR_COL_OID));
+    if (object_ptr == nullptr) return;
+    const auto class_oid = *(reinterpret_cast<const uint32_t *>(
+        delta->AccessWithNullCheck(class_pr_map.at(catalog::postgres::RELOID_COL_OID))));
+    const auto class_kind = *(reinterpret_cast<const catalog::postgres::ClassKind *>(
+        delta->AccessWithNullCheck(class_pr_map.at(catalog::postgres::RELKIND_COL_OID))));
+    if (class_kind == catalog::postgres::ClassKind::REGULAR_TABLE) {
+      table_entries.push_back(redo.GetTupleSlot());
+      // All catalog tables/indexes have OIDS less than START_OID. Catalog tables were written out above.
+      if (class_oid >= catalog::START_OID) {
+        user_tables.emplace_back(catalog::table_oid_t(class_oid), *reinterpret_cast<SqlTable *const *>(object_ptr));
+      }
+    } else if (class_kind == catalog::postgres::ClassKind::INDEX) {
+      index_entries.push_back(redo.GetTupleSlot());
+    }
+  };
+
+  WriteTable(txn, db_oid, catalog::postgres::NAMESPACE_TABLE_OID, db_catalog->namespaces_,
+             catalog::postgres::Builder::GetNamespaceTableSchema(), false, out, nullptr);
+  WriteTable(txn, db_oid, catalog::postgres::CLASS_TABLE_OID, db_catalog->classes_,
+             catalog::postgres::Builder::GetClassTableSchema(), false, out, on_class_row);
+  WriteTable(txn, db_oid, catalog::postgres::COLUMN_TABLE_OID, db_catalog->columns_,
+             catalog::postgres::Builder::GetColumnTableSchema(), false, out, nullptr);
+  WriteTable(txn, db_oid, catalog::postgres::TYPE_TABLE_OID, db_catalog->types_,
+             catalog::postgres::Builder::GetTypeTableSchema(), false, out, nullptr);
+  WriteTable(txn, db_oid, catalog::postgres::CONSTRAINT_TABLE_OID, db_catalog->constraints_,
+             catalog::postgres::Builder::GetConstraintTableSchema(), false, out, nullptr);
+  WriteTable(txn, db_oid, catalog::postgres::INDEX_TABLE_OID, db_catalog->indexes_,
+             catalog::postgres::Builder::GetIndexTableSchema(), false, out, nullptr);
+  WriteTable(txn, db_oid, catalog::postgres::LANGUAGE_TABLE_OID, db_catalog->languages_,
+             catalog::postgres::Builder::GetLanguageTableSchema(), false, out, nullptr);
+  WriteTable(txn, db_oid, catalog::postgres::PRO_TABLE_OID, db_catalog->procs_,
+             catalog::postgres::Builder::GetProcTableSchema(), false, out, nullptr);
+
+  // Step 2: Set the pointer of every table and index, which makes recovery recreate them now that all the metadata it
+  // needs is in place. Tables go first, so they exist before any index on them. The pointer value itself is ignored.
+  const auto &initializer = db_catalog->set_class_pointer_pri_;
+  auto *const buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+  auto *const record = RedoRecord::Initialize(buffer, txn->StartTime(), db_oid, catalog::postgres::CLASS_TABLE_OID,
+                                              initializer);
+  auto *const redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+  *(reinterpret_cast<uintptr_t *>(redo->Delta()->AccessForceNotNull(0))) = 0;
+  for (const auto *entries : {&table_entries, &index_entries}) {
+    for (const auto &slot : *entries) {
+      redo->SetTupleSlot(slot);
+      LogSerializerTask::SerializeRecord(*record, out);
+    }
+  }
+  delete[] buffer;
+  WriteCommit(txn, out);
+
+  // Step 3: Write out the contents of the user tables
+  for (const auto &user_table : user_tables) {
+    WriteTable(txn, db_oid, user_table.first, user_table.second,
+               db_catalog->GetSchema(common::ManagedPointer(txn), user_table.first), true, out, nullptr);
+  }
+}
+
+void CheckpointManager::WriteTable(transaction::TransactionContext *const txn, const catalog::db_oid_t db_oid,
+                                   const catalog::table_oid_t table_oid, SqlTable *const table,
+                                   const catalog::Schema &schema, const bool split_txns, BufferedLogWriter *const out,
+                                   const std::function<void(const RedoRecord &)> &on_row) {
+  std::vector<catalog::col_oid_t> col_oids;
+  for (const auto &col : schema.GetColumns()) col_oids.push_back(col.Oid());
+  const auto initializer = table->InitializerForProjectedRow(col_oids);
+  auto *const buffer = common::AllocationUtil::AllocateAligned(RedoRecord::Size(initializer));
+  auto *const record = RedoRecord::Initialize(buffer, txn->StartTime(), db_oid, table_oid, initializer);
+  auto *const redo = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+
+  uint32_t rows_in_txn = 0;
+  for (auto it = table->begin(); it != table->end(); it++) {
+    // Tuples that are not visible to the snapshot were either deleted or inserted after it was taken
+    if (!table->Select(common::ManagedPointer(txn), *it, redo->Delta())) continue;
+    redo->SetTupleSlot(*it);
+    LogSerializerTask::SerializeRecord(*record, out);
+    if (on_row) on_row(*redo);
+
+    if (split_txns && ++rows_in_txn == ROWS_PER_CHECKPOINT_TXN) {
+      WriteCommit(txn, out);
+      rows_in_txn = 0;
+    }
+  }
+  if (split_txns && rows_in_txn > 0) WriteCommit(txn, out);
+  delete[] buffer;
+}
+
+void CheckpointManager::WriteCommit(transaction::TransactionContext *const txn, BufferedLogWriter *const out) {
+  // Checkpoint transactions are not concurrent with anything, so recovery can replay them as soon as it reads their
+  // commit record
+  auto *const buffer = common::AllocationUtil::AllocateAligned(CommitRecord::Size());
+  auto *const record = CommitRecord::Initialize(buffer, txn->StartTime(), txn->StartTime(), nullptr, nullptr,
+                                                transaction::INVALID_TXN_TIMESTAMP, false, nullptr, nullptr);
+  LogSerializerTask::SerializeRecord(*record, out);
+  delete[] buffer;
+}
+
+}  // namespace terrier::storage
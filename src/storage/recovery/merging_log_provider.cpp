@@ -0,0 +1,106 @@
+#include "storage/recovery/merging_log_provider.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/write_ahead_log/log_manager.h"
+
+namespace terrier::storage {
+
+MergingLogProvider::MergingLogProvider(const std::string &log_file_path, const uint32_t num_log_streams) {
+  for (uint32_t i = 0; i < num_log_streams; i++) {
+    cursors_.emplace_back(std::make_unique<StreamCursor>(LogManager::LogStreamFilePath(log_file_path, i)));
+    cursor_heap_.push(cursors_.back().get());
+  }
+}
+
+MergingLogProvider::~MergingLogProvider() {
+  // Records before current_record_ were handed out, and are owned by the caller
+  current_.erase(current_.begin(), current_.begin() + current_record_);
+  DeleteRecords(&current_);
+  for (auto &transaction : read_ahead_) DeleteRecords(&transaction.second);
+  for (auto &cursor : cursors_) {
+    for (auto &transaction : cursor->unfinished_) DeleteRecords(&transaction.second);
+  }
+}
+
+std::pair<LogRecord *, std::vector<byte *>> MergingLogProvider::GetNextRecord() {
+  if (current_record_ == current_.size()) {
+    current_.clear();
+    current_record_ = 0;
+    if (!NextTransaction()) return {nullptr, std::vector<byte *>()};
+  }
+  return std::move(current_[current_record_++]);
+}
+
+bool MergingLogProvider::NextTransaction() {
+  while (true) {
+    auto next = read_ahead_.find(last_commit_);
+    if (next != read_ahead_.end()) {
+      current_ = std::move(next->second);
+      read_ahead_.erase(next);
+      last_commit_ = current_.back().first->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime();
+      return true;
+    }
+    if (cursor_heap_.empty()) break;
+    // The next commit is most likely in the file that is furthest behind. The files are read in commit order as a
+    // whole, so we only read ahead of the next commit as far as concurrent commits reached the files out of order.
+    auto *const cursor = cursor_heap_.top();
+    cursor_heap_.pop();
+    if (ReadTransaction(cursor)) cursor_heap_.push(cursor);
+  }
+
+  // Every file is exhausted. Anything left was committed after a commit that is missing from the log.
+  if (!read_ahead_.empty()) {
+    stopped_at_gap_ = true;
+    STORAGE_LOG_WARN("Log replay stopped at a missing commit, {} later commits are not replayed", read_ahead_.size());
+    for (auto &transaction : read_ahead_) DeleteRecords(&transaction.second);
+    read_ahead_.clear();
+  }
+  return false;
+}
+
+bool MergingLogProvider::ReadTransaction(StreamCursor *const cursor) {
+  while (true) {
+    auto pair = cursor->provider_.GetNextRecord();
+    if (pair.first == nullptr) {
+      // Records at the end of the file that are not followed by a commit belong to transactions that never committed
+      for (auto &transaction : cursor->unfinished_) DeleteRecords(&transaction.second);
+      cursor->unfinished_.clear();
+      return false;
+    }
+    auto *const record = pair.first;
+    auto &records = cursor->unfinished_[record->TxnBegin()];
+    records.emplace_back(std::move(pair));
+
+    if (record->RecordType() == LogRecordType::ABORT) {
+      // The recovery manager would discard an aborted transaction's records anyway
+      DeleteRecords(&records);
+      cursor->unfinished_.erase(record->TxnBegin());
+      return true;
+    }
+    if (record->RecordType() == LogRecordType::COMMIT) {
+      const auto *const commit = record->GetUnderlyingRecordBodyAs<CommitRecord>();
+      cursor->position_ = commit->CommitTime();
+      read_ahead_.emplace(commit->PreviousCommit(), std::move(records));
+      cursor->unfinished_.erase(record->TxnBegin());
+      return true;
+    }
+  }
+}
+
+void MergingLogProvider::DeleteRecords(std::vector<Record> *const records) {
+  for (auto &record : *records) {
+    for (auto *varlen : record.second) delete[] varlen;
+    delete[] reinterpret_cast<byte *>(record.first);
+  }
+  records->clear();
+}
+
+bool MergingLogProvider::HasMoreRecords() {
+  return current_record_ < current_.size() || !read_ahead_.empty() || !cursor_heap_.empty();
+}
+
+}  // namespace terrier::storage
@@ -40,9 +40,35 @@ void RecoveryManager::WaitForRecoveryToFinish() {
 }
 
 void RecoveryManager::RecoverFromLogs() {
+  if (replay_pool_ != nullptr) replay_pool_->Startup();
+
+  // The checkpoint is made up of committed transactions that can be replayed as soon as they are read. Afterwards, we
+  // only need to replay the transactions in the log that committed after the checkpoint was taken.
+  if (checkpoint_provider_ != nullptr) checkpoint_timestamp_ = ReplayLogRecords(checkpoint_provider_);
+  ReplayLogRecords(log_provider_);
+
+  // Process all deferred txns
+  ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
+  ReplayPartitionedTransactions();
+  TERRIER_ASSERT(deferred_txns_.empty(), "We should have no unprocessed deferred transactions at the end of recovery");
+  if (replay_pool_ != nullptr) replay_pool_->Shutdown();
+
+  // If we have unprocessed buffered changes, then these transactions were in-process at the time of system shutdown.
+  // They are unrecoverable, so we need to clean up the memory of their records.
+  if (!buffered_changes_map_.empty()) {
+    for (const auto &txn : buffered_changes_map_) {
+      DeferRecordDeletes(txn.first, true);
+    }
+    buffered_changes_map_.clear();
+  }
+}
+
+transaction::timestamp_t RecoveryManager::ReplayLogRecords(const common::ManagedPointer<AbstractLogProvider> provider) {
+  auto latest_commit = transaction::INITIAL_TXN_TIMESTAMP;
+
   // Replay logs until the log provider no longer gives us logs
   while (true) {
-    auto pair = log_provider_->GetNextRecord();
+    auto pair = provider->GetNextRecord();
     auto *log_record = pair.first;
 
     // If we have exhausted all the logs, break from the loop
@@ -60,9 +86,17 @@ void RecoveryManager::RecoverFromLogs() {
       case (LogRecordType::COMMIT): {
         TERRIER_ASSERT(pair.second.empty(), "Commit records should not have any varlen pointers");
         auto *commit_record = log_record->GetUnderlyingRecordBodyAs<CommitRecord>();
-
-        // We defer all transactions initially
-        deferred_txns_.insert(log_record->TxnBegin());
+        latest_commit = std::max(latest_commit, commit_record->CommitTime());
+
+        if (commit_record->CommitTime() < checkpoint_timestamp_) {
+          // The checkpoint already holds this transaction's changes. Some of its records may have been truncated from
+          // the log, so we must not replay it.
+          DeferRecordDeletes(log_record->TxnBegin(), true);
+          buffered_changes_map_.erase(log_record->TxnBegin());
+        } else {
+          // We defer all transactions initially
+          deferred_txns_.insert(log_record->TxnBegin());
+        }
 
         // Process any deferred transactions that are safe to execute
         recovered_txns_ += ProcessDeferredTransactions(commit_record->OldestActiveTxn());
@@ -79,18 +113,7 @@ void RecoveryManager::RecoverFromLogs() {
         buffered_changes_map_[log_record->TxnBegin()].push_back(pair);
     }
   }
-  // Process all deferred txns
-  ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
-  TERRIER_ASSERT(deferred_txns_.empty(), "We should have no unprocessed deferred transactions at the end of recovery");
-
-  // If we have unprocessed buffered changes, then these transactions were in-process at the time of system shutdown.
-  // They are unrecoverable, so we need to clean up the memory of their records.
-  if (!buffered_changes_map_.empty()) {
-    for (const auto &txn : buffered_changes_map_) {
-      DeferRecordDeletes(txn.first, true);
-    }
-    buffered_changes_map_.clear();
-  }
+  return latest_commit;
 }
 
 void RecoveryManager::ProcessCommittedTransaction(terrier::transaction::timestamp_t txn_id) {
@@ -144,7 +167,13 @@ uint32_t RecoveryManager::ProcessDeferredTransactions(terrier::transaction::time
   auto upper_bound_it = deferred_txns_.upper_bound(upper_bound_ts);
 
   for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
-    ProcessCommittedTransaction(*it);
+    if (replay_pool_ != nullptr && IsPartitionableTransaction(*it)) {
+      DeferPartitionedTransaction(*it);
+    } else {
+      // Transactions that must be replayed serially act as a barrier for the parallel replay of earlier transactions
+      ReplayPartitionedTransactions();
+      ProcessCommittedTransaction(*it);
+    }
     txns_processed++;
   }
 
@@ -154,6 +183,148 @@ uint32_t RecoveryManager::ProcessDeferredTransactions(terrier::transaction::time
   return txns_processed;
 }
 
+bool RecoveryManager::IsPartitionableTransaction(const transaction::timestamp_t txn_id) {
+  for (const auto &buffered_pair : buffered_changes_map_[txn_id]) {
+    const auto *record = buffered_pair.first;
+    const auto table_oid = record->RecordType() == LogRecordType::REDO
+                               ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid()
+                               : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid();
+    // Catalog tables are always replayed serially, as their changes have side effects on other tables
+    if (table_oid.UnderlyingValue() < catalog::START_OID) return false;
+  }
+  return true;
+}
+
+void RecoveryManager::DeferPartitionedTransaction(const transaction::timestamp_t txn_id) {
+  auto &changes = buffered_changes_map_[txn_id];
+  num_pending_partitioned_records_ += changes.size();
+  pending_partitioned_txns_.emplace_back(txn_id, std::move(changes));
+  buffered_changes_map_.erase(txn_id);
+  if (num_pending_partitioned_records_ >= PARTITIONED_REPLAY_BATCH_SIZE) ReplayPartitionedTransactions();
+}
+
+void RecoveryManager::ReplayPartitionedTransactions() {
+  if (pending_partitioned_txns_.empty()) return;
+
+  // Partition the changes by table. No DDL can happen within the batch, so we can resolve every table through the
+  // catalog once up front with a single transaction.
+  std::map<std::pair<catalog::db_oid_t, catalog::table_oid_t>, PartitionedTableReplay> partitions;
+  auto *lookup_txn = txn_manager_->BeginTransaction();
+  for (auto &txn_changes : pending_partitioned_txns_) {
+    for (auto &buffered_pair : txn_changes.second) {
+      auto *record = buffered_pair.first;
+      const auto key = record->RecordType() == LogRecordType::REDO
+                           ? std::make_pair(record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetDatabaseOid(),
+                                            record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTableOid())
+                           : std::make_pair(record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetDatabaseOid(),
+                                            record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid());
+      auto it = partitions.find(key);
+      if (it == partitions.end()) {
+        auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(lookup_txn), key.first);
+        TERRIER_ASSERT(db_catalog != nullptr, "No catalog for given database oid");
+        it = partitions.emplace(key, PartitionedTableReplay()).first;
+        auto &table_replay = it->second;
+        table_replay.table_ = db_catalog->GetTable(common::ManagedPointer(lookup_txn), key.second);
+        TERRIER_ASSERT(table_replay.table_ != nullptr, "Table should exist for a committed change");
+        for (const auto &col : db_catalog->GetSchema(common::ManagedPointer(lookup_txn), key.second).GetColumns()) {
+          table_replay.all_col_oids_.push_back(col.Oid());
+        }
+        table_replay.indexes_ = db_catalog->GetIndexes(common::ManagedPointer(lookup_txn), key.second);
+      }
+      // Start a new group whenever we see the first change of a txn to this table
+      auto &table_changes = it->second.txn_changes_;
+      if (table_changes.empty() || table_changes.back().front()->TxnBegin() != txn_changes.first) {
+        table_changes.emplace_back();
+      }
+      table_changes.back().push_back(record);
+    }
+  }
+  txn_manager_->Commit(lookup_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Each table is replayed by exactly one worker, so workers never touch the same tuples or indexes
+  for (auto &partition : partitions) {
+    auto *table_replay = &partition.second;
+    replay_pool_->SubmitTask([this, table_replay] { ReplayPartitionedTable(table_replay); });
+  }
+  replay_pool_->WaitUntilAllFinished();
+
+  // Fold the workers' tuple slot mappings back into the global map
+  for (const auto &partition : partitions) {
+    for (const auto &slot_change : partition.second.tuple_slot_changes_) {
+      if (slot_change.second == TupleSlot(nullptr, 0)) {
+        tuple_slot_map_.erase(slot_change.first);
+      } else {
+        tuple_slot_map_[slot_change.first] = slot_change.second;
+      }
+    }
+  }
+
+  // Defer deletes of the log records. Varlens are now owned by the tables.
+  deferred_action_manager_->RegisterDeferredAction([buffered_txns{std::move(pending_partitioned_txns_)}]() {
+    for (const auto &txn_changes : buffered_txns) {
+      for (const auto &buffered_pair : txn_changes.second) delete[] reinterpret_cast<byte *>(buffered_pair.first);
+    }
+  });
+  pending_partitioned_txns_.clear();
+  num_pending_partitioned_records_ = 0;
+}
+
+TupleSlot RecoveryManager::GetPartitionedTupleSlotMapping(const PartitionedTableReplay &table_replay,
+                                                          const TupleSlot slot) const {
+  // The worker's own changes take precedence. The global map is not modified while workers are running.
+  const auto local_it = table_replay.tuple_slot_changes_.find(slot);
+  if (local_it != table_replay.tuple_slot_changes_.end()) return local_it->second;
+  const auto global_it = tuple_slot_map_.find(slot);
+  return global_it != tuple_slot_map_.end() ? global_it->second : TupleSlot(nullptr, 0);
+}
+
+void RecoveryManager::ReplayPartitionedTable(PartitionedTableReplay *const table_replay) {
+  const auto table_ptr = table_replay->table_;
+  const auto initializer = table_ptr->InitializerForProjectedRow(table_replay->all_col_oids_);
+  auto *const select_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+
+  for (const auto &txn_records : table_replay->txn_changes_) {
+    auto *txn = txn_manager_->BeginTransaction();
+    for (auto *record : txn_records) {
+      if (record->RecordType() == LogRecordType::REDO) {
+        auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+        const auto old_tuple_slot = redo_record->GetTupleSlot();
+        const auto mapped_tuple_slot = GetPartitionedTupleSlotMapping(*table_replay, old_tuple_slot);
+        if (mapped_tuple_slot == TupleSlot(nullptr, 0)) {
+          // Insert, see ReplayRedoRecord
+          redo_record->SetTupleSlot(TupleSlot(nullptr, 0));
+          auto staged_record = txn->StageRecoveryWrite(record);
+          auto new_tuple_slot = table_ptr->Insert(common::ManagedPointer(txn), staged_record);
+          UpdateIndexes(txn, table_replay->indexes_, table_ptr, table_replay->all_col_oids_, new_tuple_slot,
+                        staged_record->Delta(), true /* insert */);
+          table_replay->tuple_slot_changes_[old_tuple_slot] = new_tuple_slot;
+        } else {
+          // Update, see ReplayRedoRecord
+          redo_record->SetTupleSlot(mapped_tuple_slot);
+          auto staged_record = txn->StageRecoveryWrite(record);
+          bool result UNUSED_ATTRIBUTE = table_ptr->Update(common::ManagedPointer(txn), staged_record);
+          TERRIER_ASSERT(result, "Buffered changes should always succeed during commit");
+        }
+      } else {
+        // Delete, see ReplayDeleteRecord
+        auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
+        const auto new_tuple_slot = GetPartitionedTupleSlotMapping(*table_replay, delete_record->GetTupleSlot());
+        TERRIER_ASSERT(new_tuple_slot != TupleSlot(nullptr, 0), "No tuple slot mapping exists");
+        txn->StageDelete(delete_record->GetDatabaseOid(), delete_record->GetTableOid(), new_tuple_slot);
+        auto *pr = initializer.InitializeRow(select_buffer);
+        table_ptr->Select(common::ManagedPointer(txn), new_tuple_slot, pr);
+        bool result UNUSED_ATTRIBUTE = table_ptr->Delete(common::ManagedPointer(txn), new_tuple_slot);
+        TERRIER_ASSERT(result, "Buffered changes should always succeed during commit");
+        UpdateIndexes(txn, table_replay->indexes_, table_ptr, table_replay->all_col_oids_, new_tuple_slot, pr,
+                      false /* delete */);
+        table_replay->tuple_slot_changes_[delete_record->GetTupleSlot()] = TupleSlot(nullptr, 0);
+      }
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+  delete[] select_buffer;
+}
+
 void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record) {
   auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
   auto sql_table_ptr = GetSqlTable(txn, redo_record->GetDatabaseOid(), redo_record->GetTableOid());
@@ -318,6 +489,22 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
   // If there's no indexes on the table, we can return
   if (index_objects.empty()) return;
 
+  // Build a PR map for all columns in the table, as the table pr should have values for every column
+  const auto &table_schema = GetTableSchema(txn, db_catalog_ptr, table_oid);
+  std::vector<catalog::col_oid_t> all_table_oids;
+  for (const auto &col : table_schema.GetColumns()) {
+    all_table_oids.push_back(col.Oid());
+  }
+  UpdateIndexes(txn, index_objects, table_ptr, all_table_oids, tuple_slot, table_pr, insert);
+}
+
+void RecoveryManager::UpdateIndexes(
+    transaction::TransactionContext *txn,
+    const std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> &index_objects,
+    common::ManagedPointer<storage::SqlTable> table_ptr, const std::vector<catalog::col_oid_t> &all_table_oids,
+    const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
+  if (index_objects.empty()) return;
+
   // Compute largest PR size we need for index PRs.
   uint32_t max_index_key_pr_size = 0;
   for (const auto &index_obj : index_objects) {
@@ -326,12 +513,6 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
   }
   auto *index_buffer = common::AllocationUtil::AllocateAligned(max_index_key_pr_size);
 
-  // Build a PR map for all columns in the table, as the table pr should have values for every column
-  const auto &table_schema = GetTableSchema(txn, db_catalog_ptr, table_oid);
-  std::vector<catalog::col_oid_t> all_table_oids;
-  for (const auto &col : table_schema.GetColumns()) {
-    all_table_oids.push_back(col.Oid());
-  }
   auto pr_map = table_ptr->ProjectionMapForOids(all_table_oids);
   TERRIER_ASSERT(pr_map.size() == table_pr->NumColumns(), "Projected row should contain all attributes");
 
@@ -655,7 +836,7 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
             col_oids.clear();
             col_oids = {catalog::postgres::INDISUNIQUE_COL_OID, catalog::postgres::INDISPRIMARY_COL_OID,
                         catalog::postgres::INDISEXCLUSION_COL_OID, catalog::postgres::INDIMMEDIATE_COL_OID,
-                        catalog::postgres::IND_TYPE_COL_OID};
+                        catalog::postgres::IND_TYPE_COL_OID, catalog::postgres::IND_NUM_INCLUDE_COL_OID};
             auto pg_index_pr_init = db_catalog->indexes_->InitializerForProjectedRow(col_oids);
             auto pg_index_pr_map = db_catalog->indexes_->ProjectionMapForOids(col_oids);
             delete[] buffer;  // Delete old buffer, it won't be large enough for this PR
@@ -674,10 +855,12 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
                 pr->AccessWithNullCheck(pg_index_pr_map[catalog::postgres::INDIMMEDIATE_COL_OID])));
             storage::index::IndexType index_type = *(reinterpret_cast<storage::index::IndexType *>(
                 pr->AccessWithNullCheck(pg_index_pr_map[catalog::postgres::IND_TYPE_COL_OID])));
+            uint16_t num_include_columns = *(reinterpret_cast<uint16_t *>(
+                pr->AccessWithNullCheck(pg_index_pr_map[catalog::postgres::IND_NUM_INCLUDE_COL_OID])));
 
             // Step 4: Create and set IndexSchema in catalog
-            auto *index_schema =
-                new catalog::IndexSchema(index_cols, index_type, is_unique, is_primary, is_exclusion, is_immediate);
+            auto *index_schema = new catalog::IndexSchema(index_cols, index_type, is_unique, is_primary, is_exclusion,
+                                                          is_immediate, num_include_columns);
             result = db_catalog->SetIndexSchemaPointer(common::ManagedPointer(txn), catalog::index_oid_t(class_oid),
                                                        index_schema);
             TERRIER_ASSERT(result, "Setting index schema pointer should succeed, entry should be in pg_class already");
@@ -0,0 +1,50 @@
+#include "storage/recovery/replication_log_provider.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace terrier::storage {
+
+void ReplicationLogProvider::HandBufferToReplication(std::unique_ptr<network::ReadBuffer> buffer) {
+  {
+    std::unique_lock<std::mutex> lock(latch_);
+    TERRIER_ASSERT(replication_active_, "Received logs after replication has ended");
+    if (buffer->BytesAvailable() == 0) return;
+    buffers_.emplace_back(std::move(buffer));
+  }
+  cv_.notify_one();
+}
+
+void ReplicationLogProvider::EndReplication() {
+  {
+    std::unique_lock<std::mutex> lock(latch_);
+    replication_active_ = false;
+  }
+  cv_.notify_one();
+}
+
+bool ReplicationLogProvider::HasMoreRecords() {
+  std::unique_lock<std::mutex> lock(latch_);
+  cv_.wait(lock, [&] { return !buffers_.empty() || !replication_active_; });
+  return !buffers_.empty();
+}
+
+bool ReplicationLogProvider::Read(void *const dest, const uint32_t size) {
+  std::unique_lock<std::mutex> lock(latch_);
+  uint32_t bytes_read = 0;
+  while (bytes_read < size) {
+    // A record can be split across the buffers the primary shipped, so we may have to wait for the rest of it
+    cv_.wait(lock, [&] { return !buffers_.empty() || !replication_active_; });
+    if (buffers_.empty()) return false;
+
+    auto &buffer = buffers_.front();
+    const auto bytes_to_read = static_cast<uint32_t>(std::min<size_t>(buffer->BytesAvailable(), size - bytes_read));
+    buffer->ReadIntoView(bytes_to_read).Read(bytes_to_read, reinterpret_cast<byte *>(dest) + bytes_read);
+    bytes_read += bytes_to_read;
+    if (buffer->BytesAvailable() == 0) buffers_.pop_front();
+  }
+  return true;
+}
+
+}  // namespace terrier::storage
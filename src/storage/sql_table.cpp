@@ -56,6 +56,26 @@ SqlTable::SqlTable(const common::ManagedPointer<BlockStore> store, const catalog
   table_ = {new DataTable(store, layout, layout_version_t(0)), layout, col_map};
 }
 
+void SqlTable::InsertBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                           const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                           ProjectedColumns *const columns) const {
+  table_.data_table_->InsertBatch(txn, columns);
+
+  // Log the tuples in the order they were inserted, so that the last RedoRecord matches the last UndoRecord
+  const std::vector<col_id_t> col_ids(columns->ColumnIds(), columns->ColumnIds() + columns->NumColumns());
+  const auto initializer = ProjectedRowInitializer::Create(table_.layout_, col_ids);
+  for (uint32_t row = 0; row < columns->NumTuples(); row++) {
+    RedoRecord *const redo = txn->StageWrite(db_oid, table_oid, initializer);
+    redo->SetTupleSlot(columns->TupleSlots()[row]);
+    const ProjectedColumns::RowView tuple = columns->InterpretAsRow(row);
+    for (uint16_t i = 0; i < tuple.NumColumns(); i++) {
+      TERRIER_ASSERT(redo->Delta()->ColumnIds()[i] == col_ids[i], "Projection lists should be ordered the same way");
+      StorageUtil::CopyWithNullCheck(tuple.AccessWithNullCheck(i), redo->Delta(), table_.layout_.AttrSize(col_ids[i]),
+                                     i);
+    }
+  }
+}
+
 std::vector<col_id_t> SqlTable::ColIdsForOids(const std::vector<catalog::col_oid_t> &col_oids) const {
   TERRIER_ASSERT(!col_oids.empty(), "Should be used to access at least one column.");
   std::vector<col_id_t> col_ids;
@@ -1,5 +1,10 @@
 #include "storage/storage_defs.h"
 
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <vector>
+
 #include "common/strong_typedef_body.h"
 
 namespace terrier::storage {
@@ -7,4 +12,112 @@ namespace terrier::storage {
 STRONG_TYPEDEF_BODY(col_id_t, uint16_t);
 STRONG_TYPEDEF_BODY(layout_version_t, uint16_t);
 
+RawBlock *BlockAllocator::New() {
+  // The arena places its blocks itself
+  void *memory = arena_ == nullptr ? nullptr : arena_->AllocateBlock(numa_node_);
+  if (memory == nullptr) {
+    memory = ::operator new(sizeof(RawBlock), std::align_val_t(alignof(RawBlock)));
+    // Place the pages of the block before the constructor touches them
+    common::NumaUtil::BindMemory(memory, sizeof(RawBlock), numa_node_);
+  }
+  auto *const result = new (memory) RawBlock();
+  result->numa_node_ = numa_node_;
+  return result;
+}
+
+void BlockAllocator::Delete(RawBlock *const ptr) {
+  ptr->~RawBlock();
+  if (arena_ != nullptr && arena_->Contains(ptr))
+    arena_->FreeBlock(ptr);
+  else
+    ::operator delete(ptr, std::align_val_t(alignof(RawBlock)));
+}
+
+BlockStore::BlockStore(const uint64_t size_limit, const uint64_t reuse_limit, const BlockPlacement placement,
+                       const uint16_t num_nodes, BlockArena *const arena)
+    : placement_(placement), size_limit_(size_limit) {
+  TERRIER_ASSERT(num_nodes > 0, "There is always at least one NUMA node");
+  pools_.resize(num_nodes);
+  for (uint16_t node = 0; node < num_nodes; node++)
+    pools_[node] = std::make_unique<common::ShardedObjectPool<RawBlock, BlockAllocator>>(
+        NodeShare(size_limit, node), NodeShare(reuse_limit, node), BlockAllocator(node, arena));
+}
+
+RawBlock *BlockStore::Get(const uint16_t numa_node) {
+  TERRIER_ASSERT(numa_node < pools_.size(), "NUMA node out of bounds");
+  // Only spill over to other nodes once this one has handed out its share of blocks
+  for (uint16_t i = 0; i < pools_.size(); i++) {
+    try {
+      return pools_[(numa_node + i) % pools_.size()]->Get();
+    } catch (common::NoMoreObjectException &) {
+    }
+  }
+  throw common::NoMoreObjectException(size_limit_);
+}
+
+void BlockStore::Release(const std::vector<RawBlock *> &blocks) {
+  {
+    common::SharedLatch::ScopedSharedLatch guard(&listeners_latch_);
+    for (BlockReleaseListener *const listener : release_listeners_) listener->OnRelease(blocks);
+  }
+  for (RawBlock *const block : blocks) Release(block);
+}
+
+void BlockStore::RegisterReleaseListener(BlockReleaseListener *const listener) {
+  common::SharedLatch::ScopedExclusiveLatch guard(&listeners_latch_);
+  release_listeners_.push_back(listener);
+}
+
+void BlockStore::UnregisterReleaseListener(BlockReleaseListener *const listener) {
+  common::SharedLatch::ScopedExclusiveLatch guard(&listeners_latch_);
+  release_listeners_.erase(std::remove(release_listeners_.begin(), release_listeners_.end(), listener),
+                           release_listeners_.end());
+}
+
+bool BlockStore::SetSizeLimit(const uint64_t new_size) {
+  common::SpinLatch::ScopedSpinLatch guard(&size_latch_);
+  const auto num_nodes = static_cast<uint16_t>(pools_.size());
+  std::vector<uint64_t> held(num_nodes), caps(num_nodes);
+  uint64_t total_held = 0;
+  for (uint16_t node = 0; node < num_nodes; node++) {
+    held[node] = pools_[node]->GetNumObjectsAllocated();
+    total_held += held[node];
+  }
+  if (total_held > new_size) return false;
+
+  // Every node gets its share of the new limit, but no less than it holds. Nodes with room to spare make up for the
+  // difference, which they can since the total fits.
+  uint64_t excess = 0;
+  for (uint16_t node = 0; node < num_nodes; node++) {
+    caps[node] = std::max(NodeShare(new_size, node), held[node]);
+    excess += caps[node] - NodeShare(new_size, node);
+  }
+  for (uint16_t node = 0; node < num_nodes && excess > 0; node++) {
+    const uint64_t reduction = std::min(excess, caps[node] - held[node]);
+    caps[node] -= reduction;
+    excess -= reduction;
+  }
+
+  std::vector<uint64_t> old_caps(num_nodes);
+  for (uint16_t node = 0; node < num_nodes; node++) {
+    old_caps[node] = pools_[node]->GetSizeLimit();
+    if (pools_[node]->SetSizeLimit(caps[node])) continue;
+    // The node allocated more blocks in the meantime. Undo what has been changed so far.
+    for (uint16_t changed = 0; changed < node; changed++) pools_[changed]->SetSizeLimit(old_caps[changed]);
+    return false;
+  }
+  size_limit_ = new_size;
+  return true;
+}
+
+void BlockStore::SetReuseLimit(const uint64_t new_reuse_limit) {
+  for (uint16_t node = 0; node < pools_.size(); node++) pools_[node]->SetReuseLimit(NodeShare(new_reuse_limit, node));
+}
+
+uint64_t BlockStore::GetNumObjectsInUse() const {
+  uint64_t result = 0;
+  for (const auto &pool : pools_) result += pool->GetNumObjectsInUse();
+  return result;
+}
+
 }  // namespace terrier::storage
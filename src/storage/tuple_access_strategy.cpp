@@ -1,5 +1,6 @@
 #include "storage/tuple_access_strategy.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "common/container/concurrent_bitmap.h"
@@ -30,6 +31,8 @@ void TupleAccessStrategy::InitializeRawBlock(storage::DataTable *const data_tabl
   raw->layout_version_ = layout_version;
   raw->insert_head_ = 0;
   raw->controller_.Initialize();
+  raw->varlen_arena_ = nullptr;
+  raw->num_versioned_slots_ = 0;
   auto *result = reinterpret_cast<TupleAccessStrategy::Block *>(raw);
   result->GetArrowBlockMetadata().Initialize(GetBlockLayout().NumColumns());
   for (uint16_t i = 0; i < layout_.NumColumns(); i++) result->AttrOffsets(layout_)[i] = column_offsets_[i];
@@ -60,4 +63,18 @@ bool TupleAccessStrategy::Allocate(RawBlock *const block, TupleSlot *const slot)
   block->insert_head_++;
   return true;
 }
+
+uint32_t TupleAccessStrategy::AllocateRange(RawBlock *const block, const uint32_t max_slots,
+                                            uint32_t *const start) const {
+  common::RawConcurrentBitmap *bitmap = reinterpret_cast<Block *>(block)->SlotAllocationBitmap(layout_);
+  *start = block->GetInsertHead();
+  const uint32_t num_slots = std::min(max_slots, layout_.NumSlots() - *start);
+  // Same assumption as above, no one else inserts into this block at the same time
+  for (uint32_t pos = *start; pos < *start + num_slots; pos++) {
+    bool UNUSED_ATTRIBUTE flip_res = bitmap->Flip(pos, false);
+    TERRIER_ASSERT(flip_res, "Flip should always succeed");
+  }
+  block->insert_head_ += num_slots;
+  return num_slots;
+}
 }  // namespace terrier::storage
@@ -0,0 +1,38 @@
+#include "storage/varlen_arena.h"
+
+#include "common/allocator.h"
+
+namespace terrier::storage {
+
+byte *VarlenArena::Allocate(const uint32_t size) {
+  // Keep every value 8-byte aligned
+  const auto padded_size = static_cast<uint32_t>((size + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t));
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (padded_size > MAX_PACKED_SIZE) return size_ + padded_size > MAX_SIZE ? nullptr : NewChunk(padded_size);
+
+  if (current_used_ + padded_size > CHUNK_SIZE) {
+    if (size_ + CHUNK_SIZE > MAX_SIZE) return nullptr;
+    current_chunk_ = NewChunk(CHUNK_SIZE);
+    current_used_ = 0;
+  }
+  byte *const result = current_chunk_ + current_used_;
+  current_used_ += padded_size;
+  return result;
+}
+
+bool VarlenArena::Contains(const byte *const ptr) const {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  for (uint32_t i = 0; i < chunks_.size(); i++)
+    if (ptr >= chunks_[i] && ptr < chunks_[i] + chunk_sizes_[i]) return true;
+  return false;
+}
+
+byte *VarlenArena::NewChunk(const uint32_t size) {
+  byte *const chunk = common::AllocationUtil::AllocateAligned(size);
+  chunks_.push_back(chunk);
+  chunk_sizes_.push_back(size);
+  size_ += size;
+  return chunk;
+}
+
+}  // namespace terrier::storage
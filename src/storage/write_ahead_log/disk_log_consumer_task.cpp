@@ -25,18 +25,23 @@ void DiskLogConsumerTask::WriteBuffersToLogFile() {
   // Persist all the filled buffers to the disk
   SerializedLogs logs;
   while (!filled_buffer_queue_->Empty()) {
-    // Dequeue filled buffers and flush them to disk, as well as storing commit callbacks
-    filled_buffer_queue_->Dequeue(&logs);
-    if (logs.first != nullptr) {
+    // Dequeue all the filled buffers that are currently available, as well as storing commit callbacks. Buffers are
+    // handed to us in serialization order, so writing them out in dequeue order preserves the order of the log.
+    while (filled_buffer_queue_->Dequeue(&logs)) {
       // Need the nullptr check because read-only txns don't serialize any buffers, but generate callbacks to be invoked
-      current_data_written_ += logs.first->FlushBuffer();
+      if (logs.first != nullptr) write_batch_.push_back(logs.first);
+      commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
     }
-    commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
-    // Enqueue the flushed buffer to the empty buffer queue
-    if (logs.first != nullptr) {
-      // nullptr check for the same reason as above
-      empty_buffer_queue_->Enqueue(logs.first);
+    if (write_batch_.empty()) continue;
+
+    if (log_shipper_ != nullptr) {
+      for (auto *const buffer : write_batch_) buffer->CopyBufferTo(&unshipped_logs_);
     }
+    // Group the filled buffers into a single vectored write instead of issuing one write per buffer
+    current_data_written_ += BufferedLogWriter::FlushBuffers(write_batch_);
+    // Enqueue the flushed buffers to the empty buffer queue
+    for (auto *const buffer : write_batch_) empty_buffer_queue_->Enqueue(buffer);
+    write_batch_.clear();
   }
 }
 
@@ -48,12 +53,21 @@ uint64_t DiskLogConsumerTask::PersistLogFile() {
     buffers_->front().Persist();
   }
   const auto num_buffers = commit_callbacks_.size();
-  // Execute the callbacks for the transactions that have been persisted
-  for (auto &callback : commit_callbacks_) callback.first(callback.second);
-  commit_callbacks_.clear();
+  // Execute the callbacks for the transactions that are durable now. A transaction persisted by this stream may have
+  // read from one that another stream has not persisted yet, in which case its callback runs once that one is.
+  durable_watermark_->Persisted(&commit_callbacks_);
+  // The replica is sent the log only once it is persisted, so that it never gets ahead of what the primary recovers to
+  TERRIER_ASSERT(persisted_logs_.empty(), "Persisted logs must be shipped before the next persist");
+  persisted_logs_.swap(unshipped_logs_);
   return num_buffers;
 }
 
+void DiskLogConsumerTask::ShipPersistedLogs() {
+  if (persisted_logs_.empty()) return;
+  log_shipper_->ShipLogs(persisted_logs_.data(), persisted_logs_.size());
+  persisted_logs_.clear();
+}
+
 void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // input for this operating unit
   uint64_t num_bytes = 0, num_buffers = 0;
@@ -98,17 +112,25 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
     WriteBuffersToLogFile();
 
     // We persist the log file if the following conditions are met
-    // 1) The persist interval amount of time has passed since the last persist
+    // 1) The sleep interval amount of time has passed since the last persist, or the persist interval if we have
+    //    written data that is not yet persisted. This bounds how long an asynchronous commit is not durable for.
     // 2) We have written more data since the last persist than the threshold
     // 3) We are signaled to persist
     // 4) We are shutting down this task
     bool timeout = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
-                                                                         last_persist) > curr_sleep;
+                                                                         last_persist) >
+                   (current_data_written_ > 0 ? persist_interval_ : curr_sleep);
 
     if (timeout || current_data_written_ > persist_threshold_ || do_persist_ || !run_task_) {
       std::unique_lock<std::mutex> lock(persist_lock_);
       num_buffers = PersistLogFile();
       num_bytes = current_data_written_;
+      // Switch over to a new log file if the LogManager asked us to. Doing this right after persisting guarantees that
+      // the old log file is durable, and that it holds everything written before the switch
+      if (new_log_file_fd_ != -1) {
+        for (auto &buffer : *buffers_) buffer.SwitchLogFile(new_log_file_fd_);
+        new_log_file_fd_ = -1;
+      }
       // Reset meta data
       last_persist = std::chrono::high_resolution_clock::now();
       current_data_written_ = 0;
@@ -116,6 +138,9 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
 
       // Signal anyone who forced a persist that the persist has finished
       persist_cv_.notify_all();
+      // Transactions forcing a persist do not wait on the replica
+      lock.unlock();
+      ShipPersistedLogs();
     }
 
     if (logging_metrics_enabled && num_buffers > 0) {
@@ -130,5 +155,6 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // Be extra sure we processed everything
   WriteBuffersToLogFile();
   PersistLogFile();
+  ShipPersistedLogs();
 }
 }  // namespace terrier::storage
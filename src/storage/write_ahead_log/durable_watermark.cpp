@@ -0,0 +1,43 @@
+#include "storage/write_ahead_log/durable_watermark.h"
+
+#include <utility>
+#include <vector>
+
+#include "transaction/timestamp_manager.h"
+
+namespace terrier::storage {
+
+transaction::timestamp_t DurableWatermark::CheckOutCommitTimestamp(
+    transaction::TimestampManager *const timestamp_manager, transaction::timestamp_t *const previous_commit) {
+  // The timestamp is checked out under the latch, so every commit timestamp below a waiting commit is either known to
+  // be unpersisted here, or belongs to a read-only or aborted transaction that has nothing to persist
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  const auto commit_time = timestamp_manager->CheckOutTimestamp();
+  unpersisted_commits_.insert(commit_time);
+  *previous_commit = last_commit_;
+  last_commit_ = commit_time;
+  return commit_time;
+}
+
+void DurableWatermark::Persisted(std::vector<CommitCallback> *const commits) {
+  std::vector<std::pair<transaction::callback_fn, void *>> durable;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    // Read-only transactions never checked out their timestamp here, but their callbacks wait all the same: they may
+    // have read the writes of a commit that is not persisted yet
+    for (const auto &commit : *commits) {
+      unpersisted_commits_.erase(commit.commit_time_);
+      waiting_callbacks_.emplace(commit.commit_time_, std::make_pair(commit.callback_, commit.callback_arg_));
+    }
+    // Everything that committed before the oldest unpersisted commit is durable
+    const auto end = unpersisted_commits_.empty() ? waiting_callbacks_.end()
+                                                  : waiting_callbacks_.lower_bound(*unpersisted_commits_.begin());
+    for (auto it = waiting_callbacks_.begin(); it != end; ++it) durable.push_back(it->second);
+    waiting_callbacks_.erase(waiting_callbacks_.begin(), end);
+  }
+  commits->clear();
+  // Callbacks are invoked outside the latch, so that they do not hold up other streams or committing transactions
+  for (const auto &callback : durable) callback.first(callback.second);
+}
+
+}  // namespace terrier::storage
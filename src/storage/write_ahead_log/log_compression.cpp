@@ -0,0 +1,207 @@
+#include "storage/write_ahead_log/log_compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "storage/data_table.h"
+#include "storage/storage_util.h"
+
+namespace terrier::storage {
+
+namespace {
+// Shortest back-reference the codec emits
+constexpr uint32_t MIN_MATCH = 4;
+// Farthest back a back-reference can point, bounded by its 16 bit encoding
+constexpr uint32_t MAX_OFFSET = UINT16_MAX;
+// log2 of the number of entries in the table of recently seen positions used to find matches
+constexpr uint32_t HASH_BITS = 12;
+// Lengths at or above this value do not fit into their 4 bits of the sequence token and are extended
+constexpr uint32_t MAX_TOKEN_LENGTH = 15;
+
+uint32_t HashFourBytes(const uint8_t *const src) {
+  uint32_t value;
+  std::memcpy(&value, src, sizeof(value));
+  return (value * 2654435761U) >> (32 - HASH_BITS);
+}
+
+void AppendExtendedLength(uint32_t length, std::vector<byte> *const out) {
+  for (; length >= UINT8_MAX; length -= UINT8_MAX) out->push_back(static_cast<byte>(UINT8_MAX));
+  out->push_back(static_cast<byte>(length));
+}
+
+// Appends a run of literals followed by a back-reference. A match_length of 0 means there is no back-reference, which
+// is only the case for the last sequence of the output
+void AppendSequence(const uint8_t *const literals, const uint32_t num_literals, const uint32_t offset,
+                    const uint32_t match_length, std::vector<byte> *const out) {
+  const uint32_t literal_token = std::min(num_literals, MAX_TOKEN_LENGTH);
+  const uint32_t match_token = match_length == 0 ? 0 : std::min(match_length - MIN_MATCH, MAX_TOKEN_LENGTH);
+  out->push_back(static_cast<byte>((literal_token << 4) | match_token));
+  if (literal_token == MAX_TOKEN_LENGTH) AppendExtendedLength(num_literals - MAX_TOKEN_LENGTH, out);
+  const auto *const literal_bytes = reinterpret_cast<const byte *>(literals);
+  out->insert(out->end(), literal_bytes, literal_bytes + num_literals);
+
+  if (match_length == 0) return;
+  out->push_back(static_cast<byte>(offset & 0xFF));
+  out->push_back(static_cast<byte>(offset >> 8));
+  if (match_token == MAX_TOKEN_LENGTH) AppendExtendedLength(match_length - MIN_MATCH - MAX_TOKEN_LENGTH, out);
+}
+}  // namespace
+
+void LogCompressionUtil::Compress(const byte *const src, const uint32_t size, std::vector<byte> *const out) {
+  const auto *const in = reinterpret_cast<const uint8_t *>(src);
+  // Last position each hash of 4 bytes was seen at
+  std::vector<uint32_t> last_seen(1U << HASH_BITS, UINT32_MAX);
+  uint32_t anchor = 0, pos = 0;
+
+  while (pos + MIN_MATCH <= size) {
+    const uint32_t hash = HashFourBytes(in + pos);
+    const uint32_t candidate = last_seen[hash];
+    last_seen[hash] = pos;
+    if (candidate == UINT32_MAX || pos - candidate > MAX_OFFSET ||
+        std::memcmp(in + candidate, in + pos, MIN_MATCH) != 0) {
+      pos++;
+      continue;
+    }
+
+    // Extend the match as far as it goes. It may overlap the bytes it copies, which encodes runs of repeated bytes.
+    uint32_t match_length = MIN_MATCH;
+    while (pos + match_length < size && in[candidate + match_length] == in[pos + match_length]) match_length++;
+    AppendSequence(in + anchor, pos - anchor, pos - candidate, match_length, out);
+    pos += match_length;
+    anchor = pos;
+  }
+
+  if (anchor < size) AppendSequence(in + anchor, size - anchor, 0, 0, out);
+}
+
+bool LogCompressionUtil::Decompress(const byte *const src, const uint32_t size, byte *const dest,
+                                    const uint32_t raw_size) {
+  const auto *const in = reinterpret_cast<const uint8_t *>(src);
+  auto *const out = reinterpret_cast<uint8_t *>(dest);
+  uint32_t in_pos = 0, out_pos = 0;
+
+  const auto read_extended_length = [&](uint32_t *const length) -> bool {
+    uint8_t next;
+    do {
+      if (in_pos == size || *length > raw_size) return false;
+      next = in[in_pos++];
+      *length += next;
+    } while (next == UINT8_MAX);
+    return true;
+  };
+
+  while (in_pos < size) {
+    const uint8_t token = in[in_pos++];
+
+    uint32_t num_literals = token >> 4;
+    if (num_literals == MAX_TOKEN_LENGTH && !read_extended_length(&num_literals)) return false;
+    if (num_literals > size - in_pos || num_literals > raw_size - out_pos) return false;
+    std::memcpy(out + out_pos, in + in_pos, num_literals);
+    in_pos += num_literals;
+    out_pos += num_literals;
+
+    // Only the last sequence has no back-reference
+    if (in_pos == size) break;
+
+    if (size - in_pos < 2) return false;
+    const uint32_t offset = in[in_pos] | (static_cast<uint32_t>(in[in_pos + 1]) << 8);
+    in_pos += 2;
+    if (offset == 0 || offset > out_pos) return false;
+    uint32_t match_length = token & MAX_TOKEN_LENGTH;
+    if (match_length == MAX_TOKEN_LENGTH && !read_extended_length(&match_length)) return false;
+    match_length += MIN_MATCH;
+    if (match_length > raw_size - out_pos) return false;
+    // Copy byte by byte, as the match may overlap the bytes being written
+    for (uint32_t i = 0; i < match_length; i++, out_pos++) out[out_pos] = out[out_pos - offset];
+  }
+
+  return out_pos == raw_size;
+}
+
+uint64_t CompactLogEncoder::Encode(const LogRecord &record) {
+  const auto frame_start = frame_.size();
+  AppendField(record.Size());
+  AppendField(record.RecordType());
+  AppendField(record.TxnBegin());
+
+  switch (record.RecordType()) {
+    case LogRecordType::REDO: {
+      auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
+      AppendField(record_body->GetDatabaseOid());
+      AppendField(record_body->GetTableOid());
+      const auto tuple_slot = record_body->GetTupleSlot();
+      AppendBytes(&tuple_slot, sizeof(TupleSlot));
+
+      auto *delta = record_body->Delta();
+      AppendField(delta->NumColumns());
+      for (uint16_t i = 0; i < delta->NumColumns(); i++) AppendField(delta->ColumnIds()[i]);
+
+      const auto &block_layout = tuple_slot.GetBlock()->data_table_->GetBlockLayout();
+      uint16_t boundaries[NUM_ATTR_BOUNDARIES];
+      memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+      StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
+      for (const auto boundary : boundaries) AppendField(boundary);
+
+      AppendBytes(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
+
+      for (uint16_t i = 0; i < delta->NumColumns(); i++) {
+        const auto *column_value_address = delta->AccessWithNullCheck(i);
+        // Null columns are fully described by the bitmap
+        if (column_value_address == nullptr) continue;
+        const col_id_t col_id = delta->ColumnIds()[i];
+        if (block_layout.IsVarlen(col_id)) {
+          AppendVarlen(*reinterpret_cast<const VarlenEntry *>(column_value_address));
+        } else {
+          AppendBytes(column_value_address, block_layout.AttrSize(col_id));
+        }
+      }
+      break;
+    }
+    case LogRecordType::DELETE: {
+      auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
+      AppendField(record_body->GetDatabaseOid());
+      AppendField(record_body->GetTableOid());
+      const auto tuple_slot = record_body->GetTupleSlot();
+      AppendBytes(&tuple_slot, sizeof(TupleSlot));
+      break;
+    }
+    case LogRecordType::COMMIT: {
+      auto *record_body = record.GetUnderlyingRecordBodyAs<CommitRecord>();
+      AppendField(record_body->CommitTime());
+      AppendField(record_body->OldestActiveTxn());
+      AppendField(record_body->PreviousCommit());
+      break;
+    }
+    case LogRecordType::ABORT: {
+      // AbortRecord does not hold any additional metadata
+      break;
+    }
+  }
+
+  return frame_.size() - frame_start;
+}
+
+void CompactLogEncoder::AppendVarlen(const VarlenEntry &entry) {
+  const auto *const content = entry.IsInlined() ? entry.Prefix() : entry.Content();
+  const uint32_t size = entry.Size();
+
+  // A varlen is written as a tag whose lowest bit tells a reference to an earlier value of the frame (1) apart from a
+  // value written out in full (0). The remaining bits hold the index of the earlier value or the size respectively.
+  const auto hash = common::HashUtil::HashBytes(content, size);
+  const auto it = varlen_index_.find(hash);
+  if (it != varlen_index_.end()) {
+    const auto &earlier = varlens_[it->second];
+    if (earlier.second == size && std::memcmp(frame_.data() + earlier.first, content, size) == 0) {
+      AppendField((static_cast<uint64_t>(it->second) << 1) | 1);
+      return;
+    }
+  }
+
+  AppendField(static_cast<uint64_t>(size) << 1);
+  varlen_index_[hash] = static_cast<uint32_t>(varlens_.size());
+  varlens_.emplace_back(static_cast<uint32_t>(frame_.size()), size);
+  AppendBytes(content, size);
+}
+
+}  // namespace terrier::storage
@@ -1,5 +1,7 @@
 #include "storage/write_ahead_log/log_io.h"
+#include <limits.h>
 #include <algorithm>
+#include <vector>
 namespace terrier::storage {
 void PosixIoWrappers::Close(int fd) {
   while (true) {
@@ -38,6 +40,72 @@ void PosixIoWrappers::WriteFully(int fd, const void *buf, size_t nbyte) {
   }
 }
 
+uint64_t PosixIoWrappers::WriteVectorFully(int fd, struct iovec *iov, size_t iovcnt) {
+  uint64_t total_written = 0;
+  while (iovcnt > 0) {
+    // Skip over buffers that have been fully written (or that were empty to begin with)
+    if (iov->iov_len == 0) {
+      iov++;
+      iovcnt--;
+      continue;
+    }
+    ssize_t ret = writev(fd, iov, static_cast<int>(std::min<size_t>(iovcnt, IOV_MAX)));
+    if (ret == -1) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Vectored write to log file failed with errno " + std::to_string(errno));
+    }
+    total_written += ret;
+    // Advance past everything that was written. The last buffer touched may have been written partially.
+    auto remaining = static_cast<size_t>(ret);
+    while (remaining > 0) {
+      const size_t advance = std::min(remaining, iov->iov_len);
+      iov->iov_base = reinterpret_cast<char *>(iov->iov_base) + advance;
+      iov->iov_len -= advance;
+      remaining -= advance;
+      if (iov->iov_len == 0) {
+        iov++;
+        iovcnt--;
+      }
+    }
+  }
+  return total_written;
+}
+
+void PosixIoWrappers::SyncData(int fd) {
+  while (true) {
+#if __APPLE__
+    int ret = fsync(fd);
+#else
+    int ret = fdatasync(fd);
+#endif
+    if (ret == -1) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("fsync failed with errno " + std::to_string(errno));
+    }
+    return;
+  }
+}
+
+void BufferedLogWriter::SwitchLogFile(const int fd) {
+  // dup2 atomically closes our old descriptor and makes it refer to the new file
+  while (dup2(fd, out_) == -1) {
+    if (errno == EINTR) continue;
+    throw std::runtime_error("Failed to switch log file with errno " + std::to_string(errno));
+  }
+}
+
+uint64_t BufferedLogWriter::FlushBuffers(const std::vector<BufferedLogWriter *> &writers) {
+  TERRIER_ASSERT(!writers.empty(), "Must flush at least one buffer");
+  std::vector<struct iovec> iov;
+  iov.reserve(writers.size());
+  for (auto *const writer : writers) {
+    iov.push_back({writer->buffer_, writer->buffer_size_});
+    writer->buffer_size_ = 0;
+  }
+  // All writers append to the same file, so it does not matter whose file descriptor we use
+  return PosixIoWrappers::WriteVectorFully(writers.front()->out_, iov.data(), iov.size());
+}
+
 bool BufferedLogReader::Read(void *dest, uint32_t size) {
   if (read_head_ + size <= filled_size_) {
     // bytes to read are already buffered.
@@ -1,6 +1,11 @@
 #include "storage/write_ahead_log/log_manager.h"
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
 #include "common/dedicated_thread_registry.h"
+#include "common/hash_util.h"
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 #include "storage/write_ahead_log/log_serializer_task.h"
 #include "transaction/transaction_context.h"
@@ -10,36 +15,80 @@ namespace terrier::storage {
 void LogManager::Start() {
   TERRIER_ASSERT(!run_log_manager_, "Can't call Start on already started LogManager");
   // Initialize buffers for logging
-  for (size_t i = 0; i < num_buffers_; i++) {
-    buffers_.emplace_back(BufferedLogWriter(log_file_path_.c_str()));
-  }
-  for (size_t i = 0; i < num_buffers_; i++) {
-    empty_buffer_queue_.Enqueue(&buffers_[i]);
+  for (auto &stream : streams_) {
+    for (size_t i = 0; i < num_buffers_; i++) {
+      stream->buffers_.emplace_back(BufferedLogWriter(stream->file_path_.c_str()));
+    }
+    for (size_t i = 0; i < num_buffers_; i++) {
+      stream->empty_buffer_queue_.Enqueue(&stream->buffers_[i]);
+    }
   }
 
   run_log_manager_ = true;
 
-  // Register DiskLogConsumerTask
-  disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
-      this /* requester */, persist_interval_, persist_threshold_, &buffers_, &empty_buffer_queue_,
-      &filled_buffer_queue_);
+  for (auto &stream : streams_) {
+    // Register DiskLogConsumerTask
+    stream->disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
+        this /* requester */, persist_interval_, persist_threshold_, &stream->buffers_, &stream->empty_buffer_queue_,
+        &stream->filled_buffer_queue_, common::ManagedPointer(&durable_watermark_), log_shipper_);
 
-  // Register LogSerializerTask
-  log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
-      this /* requester */, serialization_interval_, buffer_pool_, &empty_buffer_queue_, &filled_buffer_queue_,
-      &disk_log_writer_task_->disk_log_writer_thread_cv_);
+    // Register LogSerializerTask
+    stream->log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
+        this /* requester */, serialization_interval_, buffer_pool_, &stream->empty_buffer_queue_,
+        &stream->filled_buffer_queue_, &stream->disk_log_writer_task_->disk_log_writer_thread_cv_, compress_logs_);
+  }
 }
 
 void LogManager::ForceFlush() {
-  // Force the serializer task to serialize buffers
-  log_serializer_task_->Process();
-  // Signal the disk log consumer task thread to persist the buffers to disk
-  std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
-  disk_log_writer_task_->do_persist_ = true;
-  disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
-
-  // Wait for the disk log consumer task thread to persist the logs
-  disk_log_writer_task_->persist_cv_.wait(lock, [&] { return !disk_log_writer_task_->do_persist_; });
+  // Force the serializer tasks to serialize buffers
+  for (auto &stream : streams_) stream->log_serializer_task_->Process();
+
+  // Signal all the disk log consumer task threads to persist the buffers to disk, so the streams persist in parallel
+  for (auto &stream : streams_) {
+    auto *const writer = stream->disk_log_writer_task_.Get();
+    std::unique_lock<std::mutex> lock(writer->persist_lock_);
+    writer->do_persist_ = true;
+    writer->disk_log_writer_thread_cv_.notify_one();
+  }
+
+  // Wait for the disk log consumer task threads to persist the logs
+  for (auto &stream : streams_) {
+    auto *const writer = stream->disk_log_writer_task_.Get();
+    std::unique_lock<std::mutex> lock(writer->persist_lock_);
+    writer->persist_cv_.wait(lock, [&] { return !writer->do_persist_; });
+  }
+}
+
+void LogManager::RotateLogFile(const std::string &archive_path) {
+  TERRIER_ASSERT(run_log_manager_, "Can't call RotateLogFile on an un-started LogManager");
+  std::vector<int> new_log_files;
+  for (uint32_t i = 0; i < streams_.size(); i++) {
+    // Renaming the log file does not affect open file descriptors, so the writers keep appending to the moved file
+    // until the disk log consumer task switches them over
+    const auto &file_path = streams_[i]->file_path_;
+    if (std::rename(file_path.c_str(), LogStreamFilePath(archive_path, i).c_str()) != 0) {
+      throw std::runtime_error("Failed to move log file with errno " + std::to_string(errno));
+    }
+    new_log_files.push_back(
+        PosixIoWrappers::Open(file_path.c_str(), O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR));
+  }
+
+  // Hand the new log files to the disk log consumer tasks and wait for them to persist the old files and switch over
+  for (uint32_t i = 0; i < streams_.size(); i++) {
+    auto *const writer = streams_[i]->disk_log_writer_task_.Get();
+    std::unique_lock<std::mutex> lock(writer->persist_lock_);
+    writer->new_log_file_fd_ = new_log_files[i];
+    writer->do_persist_ = true;
+    writer->disk_log_writer_thread_cv_.notify_one();
+    writer->persist_cv_.wait(lock, [&] { return !writer->do_persist_; });
+  }
+
+  // Every writer holds its own duplicate of the descriptor now
+  for (const int new_log_file : new_log_files) PosixIoWrappers::Close(new_log_file);
+
+  // Commits from here on only reach the new log files. Unlinking them from the commits before lets recovery replay the
+  // new log files without the moved ones; the moved ones are covered by a checkpoint.
+  durable_watermark_.StartNewChain();
 }
 
 void LogManager::PersistAndStop() {
@@ -49,27 +98,44 @@ void LogManager::PersistAndStop() {
   // Signal all tasks to stop. The shutdown of the tasks will trigger any remaining logs to be serialized, writen to the
   // log file, and persisted. The order in which we shut down the tasks is important, we must first serialize, then
   // shutdown the disk consumer task (reverse order of Start())
-  auto result UNUSED_ATTRIBUTE =
-      thread_registry_->StopTask(this, log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  TERRIER_ASSERT(result, "LogSerializerTask should have been stopped");
+  for (auto &stream : streams_) {
+    auto result UNUSED_ATTRIBUTE = thread_registry_->StopTask(
+        this, stream->log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    TERRIER_ASSERT(result, "LogSerializerTask should have been stopped");
 
-  result = thread_registry_->StopTask(this, disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  TERRIER_ASSERT(result, "DiskLogConsumerTask should have been stopped");
-  TERRIER_ASSERT(filled_buffer_queue_.Empty(), "disk log consumer task should have processed all filled buffers\n");
+    result = thread_registry_->StopTask(
+        this, stream->disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    TERRIER_ASSERT(result, "DiskLogConsumerTask should have been stopped");
+    TERRIER_ASSERT(stream->filled_buffer_queue_.Empty(),
+                   "disk log consumer task should have processed all filled buffers\n");
 
-  // Close the buffers corresponding to the log file
-  for (auto buf : buffers_) {
-    buf.Close();
+    // Close the buffers corresponding to the log file
+    for (auto buf : stream->buffers_) {
+      buf.Close();
+    }
+    // Clear buffer queues
+    stream->empty_buffer_queue_.Clear();
+    stream->filled_buffer_queue_.Clear();
+    stream->buffers_.clear();
   }
-  // Clear buffer queues
-  empty_buffer_queue_.Clear();
-  filled_buffer_queue_.Clear();
-  buffers_.clear();
 }
 
 void LogManager::AddBufferToFlushQueue(RecordBufferSegment *const buffer_segment) {
   TERRIER_ASSERT(run_log_manager_, "Must call Start on log manager before handing it buffers");
-  log_serializer_task_->AddBufferToFlushQueue(buffer_segment);
+  LogStream *stream = streams_[0].get();
+  if (streams_.size() > 1) {
+    // A segment only holds records of one transaction. Picking the stream by the transaction's start timestamp keeps
+    // all of its records in one stream, in the order they were handed over. Start and commit timestamps are drawn from
+    // the same counter, so start timestamps follow the workload's pattern; scrambling them first spreads transactions
+    // over the streams evenly whatever that pattern is.
+    IterableBufferSegment<LogRecord> records(buffer_segment);
+    const auto first_record = records.begin();
+    if (first_record != records.end()) {
+      const auto hash = common::HashUtil::ScrambleHash(first_record->TxnBegin().UnderlyingValue());
+      stream = streams_[hash % streams_.size()].get();
+    }
+  }
+  stream->log_serializer_task_->AddBufferToFlushQueue(buffer_segment);
 }
 
 }  // namespace terrier::storage
@@ -102,18 +102,22 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::Process() {
         num_bytes += std::get<0>(num_bytes_records_and_txns);
         num_records += std::get<1>(num_bytes_records_and_txns);
         num_txns += std::get<2>(num_bytes_records_and_txns);
+        if (compress_logs_ && encoder_.FrameSize() >= COMPRESSED_FRAME_SIZE) WriteFrame();
       }
 
       buffers_processed = true;
     }
 
+    // Write out the last frame, so its commits can be persisted along with the last buffer
+    if (compress_logs_) WriteFrame();
+
     // Mark the last buffer that was written to as full
     if (buffers_processed) HandFilledBufferToWriter();
 
     // Mark the last buffer that was written to as full
     if (filled_buffer_ != nullptr) HandFilledBufferToWriter();
 
-    // Bulk remove all the transactions we serialized. This prevents having to take the TimestampManager's latch once
+    // Bulk remove all the transactions we serialized. This prevents having to take the TimestampManager's latches once
     // for each timestamp we remove.
     for (const auto &txns : serialized_txns_) {
       txns.first->RemoveTransactions(txns.second);
@@ -161,8 +165,10 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
         // If a transaction is read-only, then the only record it generates is its commit record. This commit record is
         // necessary for the transaction's callback function to be invoked, but there is no need to serialize it, as
         // it corresponds to a transaction with nothing to redo.
-        if (!commit_record->IsReadOnly()) num_bytes += SerializeRecord(record);
-        commits_in_buffer_.emplace_back(commit_record->CommitCallback(), commit_record->CommitCallbackArg());
+        if (!commit_record->IsReadOnly()) num_bytes += WriteRecord(record);
+        (compress_logs_ ? commits_in_frame_ : commits_in_buffer_)
+            .push_back({commit_record->CommitCallback(), commit_record->CommitCallbackArg(),
+                        commit_record->CommitTime()});
         // Once serialization is done, we notify the txn manager to let GC know this txn is ready to clean up
         serialized_txns_[commit_record->TimestampManager()].push_back(record.TxnBegin());
         num_txns++;
@@ -171,7 +177,7 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
 
       case (LogRecordType::ABORT): {
         // If an abort record shows up at all, the transaction cannot be read-only
-        num_bytes += SerializeRecord(record);
+        num_bytes += WriteRecord(record);
         auto *abord_record = record.GetUnderlyingRecordBodyAs<AbortRecord>();
         serialized_txns_[abord_record->TimestampManager()].push_back(record.TxnBegin());
         num_txns++;
@@ -180,7 +186,7 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
 
       default:
         // Any record that is not a commit record is always serialized.`
-        num_bytes += SerializeRecord(record);
+        num_bytes += WriteRecord(record);
     }
     num_records++;
   }
@@ -188,7 +194,8 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
   return {num_bytes, num_records, num_txns};
 }
 
-uint64_t LogSerializerTask::SerializeRecord(const terrier::storage::LogRecord &record) {
+template <class Sink>
+uint64_t LogSerializerTask::SerializeRecord(const terrier::storage::LogRecord &record, Sink *const sink) {
   uint64_t num_bytes = 0;
   // First, serialize out fields common across all LogRecordType's.
 
@@ -197,23 +204,23 @@ uint64_t LogSerializerTask::SerializeRecord(const terrier::storage::LogRecord &r
   // manager generates in this function. In particular, the later value is very likely to be strictly smaller when the
   // LogRecordType is REDO. On recovery, the goal is to turn the serialized format back into an in-memory log record of
   // this size.
-  num_bytes += WriteValue(record.Size());
+  num_bytes += SerializeValue(sink, record.Size());
 
-  num_bytes += WriteValue(record.RecordType());
-  num_bytes += WriteValue(record.TxnBegin());
+  num_bytes += SerializeValue(sink, record.RecordType());
+  num_bytes += SerializeValue(sink, record.TxnBegin());
 
   switch (record.RecordType()) {
     case LogRecordType::REDO: {
       auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
-      num_bytes += WriteValue(record_body->GetDatabaseOid());
-      num_bytes += WriteValue(record_body->GetTableOid());
-      num_bytes += WriteValue(record_body->GetTupleSlot());
+      num_bytes += SerializeValue(sink, record_body->GetDatabaseOid());
+      num_bytes += SerializeValue(sink, record_body->GetTableOid());
+      num_bytes += SerializeValue(sink, record_body->GetTupleSlot());
 
       auto *delta = record_body->Delta();
       // Write out which column ids this redo record is concerned with. On recovery, we can construct the appropriate
       // ProjectedRowInitializer from these ids and their corresponding block layout.
-      num_bytes += WriteValue(delta->NumColumns());
-      num_bytes += WriteValue(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
+      num_bytes += SerializeValue(sink, delta->NumColumns());
+      num_bytes += sink->WriteValue(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
 
       // Write out the attr sizes boundaries, this way we can deserialize the records without the need of the block
       // layout
@@ -221,10 +228,10 @@ uint64_t LogSerializerTask::SerializeRecord(const terrier::storage::LogRecord &r
       uint16_t boundaries[NUM_ATTR_BOUNDARIES];
       memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
       StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
-      WriteValue(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+      sink->WriteValue(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
 
       // Write out the null bitmap.
-      num_bytes += WriteValue(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
+      num_bytes += sink->WriteValue(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
 
       // Write out attribute values
       for (uint16_t i = 0; i < delta->NumColumns(); i++) {
@@ -241,34 +248,35 @@ uint64_t LogSerializerTask::SerializeRecord(const terrier::storage::LogRecord &r
           // Inline column value is a pointer to a VarlenEntry, so reinterpret as such.
           const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
           // Serialize out length of the varlen entry.
-          num_bytes += WriteValue(varlen_entry->Size());
+          num_bytes += SerializeValue(sink, varlen_entry->Size());
           if (varlen_entry->IsInlined()) {
             // Serialize out the prefix of the varlen entry.
-            num_bytes += WriteValue(varlen_entry->Prefix(), varlen_entry->Size());
+            num_bytes += sink->WriteValue(varlen_entry->Prefix(), varlen_entry->Size());
           } else {
             // Serialize out the content field of the varlen entry.
-            num_bytes += WriteValue(varlen_entry->Content(), varlen_entry->Size());
+            num_bytes += sink->WriteValue(varlen_entry->Content(), varlen_entry->Size());
           }
         } else {
           // Inline column value is the actual data we want to serialize out.
           // Note that by writing out AttrSize(col_id) bytes instead of just the difference between successive offsets
           // of the delta record, we avoid serializing out any potential padding.
-          num_bytes += WriteValue(column_value_address, block_layout.AttrSize(col_id));
+          num_bytes += sink->WriteValue(column_value_address, block_layout.AttrSize(col_id));
         }
       }
       break;
     }
     case LogRecordType::DELETE: {
       auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
-      num_bytes += WriteValue(record_body->GetDatabaseOid());
-      num_bytes += WriteValue(record_body->GetTableOid());
-      num_bytes += WriteValue(record_body->GetTupleSlot());
+      num_bytes += SerializeValue(sink, record_body->GetDatabaseOid());
+      num_bytes += SerializeValue(sink, record_body->GetTableOid());
+      num_bytes += SerializeValue(sink, record_body->GetTupleSlot());
       break;
     }
     case LogRecordType::COMMIT: {
       auto *record_body = record.GetUnderlyingRecordBodyAs<CommitRecord>();
-      num_bytes += WriteValue(record_body->CommitTime());
-      num_bytes += WriteValue(record_body->OldestActiveTxn());
+      num_bytes += SerializeValue(sink, record_body->CommitTime());
+      num_bytes += SerializeValue(sink, record_body->OldestActiveTxn());
+      num_bytes += SerializeValue(sink, record_body->PreviousCommit());
       break;
     }
     case LogRecordType::ABORT: {
@@ -280,6 +288,16 @@ uint64_t LogSerializerTask::SerializeRecord(const terrier::storage::LogRecord &r
   return num_bytes;
 }
 
+uint64_t LogSerializerTask::WriteRecord(const LogRecord &record) {
+  return compress_logs_ ? encoder_.Encode(record) : SerializeRecord(record, this);
+}
+
+void LogSerializerTask::WriteFrame() {
+  encoder_.WriteFrame(this);
+  commits_in_buffer_.insert(commits_in_buffer_.end(), commits_in_frame_.begin(), commits_in_frame_.end());
+  commits_in_frame_.clear();
+}
+
 uint32_t LogSerializerTask::WriteValue(const void *val, const uint32_t size) {
   // Serialize the value and copy it to the buffer
   BufferedLogWriter *out = GetCurrentWriteBuffer();
@@ -298,4 +316,8 @@ uint32_t LogSerializerTask::WriteValue(const void *val, const uint32_t size) {
   return size;
 }
 
+// Checkpoints are written out directly through a BufferedLogWriter
+template uint64_t LogSerializerTask::SerializeRecord<BufferedLogWriter>(const LogRecord &record,
+                                                                        BufferedLogWriter *sink);
+
 }  // namespace terrier::storage
@@ -0,0 +1,191 @@
+#include "storage/write_ahead_log/log_shipper.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "loggers/storage_logger.h"
+#include "network/itp/itp_packet_writer.h"
+
+namespace terrier::storage {
+
+LogShipper::LogShipper(const std::string &replica_host, const uint16_t replica_port,
+                       const std::chrono::milliseconds send_timeout, const std::chrono::milliseconds retry_interval,
+                       const uint64_t max_backlog)
+    : send_timeout_(send_timeout), retry_interval_(retry_interval), max_backlog_(max_backlog) {
+  std::memset(&replica_addr_, 0, sizeof(replica_addr_));
+  replica_addr_.sin_family = AF_INET;
+  replica_addr_.sin_port = htons(replica_port);
+  if (inet_pton(AF_INET, replica_host.c_str(), &replica_addr_.sin_addr) != 1) {
+    throw std::runtime_error("Invalid replica address " + replica_host);
+  }
+  connect_thread_ = std::thread([this] { ConnectLoop(); });
+}
+
+LogShipper::~LogShipper() {
+  StopReplication();
+  // Replication may have stopped before the replica's connection was taken over
+  const int socket_fd = connected_fd_.exchange(-1);
+  if (socket_fd >= 0) close(socket_fd);
+}
+
+void LogShipper::ShipLogs(const byte *const data, const uint64_t size) {
+  if (io_ == nullptr && !stopped_) AdoptConnection();
+  if (stopped_) return;
+  if (io_ == nullptr) {
+    HoldBack(data, size);
+    return;
+  }
+  Send(data, size);
+}
+
+void LogShipper::StopReplication() {
+  StopConnecting();
+  if (stopped_) return;
+  if (io_ == nullptr) {
+    // The replica may have come up since the last attempt to connect to it
+    if (connected_fd_ < 0) connected_fd_ = Connect();
+    AdoptConnection();
+    if (stopped_) return;
+    if (io_ == nullptr) {
+      STORAGE_LOG_ERROR("Replica never connected, {} bytes of log were not shipped to it", backlog_.size());
+      backlog_.clear();
+      stopped_ = true;
+      return;
+    }
+  }
+  network::ITPPacketWriter writer(io_->GetWriteQueue());
+  writer.StopReplicationCommand();
+  Flush();
+  if (io_ != nullptr) {
+    io_->Close();
+    io_ = nullptr;
+  }
+  stopped_ = true;
+}
+
+void LogShipper::ConnectLoop() {
+  std::unique_lock<std::mutex> lock(connect_latch_);
+  while (run_connect_) {
+    lock.unlock();
+    const int socket_fd = Connect();
+    lock.lock();
+    if (socket_fd >= 0) {
+      connected_fd_ = socket_fd;
+      connected_ = true;
+      STORAGE_LOG_INFO("Connected to replica, log shipping started");
+      return;
+    }
+    connect_cv_.wait_for(lock, retry_interval_, [this] { return !run_connect_; });
+  }
+}
+
+int LogShipper::Connect() const {
+  const int socket_fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (socket_fd < 0) {
+    STORAGE_LOG_WARN("Failed to open socket to replica with errno {}", errno);
+    return -1;
+  }
+  // Connect without blocking, so that an unreachable replica does not hold up StopConnecting for the TCP timeout
+  fcntl(socket_fd, F_SETFL, fcntl(socket_fd, F_GETFL) | O_NONBLOCK);
+  int error = 0;
+  if (connect(socket_fd, reinterpret_cast<const sockaddr *>(&replica_addr_), sizeof(replica_addr_)) < 0) {
+    error = errno;
+    if (error == EINPROGRESS) {
+      struct pollfd poll_fd {
+        socket_fd, POLLOUT, 0
+      };
+      error = ETIMEDOUT;
+      if (poll(&poll_fd, 1, static_cast<int>(retry_interval_.count())) == 1) {
+        socklen_t error_size = sizeof(error);
+        getsockopt(socket_fd, SOL_SOCKET, SO_ERROR, &error, &error_size);
+      }
+    }
+  }
+  if (error != 0) {
+    STORAGE_LOG_DEBUG("Failed to connect to replica with errno {}", error);
+    close(socket_fd);
+    return -1;
+  }
+  return socket_fd;
+}
+
+void LogShipper::StopConnecting() {
+  {
+    std::unique_lock<std::mutex> lock(connect_latch_);
+    run_connect_ = false;
+  }
+  connect_cv_.notify_all();
+  if (connect_thread_.joinable()) connect_thread_.join();
+}
+
+void LogShipper::AdoptConnection() {
+  const int socket_fd = connected_fd_.exchange(-1);
+  if (socket_fd < 0) return;
+  io_ = std::make_unique<network::NetworkIoWrapper>(socket_fd);
+  // The held back logs come before any logs shipped from here on
+  Send(backlog_.data(), backlog_.size());
+  backlog_.clear();
+  backlog_.shrink_to_fit();
+}
+
+void LogShipper::HoldBack(const byte *const data, const uint64_t size) {
+  if (backlog_.size() + size > max_backlog_) {
+    STORAGE_LOG_ERROR("Replica did not connect before {} bytes of log were held back for it, log shipping stopped",
+                      max_backlog_);
+    StopConnecting();
+    backlog_.clear();
+    backlog_.shrink_to_fit();
+    stopped_ = true;
+    return;
+  }
+  backlog_.insert(backlog_.end(), data, data + size);
+}
+
+void LogShipper::Send(const byte *const data, const uint64_t size) {
+  for (uint64_t offset = 0; offset < size && io_ != nullptr; offset += MAX_COMMAND_SIZE) {
+    const uint64_t command_size = std::min(size - offset, MAX_COMMAND_SIZE);
+    network::ITPPacketWriter writer(io_->GetWriteQueue());
+    writer.WriteReplicationCommand(next_message_id_++, data + offset, command_size);
+    Flush();
+  }
+}
+
+void LogShipper::Flush() {
+  try {
+    auto result = io_->FlushAllWrites();
+    while (result == network::Transition::NEED_WRITE) {
+      // The socket buffer is full. Wait for the replica to read some of it before trying again.
+      struct pollfd poll_fd {
+        io_->GetSocketFd(), POLLOUT, 0
+      };
+      const int ready = poll(&poll_fd, 1, static_cast<int>(send_timeout_.count()));
+      if (ready == 0) {
+        // A replica that reads nothing for this long is as good as gone, and would hold up the log consumer
+        STORAGE_LOG_ERROR("Replica stopped reading the log, log shipping stopped");
+        io_->Close();
+        io_ = nullptr;
+        stopped_ = true;
+        return;
+      }
+      if (ready < 0 && errno != EINTR) break;
+      result = io_->FlushAllWrites();
+    }
+    if (result == network::Transition::PROCEED) return;
+  } catch (NetworkProcessException &e) {
+    // Fall through, the connection is unusable
+  }
+  STORAGE_LOG_ERROR("Lost the connection to the replica, log shipping stopped");
+  io_->Close();
+  io_ = nullptr;
+  stopped_ = true;
+}
+
+}  // namespace terrier::storage
@@ -41,6 +41,7 @@
 #include "traffic_cop/traffic_cop_defs.h"
 #include "traffic_cop/traffic_cop_util.h"
 #include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
 
 namespace terrier::trafficcop {
 
@@ -66,13 +67,19 @@ void TrafficCop::EndTransaction(const common::ManagedPointer<network::Connection
   if (query_type == network::QueryType::QUERY_COMMIT) {
     TERRIER_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
                    "Invalid ConnectionContext state, not in a transaction that can be committed.");
-    // Set up a blocking callback. Will be invoked when we can tell the client that commit is complete.
-    std::promise<bool> promise;
-    auto future = promise.get_future();
-    TERRIER_ASSERT(future.valid(), "future must be valid for synchronization to work.");
-    txn_manager_->Commit(txn.Get(), CommitCallback, &promise);
-    future.wait();
-    TERRIER_ASSERT(future.get(), "Got past the wait() without the value being set to true. That's weird.");
+    if (!connection_ctx->SynchronousCommit()) {
+      // Acknowledge the commit as soon as it is visible. The log manager persists it within its persist interval, and
+      // until then a crash can lose it.
+      txn_manager_->Commit(txn.Get(), transaction::TransactionUtil::EmptyCallback, nullptr);
+    } else {
+      // Set up a blocking callback. Will be invoked when we can tell the client that commit is complete.
+      std::promise<bool> promise;
+      auto future = promise.get_future();
+      TERRIER_ASSERT(future.valid(), "future must be valid for synchronization to work.");
+      txn_manager_->Commit(txn.Get(), CommitCallback, &promise);
+      future.wait();
+      TERRIER_ASSERT(future.get(), "Got past the wait() without the value being set to true. That's weird.");
+    }
   } else {
     TERRIER_ASSERT(connection_ctx->TransactionState() != network::NetworkTransactionStateType::IDLE,
                    "Invalid ConnectionContext state, not in a transaction that can be aborted.");
@@ -87,6 +94,11 @@ void TrafficCop::HandBufferToReplication(std::unique_ptr<network::ReadBuffer> bu
   replication_log_provider_->HandBufferToReplication(std::move(buffer));
 }
 
+void TrafficCop::StopReplication() {
+  TERRIER_ASSERT(replication_log_provider_ != DISABLED, "Should not be stopping replication without a log provider");
+  replication_log_provider_->EndReplication();
+}
+
 void TrafficCop::ExecuteTransactionStatement(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
                                              const common::ManagedPointer<network::PostgresPacketWriter> out,
                                              const bool explicit_txn_block,
@@ -155,7 +167,13 @@ TrafficCopResult TrafficCop::ExecuteSetStatement(common::ManagedPointer<network:
   const auto &set_stmt = statement->RootStatement().CastManagedPointerTo<parser::VariableSetStatement>();
 
   try {
-    if (set_stmt->IsSetDefault()) {
+    if (set_stmt->GetParameterName() == SYNCHRONOUS_COMMIT_PARAMETER) {
+      // Only changes this connection. The setting holds the default of new connections.
+      connection_ctx->SetSynchronousCommit(
+          set_stmt->IsSetDefault() ? SynchronousCommit()
+                                   : settings_manager_->ParseBoolParameter(set_stmt->GetParameterName(),
+                                                                           set_stmt->GetValues()));
+    } else if (set_stmt->IsSetDefault()) {
       // TODO(WAN): Annoyingly, a copy is done for default_val because of differences in const qualifiers.
       parser::ConstantValueExpression default_val = settings_manager_->GetDefault(set_stmt->GetParameterName());
       auto default_val_ptr = common::ManagedPointer(&default_val).CastManagedPointerTo<parser::AbstractExpression>();
@@ -303,6 +321,13 @@ TrafficCopResult TrafficCop::BindQuery(
   TERRIER_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
                  "Not in a valid txn. This should have been caught before calling this function.");
 
+  if (IsReplica() && statement->GetQueryType() != network::QueryType::QUERY_SELECT) {
+    // A replica only changes by replaying the log of its primary
+    return {ResultType::ERROR,
+            common::ErrorData(common::ErrorSeverity::ERROR, "cannot execute a write on a read-only replica",
+                              common::ErrorCode::ERRCODE_READ_ONLY_SQL_TRANSACTION)};
+  }
+
   try {
     if (statement->PhysicalPlan() == nullptr || !UseQueryCache()) {
       // it's not cached, bind it
@@ -435,6 +460,13 @@ std::pair<catalog::db_oid_t, catalog::namespace_oid_t> TrafficCop::CreateTempNam
     return {catalog::INVALID_DATABASE_OID, catalog::INVALID_NAMESPACE_OID};
   }
 
+  if (IsReplica()) {
+    // The namespace would take an oid from the replica's catalog that the primary hands out as well, so that replaying
+    // the primary's log would run into it
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return {db_oid, catalog::INVALID_NAMESPACE_OID};
+  }
+
   const auto ns_oid =
       catalog_->GetAccessor(common::ManagedPointer(txn), db_oid, DISABLED)
           ->CreateNamespace(std::string(TEMP_NAMESPACE_PREFIX) + std::to_string(connection_id.UnderlyingValue()));
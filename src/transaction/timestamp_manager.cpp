@@ -5,9 +5,12 @@
 namespace terrier::transaction {
 
 timestamp_t TimestampManager::OldestTransactionStartTime() {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
-  timestamp_t result = (oldest_txn != curr_running_txns_.end()) ? *oldest_txn : time_.load();
+  // Read the clock before visiting the shards. Any txn we do not find began after this point (see BeginTransaction).
+  timestamp_t result = time_.load();
+  for (auto &shard : running_txns_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (!shard.txns_.empty()) result = std::min(result, *shard.txns_.cbegin());
+  }
   cached_oldest_txn_start_time_.store(result);  // Cache the timestamp
   return result;
 }
@@ -15,17 +18,29 @@ timestamp_t TimestampManager::OldestTransactionStartTime() {
 timestamp_t TimestampManager::CachedOldestTransactionStartTime() { return cached_oldest_txn_start_time_.load(); }
 
 void TimestampManager::RemoveTransaction(timestamp_t timestamp) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-  TERRIER_ASSERT(ret == 1, "erased timestamp did not exist");
+  // Txns usually finish on the thread that began them, so we start looking in that thread's shard
+  const uint32_t first_shard = ThreadShard();
+  for (uint32_t i = 0; i < NUM_RUNNING_TXN_SHARDS; i++) {
+    auto &shard = running_txns_[(first_shard + i) % NUM_RUNNING_TXN_SHARDS];
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (shard.txns_.erase(timestamp) == 1) return;
+  }
+  TERRIER_ASSERT(false, "erased timestamp did not exist");
 }
 
 void TimestampManager::RemoveTransactions(const std::vector<terrier::transaction::timestamp_t> &timestamps) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  for (const auto &timestamp : timestamps) {
-    const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-    TERRIER_ASSERT(ret == 1, "erased timestamp did not exist");
+  // We do not know which shards the txns began in, so we look for all of them in every shard until we found them all
+  size_t num_removed = 0;
+  for (auto &shard : running_txns_) {
+    if (num_removed == timestamps.size()) break;
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (shard.txns_.empty()) continue;
+    const timestamp_t oldest = *shard.txns_.cbegin(), newest = *shard.txns_.crbegin();
+    for (const auto &timestamp : timestamps) {
+      if (timestamp >= oldest && timestamp <= newest) num_removed += shard.txns_.erase(timestamp);
+    }
   }
+  TERRIER_ASSERT(num_removed == timestamps.size(), "erased timestamp did not exist");
 }
 
 }  // namespace terrier::transaction
@@ -6,6 +6,8 @@
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
+#include "storage/varlen_arena.h"
+#include "storage/write_ahead_log/log_manager.h"
 
 namespace terrier::transaction {
 TransactionContext *TransactionManager::BeginTransaction() {
@@ -19,7 +21,8 @@ TransactionContext *TransactionManager::BeginTransaction() {
   // start the operating unit resource tracker
   if (txn_metrics_enabled) common::thread_context.resource_tracker_.Start();
   start_time = timestamp_manager_->BeginTransaction();
-  result = new TransactionContext(start_time, start_time + INT64_MIN, buffer_pool_, log_manager_);
+  result = new TransactionContext(start_time, start_time + INT64_MIN, buffer_pool_, log_manager_,
+                                  timestamp_manager_->CachedOldestTransactionStartTime());
   // Ensure we do not return from this function if there are ongoing write commits
   txn_gate_.Traverse();
 
@@ -34,7 +37,7 @@ TransactionContext *TransactionManager::BeginTransaction() {
 
 void TransactionManager::LogCommit(TransactionContext *const txn, const timestamp_t commit_time,
                                    const callback_fn commit_callback, void *const commit_callback_arg,
-                                   const timestamp_t oldest_active_txn) {
+                                   const timestamp_t oldest_active_txn, const timestamp_t previous_commit) {
   if (log_manager_ != DISABLED) {
     // At this point the commit has already happened for the rest of the system.
     // Here we will manually add a commit record and flush the buffer to ensure the logger
@@ -42,7 +45,7 @@ void TransactionManager::LogCommit(TransactionContext *const txn, const timestam
     byte *const commit_record = txn->redo_buffer_.NewEntry(storage::CommitRecord::Size());
     storage::CommitRecord::Initialize(commit_record, txn->StartTime(), commit_time, commit_callback,
                                       commit_callback_arg, oldest_active_txn, txn->IsReadOnly(), txn,
-                                      timestamp_manager_.Get());
+                                      timestamp_manager_.Get(), previous_commit);
   } else {
     // Otherwise, logging is disabled. We should pretend to have serialized and flushed the record so the rest of the
     // system proceeds correctly
@@ -52,7 +55,8 @@ void TransactionManager::LogCommit(TransactionContext *const txn, const timestam
   txn->redo_buffer_.Finalize(true);
 }
 
-timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext *const txn) {
+timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext *const txn,
+                                                              timestamp_t *const previous_commit) {
   // WARNING: This operation has to happen appear atomic to new transactions:
   // transaction 1        transaction 2
   //   begin
@@ -68,7 +72,11 @@ timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext
   //  the correct version the second time, violating snapshot isolation.
   //  Make sure you solve this problem before you remove this gate for whatever reason.
   common::Gate::ScopedLock gate(&txn_gate_);
-  const timestamp_t commit_time = timestamp_manager_->CheckOutTimestamp();
+  // With logging, the commit timestamp is checked out through the log manager, which holds back the commit callbacks of
+  // later transactions until this transaction's commit record is persisted
+  const timestamp_t commit_time = log_manager_ != DISABLED
+                                      ? log_manager_->CheckOutCommitTimestamp(timestamp_manager_.Get(), previous_commit)
+                                      : timestamp_manager_->CheckOutTimestamp();
 
   // flip all timestamps to be committed
   for (auto &it : txn->undo_buffer_) it.Timestamp().store(commit_time);
@@ -88,7 +96,9 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
   TERRIER_ASSERT(!txn->must_abort_,
                  "This txn was marked that it must abort. Set a breakpoint at TransactionContext::MustAbort() to see a "
                  "stack trace for when this flag is getting tripped.");
-  result = txn->IsReadOnly() ? timestamp_manager_->CheckOutTimestamp() : UpdatingCommitCriticalSection(txn);
+  timestamp_t previous_commit = INVALID_TXN_TIMESTAMP;
+  result = txn->IsReadOnly() ? timestamp_manager_->CheckOutTimestamp()
+                             : UpdatingCommitCriticalSection(txn, &previous_commit);
 
   txn->finish_time_.store(result);
 
@@ -107,11 +117,11 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
     // added.
     oldest_active_txn = timestamp_manager_->CachedOldestTransactionStartTime();
   }
-  LogCommit(txn, result, callback, callback_arg, oldest_active_txn);
+  LogCommit(txn, result, callback, callback_arg, oldest_active_txn, previous_commit);
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -188,7 +198,7 @@ timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
-    common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+    common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
     // It is not necessary to have to GC process read-only transactions, but it's probably faster to call free off
     // the critical path there anyway
     // Also note here that GC will figure out what varlen entries to GC, as opposed to in the abort case.
@@ -224,16 +234,14 @@ void TransactionManager::GCLastUpdateOnAbort(TransactionContext *const txn) {
     storage::col_id_t col_id = redo->Delta()->ColumnIds()[i];
     if (layout.IsVarlen(col_id)) {
       auto *varlen = reinterpret_cast<storage::VarlenEntry *>(redo->Delta()->AccessWithNullCheck(i));
-      if (varlen != nullptr) {
-        TERRIER_ASSERT(varlen->NeedReclaim() || varlen->IsInlined(), "Fresh updates cannot be compacted or compressed");
-        if (varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
-      }
+      // Values the redo does not own still belong to whoever staged the update
+      if (varlen != nullptr && varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
     }
   }
 }
 
 TransactionQueue TransactionManager::CompletedTransactionsForGC() {
-  common::SpinLatch::ScopedSpinLatch guard(&timestamp_manager_->curr_running_txns_latch_);
+  common::SpinLatch::ScopedSpinLatch guard(&completed_txns_latch_);
   return std::move(completed_txns_);
 }
 
@@ -285,7 +293,11 @@ void TransactionManager::DeallocateColumnUpdateIfVarlen(TransactionContext *txn,
   if (layout.IsVarlen(col_id)) {
     auto *varlen = reinterpret_cast<storage::VarlenEntry *>(accessor.AccessWithNullCheck(undo->Slot(), col_id));
     if (varlen != nullptr) {
-      TERRIER_ASSERT(varlen->NeedReclaim() || varlen->IsInlined(), "Fresh updates cannot be compacted or compressed");
+      // Values in the varlen arena of the block are freed along with the arena
+      UNUSED_ATTRIBUTE storage::VarlenArena *const arena = undo->Slot().GetBlock()->varlen_arena_.load();
+      TERRIER_ASSERT(varlen->NeedReclaim() || varlen->IsInlined() ||
+                         (arena != nullptr && arena->Contains(varlen->Content())),
+                     "Fresh updates cannot be compacted or compressed");
       if (varlen->NeedReclaim()) txn->loose_ptrs_.push_back(varlen->Content());
     }
   }
@@ -0,0 +1,127 @@
+#include "common/sharded_object_pool.h"
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/random_test_util.h"
+
+namespace terrier {
+
+// Objects released on a thread are reused by that thread first
+// NOLINTNEXTLINE
+TEST(ShardedObjectPoolTests, SimpleReuseTest) {
+  common::ShardedObjectPool<uint32_t> tested(1, 1);
+  // clang-tidy thinks gtest-printers will DefaultPrintTo the released pointer
+  // NOLINTNEXTLINE
+  uint32_t *reused_ptr = tested.Get();
+  tested.Release(reused_ptr);
+  // NOLINTNEXTLINE
+  for (uint32_t i = 0; i < 10; i++) {
+    EXPECT_EQ(tested.Get(), reused_ptr);
+    tested.Release(reused_ptr);
+  }
+  EXPECT_EQ(tested.GetNumObjectsInUse(), 0);
+}
+
+// The reuse limit holds across full magazines handed to the depot, and lowering it frees objects
+// NOLINTNEXTLINE
+TEST(ShardedObjectPoolTests, ResetLimitTest) {
+  const uint64_t size_limit = 5 * common::ShardedObjectPool<uint32_t>::MAGAZINE_SIZE;
+  common::ShardedObjectPool<uint32_t> tested(size_limit, size_limit);
+  std::unordered_set<uint32_t *> used_ptrs;
+  for (uint32_t i = 0; i < size_limit; ++i) used_ptrs.insert(tested.Get());
+  EXPECT_EQ(tested.GetNumObjectsInUse(), size_limit);
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+  for (auto &it : used_ptrs) tested.Release(it);
+  EXPECT_EQ(tested.GetNumObjectsInUse(), 0);
+
+  // Every remaining object is a reused one, until the pool is full again
+  tested.SetReuseLimit(size_limit / 2);
+  EXPECT_FALSE(tested.SetSizeLimit(size_limit / 2 - 1));
+  EXPECT_TRUE(tested.SetSizeLimit(size_limit / 2));
+  std::vector<uint32_t *> ptrs;
+  for (uint32_t i = 0; i < size_limit / 2; ++i) {
+    ptrs.push_back(tested.Get());
+    EXPECT_FALSE(used_ptrs.find(ptrs.back()) == used_ptrs.end());
+  }
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+  for (auto &it : ptrs) tested.Release(it);
+}
+
+// Once the pool has reached its size limit, objects released on one thread are handed out on another
+// NOLINTNEXTLINE
+TEST(ShardedObjectPoolTests, CrossThreadReuseTest) {
+  const uint64_t limit = 4;
+  common::ShardedObjectPool<uint32_t> tested(limit, limit);
+  std::vector<uint32_t *> ptrs;
+  std::thread other([&] {
+    for (uint32_t i = 0; i < limit; i++) ptrs.push_back(tested.Get());
+    for (auto *ptr : ptrs) tested.Release(ptr);
+  });
+  other.join();
+
+  std::unordered_set<uint32_t *> reused;
+  for (uint32_t i = 0; i < limit; i++) reused.insert(tested.Get());
+  EXPECT_EQ(reused, std::unordered_set<uint32_t *>(ptrs.begin(), ptrs.end()));
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+  for (auto *ptr : reused) tested.Release(ptr);
+}
+
+class ShardedObjectPoolTestType {
+ public:
+  ShardedObjectPoolTestType *Use(uint32_t thread_id) {
+    user_ = thread_id;
+    return this;
+  }
+
+  ShardedObjectPoolTestType *Release(uint32_t thread_id) {
+    // Nobody used this
+    EXPECT_EQ(thread_id, user_);
+    return this;
+  }
+
+ private:
+  std::atomic<uint32_t> user_;
+};
+
+// This test generates random workload and sees if the pool gives out the same pointer to two threads at the same
+// time, and whether the limits still hold afterwards.
+// NOLINTNEXTLINE
+TEST(ShardedObjectPoolTests, ConcurrentCorrectnessTest) {
+  const uint64_t size_limit = 100;
+  const uint64_t reuse_limit = 100;
+  common::ShardedObjectPool<ShardedObjectPoolTestType> tested(size_limit, reuse_limit);
+  auto workload = [&](uint32_t tid) {
+    std::uniform_int_distribution<uint64_t> size_dist(1, reuse_limit);
+    std::default_random_engine generator;
+    std::vector<ShardedObjectPoolTestType *> ptrs;
+    auto allocate = [&] {
+      try {
+        ptrs.push_back(tested.Get()->Use(tid));
+      } catch (common::NoMoreObjectException &) {
+        // Other threads hold all objects for now, see ObjectPoolTests
+      }
+    };
+    auto free = [&] {
+      if (!ptrs.empty()) {
+        auto pos = RandomTestUtil::UniformRandomElement(&ptrs, &generator);
+        tested.Release((*pos)->Release(tid));
+        ptrs.erase(pos);
+      }
+    };
+    auto set_reuse_limit = [&] { tested.SetReuseLimit(size_dist(generator)); };
+    auto set_size_limit = [&] { tested.SetSizeLimit(size_dist(generator)); };
+
+    RandomTestUtil::InvokeWorkloadWithDistribution({free, allocate, set_reuse_limit, set_size_limit},
+                                                   {0.25, 0.25, 0.25, 0.25}, &generator, 1000);
+    for (auto *ptr : ptrs) tested.Release(ptr->Release(tid));
+  };
+  common::WorkerPool thread_pool(MultiThreadTestUtil::HardwareConcurrency(), {});
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, MultiThreadTestUtil::HardwareConcurrency(), workload, 100);
+  EXPECT_EQ(tested.GetNumObjectsInUse(), 0);
+}
+}  // namespace terrier
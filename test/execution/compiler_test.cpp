@@ -2356,6 +2356,120 @@ TEST_F(CompilerTest, SimpleIndexNestedLoopJoinTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec0, exp_vec0));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleIndexNestedLoopJoinExactTest) {
+  // SELECT t1.colA, t2.colA, t2.colB, t1.colA + t2.colB FROM test_1 AS t2 INNER JOIN test_1 AS t1 ON t1.colA=t2.colA
+  // WHERE t2.colA < 5000
+  // Exact lookups probe the index in batches of outer tuples. 5000 outer tuples fill two batches and leave a partial
+  // one, which is probed when the pipeline finishes.
+  // Get accessor
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+
+  // Make the seq scan: Here test_1 is also the outer table
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema1.GetColumn("colA").Oid();
+    auto colb_oid = table_schema1.GetColumn("colB").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("colA", col1);
+    seq_scan_out.AddOutput("colB", col2);
+    auto schema = seq_scan_out.MakeSchema();
+    // Make predicate
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(5000));
+    // Build
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid, colb_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetTableOid(table_oid1)
+                   .Build();
+  }
+  // Make index join
+  std::unique_ptr<planner::AbstractPlanNode> index_join;
+  OutputSchemaHelper index_join_out{0, &expr_maker};
+  {
+    // Retrieve index
+    auto index_oid1 = accessor->GetIndexOid(NSOid(), "index_1");
+    // t1.colA
+    auto t1_col1 = expr_maker.CVE(table_schema1.GetColumn("colA").Oid(), type::TypeId::INTEGER);
+    // t2.colA, and t2.colB
+    auto t2_col1 = seq_scan_out.GetOutput("colA");
+    auto t2_col2 = seq_scan_out.GetOutput("colB");
+    // t1.colA + t2.colB
+    auto sum = expr_maker.OpSum(t1_col1, t2_col2);
+    // Output Schema
+    index_join_out.AddOutput("t1.colA", t1_col1);
+    index_join_out.AddOutput("t2.colA", t2_col1);
+    index_join_out.AddOutput("t2.colB", t2_col2);
+    index_join_out.AddOutput("sum", sum);
+    auto schema = index_join_out.MakeSchema();
+    // Predicate
+    auto predicate = expr_maker.ComparisonEq(t1_col1, t2_col1);
+    // Build
+    planner::IndexJoinPlanNode::Builder builder;
+    index_join = builder.AddChild(std::move(seq_scan))
+                     .SetIndexOid(index_oid1)
+                     .SetTableOid(table_oid1)
+                     .AddLoIndexColumn(catalog::indexkeycol_oid_t(1), t2_col1)
+                     .AddHiIndexColumn(catalog::indexkeycol_oid_t(1), t2_col1)
+                     .SetOutputSchema(std::move(schema))
+                     .SetJoinType(planner::LogicalJoinType::INNER)
+                     .SetJoinPredicate(predicate)
+                     .SetScanType(planner::IndexScanType::Exact)
+                     .Build();
+  }
+  // Compile and Run
+  // Every outer tuple should match itself exactly once
+  // The joined cols should be equal
+  // The 4th column is the sum of the 1nd and 3rd columns
+  uint32_t num_output_rows{0};
+  uint32_t num_expected_rows{5000};
+  std::vector<bool> seen(num_expected_rows, false);
+  RowChecker row_checker = [&num_output_rows, &seen, num_expected_rows](const std::vector<sql::Val *> &vals) {
+    // Read cols
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto col2 = static_cast<sql::Integer *>(vals[1]);
+    auto col3 = static_cast<sql::Integer *>(vals[2]);
+    auto col4 = static_cast<sql::Integer *>(vals[3]);
+    ASSERT_FALSE(col1->is_null_ || col2->is_null_);
+    // Check join cols
+    ASSERT_EQ(col1->val_, col2->val_);
+    // Check that col4 = col1 + col3
+    ASSERT_EQ(col4->val_, col1->val_ + col3->val_);
+    // Check that every outer tuple is joined once
+    ASSERT_LT(col2->val_, static_cast<int64_t>(num_expected_rows));
+    ASSERT_FALSE(seen[col2->val_]);
+    seen[col2->val_] = true;
+    // Check the number of output row
+    num_output_rows++;
+    ASSERT_LE(num_output_rows, num_expected_rows);
+  };
+  CorrectnessFn correctness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+  GenericChecker checker(row_checker, correctness_fn);
+
+  // Make Exec Ctx
+  OutputStore store{&checker, index_join->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(index_join->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), index_join->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = execution::compiler::CompilationContext::Compile(*index_join, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleIndexNestedLoopJoinMultiColumnTest) {
   // SELECT t1.col1, t2.col1, t2.col2, t1.col2 + t2.col2 FROM test_1 AS t1 INNER JOIN test_2 AS t2 ON t1.col1=t2.col1
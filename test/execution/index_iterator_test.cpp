@@ -3,10 +3,13 @@
 #include <array>
 #include <memory>
 
+#include "catalog/catalog_accessor.h"
 #include "catalog/catalog_defs.h"
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql_test.h"
 #include "execution/util/timer.h"
+#include "parser/expression/column_value_expression.h"
+#include "storage/index/index_builder.h"
 
 namespace terrier::execution::sql::test {
 
@@ -211,4 +214,126 @@ TEST_F(IndexIteratorTest, SimpleLimitDescendingScanTest) {
   ASSERT_EQ(num_matches, 5);
 }
 
+class IndexIteratorIncludeTest : public TplTest {
+  void SetUp() override {
+    TplTest::SetUp();
+    // The GC is run by hand, so that the test knows when version chains are unlinked
+    db_main_ = terrier::DBMain::Builder().SetUseGC(true).SetUseCatalog(true).Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    gc_ = db_main_->GetStorageLayer()->GetGarbageCollector();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+
+    // Index the key column of a table, and include its value column
+    auto *txn = txn_manager_->BeginTransaction();
+    db_oid_ = catalog_->CreateDatabase(common::ManagedPointer(txn), "test_db", true);
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_oid_, DISABLED);
+    const catalog::namespace_oid_t ns_oid = accessor->GetDefaultNamespace();
+    std::vector<catalog::Schema::Column> cols;
+    cols.emplace_back("key", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+    cols.emplace_back("value", type::TypeId::BIGINT, false, parser::ConstantValueExpression(type::TypeId::BIGINT));
+    table_oid_ = accessor->CreateTable(ns_oid, "include_table", catalog::Schema(cols));
+    const catalog::Schema &schema = accessor->GetSchema(table_oid_);
+    accessor->SetTablePointer(table_oid_, new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), schema));
+    key_oid_ = schema.GetColumn("key").Oid();
+    value_oid_ = schema.GetColumn("value").Oid();
+
+    std::vector<catalog::IndexSchema::Column> index_cols;
+    index_cols.emplace_back("key", type::TypeId::INTEGER, false,
+                            parser::ColumnValueExpression(db_oid_, table_oid_, key_oid_));
+    index_cols.emplace_back("value", type::TypeId::BIGINT, false,
+                            parser::ColumnValueExpression(db_oid_, table_oid_, value_oid_));
+    catalog::IndexSchema index_schema(index_cols, storage::index::IndexType::ART, true, false, false, true, 1);
+    index_oid_ = accessor->CreateIndex(ns_oid, table_oid_, "include_index", index_schema);
+    accessor->SetIndexPointer(
+        index_oid_, storage::index::IndexBuilder().SetKeySchema(accessor->GetIndexSchema(index_oid_)).Build());
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+
+ protected:
+  // Inserts a tuple into the table and the index, and commits it
+  void Insert(const int32_t key, const int64_t value) {
+    auto *txn = txn_manager_->BeginTransaction();
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_oid_, DISABLED);
+    auto table = accessor->GetTable(table_oid_);
+    auto index = accessor->GetIndex(index_oid_);
+    const auto table_map = table->ProjectionMapForOids({key_oid_, value_oid_});
+    auto *redo = txn->StageWrite(db_oid_, table_oid_, table->InitializerForProjectedRow({key_oid_, value_oid_}));
+    redo->Delta()->Set<int32_t, false>(table_map.at(key_oid_), key, false);
+    redo->Delta()->Set<int64_t, false>(table_map.at(value_oid_), value, false);
+    const storage::TupleSlot slot = table->Insert(common::ManagedPointer(txn), redo);
+
+    const auto &index_cols = accessor->GetIndexSchema(index_oid_).GetColumns();
+    const auto &key_map = index->GetKeyOidToOffsetMap();
+    auto *key_buffer = common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+    auto *index_pr = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+    index_pr->Set<int32_t, false>(key_map.at(index_cols[0].Oid()), key, false);
+    index_pr->Set<int64_t, false>(key_map.at(index_cols[1].Oid()), value, false);
+    EXPECT_TRUE(index->InsertUnique(common::ManagedPointer(txn), *index_pr, slot));
+    delete[] key_buffer;
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+
+  // Looks up the key through an index iterator, and returns the value it reads
+  int64_t Lookup(const int32_t key) {
+    auto *txn = txn_manager_->BeginTransaction();
+    auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_oid_, DISABLED);
+    exec::ExecutionSettings exec_settings;
+    exec::ExecutionContext exec_ctx(db_oid_, common::ManagedPointer(txn), nullptr, nullptr,
+                                    common::ManagedPointer(accessor), exec_settings);
+    std::array<uint32_t, 2> col_oids{key_oid_.UnderlyingValue(), value_oid_.UnderlyingValue()};
+    const auto table_map = accessor->GetTable(table_oid_)->ProjectionMapForOids({key_oid_, value_oid_});
+    int64_t value = -1;
+    {
+      IndexIterator index_iter{&exec_ctx,
+                               1,
+                               table_oid_.UnderlyingValue(),
+                               index_oid_.UnderlyingValue(),
+                               col_oids.data(),
+                               static_cast<uint32_t>(col_oids.size())};
+      index_iter.Init();
+      const auto &key_map = accessor->GetIndex(index_oid_)->GetKeyOidToOffsetMap();
+      const auto &index_cols = accessor->GetIndexSchema(index_oid_).GetColumns();
+      index_iter.PR()->Set<int32_t, false>(key_map.at(index_cols[0].Oid()), key, false);
+      index_iter.ScanKey();
+      EXPECT_TRUE(index_iter.Advance());
+      auto *const table_pr = index_iter.TablePR();
+      const int32_t *read_key = table_pr->Get<int32_t, false>(table_map.at(key_oid_), nullptr);
+      EXPECT_EQ(*read_key, key);
+      value = *table_pr->Get<int64_t, false>(table_map.at(value_oid_), nullptr);
+      EXPECT_FALSE(index_iter.Advance());
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return value;
+  }
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  common::ManagedPointer<storage::GarbageCollector> gc_;
+  common::ManagedPointer<catalog::Catalog> catalog_;
+  catalog::db_oid_t db_oid_;
+  catalog::table_oid_t table_oid_;
+  catalog::index_oid_t index_oid_;
+  catalog::col_oid_t key_oid_;
+  catalog::col_oid_t value_oid_;
+};
+
+// Looks up keys through an index that includes every column read, once with the tuple still holding a version chain,
+// where the iterator reads the tuple from the table, and once without, where it copies the columns out of the index
+// NOLINTNEXTLINE
+TEST_F(IndexIteratorIncludeTest, ExactScanReadsIncludedColumns) {
+  Insert(15721, 42);
+  gc_->PerformGarbageCollection();
+  gc_->PerformGarbageCollection();
+  Insert(15722, 43);
+
+  // The version chain of the second insert is still linked
+  EXPECT_EQ(Lookup(15722), 43);
+  EXPECT_EQ(Lookup(15721), 42);
+
+  gc_->PerformGarbageCollection();
+  gc_->PerformGarbageCollection();
+  EXPECT_EQ(Lookup(15722), 43);
+  EXPECT_EQ(Lookup(15721), 42);
+}
+
 }  // namespace terrier::execution::sql::test
@@ -27,6 +27,18 @@ class StorageInterfaceTest : public SqlBasedTest {
   std::unique_ptr<exec::ExecutionContext> exec_ctx_;
 };
 
+/**
+ * Storage interface with a bulk load memory limit small enough for the tests to go over
+ */
+class LimitedStorageInterface : public StorageInterface {
+ public:
+  LimitedStorageInterface(exec::ExecutionContext *exec_ctx, catalog::table_oid_t table_oid, uint32_t *col_oids,
+                          uint32_t num_oids, uint64_t bulk_load_memory_limit)
+      : StorageInterface(exec_ctx, table_oid, col_oids, num_oids, true) {
+    bulk_load_memory_limit_ = bulk_load_memory_limit;
+  }
+};
+
 // NOLINTNEXTLINE
 TEST_F(StorageInterfaceTest, SimpleInsertTest) {
   // INSERT INTO empty_table SELECT colA FROM test_1 WHERE colA BETWEEN 495 and 505.
@@ -415,4 +427,47 @@ TEST_F(StorageInterfaceTest, MultiIndexedUpdateTest) {
     ASSERT_EQ(num_matches, (hi_match - lo_match) + 1);
   }
 }
+
+// NOLINTNEXTLINE
+TEST_F(StorageInterfaceTest, BulkLoadMemoryLimitTest) {
+  // INSERT INTO empty_table with a bulk load into index_empty that only has room to stage a few of the keys.
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "empty_table");
+  auto index_oid = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_empty");
+  std::array<uint32_t, 1> col_oids{1};
+  LimitedStorageInterface inserter(exec_ctx_.get(), table_oid, col_oids.data(), col_oids.size(), 1024);
+
+  // Insert the keys in descending order, so that they are not already sorted
+  constexpr int32_t num_tuples = 1000;
+  for (int32_t i = num_tuples - 1; i >= 0; i--) {
+    auto *const insert_pr(inserter.GetTablePR());
+    insert_pr->Set<int32_t, false>(0, i, false);
+    const storage::TupleSlot slot = inserter.TableInsert();
+    auto *const index_pr(inserter.GetIndexPR(index_oid));
+    index_pr->Set<int32_t, false>(0, i, false);
+    inserter.IndexBulkLoadAdd(slot);
+  }
+  ASSERT_TRUE(inserter.IndexBulkLoad());
+
+  // Every key is in the index, both the ones staged before going over the limit and the ones inserted after
+  IndexIterator index_iter{exec_ctx_.get(),
+                           1,
+                           table_oid.UnderlyingValue(),
+                           index_oid.UnderlyingValue(),
+                           col_oids.data(),
+                           static_cast<uint32_t>(col_oids.size())};
+  index_iter.Init();
+  auto *const lo_pr(index_iter.LoPR());
+  auto *const hi_pr(index_iter.HiPR());
+  lo_pr->Set<int32_t, false>(0, 0, false);
+  hi_pr->Set<int32_t, false>(0, num_tuples - 1, false);
+  index_iter.ScanAscending(storage::index::ScanType::Closed, 0);
+  int32_t num_matches = 0;
+  while (index_iter.Advance()) {
+    auto *const table_pr(index_iter.TablePR());
+    auto *val = table_pr->Get<int32_t, false>(0, nullptr);
+    EXPECT_EQ(*val, num_matches);
+    num_matches++;
+  }
+  EXPECT_EQ(num_matches, num_tuples);
+}
 }  // namespace terrier::execution::sql::test
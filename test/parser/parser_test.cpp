@@ -1289,6 +1289,11 @@ TEST_F(ParserTestBase, OldCreateIndexTest) {
   EXPECT_EQ(create_stmt->GetIndexName(), "ii");
   EXPECT_EQ(create_stmt->GetTableName(), "t");
 
+  query = "CREATE INDEX ii ON t USING ART (col);";
+  result = parser::PostgresParser::BuildParseTree(query);
+  create_stmt = result->GetStatement(0).CastManagedPointerTo<CreateStatement>();
+  EXPECT_EQ(create_stmt->GetIndexType(), IndexType::ART);
+
   query = "CREATE INDEX ii ON t (col);";
   result = parser::PostgresParser::BuildParseTree(query);
   create_stmt = result->GetStatement(0).CastManagedPointerTo<CreateStatement>();
@@ -1,17 +1,13 @@
 #include "storage/access_observer.h"
+#include <chrono>  // NOLINT
 #include <random>
-#include <thread>  // NOLINT
-#include "storage/block_compactor.h"
+#include <vector>
+#include "storage/data_table.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
 namespace terrier {
-class MockBlockCompactor : public storage::BlockCompactor {
- public:
-  // NOLINTNEXTLINE
-  MOCK_METHOD1(PutInQueue, void(storage::RawBlock *));
-};
 
-// Tests that the observer only enqueues blocks that are full and has not been accessed for a while
+// Tests that the observer only tracks blocks that are full
 // NOLINTNEXTLINE
 TEST(AccessObserverTest, EmptyBlocksNotObserved) {
   // Obtain a fake block
@@ -23,17 +19,17 @@ TEST(AccessObserverTest, EmptyBlocksNotObserved) {
   auto *fake_block = new storage::RawBlock;
   accessor.InitializeRawBlock(&table, fake_block, storage::layout_version_t(0));
 
-  MockBlockCompactor mock_compactor;
-  EXPECT_CALL(mock_compactor, PutInQueue(::testing::_)).Times(0);
-  storage::AccessObserver tested(&mock_compactor);
+  storage::AccessObserver tested;
 
   // Test that empty blocks are never observed
   tested.ObserveWrite(fake_block);
-  for (uint32_t i = 0; i < COLD_DATA_EPOCH_THRESHOLD; i++) tested.ObserveGCInvocation();
-  // Should not be called
+  tested.ObserveGCInvocation();
+  EXPECT_EQ(tested.NumObservedBlocks(), 0);
+  EXPECT_TRUE(tested.ColdBlocks(std::chrono::milliseconds(0)).empty());
   delete fake_block;
 }
 
+// Tests that full blocks are reported as cold once they have not been written to for long enough
 // NOLINTNEXTLINE
 TEST(AccessObserverTest, FilledBlocksObserved) {
   // Obtain a fake block
@@ -45,23 +41,23 @@ TEST(AccessObserverTest, FilledBlocksObserved) {
   auto *fake_block = new storage::RawBlock;
   accessor.InitializeRawBlock(&table, fake_block, storage::layout_version_t(0));
 
-  MockBlockCompactor mock_compactor;
-  // NOLINTNEXTLINE
-  EXPECT_CALL(mock_compactor, PutInQueue(::testing::_)).Times(1);
-  storage::AccessObserver tested(&mock_compactor);
+  storage::AccessObserver tested;
 
   // Manually set block to be filled
   fake_block->insert_head_ = layout.NumSlots();
-  // Now it should be called
+  tested.ObserveGCInvocation();
   tested.ObserveWrite(fake_block);
-  for (uint32_t i = 0; i <= COLD_DATA_EPOCH_THRESHOLD; i++) tested.ObserveGCInvocation();
+  EXPECT_EQ(tested.NumObservedBlocks(), 1);
+  // Not cold yet
+  EXPECT_TRUE(tested.ColdBlocks(std::chrono::hours(1)).empty());
+  // Now it should be cold
+  EXPECT_EQ(tested.ColdBlocks(std::chrono::milliseconds(0)), std::vector<storage::RawBlock *>{fake_block});
+
+  // A forgotten block is not tracked until it is written to again
+  tested.Forget(fake_block);
+  EXPECT_TRUE(tested.ColdBlocks(std::chrono::milliseconds(0)).empty());
+  tested.ObserveWrite(fake_block);
+  EXPECT_EQ(tested.NumObservedBlocks(), 1);
   delete fake_block;
 }
 }  // namespace terrier
-
-int main(int argc, char **argv) {
-  // The following line must be executed to initialize Google Mock
-  // (and Google Test) before running the tests.
-  ::testing::InitGoogleMock(&argc, argv);
-  return RUN_ALL_TESTS();
-}
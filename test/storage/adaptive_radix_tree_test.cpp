@@ -0,0 +1,166 @@
+#include "storage/index/adaptive_radix_tree.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "portable_endian/portable_endian.h"
+#include "test_util/test_harness.h"
+
+namespace terrier {
+
+struct AdaptiveRadixTreeTests : public TerrierTest {
+  using Key = std::vector<uint8_t>;
+
+  std::default_random_engine generator_;
+
+  // Keys share their first bytes with probability, so that the tree grows long compressed paths as well as wide nodes
+  Key RandomKey(const uint16_t key_size, const uint32_t alphabet) {
+    std::uniform_int_distribution<uint32_t> shared_dist(0, key_size);
+    std::uniform_int_distribution<uint32_t> byte_dist(0, alphabet - 1);
+    const uint32_t shared = shared_dist(generator_);
+    Key key(key_size);
+    for (uint32_t i = 0; i < key_size; i++) key[i] = static_cast<uint8_t>(i < shared ? 7 * i : byte_dist(generator_));
+    return key;
+  }
+
+  static const byte *Bytes(const Key &key) { return reinterpret_cast<const byte *>(key.data()); }
+
+  // Checks a scan of the tree against the same range of the reference
+  static void CheckScan(const storage::index::AdaptiveRadixTree &tree, const std::set<Key> &reference, const Key &low,
+                        const Key &high, const bool ascending, const size_t limit) {
+    std::vector<Key> results;
+    tree.Scan(Bytes(low), Bytes(high), ascending, [&](const byte *const key) {
+      const auto *const key_bytes = reinterpret_cast<const uint8_t *>(key);
+      results.emplace_back(key_bytes, key_bytes + low.size());
+      return results.size() < limit;
+    });
+
+    std::vector<Key> expected;
+    if (low <= high) expected.assign(reference.lower_bound(low), reference.upper_bound(high));
+    if (!ascending) std::reverse(expected.begin(), expected.end());
+    if (expected.size() > limit) expected.resize(limit);
+    EXPECT_EQ(results, expected);
+  }
+};
+
+// Random inserts, deletes and scans give the same results as on a std::set, for keys of many sizes and byte
+// distributions, and the tree frees all of its memory once it is empty again
+// NOLINTNEXTLINE
+TEST_F(AdaptiveRadixTreeTests, RandomOperations) {
+  const uint32_t num_iterations = 15;
+  const uint32_t num_ops = 10000;
+  for (uint32_t iteration = 0; iteration < num_iterations; iteration++) {
+    std::uniform_int_distribution<uint16_t> key_size_dist(1, 24);
+    const uint16_t key_size = key_size_dist(generator_);
+    // Few distinct bytes make deep trees of small nodes, many distinct bytes make shallow trees of large nodes
+    const uint32_t alphabet = std::vector<uint32_t>{3, 60, 256}[iteration % 3];
+    storage::index::AdaptiveRadixTree tree(key_size);
+    std::set<Key> reference;
+
+    std::uniform_int_distribution<uint32_t> op_dist(0, 9);
+    for (uint32_t i = 0; i < num_ops; i++) {
+      const uint32_t op = op_dist(generator_);
+      if (op < 5) {
+        const Key key = RandomKey(key_size, alphabet);
+        EXPECT_EQ(tree.Insert(Bytes(key)), reference.insert(key).second);
+      } else if (op < 8) {
+        // Delete a key in the tree half of the time, and a random one otherwise
+        Key key = RandomKey(key_size, alphabet);
+        if (!reference.empty() && op % 2 == 0) {
+          std::uniform_int_distribution<size_t> pos_dist(0, std::min<size_t>(reference.size(), 50) - 1);
+          key = *std::next(reference.begin(), static_cast<int64_t>(pos_dist(generator_)));
+        }
+        EXPECT_EQ(tree.Delete(Bytes(key)), reference.erase(key) > 0);
+      } else {
+        const Key low = RandomKey(key_size, alphabet);
+        const Key high = RandomKey(key_size, alphabet);
+        CheckScan(tree, reference, low, high, op == 8, SIZE_MAX);
+        CheckScan(tree, reference, low, high, op == 8, 5);
+      }
+      ASSERT_EQ(tree.Size(), reference.size());
+    }
+
+    const Key min(key_size, 0), max(key_size, UINT8_MAX);
+    CheckScan(tree, reference, min, max, true, SIZE_MAX);
+    CheckScan(tree, reference, min, max, false, SIZE_MAX);
+
+    for (const auto &key : reference) EXPECT_TRUE(tree.Delete(Bytes(key)));
+    EXPECT_EQ(tree.Size(), 0);
+    EXPECT_EQ(tree.HeapUsage(), 0);
+  }
+}
+
+// Dense keys fill nodes up to 256 children, and deleting them shrinks the nodes again on the way down
+// NOLINTNEXTLINE
+TEST_F(AdaptiveRadixTreeTests, GrowAndShrink) {
+  storage::index::AdaptiveRadixTree tree(sizeof(uint32_t));
+  const uint32_t num_keys = 1 << 16;
+  std::vector<uint32_t> keys;
+  for (uint32_t i = 0; i < num_keys; i++) keys.push_back(htobe32(i));
+  std::shuffle(keys.begin(), keys.end(), generator_);
+
+  for (const uint32_t key : keys) EXPECT_TRUE(tree.Insert(reinterpret_cast<const byte *>(&key)));
+  for (const uint32_t key : keys) EXPECT_FALSE(tree.Insert(reinterpret_cast<const byte *>(&key)));
+  EXPECT_EQ(tree.Size(), num_keys);
+  // A leaf per key, under 256 full nodes for the last key byte and a full node for the one before
+  EXPECT_LT(tree.HeapUsage(), num_keys * (sizeof(uint32_t) + 2 * sizeof(uintptr_t)));
+
+  uint32_t expected = 0;
+  const uint32_t low = 0, high = UINT32_MAX;
+  tree.Scan(reinterpret_cast<const byte *>(&low), reinterpret_cast<const byte *>(&high), true,
+            [&](const byte *const key) {
+              EXPECT_EQ(be32toh(*reinterpret_cast<const uint32_t *>(key)), expected++);
+              return true;
+            });
+  EXPECT_EQ(expected, num_keys);
+
+  std::shuffle(keys.begin(), keys.end(), generator_);
+  for (const uint32_t key : keys) EXPECT_TRUE(tree.Delete(reinterpret_cast<const byte *>(&key)));
+  for (const uint32_t key : keys) EXPECT_FALSE(tree.Delete(reinterpret_cast<const byte *>(&key)));
+  EXPECT_EQ(tree.Size(), 0);
+  EXPECT_EQ(tree.HeapUsage(), 0);
+}
+
+// A bulk loaded tree gives the same results as a std::set, and behaves like any other tree under later inserts and
+// deletes
+// NOLINTNEXTLINE
+TEST_F(AdaptiveRadixTreeTests, BulkLoad) {
+  const uint32_t num_iterations = 15;
+  const uint32_t num_keys = 10000;
+  for (uint32_t iteration = 0; iteration < num_iterations; iteration++) {
+    std::uniform_int_distribution<uint16_t> key_size_dist(1, 24);
+    const uint16_t key_size = key_size_dist(generator_);
+    const uint32_t alphabet = std::vector<uint32_t>{3, 60, 256}[iteration % 3];
+    storage::index::AdaptiveRadixTree tree(key_size);
+    std::set<Key> reference;
+    for (uint32_t i = 0; i < num_keys; i++) reference.insert(RandomKey(key_size, alphabet));
+
+    std::vector<uint8_t> keys;
+    for (const auto &key : reference) keys.insert(keys.end(), key.begin(), key.end());
+    tree.BulkLoad(reinterpret_cast<const byte *>(keys.data()), reference.size());
+    ASSERT_EQ(tree.Size(), reference.size());
+
+    const Key min(key_size, 0), max(key_size, UINT8_MAX);
+    CheckScan(tree, reference, min, max, true, SIZE_MAX);
+    CheckScan(tree, reference, min, max, false, SIZE_MAX);
+    for (uint32_t i = 0; i < 100; i++) {
+      const Key low = RandomKey(key_size, alphabet);
+      const Key high = RandomKey(key_size, alphabet);
+      CheckScan(tree, reference, low, high, i % 2 == 0, SIZE_MAX);
+    }
+
+    for (uint32_t i = 0; i < 1000; i++) {
+      const Key key = RandomKey(key_size, alphabet);
+      EXPECT_EQ(tree.Insert(Bytes(key)), reference.insert(key).second);
+    }
+    CheckScan(tree, reference, min, max, true, SIZE_MAX);
+
+    for (const auto &key : reference) EXPECT_TRUE(tree.Delete(Bytes(key)));
+    EXPECT_EQ(tree.Size(), 0);
+    EXPECT_EQ(tree.HeapUsage(), 0);
+  }
+}
+
+}  // namespace terrier
@@ -0,0 +1,567 @@
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "main/db_main.h"
+#include "parser/expression/column_value_expression.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
+#include "storage/projected_row.h"
+#include "storage/sql_table.h"
+#include "test_util/catalog_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "type/type_id.h"
+
+namespace terrier::storage::index {
+
+class ArtIndexTests : public TerrierTest {
+ private:
+  catalog::Schema table_schema_;
+  catalog::IndexSchema unique_schema_;
+  catalog::IndexSchema default_schema_;
+
+ public:
+  std::default_random_engine generator_;
+  const uint32_t num_threads_ = 4;
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+
+  // SqlTable
+  storage::SqlTable *sql_table_;
+  storage::ProjectedRowInitializer tuple_initializer_ =
+      storage::ProjectedRowInitializer::Create(std::vector<uint16_t>{1}, std::vector<uint16_t>{1});
+
+  // ArtIndex
+  Index *default_index_, *unique_index_;
+
+  byte *key_buffer_1_, *key_buffer_2_;
+
+  common::WorkerPool thread_pool_{num_threads_, {}};
+
+  // Inserts a tuple with the given value into the table and returns its slot
+  TupleSlot InsertTuple(transaction::TransactionContext *const txn, const int32_t value) {
+    auto *const insert_redo =
+        txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = value;
+    return sql_table_->Insert(common::ManagedPointer(txn), insert_redo);
+  }
+
+  // Initializes a key with the given value in the given buffer
+  ProjectedRow *MakeKey(byte *const key_buffer, const int32_t value) {
+    auto *const key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer);
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = value;
+    return key;
+  }
+
+ protected:
+  void SetUp() override {
+    thread_pool_.Startup();
+    db_main_ = terrier::DBMain::Builder().SetUseGC(true).SetUseGCThread(true).SetRecordBufferSegmentSize(1e6).Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+
+    auto col = catalog::Schema::Column("attribute", type::TypeId::INTEGER, false,
+                                       parser::ConstantValueExpression(type::TypeId::INTEGER));
+    StorageTestUtil::ForceOid(&(col), catalog::col_oid_t(1));
+    table_schema_ = catalog::Schema({col});
+    sql_table_ = new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), table_schema_);
+    tuple_initializer_ = sql_table_->InitializerForProjectedRow({catalog::col_oid_t(1)});
+
+    std::vector<catalog::IndexSchema::Column> keycols;
+    keycols.emplace_back("", type::TypeId::INTEGER, false,
+                         parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                       catalog::col_oid_t(1)));
+    StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+    unique_schema_ = catalog::IndexSchema(keycols, storage::index::IndexType::ART, true, true, false, true);
+    default_schema_ = catalog::IndexSchema(keycols, storage::index::IndexType::ART, false, false, false, true);
+
+    unique_index_ = (IndexBuilder().SetKeySchema(unique_schema_)).Build();
+    default_index_ = (IndexBuilder().SetKeySchema(default_schema_)).Build();
+
+    key_buffer_1_ =
+        common::AllocationUtil::AllocateAligned(default_index_->GetProjectedRowInitializer().ProjectedRowSize());
+    key_buffer_2_ =
+        common::AllocationUtil::AllocateAligned(default_index_->GetProjectedRowInitializer().ProjectedRowSize());
+  }
+  void TearDown() override {
+    thread_pool_.Shutdown();
+    db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() {
+      delete sql_table_;
+      delete default_index_;
+      delete unique_index_;
+    });
+
+    delete[] key_buffer_1_;
+    delete[] key_buffer_2_;
+  }
+};
+
+// Integer keys get an ART, with the same key kind as a BwTree over them
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, Build) {
+  EXPECT_EQ(default_index_->Type(), IndexType::ART);
+  EXPECT_EQ(unique_index_->Type(), IndexType::ART);
+  EXPECT_EQ(default_index_->KeyKind(), IndexKeyKind::COMPACTINTSKEY);
+}
+
+/**
+ * This test creates multiple worker threads that all try to insert [0,num_inserts) as tuples in the table and into the
+ * primary key index. At completion of the workload, only num_inserts_ txns should have committed with visible versions
+ * in the index and table.
+ */
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, UniqueInsert) {
+  const uint32_t num_inserts = 100000;  // number of tuples/primary keys for each worker to attempt to insert
+  auto workload = [&](uint32_t worker_id) {
+    auto *const key_buffer =
+        common::AllocationUtil::AllocateAligned(unique_index_->GetProjectedRowInitializer().ProjectedRowSize());
+
+    // some threads count up, others count down. This is to mix whether threads abort for write-write conflict or
+    // previously committed versions
+    for (uint32_t j = 0; j < num_inserts; j++) {
+      const uint32_t i = worker_id % 2 == 0 ? j : num_inserts - 1 - j;
+      auto *const insert_txn = txn_manager_->BeginTransaction();
+      const auto tuple_slot = InsertTuple(insert_txn, i);
+      if (unique_index_->InsertUnique(common::ManagedPointer(insert_txn), *MakeKey(key_buffer, i), tuple_slot)) {
+        txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      } else {
+        txn_manager_->Abort(insert_txn);
+      }
+    }
+    delete[] key_buffer;
+  };
+
+  const auto starting_size = unique_index_->EstimateHeapUsage();
+
+  // run the workload
+  for (uint32_t i = 0; i < num_threads_; i++) {
+    thread_pool_.SubmitTask([i, &workload] { workload(i); });
+  }
+  thread_pool_.WaitUntilAllFinished();
+
+  EXPECT_GT(unique_index_->EstimateHeapUsage(), starting_size);
+
+  // scan[0,num_inserts_) should hit num_inserts_ keys (no duplicates)
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+  std::vector<storage::TupleSlot> results;
+  unique_index_->ScanAscending(*scan_txn, storage::index::ScanType::Closed, 1, MakeKey(key_buffer_1_, 0),
+                               MakeKey(key_buffer_2_, num_inserts - 1), 0, &results);
+  EXPECT_EQ(results.size(), num_inserts);
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/**
+ * This test creates multiple worker threads that all try to insert [0,num_inserts) as tuples in the table and into the
+ * index. At completion of the workload, all num_inserts_ txns * num_threads_ should have committed with visible
+ * versions in the index and table, and every key should lead to one tuple per thread.
+ */
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, DefaultInsert) {
+  const uint32_t num_inserts = 100000;  // number of tuples/keys for each worker to insert
+  auto workload = [&](uint32_t worker_id) {
+    auto *const key_buffer =
+        common::AllocationUtil::AllocateAligned(default_index_->GetProjectedRowInitializer().ProjectedRowSize());
+    for (uint32_t j = 0; j < num_inserts; j++) {
+      const uint32_t i = worker_id % 2 == 0 ? j : num_inserts - 1 - j;
+      auto *const insert_txn = txn_manager_->BeginTransaction();
+      const auto tuple_slot = InsertTuple(insert_txn, i);
+      EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *MakeKey(key_buffer, i), tuple_slot));
+      txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+    delete[] key_buffer;
+  };
+
+  for (uint32_t i = 0; i < num_threads_; i++) {
+    thread_pool_.SubmitTask([i, &workload] { workload(i); });
+  }
+  thread_pool_.WaitUntilAllFinished();
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+  std::vector<storage::TupleSlot> results;
+  default_index_->ScanAscending(*scan_txn, storage::index::ScanType::Closed, 1, MakeKey(key_buffer_1_, 0),
+                                MakeKey(key_buffer_2_, num_inserts - 1), 0, &results);
+  EXPECT_EQ(results.size(), num_inserts * num_threads_);
+  results.clear();
+
+  std::uniform_int_distribution<int32_t> key_dist(0, num_inserts - 1);
+  for (uint32_t i = 0; i < 100; i++) {
+    default_index_->ScanKey(*scan_txn, *MakeKey(key_buffer_1_, key_dist(generator_)), &results);
+    EXPECT_EQ(results.size(), num_threads_);
+    results.clear();
+  }
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/**
+ * Scans of random windows, including open ones and ones with limits, see the same tuples in the same order as a
+ * std::multimap holding the same keys. Negative keys check that the byte order of keys matches their integer order.
+ */
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, ScanRandomWindows) {
+  const uint32_t num_keys = 10000;
+  std::uniform_int_distribution<int32_t> key_dist(-1000, 1000);
+  std::multimap<int32_t, TupleSlot> reference;
+  auto *const insert_txn = txn_manager_->BeginTransaction();
+  for (uint32_t i = 0; i < num_keys; i++) {
+    const int32_t key = key_dist(generator_);
+    const auto tuple_slot = InsertTuple(insert_txn, key);
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *MakeKey(key_buffer_1_, key), tuple_slot));
+    reference.emplace(key, tuple_slot);
+  }
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // The index orders the tuples of a key in some order of its own, so compare the keys of the tuples found
+  std::unordered_map<TupleSlot, int32_t> slot_keys;
+  for (const auto &entry : reference) slot_keys[entry.second] = entry.first;
+  auto keys_of = [&](const std::vector<TupleSlot> &slots) {
+    std::vector<int32_t> keys;
+    for (const auto &slot : slots) keys.push_back(slot_keys.at(slot));
+    return keys;
+  };
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+  std::vector<storage::TupleSlot> results;
+  std::uniform_int_distribution<uint32_t> limit_dist(0, 20);
+  for (uint32_t i = 0; i < 100; i++) {
+    int32_t low = key_dist(generator_), high = key_dist(generator_);
+    if (low > high) std::swap(low, high);
+    const uint32_t limit = limit_dist(generator_);
+    std::vector<int32_t> expected;
+    for (auto it = reference.lower_bound(low); it != reference.upper_bound(high); ++it) expected.push_back(it->first);
+
+    const auto scan_type = static_cast<ScanType>(i % 4);
+    const bool open_low = scan_type == ScanType::OpenLow || scan_type == ScanType::OpenBoth;
+    const bool open_high = scan_type == ScanType::OpenHigh || scan_type == ScanType::OpenBoth;
+    std::vector<int32_t> ascending;
+    for (auto it = open_low ? reference.begin() : reference.lower_bound(low);
+         it != (open_high ? reference.end() : reference.upper_bound(high)); ++it)
+      ascending.push_back(it->first);
+    if (limit != 0 && ascending.size() > limit) ascending.resize(limit);
+    default_index_->ScanAscending(*scan_txn, scan_type, 1, MakeKey(key_buffer_1_, low), MakeKey(key_buffer_2_, high),
+                                  limit, &results);
+    EXPECT_EQ(keys_of(results), ascending);
+    results.clear();
+
+    std::vector<int32_t> descending(expected.rbegin(), expected.rend());
+    default_index_->ScanDescending(*scan_txn, *MakeKey(key_buffer_1_, low), *MakeKey(key_buffer_2_, high), &results);
+    EXPECT_EQ(keys_of(results), descending);
+    results.clear();
+
+    if (limit == 0) continue;
+    if (descending.size() > limit) descending.resize(limit);
+    default_index_->ScanLimitDescending(*scan_txn, *MakeKey(key_buffer_1_, low), *MakeKey(key_buffer_2_, high),
+                                        &results, limit);
+    EXPECT_EQ(keys_of(results), descending);
+    results.clear();
+  }
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// Verifies that primary key insert fails on write-write conflict and on a visible key, but not on a deleted key
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, UniqueKey) {
+  auto *txn0 = txn_manager_->BeginTransaction();
+  const auto tuple_slot = InsertTuple(txn0, 15721);
+  EXPECT_TRUE(unique_index_->InsertUnique(common::ManagedPointer(txn0), *MakeKey(key_buffer_1_, 15721), tuple_slot));
+
+  // txn 1 fails to insert the key due to write-write conflict with txn 0
+  auto *txn1 = txn_manager_->BeginTransaction();
+  auto new_tuple_slot = InsertTuple(txn1, 15721);
+  EXPECT_FALSE(
+      unique_index_->InsertUnique(common::ManagedPointer(txn1), *MakeKey(key_buffer_1_, 15721), new_tuple_slot));
+  txn_manager_->Abort(txn1);
+  txn_manager_->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // txn 2 fails to insert the key because txn 0's version is visible to it
+  auto *txn2 = txn_manager_->BeginTransaction();
+  new_tuple_slot = InsertTuple(txn2, 15721);
+  EXPECT_FALSE(
+      unique_index_->InsertUnique(common::ManagedPointer(txn2), *MakeKey(key_buffer_1_, 15721), new_tuple_slot));
+  txn_manager_->Abort(txn2);
+
+  // txn 3 deletes the key and inserts it again
+  auto *txn3 = txn_manager_->BeginTransaction();
+  txn3->StageDelete(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_slot);
+  EXPECT_TRUE(sql_table_->Delete(common::ManagedPointer(txn3), tuple_slot));
+  unique_index_->Delete(common::ManagedPointer(txn3), *MakeKey(key_buffer_1_, 15721), tuple_slot);
+  new_tuple_slot = InsertTuple(txn3, 15721);
+  EXPECT_TRUE(
+      unique_index_->InsertUnique(common::ManagedPointer(txn3), *MakeKey(key_buffer_1_, 15721), new_tuple_slot));
+  txn_manager_->Commit(txn3, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // txn 4 sees only txn 3's version
+  auto *txn4 = txn_manager_->BeginTransaction();
+  std::vector<storage::TupleSlot> results;
+  unique_index_->ScanKey(*txn4, *MakeKey(key_buffer_1_, 15721), &results);
+  EXPECT_EQ(results.size(), 1);
+  EXPECT_EQ(new_tuple_slot, results[0]);
+  txn_manager_->Commit(txn4, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// A bulk load puts every key in the index, and a unique index refuses to load a key twice
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, BulkLoad) {
+  const uint32_t num_keys = 10000;
+  const auto key_size = default_index_->GetProjectedRowInitializer().ProjectedRowSize();
+  std::vector<byte *> key_buffers;
+  std::vector<std::pair<const ProjectedRow *, TupleSlot>> entries;
+
+  auto *const load_txn = txn_manager_->BeginTransaction();
+  for (uint32_t i = 0; i < num_keys; i++) {
+    // Every key twice, in descending order
+    const auto value = static_cast<int32_t>((num_keys - 1 - i) / 2);
+    key_buffers.emplace_back(common::AllocationUtil::AllocateAligned(key_size));
+    entries.emplace_back(MakeKey(key_buffers.back(), value), InsertTuple(load_txn, value));
+  }
+  EXPECT_TRUE(default_index_->BulkLoad(common::ManagedPointer(load_txn), entries));
+  EXPECT_FALSE(unique_index_->BulkLoad(common::ManagedPointer(load_txn), entries));
+  EXPECT_TRUE(load_txn->MustAbort());
+
+  std::vector<storage::TupleSlot> results;
+  default_index_->ScanAscending(*load_txn, storage::index::ScanType::OpenBoth, 1, nullptr, nullptr, 0, &results);
+  EXPECT_EQ(results.size(), num_keys);
+  results.clear();
+  for (uint32_t i = 0; i < num_keys / 2; i++) {
+    default_index_->ScanKey(*load_txn, *MakeKey(key_buffer_1_, i), &results);
+    EXPECT_EQ(results.size(), 2);
+    results.clear();
+  }
+
+  // Aborting removes every loaded key again
+  txn_manager_->Abort(load_txn);
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+  default_index_->ScanAscending(*scan_txn, storage::index::ScanType::OpenBoth, 1, nullptr, nullptr, 0, &results);
+  EXPECT_TRUE(results.empty());
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  for (auto *const key_buffer : key_buffers) delete[] key_buffer;
+}
+
+// A batch of lookups finds the same values as looking each key up on its own, whatever the order of the keys
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, ScanKeyBatch) {
+  const uint32_t num_keys = 1000;
+  const uint32_t num_probes = 2 * num_keys;
+  const auto key_size = default_index_->GetProjectedRowInitializer().ProjectedRowSize();
+
+  auto *const txn = txn_manager_->BeginTransaction();
+  for (uint32_t i = 0; i < num_keys; i++) {
+    // Even keys twice
+    const auto value = static_cast<int32_t>(i);
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(txn), *MakeKey(key_buffer_1_, value),
+                                       InsertTuple(txn, value)));
+    if (i % 2 == 0) {
+      EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(txn), *MakeKey(key_buffer_1_, value),
+                                         InsertTuple(txn, value)));
+    }
+  }
+
+  // Probe random keys, some of them repeated and some of them missing
+  std::uniform_int_distribution<int32_t> distribution(-10, static_cast<int32_t>(num_keys) + 10);
+  std::vector<byte *> key_buffers;
+  std::vector<const ProjectedRow *> keys;
+  for (uint32_t i = 0; i < num_probes; i++) {
+    key_buffers.emplace_back(common::AllocationUtil::AllocateAligned(key_size));
+    keys.emplace_back(MakeKey(key_buffers.back(), distribution(generator_)));
+  }
+
+  std::vector<std::vector<TupleSlot>> value_lists;
+  default_index_->ScanKeyBatch(*txn, keys, &value_lists);
+  EXPECT_EQ(value_lists.size(), num_probes);
+  std::vector<TupleSlot> results;
+  for (uint32_t i = 0; i < num_probes; i++) {
+    default_index_->ScanKey(*txn, *keys[i], &results);
+    EXPECT_EQ(std::unordered_set<TupleSlot>(results.begin(), results.end()),
+              std::unordered_set<TupleSlot>(value_lists[i].begin(), value_lists[i].end()));
+    EXPECT_EQ(results.size(), value_lists[i].size());
+    results.clear();
+  }
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  for (auto *const key_buffer : key_buffers) delete[] key_buffer;
+}
+
+// An aborted insert is removed from the index, and is never visible to other txns
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, AbortInsert) {
+  const auto starting_size = default_index_->EstimateHeapUsage();
+  auto *txn0 = txn_manager_->BeginTransaction();
+  const auto tuple_slot = InsertTuple(txn0, 15721);
+  EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(txn0), *MakeKey(key_buffer_1_, 15721), tuple_slot));
+  EXPECT_GT(default_index_->EstimateHeapUsage(), starting_size);
+
+  std::vector<storage::TupleSlot> results;
+  auto *const scan_key_pr = MakeKey(key_buffer_2_, 15721);
+
+  // txn 0 scans index and gets a visible, correct result
+  default_index_->ScanKey(*txn0, *scan_key_pr, &results);
+  EXPECT_EQ(results.size(), 1);
+  EXPECT_EQ(tuple_slot, results[0]);
+  results.clear();
+
+  // txn 1 scans index and gets no visible result
+  auto *txn1 = txn_manager_->BeginTransaction();
+  default_index_->ScanKey(*txn1, *scan_key_pr, &results);
+  EXPECT_EQ(results.size(), 0);
+
+  txn_manager_->Abort(txn0);
+  EXPECT_EQ(default_index_->EstimateHeapUsage(), starting_size);
+
+  default_index_->ScanKey(*txn1, *scan_key_pr, &results);
+  EXPECT_EQ(results.size(), 0);
+  txn_manager_->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// A committed delete stays visible to txns that started before it
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, CommitDelete) {
+  auto *insert_txn = txn_manager_->BeginTransaction();
+  const auto tuple_slot = InsertTuple(insert_txn, 15721);
+  EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *MakeKey(key_buffer_1_, 15721), tuple_slot));
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  std::vector<storage::TupleSlot> results;
+  auto *const scan_key_pr = MakeKey(key_buffer_2_, 15721);
+
+  // txn 0 deletes in the table and index, after which it no longer sees the key
+  auto *txn0 = txn_manager_->BeginTransaction();
+  txn0->StageDelete(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_slot);
+  EXPECT_TRUE(sql_table_->Delete(common::ManagedPointer(txn0), tuple_slot));
+  default_index_->Delete(common::ManagedPointer(txn0), *MakeKey(key_buffer_1_, 15721), tuple_slot);
+  default_index_->ScanKey(*txn0, *scan_key_pr, &results);
+  EXPECT_EQ(results.size(), 0);
+
+  // txn 1 started before txn 0 committed, so still sees the key
+  auto *txn1 = txn_manager_->BeginTransaction();
+  txn_manager_->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+  default_index_->ScanKey(*txn1, *scan_key_pr, &results);
+  EXPECT_EQ(results.size(), 1);
+  EXPECT_EQ(tuple_slot, results[0]);
+  results.clear();
+  txn_manager_->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // txn 2 no longer sees the key
+  auto *txn2 = txn_manager_->BeginTransaction();
+  default_index_->ScanKey(*txn2, *scan_key_pr, &results);
+  EXPECT_EQ(results.size(), 0);
+  txn_manager_->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+// INCLUDE columns are stored with the key columns without being compared with them, and lookups return them without
+// reading the table once the tuple has no other versions
+// NOLINTNEXTLINE
+TEST_F(ArtIndexTests, IncludeColumns) {
+  // The GC is run by hand below, so that the test knows when version chains are unlinked
+  auto db_main = DBMain::Builder().SetUseGC(true).SetRecordBufferSegmentSize(1e6).Build();
+  const auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  const auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+  // Index the first column of a two column table, and include the second
+  auto key_col = catalog::Schema::Column("key", type::TypeId::INTEGER, false,
+                                         parser::ConstantValueExpression(type::TypeId::INTEGER));
+  StorageTestUtil::ForceOid(&(key_col), catalog::col_oid_t(1));
+  auto include_col = catalog::Schema::Column("include", type::TypeId::BIGINT, false,
+                                             parser::ConstantValueExpression(type::TypeId::BIGINT));
+  StorageTestUtil::ForceOid(&(include_col), catalog::col_oid_t(2));
+  auto *const table =
+      new storage::SqlTable(db_main->GetStorageLayer()->GetBlockStore(), catalog::Schema({key_col, include_col}));
+  const auto table_initializer = table->InitializerForProjectedRow({catalog::col_oid_t(1), catalog::col_oid_t(2)});
+  const auto table_map = table->ProjectionMapForOids({catalog::col_oid_t(1), catalog::col_oid_t(2)});
+
+  std::vector<catalog::IndexSchema::Column> index_cols;
+  index_cols.emplace_back("", type::TypeId::INTEGER, false,
+                          parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                        catalog::col_oid_t(1)));
+  StorageTestUtil::ForceOid(&(index_cols[0]), catalog::indexkeycol_oid_t(1));
+  index_cols.emplace_back("", type::TypeId::BIGINT, false,
+                          parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                        catalog::col_oid_t(2)));
+  StorageTestUtil::ForceOid(&(index_cols[1]), catalog::indexkeycol_oid_t(2));
+  const catalog::IndexSchema include_schema(index_cols, storage::index::IndexType::ART, true, false, false, true, 1);
+  EXPECT_EQ(include_schema.NumKeyColumns(), 1);
+
+  // Only the ART can leave INCLUDE columns out of its keys
+  const catalog::IndexSchema bwtree_schema(index_cols, storage::index::IndexType::BWTREE, true, false, false, true, 1);
+  EXPECT_EQ((IndexBuilder().SetKeySchema(bwtree_schema)).Build(), nullptr);
+  auto *const index = (IndexBuilder().SetKeySchema(include_schema)).Build();
+  ASSERT_NE(index, nullptr);
+  EXPECT_TRUE(index->StoresColumns());
+
+  const auto &key_map = index->GetKeyOidToOffsetMap();
+  const auto key_offset = key_map.at(catalog::indexkeycol_oid_t(1));
+  const auto include_offset = key_map.at(catalog::indexkeycol_oid_t(2));
+  auto *const key_buffer =
+      common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+  auto *const key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+  *reinterpret_cast<int32_t *>(key->AccessForceNotNull(key_offset)) = 15721;
+  *reinterpret_cast<int64_t *>(key->AccessForceNotNull(include_offset)) = 42;
+
+  // Inserts a tuple and its key into the table and the index, and returns whether the index took it
+  auto insert = [&](transaction::TransactionContext *const txn) {
+    auto *const insert_redo =
+        txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, table_initializer);
+    *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(table_map.at(catalog::col_oid_t(1)))) =
+        *reinterpret_cast<int32_t *>(key->AccessForceNotNull(key_offset));
+    *reinterpret_cast<int64_t *>(insert_redo->Delta()->AccessForceNotNull(table_map.at(catalog::col_oid_t(2)))) =
+        *reinterpret_cast<int64_t *>(key->AccessForceNotNull(include_offset));
+    const auto tuple_slot = table->Insert(common::ManagedPointer(txn), insert_redo);
+    return std::make_pair(index->InsertUnique(common::ManagedPointer(txn), *key, tuple_slot), tuple_slot);
+  };
+
+  auto *const insert_txn = txn_manager->BeginTransaction();
+  const auto inserted = insert(insert_txn);
+  EXPECT_TRUE(inserted.first);
+  txn_manager->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // The same key with a different INCLUDE column is still a duplicate
+  auto *const duplicate_txn = txn_manager->BeginTransaction();
+  *reinterpret_cast<int64_t *>(key->AccessForceNotNull(include_offset)) = 43;
+  EXPECT_FALSE(insert(duplicate_txn).first);
+  txn_manager->Abort(duplicate_txn);
+
+  std::vector<TupleSlot> results;
+  std::vector<byte> rows;
+  std::vector<bool> covered;
+
+  // A tuple that still has a version chain has to be read from the table. Lookups only set the key columns.
+  auto *const uncommitted_txn = txn_manager->BeginTransaction();
+  *reinterpret_cast<int32_t *>(key->AccessForceNotNull(key_offset)) = 15722;
+  const auto uncommitted = insert(uncommitted_txn);
+  EXPECT_TRUE(uncommitted.first);
+  key->SetNull(include_offset);
+  index->ScanKeyCovered(*uncommitted_txn, *key, &results, &rows, &covered);
+  ASSERT_EQ(results.size(), 1);
+  EXPECT_EQ(results[0], uncommitted.second);
+  EXPECT_EQ(covered, std::vector<bool>{false});
+  txn_manager->Abort(uncommitted_txn);
+
+  // Once the GC has unlinked the version chain of the committed insert, the index returns the columns itself
+  *reinterpret_cast<int32_t *>(key->AccessForceNotNull(key_offset)) = 15721;
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+  results.clear();
+  auto *const scan_txn = txn_manager->BeginTransaction();
+  index->ScanKeyCovered(*scan_txn, *key, &results, &rows, &covered);
+  txn_manager->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  ASSERT_EQ(results.size(), 1);
+  ASSERT_TRUE(covered[0]);
+  EXPECT_EQ(results[0], inserted.second);
+  const auto *const row = reinterpret_cast<const ProjectedRow *>(rows.data());
+  EXPECT_EQ(*reinterpret_cast<const int32_t *>(row->AccessWithNullCheck(key_offset)), 15721);
+  EXPECT_EQ(*reinterpret_cast<const int64_t *>(row->AccessWithNullCheck(include_offset)), 42);
+
+  db_main->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() {
+    delete table;
+    delete index;
+  });
+  delete[] key_buffer;
+}
+
+}  // namespace terrier::storage::index
@@ -1,18 +1,28 @@
 #include "storage/block_compactor.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <thread>  // NOLINT
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "common/hash_util.h"
+#include "storage/access_observer.h"
 #include "storage/block_access_controller.h"
+#include "storage/block_evictor.h"
 #include "storage/garbage_collector.h"
 #include "storage/storage_defs.h"
 #include "storage/tuple_access_strategy.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
 #include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_util.h"
 
 #define EXPORT_TABLE_NAME "test_table.arrow"
+#define SWAP_FILE_NAME "test_compacted_blocks.swap"
 
 namespace terrier {
 
@@ -256,10 +266,9 @@ TEST_F(BlockCompactorTest, GatherTest) {
 
     gc.PerformGarbageCollection();
     gc.PerformGarbageCollection();  // Second call to deallocate.
-    // Deallocate all the leftover gathered varlens
+    // Deallocate all the leftover gathered varlens and compressed columns
     // No need to gather the ones still in the block because they are presumably all gathered
-    for (storage::col_id_t col_id : layout.AllColumns())
-      if (layout.IsVarlen(col_id)) arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
+    for (storage::col_id_t col_id : layout.AllColumns()) arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
     block_store_.Release(block);
   }
 }
@@ -379,12 +388,372 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
 
     gc.PerformGarbageCollection();
     gc.PerformGarbageCollection();  // Second call to deallocate.
-    // Deallocate all the leftover gathered varlens
+    // Deallocate all the leftover gathered varlens and compressed columns
     // No need to gather the ones still in the block because they are presumably all gathered
+    for (storage::col_id_t col_id : layout.AllColumns()) arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
+    block_store_.Release(block);
+  }
+}
+
+// This test generates random single blocks and freezes them. It then verifies that the null counts and zone maps of
+// the block describe the contents of the block.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, ZoneMapTest) {
+  uint32_t repeat = 10;
+  for (uint32_t iteration = 0; iteration < repeat; iteration++) {
+    storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(100, &generator_);
+    storage::TupleAccessStrategy accessor(layout);
+    // Technically, the block above is not "in" the table, but since we don't sequential scan that does not matter
+    storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                             storage::layout_version_t(0));
+    storage::RawBlock *block = block_store_.Get();
+    accessor.InitializeRawBlock(&table, block, storage::layout_version_t(0));
+
+    // Enable GC to cleanup transactions started by the block compactor
+    transaction::TimestampManager timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool_), true, DISABLED};
+    storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                                 common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                                 DISABLED};
+
+    auto tuples = StorageTestUtil::PopulateBlockRandomly(&table, block, percent_empty_, &generator_);
+    auto &arrow_metadata = accessor.GetArrowBlockMetadata(block);
     for (storage::col_id_t col_id : layout.AllColumns())
-      if (layout.IsVarlen(col_id)) arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
+      arrow_metadata.GetColumnInfo(layout, col_id).Type() = storage::ArrowColumnType::FIXED_LENGTH;
+
+    storage::BlockCompactor compactor;
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+    gc.PerformGarbageCollection();
+    compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // freezing pass
+    ASSERT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+    EXPECT_EQ(arrow_metadata.NumRecords(), tuples.size());
+
+    // Compute the expected null counts and bounds from the original tuples
+    std::unordered_map<storage::col_id_t, uint32_t> null_counts;
+    std::unordered_map<storage::col_id_t, std::pair<int64_t, int64_t>> bounds;
+    for (auto &entry : tuples) {
+      storage::ProjectedRow *row = entry.second;
+      for (uint16_t i = 0; i < row->NumColumns(); i++) {
+        const storage::col_id_t col_id = row->ColumnIds()[i];
+        const byte *value = row->AccessWithNullCheck(i);
+        if (value == nullptr) {
+          null_counts[col_id]++;
+          continue;
+        }
+        int64_t int_value;
+        switch (layout.AttrSize(col_id)) {
+          case 1:
+            int_value = *reinterpret_cast<const int8_t *>(value);
+            break;
+          case 2:
+            int_value = *reinterpret_cast<const int16_t *>(value);
+            break;
+          case 4:
+            int_value = *reinterpret_cast<const int32_t *>(value);
+            break;
+          default:
+            int_value = *reinterpret_cast<const int64_t *>(value);
+            // Every number read as a double must be within the bounds for doubles
+            double real_value;
+            std::memcpy(&real_value, value, sizeof(double));
+            if (!std::isnan(real_value)) {
+              const storage::ArrowZoneMap &zone_map = arrow_metadata.GetZoneMap(layout, col_id);
+              EXPECT_LE(zone_map.MinReal(), real_value);
+              EXPECT_GE(zone_map.MaxReal(), real_value);
+            }
+        }
+        auto it = bounds.find(col_id);
+        if (it == bounds.end()) {
+          bounds.emplace(col_id, std::make_pair(int_value, int_value));
+        } else {
+          it->second.first = std::min(it->second.first, int_value);
+          it->second.second = std::max(it->second.second, int_value);
+        }
+      }
+    }
+
+    for (storage::col_id_t col_id : layout.AllColumns()) {
+      EXPECT_EQ(arrow_metadata.NullCount(col_id), null_counts[col_id]);
+      const storage::ArrowZoneMap &zone_map = arrow_metadata.GetZoneMap(layout, col_id);
+      auto it = bounds.find(col_id);
+      if (it == bounds.end()) {
+        // A column without non-null values has empty bounds
+        EXPECT_GT(zone_map.Min(), zone_map.Max());
+      } else {
+        EXPECT_EQ(zone_map.Min(), it->second.first);
+        EXPECT_EQ(zone_map.Max(), it->second.second);
+      }
+    }
+
+    for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+    gc.PerformGarbageCollection();
+    gc.PerformGarbageCollection();  // Second call to deallocate.
+    for (storage::col_id_t col_id : layout.AllColumns()) arrow_metadata.GetColumnInfo(layout, col_id).Deallocate();
     block_store_.Release(block);
   }
 }
 
+// Populates blocks with different numbers of empty slots and checks that the compaction policy only hands cold blocks
+// to the compactor, sparsest first and no more than its budget, and that it is more eager under memory pressure.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, CompactionPolicyTest) {
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(100, &generator_);
+  storage::TupleAccessStrategy accessor(layout);
+  // Technically, the blocks below are not "in" the table, but since we don't sequential scan that does not matter
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_), true, DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+
+  // Blocks 1 and 3 have the most empty slots
+  std::vector<storage::RawBlock *> blocks;
+  storage::AccessObserver observer;
+  for (double empty_ratio : {0.1, 0.6, 0.3, 0.8}) {
+    storage::RawBlock *block = block_store_.Get();
+    StorageTestUtil::PopulateBlockRandomlyNoBookkeeping(&table, block, empty_ratio, &generator_);
+    for (storage::col_id_t col_id : layout.AllColumns())
+      accessor.GetArrowBlockMetadata(block).GetColumnInfo(layout, col_id).Type() =
+          storage::ArrowColumnType::FIXED_LENGTH;
+    observer.ObserveWrite(block);
+    blocks.push_back(block);
+  }
+  EXPECT_EQ(observer.NumObservedBlocks(), blocks.size());
+
+  storage::BlockCompactor compactor;
+  storage::CompactionPolicy policy;
+  policy.cold_threshold_ = std::chrono::hours(1);
+  policy.pressured_cold_threshold_ = std::chrono::milliseconds(0);
+  policy.max_blocks_per_round_ = 2;
+  // Nothing has been cold for an hour
+  EXPECT_EQ(compactor.EnqueueColdBlocks(&observer, policy, common::ManagedPointer(&block_store_)), 0);
+
+  // Running out of memory makes every block cold, of which the two sparsest are compacted
+  policy.memory_pressure_ratio_ = 0.0;
+  EXPECT_EQ(compactor.EnqueueColdBlocks(&observer, policy, common::ManagedPointer(&block_store_)), 2);
+  std::vector<storage::RawBlock *> left_over = observer.ColdBlocks(std::chrono::milliseconds(0));
+  std::sort(left_over.begin(), left_over.end());
+  std::vector<storage::RawBlock *> expected{blocks[0], blocks[2]};
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(left_over, expected);
+
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+  for (uint32_t i : {1, 3}) EXPECT_EQ(blocks[i]->controller_.GetBlockState()->load(), storage::BlockState::COOLING);
+  for (uint32_t i : {0, 2}) EXPECT_EQ(blocks[i]->controller_.GetBlockState()->load(), storage::BlockState::HOT);
+
+  // The rest are compacted in the next round
+  policy.cold_threshold_ = std::chrono::milliseconds(0);
+  policy.memory_pressure_ratio_ = 1.0;
+  EXPECT_EQ(compactor.EnqueueColdBlocks(&observer, policy, DISABLED), 2);
+  EXPECT_EQ(observer.NumObservedBlocks(), 0);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+
+  const storage::CompactionStatistics statistics = compactor.GetStatistics();
+  EXPECT_EQ(statistics.blocks_enqueued_, blocks.size());
+  EXPECT_EQ(statistics.blocks_compacted_, blocks.size());
+  EXPECT_EQ(statistics.compactions_aborted_, 0);
+  EXPECT_EQ(statistics.blocks_frozen_, 0);
+
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate.
+  for (storage::RawBlock *block : blocks) block_store_.Release(block);
+}
+
+// Drops a table while the compactor works on its blocks, and checks that the access observer and the compactor let go
+// of the blocks before the table releases them, so that the compactor never touches them afterwards.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, DropTableWhileCompactingTest) {
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(100, &generator_);
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_), true, DISABLED};
+  storage::AccessObserver observer;
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               &observer};
+  storage::BlockCompactor compactor;
+  block_store_.RegisterReleaseListener(&observer);
+  block_store_.RegisterReleaseListener(&compactor);
+
+  // Fill whole blocks, so that the access observer picks them up once the GC has seen the inserts
+  auto *table = new storage::DataTable(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                                       storage::layout_version_t(0));
+  auto initializer =
+      storage::ProjectedRowInitializer::Create(layout, StorageTestUtil::ProjectionListAllColumns(layout));
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  storage::ProjectedRow *row = initializer.InitializeRow(buffer);
+  StorageTestUtil::PopulateRandomRow(row, layout, 0.0, &generator_);
+  auto *txn = txn_manager.BeginTransaction();
+  for (uint32_t i = 0; i < 10 * layout.NumSlots(); i++) table->Insert(common::ManagedPointer(txn), *row);
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  EXPECT_GT(observer.NumObservedBlocks(), 0);
+
+  storage::CompactionPolicy policy;
+  policy.cold_threshold_ = std::chrono::milliseconds(0);
+  std::atomic<bool> dropped{false};
+  std::thread compaction_thread([&] {
+    while (!dropped) {
+      compactor.EnqueueColdBlocks(&observer, policy, DISABLED);
+      compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+    }
+  });
+  // Let the compactor get some blocks to cooling while the GC puts them back into the queue, then drop the table the
+  // way the catalog does
+  for (uint32_t i = 0; i < 10; i++) gc.PerformGarbageCollection();
+  deferred_action_manager.RegisterDeferredAction([=]() { delete table; });
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  dropped = true;
+  compaction_thread.join();
+  EXPECT_EQ(block_store_.GetNumObjectsInUse(), 0);
+  EXPECT_EQ(observer.NumObservedBlocks(), 0);
+
+  // Nothing is left for the compactor to work on, including the blocks that were cooling when the table was dropped
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+  EXPECT_EQ(compactor.EnqueueColdBlocks(&observer, policy, DISABLED), 0);
+  const storage::CompactionStatistics statistics = compactor.GetStatistics();
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+  EXPECT_EQ(compactor.GetStatistics().blocks_frozen_, statistics.blocks_frozen_);
+  EXPECT_EQ(compactor.GetStatistics().freezes_postponed_, statistics.freezes_postponed_);
+
+  block_store_.UnregisterReleaseListener(&compactor);
+  block_store_.UnregisterReleaseListener(&observer);
+}
+
+// Freezes a block with a compressible column through a compactor that releases compressed columns to a swap file, and
+// checks that the raw values of the column are evicted while the tuples can still be read.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, ReleaseCompressedColumnsTest) {
+  const storage::BlockLayout layout({8, 8});
+  const storage::col_id_t col_id(1);
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_), true, DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+  // Only blocks placed in the arena of the evictor can be released to the swap file
+  storage::BlockEvictor evictor(SWAP_FILE_NAME, 100);
+  storage::BlockStore block_store(100, 100, storage::BlockPlacement::LOCAL, common::NumaUtil::NumNodes(), &evictor);
+  storage::BlockCompactor compactor(&evictor);
+  block_store.RegisterReleaseListener(&compactor);
+  block_store.RegisterReleaseListener(&evictor);
+
+  // Fill a block with a run of consecutive values, which compresses well
+  auto *table = new storage::DataTable(common::ManagedPointer<storage::BlockStore>(&block_store), layout,
+                                       storage::layout_version_t(0));
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, {col_id});
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  storage::ProjectedRow *row = initializer.InitializeRow(buffer);
+  auto *txn = txn_manager.BeginTransaction();
+  storage::RawBlock *block = nullptr;
+  for (uint32_t i = 0; i < layout.NumSlots(); i++) {
+    *reinterpret_cast<int64_t *>(row->AccessForceNotNull(0)) = i;
+    block = table->Insert(common::ManagedPointer(txn), *row).GetBlock();
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  storage::TupleAccessStrategy accessor(layout);
+  storage::ArrowBlockMetadata &metadata = accessor.GetArrowBlockMetadata(block);
+  metadata.GetColumnInfo(layout, col_id).Type() = storage::ArrowColumnType::FIXED_LENGTH;
+
+  // The block has no gaps, so it starts cooling right away and is frozen once the GC has put it back into the queue
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+  ASSERT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+  EXPECT_NE(metadata.GetColumnInfo(layout, col_id).Compressed().Encoding(), storage::ColumnEncoding::UNCOMPRESSED);
+  EXPECT_GT(compactor.GetStatistics().bytes_released_, 0);
+  EXPECT_TRUE(evictor.IsEvicted(block));
+
+  // Reads fault the raw values back in from the swap file
+  txn = txn_manager.BeginTransaction();
+  for (uint32_t i = 0; i < layout.NumSlots(); i++) {
+    EXPECT_TRUE(table->Select(common::ManagedPointer(txn), {block, i}, row));
+    EXPECT_EQ(*reinterpret_cast<int64_t *>(row->AccessWithNullCheck(0)), static_cast<int64_t>(i));
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+
+  // Dropping the table frees up the space of the block in the swap file
+  delete table;
+  EXPECT_EQ(evictor.NumEvictedBlocks(), 0);
+  block_store.UnregisterReleaseListener(&evictor);
+  block_store.UnregisterReleaseListener(&compactor);
+}
+
+// Freezes a block with a compressible column through a compactor without an evictor, and checks that the column is
+// not compressed, as the compressed copy would take up memory on top of the raw values.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, NoCompressionWithoutEvictorTest) {
+  const storage::BlockLayout layout({8, 8});
+  const storage::col_id_t col_id(1);
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_), true, DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+  storage::BlockCompactor compactor;
+  block_store_.RegisterReleaseListener(&compactor);
+
+  auto *table = new storage::DataTable(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                                       storage::layout_version_t(0));
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, {col_id});
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  storage::ProjectedRow *row = initializer.InitializeRow(buffer);
+  auto *txn = txn_manager.BeginTransaction();
+  storage::RawBlock *block = nullptr;
+  for (uint32_t i = 0; i < layout.NumSlots(); i++) {
+    *reinterpret_cast<int64_t *>(row->AccessForceNotNull(0)) = i;
+    block = table->Insert(common::ManagedPointer(txn), *row).GetBlock();
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  storage::TupleAccessStrategy accessor(layout);
+  storage::ArrowBlockMetadata &metadata = accessor.GetArrowBlockMetadata(block);
+  metadata.GetColumnInfo(layout, col_id).Type() = storage::ArrowColumnType::FIXED_LENGTH;
+
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+  ASSERT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+  EXPECT_EQ(metadata.GetColumnInfo(layout, col_id).Compressed().Encoding(), storage::ColumnEncoding::UNCOMPRESSED);
+  EXPECT_EQ(compactor.GetStatistics().bytes_released_, 0);
+
+  delete table;
+  block_store_.UnregisterReleaseListener(&compactor);
+}
+
 }  // namespace terrier
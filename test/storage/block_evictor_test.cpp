@@ -0,0 +1,244 @@
+#include "storage/block_evictor.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+#include "storage/block_access_controller.h"
+#include "storage/storage_defs.h"
+#include "storage/tuple_access_strategy.h"
+#include "test_util/storage_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_context.h"
+
+#define SWAP_FILE_NAME "test_evicted_blocks.swap"
+
+namespace terrier {
+
+struct BlockEvictorTest : public ::terrier::TerrierTest {
+  // The evictor must outlive the block store, which frees its blocks into it
+  storage::BlockEvictor evictor_{SWAP_FILE_NAME, 100};
+  storage::BlockStore block_store_{100, 100, storage::BlockPlacement::LOCAL, common::NumaUtil::NumNodes(), &evictor_};
+  storage::RecordBufferSegmentPool buffer_pool_{10000, 10000};
+  std::default_random_engine generator_;
+  const uint32_t num_blocks_ = 10;
+  const double percent_empty_ = 0.1;
+
+  // Checks that every tuple in the reference can be read from the table, and that the rest of the slots are empty
+  void CheckTuples(storage::DataTable *table, const std::vector<storage::RawBlock *> &blocks,
+                   const std::unordered_map<storage::TupleSlot, storage::ProjectedRow *> &tuples) {
+    const storage::BlockLayout &layout = table->GetBlockLayout();
+    auto initializer =
+        storage::ProjectedRowInitializer::Create(layout, StorageTestUtil::ProjectionListAllColumns(layout));
+    byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *read_row = initializer.InitializeRow(buffer);
+    transaction::TransactionContext txn(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                        common::ManagedPointer(&buffer_pool_), DISABLED);
+    for (storage::RawBlock *block : blocks) {
+      for (uint32_t i = 0; i < layout.NumSlots(); i++) {
+        storage::TupleSlot slot(block, i);
+        const bool visible = table->Select(common::ManagedPointer(&txn), slot, read_row);
+        auto it = tuples.find(slot);
+        EXPECT_EQ(visible, it != tuples.end());
+        if (visible && it != tuples.end()) {
+          EXPECT_TRUE(StorageTestUtil::ProjectionListEqualDeep(layout, it->second, read_row));
+        }
+      }
+    }
+    delete[] buffer;
+  }
+};
+
+// Populates blocks randomly and freezes them, then evicts them and checks that the contents of the table, including
+// the header of every block, can still be read. Then restores the blocks and checks the same.
+// NOLINTNEXTLINE
+TEST_F(BlockEvictorTest, EvictAndRestore) {
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutWithVarlens(100, &generator_);
+  storage::TupleAccessStrategy accessor(layout);
+  // Technically, the blocks below are not "in" the table, but since we don't sequential scan that does not matter
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  std::vector<storage::RawBlock *> blocks;
+  std::unordered_map<storage::TupleSlot, storage::ProjectedRow *> tuples;
+  for (uint32_t i = 0; i < num_blocks_; i++) {
+    storage::RawBlock *block = block_store_.Get();
+    accessor.InitializeRawBlock(&table, block, storage::layout_version_t(0));
+    tuples.merge(StorageTestUtil::PopulateBlockRandomly(&table, block, percent_empty_, &generator_));
+    // Tests are allowed to skip the compactor and freeze blocks directly
+    block->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+    blocks.push_back(block);
+  }
+
+  for (storage::RawBlock *block : blocks) {
+    EXPECT_TRUE(evictor_.Evict(block));
+    EXPECT_TRUE(evictor_.IsEvicted(block));
+    EXPECT_EQ(block->data_table_, &table);
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+  }
+  EXPECT_EQ(evictor_.NumEvictedBlocks(), num_blocks_);
+  CheckTuples(&table, blocks, tuples);
+
+  // Evicting again writes the blocks out once more
+  for (storage::RawBlock *block : blocks) EXPECT_TRUE(evictor_.Evict(block));
+  EXPECT_EQ(evictor_.NumEvictedBlocks(), num_blocks_);
+  CheckTuples(&table, blocks, tuples);
+
+  for (storage::RawBlock *block : blocks) {
+    EXPECT_TRUE(evictor_.Restore(block));
+    EXPECT_FALSE(evictor_.IsEvicted(block));
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+  }
+  EXPECT_EQ(evictor_.NumEvictedBlocks(), 0);
+  CheckTuples(&table, blocks, tuples);
+
+  for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+  for (storage::RawBlock *block : blocks) {
+    storage::StorageUtil::DeallocateVarlens(block, accessor);
+    block_store_.Release(block);
+  }
+}
+
+// Checks that blocks that are not frozen are not evicted, and that evicted blocks can be written to after they are
+// thawed by a writer.
+// NOLINTNEXTLINE
+TEST_F(BlockEvictorTest, OnlyEvictFrozenBlocks) {
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(100, &generator_);
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  storage::RawBlock *block = block_store_.Get();
+  accessor.InitializeRawBlock(&table, block, storage::layout_version_t(0));
+  auto tuples = StorageTestUtil::PopulateBlockRandomly(&table, block, percent_empty_, &generator_);
+
+  for (auto state : {storage::BlockState::HOT, storage::BlockState::COOLING, storage::BlockState::FREEZING}) {
+    block->controller_.GetBlockState()->store(state);
+    EXPECT_FALSE(evictor_.Evict(block));
+    EXPECT_FALSE(evictor_.IsEvicted(block));
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), state);
+  }
+
+  block->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+  EXPECT_TRUE(evictor_.Evict(block));
+
+  // A writer thaws the block and overwrites a tuple with the contents of another
+  ASSERT_GE(tuples.size(), 2);
+  auto overwritten = tuples.begin();
+  auto source = std::next(overwritten);
+  block->controller_.WaitUntilHot();
+  EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::HOT);
+  for (uint16_t i = 0; i < source->second->NumColumns(); i++)
+    storage::StorageUtil::CopyAttrFromProjection(accessor, overwritten->first, *source->second, i);
+  std::memcpy(overwritten->second, source->second, source->second->Size());
+  EXPECT_FALSE(evictor_.Evict(block));
+  CheckTuples(&table, {block}, tuples);
+
+  // The block cannot be restored while writers may be at it, but keeps the written pages once it is frozen again
+  EXPECT_FALSE(evictor_.Restore(block));
+  EXPECT_TRUE(evictor_.IsEvicted(block));
+  block->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+  EXPECT_TRUE(evictor_.Restore(block));
+  EXPECT_FALSE(evictor_.IsEvicted(block));
+  CheckTuples(&table, {block}, tuples);
+
+  for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+  block_store_.Release(block);
+}
+
+// Evicts blocks and releases them the way a table does when it is dropped, and checks that the evictor frees up their
+// space in the swap file, while the blocks can be handed out again and evicted anew.
+// NOLINTNEXTLINE
+TEST_F(BlockEvictorTest, ReleaseEvictedBlocks) {
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(100, &generator_);
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  block_store_.RegisterReleaseListener(&evictor_);
+
+  std::vector<storage::RawBlock *> blocks;
+  for (uint32_t i = 0; i < num_blocks_; i++) {
+    storage::RawBlock *block = block_store_.Get();
+    accessor.InitializeRawBlock(&table, block, storage::layout_version_t(0));
+    auto tuples = StorageTestUtil::PopulateBlockRandomly(&table, block, percent_empty_, &generator_);
+    for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+    block->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+    EXPECT_TRUE(evictor_.Evict(block));
+    blocks.push_back(block);
+  }
+  // Keep one block that is not evicted, which the evictor leaves alone
+  EXPECT_TRUE(evictor_.Restore(blocks.back()));
+  EXPECT_EQ(evictor_.NumEvictedBlocks(), num_blocks_ - 1);
+
+  block_store_.Release(blocks);
+  EXPECT_EQ(evictor_.NumEvictedBlocks(), 0);
+
+  // Released blocks are handed out again. Writes to them make private copies of the pages, and do not go to the swap
+  // file until the blocks are evicted again.
+  storage::RawBlock *reused = block_store_.Get();
+  accessor.InitializeRawBlock(&table, reused, storage::layout_version_t(0));
+  auto tuples = StorageTestUtil::PopulateBlockRandomly(&table, reused, percent_empty_, &generator_);
+  reused->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+  EXPECT_TRUE(evictor_.Evict(reused));
+  CheckTuples(&table, {reused}, tuples);
+  EXPECT_TRUE(evictor_.Restore(reused));
+  CheckTuples(&table, {reused}, tuples);
+
+  for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+  block_store_.UnregisterReleaseListener(&evictor_);
+  block_store_.Release(reused);
+}
+
+// Evicts parts of more blocks than a process may have memory mappings by default, and checks that they can all still
+// be read. Blocks are evicted within a single mapping of the swap file, so the limit does not apply. Blocks the arena of
+// the evictor has no room for are placed on the heap, and are not evicted.
+// NOLINTNEXTLINE
+TEST_F(BlockEvictorTest, EvictMoreBlocksThanMappingLimit) {
+  // Default of vm.max_map_count on Linux, unless the limit of this machine is lower
+  uint64_t max_map_count = 65530;
+  std::ifstream limit_file("/proc/sys/vm/max_map_count");
+  uint64_t limit;
+  if (limit_file >> limit) max_map_count = std::min(max_map_count, limit);
+  const uint64_t num_blocks = max_map_count + 1;
+
+  storage::BlockEvictor evictor(SWAP_FILE_NAME, num_blocks);
+  storage::BlockStore block_store(num_blocks + 1, 0, storage::BlockPlacement::LOCAL, common::NumaUtil::NumNodes(),
+                                  &evictor);
+  block_store.RegisterReleaseListener(&evictor);
+  const auto page_size = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+
+  std::vector<storage::RawBlock *> blocks;
+  for (uint64_t i = 0; i < num_blocks; i++) {
+    storage::RawBlock *block = block_store.Get();
+    EXPECT_TRUE(evictor.Contains(block));
+    block->controller_.Initialize();
+    block->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+    // Only the second page of every block is written, which keeps the swap file small
+    *reinterpret_cast<uint64_t *>(reinterpret_cast<byte *>(block) + page_size) = i;
+    ASSERT_EQ(evictor.EvictRanges(block, {{page_size, 2 * page_size}}), page_size);
+    blocks.push_back(block);
+  }
+  EXPECT_EQ(evictor.NumEvictedBlocks(), num_blocks);
+  for (uint64_t i = 0; i < num_blocks; i++) {
+    EXPECT_TRUE(evictor.IsEvicted(blocks[i]));
+    EXPECT_EQ(*reinterpret_cast<uint64_t *>(reinterpret_cast<byte *>(blocks[i]) + page_size), i);
+  }
+
+  storage::RawBlock *heap_block = block_store.Get();
+  EXPECT_FALSE(evictor.Contains(heap_block));
+  heap_block->controller_.Initialize();
+  heap_block->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+  EXPECT_FALSE(evictor.Evict(heap_block));
+  EXPECT_EQ(evictor.EvictRanges(heap_block, {{page_size, 2 * page_size}}), 0);
+  EXPECT_FALSE(evictor.IsEvicted(heap_block));
+
+  blocks.push_back(heap_block);
+  block_store.Release(blocks);
+  EXPECT_EQ(evictor.NumEvictedBlocks(), 0);
+  block_store.UnregisterReleaseListener(&evictor);
+}
+
+}  // namespace terrier
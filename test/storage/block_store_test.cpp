@@ -0,0 +1,94 @@
+#include <vector>
+
+#include "common/numa.h"
+#include "storage/storage_defs.h"
+#include "test_util/test_harness.h"
+
+namespace terrier {
+
+struct BlockStoreTests : public TerrierTest {};
+
+// The topology of the machine is read correctly enough for the calling thread to be on one of its nodes
+// NOLINTNEXTLINE
+TEST_F(BlockStoreTests, NumaTopology) {
+  EXPECT_GE(common::NumaUtil::NumNodes(), 1);
+  EXPECT_LT(common::NumaUtil::CurrentNode(), common::NumaUtil::NumNodes());
+  {
+    common::NumaUtil::ScopedNodeBinding binding(common::NumaUtil::NumNodes() - 1);
+    EXPECT_LT(common::NumaUtil::CurrentNode(), common::NumaUtil::NumNodes());
+  }
+}
+
+// Interleaved blocks alternate between nodes, and every node hands out its share of the limit before spilling over
+// NOLINTNEXTLINE
+TEST_F(BlockStoreTests, InterleavedPlacement) {
+  storage::BlockStore block_store(6, 6, storage::BlockPlacement::INTERLEAVED, 2);
+  EXPECT_EQ(block_store.NumNodes(), 2);
+  EXPECT_EQ(block_store.InsertionNode(), common::NumaUtil::ANY_NODE);
+
+  std::vector<storage::RawBlock *> blocks;
+  for (uint32_t i = 0; i < 4; i++) {
+    blocks.push_back(block_store.Get());
+    EXPECT_EQ(blocks.back()->numa_node_, i % 2);
+  }
+
+  // Node 1 has one block left, after which asking for it spills over to node 0
+  blocks.push_back(block_store.Get(1));
+  EXPECT_EQ(blocks.back()->numa_node_, 1);
+  blocks.push_back(block_store.Get(1));
+  EXPECT_EQ(blocks.back()->numa_node_, 0);
+  EXPECT_EQ(block_store.GetNumObjectsInUse(), 6);
+  EXPECT_THROW(block_store.Get(), common::NoMoreObjectException);
+
+  // Released blocks go back to the pool of their node, which can then hand them out again
+  block_store.Release(blocks[1]);
+  EXPECT_EQ(block_store.GetNumObjectsInUse(), 5);
+  blocks[1] = block_store.Get(1);
+  EXPECT_EQ(blocks[1]->numa_node_, 1);
+
+  for (storage::RawBlock *block : blocks) block_store.Release(block);
+  EXPECT_EQ(block_store.GetNumObjectsInUse(), 0);
+}
+
+// The size limit cannot be lowered below the number of blocks in use, and a failed attempt leaves the limit unchanged
+// NOLINTNEXTLINE
+TEST_F(BlockStoreTests, SizeLimit) {
+  storage::BlockStore block_store(4, 4, storage::BlockPlacement::LOCAL, 2);
+  std::vector<storage::RawBlock *> blocks;
+  for (uint32_t i = 0; i < 3; i++) blocks.push_back(block_store.Get(0));
+  EXPECT_EQ(block_store.GetNumObjectsInUse(), 3);
+
+  EXPECT_FALSE(block_store.SetSizeLimit(2));
+  EXPECT_EQ(block_store.GetSizeLimit(), 4);
+  blocks.push_back(block_store.Get(0));
+  EXPECT_THROW(block_store.Get(0), common::NoMoreObjectException);
+
+  for (storage::RawBlock *block : blocks) block_store.Release(block);
+  EXPECT_TRUE(block_store.SetSizeLimit(8));
+  EXPECT_EQ(block_store.GetSizeLimit(), 8);
+  blocks.clear();
+  for (uint32_t i = 0; i < 8; i++) blocks.push_back(block_store.Get());
+  EXPECT_THROW(block_store.Get(), common::NoMoreObjectException);
+  for (storage::RawBlock *block : blocks) block_store.Release(block);
+}
+
+// A node that blocks spilled over to can hold more than its share of a lowered size limit, as long as the total fits
+// NOLINTNEXTLINE
+TEST_F(BlockStoreTests, SizeLimitAfterSpill) {
+  storage::BlockStore block_store(6, 6, storage::BlockPlacement::LOCAL, 2);
+  std::vector<storage::RawBlock *> blocks;
+  for (uint32_t i = 0; i < 4; i++) blocks.push_back(block_store.Get(1));
+  EXPECT_EQ(blocks.back()->numa_node_, 0);
+
+  // Node 1 holds three blocks, more than its share of the new limit, which node 0 makes up for
+  EXPECT_FALSE(block_store.SetSizeLimit(3));
+  EXPECT_TRUE(block_store.SetSizeLimit(5));
+  EXPECT_EQ(block_store.GetSizeLimit(), 5);
+  blocks.push_back(block_store.Get(1));
+  EXPECT_EQ(blocks.back()->numa_node_, 0);
+  EXPECT_THROW(block_store.Get(), common::NoMoreObjectException);
+
+  for (storage::RawBlock *block : blocks) block_store.Release(block);
+}
+
+}  // namespace terrier
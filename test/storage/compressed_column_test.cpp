@@ -0,0 +1,106 @@
+#include "storage/compressed_column.h"
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "common/allocator.h"
+#include "test_util/test_harness.h"
+
+namespace terrier {
+
+struct CompressedColumnTests : public TerrierTest {
+  std::default_random_engine generator_;
+
+  // Decodes random ranges of the column, as well as the whole of it, and checks that they match the original values
+  template <class T>
+  void CheckDecode(const storage::CompressedColumn &column, const std::vector<int64_t> &values) {
+    ASSERT_EQ(column.NumValues(), values.size());
+    byte *buffer = common::AllocationUtil::AllocateAligned(values.size() * sizeof(T));
+    auto *decoded = reinterpret_cast<T *>(buffer);
+    column.Decode(0, static_cast<uint32_t>(values.size()), sizeof(T), buffer);
+    for (uint32_t i = 0; i < values.size(); i++) EXPECT_EQ(decoded[i], static_cast<T>(values[i]));
+
+    std::uniform_int_distribution<uint32_t> start_dist(0, static_cast<uint32_t>(values.size() - 1));
+    for (uint32_t iteration = 0; iteration < 100; iteration++) {
+      const uint32_t start = start_dist(generator_);
+      std::uniform_int_distribution<uint32_t> count_dist(1, static_cast<uint32_t>(values.size()) - start);
+      const uint32_t count = count_dist(generator_);
+      column.Decode(start, count, sizeof(T), buffer);
+      for (uint32_t i = 0; i < count; i++) EXPECT_EQ(decoded[i], static_cast<T>(values[start + i]));
+    }
+    delete[] buffer;
+  }
+};
+
+// Values in a narrow range that are in no particular order are bit-packed relative to their minimum
+// NOLINTNEXTLINE
+TEST_F(CompressedColumnTests, FrameOfReference) {
+  std::uniform_int_distribution<int64_t> dist(-1000000, -1000000 + 4095);
+  std::vector<int64_t> values;
+  for (uint32_t i = 0; i < 5000; i++) values.push_back(dist(generator_));
+  storage::CompressedColumn column = storage::CompressedColumn::Encode(values, sizeof(int64_t));
+  EXPECT_EQ(column.Encoding(), storage::ColumnEncoding::FRAME_OF_REFERENCE);
+  EXPECT_LT(column.Size(), values.size() * sizeof(int64_t) / 4);
+  CheckDecode<int64_t>(column, values);
+}
+
+// Sorted values with small gaps between them are bit-packed as differences, across several checkpoints
+// NOLINTNEXTLINE
+TEST_F(CompressedColumnTests, Delta) {
+  std::uniform_int_distribution<int64_t> dist(1, 10);
+  std::vector<int64_t> values{std::numeric_limits<int32_t>::min()};
+  for (uint32_t i = 1; i < 5 * storage::CompressedColumn::DELTA_CHECKPOINT_INTERVAL + 7; i++)
+    values.push_back(values.back() + dist(generator_));
+  storage::CompressedColumn column = storage::CompressedColumn::Encode(values, sizeof(int32_t));
+  EXPECT_EQ(column.Encoding(), storage::ColumnEncoding::DELTA);
+  CheckDecode<int32_t>(column, values);
+}
+
+// Long runs of repeated values are stored once per run
+// NOLINTNEXTLINE
+TEST_F(CompressedColumnTests, RunLength) {
+  std::uniform_int_distribution<int64_t> value_dist(std::numeric_limits<int16_t>::min(),
+                                                    std::numeric_limits<int16_t>::max());
+  std::uniform_int_distribution<uint32_t> length_dist(50, 200);
+  std::vector<int64_t> values;
+  while (values.size() < 10000) values.insert(values.end(), length_dist(generator_), value_dist(generator_));
+  storage::CompressedColumn column = storage::CompressedColumn::Encode(values, sizeof(int16_t));
+  EXPECT_EQ(column.Encoding(), storage::ColumnEncoding::RUN_LENGTH);
+  CheckDecode<int16_t>(column, values);
+
+  // A constant column takes up no more space than a single run, whichever encoding is picked
+  values.assign(values.size(), -3);
+  column = storage::CompressedColumn::Encode(values, sizeof(int8_t));
+  EXPECT_LE(column.Size(), sizeof(int64_t) + sizeof(uint32_t));
+  CheckDecode<int8_t>(column, values);
+}
+
+// Values spread over the whole domain of a column cannot be stored in less space, and are left uncompressed
+// NOLINTNEXTLINE
+TEST_F(CompressedColumnTests, Incompressible) {
+  std::uniform_int_distribution<int64_t> dist(std::numeric_limits<int64_t>::min(),
+                                              std::numeric_limits<int64_t>::max());
+  std::vector<int64_t> values;
+  for (uint32_t i = 0; i < 1000; i++) values.push_back(dist(generator_));
+  storage::CompressedColumn column = storage::CompressedColumn::Encode(values, sizeof(int64_t));
+  EXPECT_EQ(column.Encoding(), storage::ColumnEncoding::UNCOMPRESSED);
+  EXPECT_EQ(column.Release(), nullptr);
+
+  column = storage::CompressedColumn::Encode({}, sizeof(int64_t));
+  EXPECT_EQ(column.Encoding(), storage::ColumnEncoding::UNCOMPRESSED);
+}
+
+// The buffer of a released column belongs to the caller, and the column is uncompressed afterwards
+// NOLINTNEXTLINE
+TEST_F(CompressedColumnTests, Release) {
+  std::vector<int64_t> values(1000, 42);
+  storage::CompressedColumn column = storage::CompressedColumn::Encode(values, sizeof(int32_t));
+  ASSERT_NE(column.Encoding(), storage::ColumnEncoding::UNCOMPRESSED);
+  const byte *buffer = column.Release();
+  EXPECT_NE(buffer, nullptr);
+  EXPECT_EQ(column.Encoding(), storage::ColumnEncoding::UNCOMPRESSED);
+  delete[] buffer;
+}
+
+}  // namespace terrier
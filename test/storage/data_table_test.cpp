@@ -1,12 +1,18 @@
 #include "storage/data_table.h"
 
 #include <cstring>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/numa.h"
 #include "common/object_pool.h"
+#include "execution/sql/vector_projection.h"
+#include "storage/block_access_controller.h"
+#include "storage/compressed_column.h"
 #include "storage/storage_util.h"
+#include "storage/varlen_arena.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
 #include "transaction/transaction_context.h"
@@ -71,7 +77,8 @@ class RandomDataTableTestObject {
   // be sure to only update tuple incrementally (cannot go back in time)
   template <class Random>
   bool RandomlyUpdateTuple(const transaction::timestamp_t timestamp, const storage::TupleSlot slot, Random *generator,
-                           storage::RecordBufferSegmentPool *buffer_pool) {
+                           storage::RecordBufferSegmentPool *buffer_pool,
+                           const transaction::timestamp_t prune_horizon = transaction::INITIAL_TXN_TIMESTAMP) {
     // tuple must already exist
     TERRIER_ASSERT(tuple_versions_.find(slot) != tuple_versions_.end(), "Slot not found.");
 
@@ -84,8 +91,8 @@ class RandomDataTableTestObject {
     StorageTestUtil::PopulateRandomRow(update, layout_, null_bias_, generator);
 
     // generate a txn with an UndoRecord to populate on Insert
-    auto *txn =
-        new transaction::TransactionContext(timestamp, timestamp, common::ManagedPointer(buffer_pool), DISABLED);
+    auto *txn = new transaction::TransactionContext(timestamp, timestamp, common::ManagedPointer(buffer_pool), DISABLED,
+                                                    prune_horizon);
     loose_txns_.push_back(txn);
 
     bool result = table_.Update(common::ManagedPointer(txn), slot, *update);
@@ -123,11 +130,13 @@ class RandomDataTableTestObject {
     return nullptr;
   }
 
-  storage::ProjectedRow *SelectIntoBuffer(const storage::TupleSlot slot, const transaction::timestamp_t timestamp,
-                                          storage::RecordBufferSegmentPool *buffer_pool) {
+  storage::ProjectedRow *SelectIntoBuffer(
+      const storage::TupleSlot slot, const transaction::timestamp_t timestamp,
+      storage::RecordBufferSegmentPool *buffer_pool,
+      const transaction::timestamp_t prune_horizon = transaction::INITIAL_TXN_TIMESTAMP) {
     // generate a txn with an UndoRecord to populate on Insert
-    auto *txn =
-        new transaction::TransactionContext(timestamp, timestamp, common::ManagedPointer(buffer_pool), DISABLED);
+    auto *txn = new transaction::TransactionContext(timestamp, timestamp, common::ManagedPointer(buffer_pool), DISABLED,
+                                                    prune_horizon);
     loose_txns_.push_back(txn);
 
     // generate a redo ProjectedRow for Select
@@ -167,6 +176,43 @@ struct DataTableTests : public TerrierTest {
   storage::RecordBufferSegmentPool buffer_pool_{500000, 50000};
   std::default_random_engine generator_;
   std::uniform_real_distribution<double> null_ratio_{0.0, 1.0};
+
+  // Creates a vector projection that holds all columns of the given layout
+  static void InitializeVectorProjection(const storage::BlockLayout &layout,
+                                         execution::sql::VectorProjection *vector_projection) {
+    std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+    std::vector<execution::sql::TypeId> col_types;
+    for (const storage::col_id_t col_id : all_cols) {
+      switch (layout.AttrSize(col_id)) {
+        case 1:
+          col_types.push_back(execution::sql::TypeId::TinyInt);
+          break;
+        case 2:
+          col_types.push_back(execution::sql::TypeId::SmallInt);
+          break;
+        case 4:
+          col_types.push_back(execution::sql::TypeId::Integer);
+          break;
+        default:
+          col_types.push_back(execution::sql::TypeId::BigInt);
+      }
+    }
+    vector_projection->SetStorageColIds(all_cols);
+    vector_projection->Initialize(col_types);
+  }
+
+  // Freezes a full block the way the block compactor would leave it, without gathering or compressing anything
+  static void FreezeBlock(const storage::TupleAccessStrategy &accessor, storage::RawBlock *block) {
+    const storage::BlockLayout &layout = accessor.GetBlockLayout();
+    storage::ArrowBlockMetadata &metadata = accessor.GetArrowBlockMetadata(block);
+    metadata.NumRecords() = layout.NumSlots();
+    for (const storage::col_id_t col_id : layout.AllColumns()) {
+      metadata.NullCount(col_id) = 0;
+      for (uint32_t i = 0; i < layout.NumSlots(); i++)
+        if (accessor.IsNull({block, i}, col_id)) metadata.NullCount(col_id)++;
+    }
+    block->controller_.GetBlockState()->store(storage::BlockState::FROZEN);
+  }
 };
 
 // Generates a random table layout and coin flip bias for an attribute being null, inserts num_inserts random tuples
@@ -289,6 +335,107 @@ TEST_F(DataTableTests, SimpleSequentialScanBlocks) {
   }
 }
 
+// Fills a few blocks with random tuples and freezes some of them. Checks that a vectorized scan consults the block
+// filter only for frozen blocks, and skips exactly the blocks the filter rejects.
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, ScanSkipsFilteredFrozenBlocks) {
+  const uint32_t num_blocks = 4;
+  RandomDataTableTestObject tested(&block_store_, 10, null_ratio_(generator_), &generator_);
+  const storage::BlockLayout &layout = tested.Layout();
+  for (uint32_t i = 0; i < num_blocks * layout.NumSlots(); ++i)
+    tested.InsertRandomTuple(transaction::timestamp_t(0), &generator_, &buffer_pool_);
+  ASSERT_EQ(tested.GetTable().GetNumBlocks(), num_blocks);
+
+  // Blocks 0, 1 and 3 are frozen, of which block 1 is rejected by the filter
+  storage::TupleAccessStrategy accessor(layout);
+  std::vector<storage::RawBlock *> blocks;
+  for (uint32_t i = 0; i < num_blocks; i++) blocks.push_back(tested.InsertedTuples()[i * layout.NumSlots()].GetBlock());
+  for (uint32_t i : {0, 1, 3}) FreezeBlock(accessor, blocks[i]);
+  uint32_t num_filter_calls = 0;
+  const storage::DataTable::FrozenBlockFilter block_filter = [&](const storage::ArrowBlockMetadata &metadata) {
+    num_filter_calls++;
+    return &metadata != &accessor.GetArrowBlockMetadata(blocks[1]);
+  };
+
+  execution::sql::VectorProjection vector_projection;
+  InitializeVectorProjection(layout, &vector_projection);
+
+  transaction::TransactionContext txn(transaction::timestamp_t(1), transaction::timestamp_t(1),
+                                      common::ManagedPointer(&buffer_pool_), DISABLED);
+  std::unordered_map<storage::RawBlock *, uint32_t> num_scanned;
+  auto it = tested.GetTable().begin();
+  while (it != tested.GetTable().end()) {
+    tested.GetTable().Scan(common::ManagedPointer(&txn), &it, &vector_projection, block_filter);
+    for (uint32_t i = 0; i < vector_projection.GetTotalTupleCount(); i++)
+      num_scanned[vector_projection.GetTupleSlot(i).GetBlock()]++;
+  }
+
+  EXPECT_EQ(num_filter_calls, 3);
+  EXPECT_EQ(num_scanned.count(blocks[1]), 0);
+  for (uint32_t i : {0, 2, 3}) EXPECT_EQ(num_scanned[blocks[i]], layout.NumSlots());
+}
+
+// Fills a few blocks with random tuples, freezes all but the last one and compresses some of their columns. Checks that
+// a vectorized scan, which copies frozen blocks in bulk, reads the same tuples as selecting them one by one.
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, ScanFrozenBlocks) {
+  const uint32_t num_blocks = 3;
+  RandomDataTableTestObject tested(&block_store_, 10, null_ratio_(generator_), &generator_);
+  const storage::BlockLayout &layout = tested.Layout();
+  for (uint32_t i = 0; i < (num_blocks - 1) * layout.NumSlots() + layout.NumSlots() / 2; ++i)
+    tested.InsertRandomTuple(transaction::timestamp_t(0), &generator_, &buffer_pool_);
+  ASSERT_EQ(tested.GetTable().GetNumBlocks(), num_blocks);
+
+  storage::TupleAccessStrategy accessor(layout);
+  for (uint32_t i = 0; i < num_blocks - 1; i++) {
+    storage::RawBlock *block = tested.InsertedTuples()[i * layout.NumSlots()].GetBlock();
+    FreezeBlock(accessor, block);
+    // Overwrite every other column with a few distinct values, so that there is something to compress
+    for (const storage::col_id_t col_id : layout.AllColumns()) {
+      if (col_id.UnderlyingValue() % 2 == 0) continue;
+      std::vector<int64_t> values;
+      for (uint32_t slot = 0; slot < layout.NumSlots(); slot++) {
+        values.push_back(slot / 100);
+        byte *value = accessor.AccessWithoutNullCheck({block, slot}, col_id);
+        std::memcpy(value, &values.back(), layout.AttrSize(col_id));  // little-endian, and values are small
+      }
+      storage::ArrowColumnInfo &col_info = accessor.GetArrowBlockMetadata(block).GetColumnInfo(layout, col_id);
+      col_info.Compressed() = storage::CompressedColumn::Encode(values, static_cast<uint8_t>(layout.AttrSize(col_id)));
+      EXPECT_NE(col_info.Compressed().Encoding(), storage::ColumnEncoding::UNCOMPRESSED);
+    }
+  }
+
+  execution::sql::VectorProjection vector_projection;
+  InitializeVectorProjection(layout, &vector_projection);
+  auto initializer =
+      storage::ProjectedRowInitializer::Create(layout, StorageTestUtil::ProjectionListAllColumns(layout));
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  storage::ProjectedRow *expected = initializer.InitializeRow(buffer);
+
+  transaction::TransactionContext txn(transaction::timestamp_t(1), transaction::timestamp_t(1),
+                                      common::ManagedPointer(&buffer_pool_), DISABLED);
+  uint32_t num_scanned = 0;
+  auto it = tested.GetTable().begin();
+  while (it != tested.GetTable().end()) {
+    tested.GetTable().Scan(common::ManagedPointer(&txn), &it, &vector_projection);
+    for (uint32_t row = 0; row < vector_projection.GetTotalTupleCount(); row++, num_scanned++) {
+      const storage::TupleSlot slot = vector_projection.GetTupleSlot(row);
+      EXPECT_TRUE(tested.GetTable().Select(common::ManagedPointer(&txn), slot, expected));
+      for (uint16_t i = 0; i < expected->NumColumns(); i++) {
+        const execution::sql::Vector *column = vector_projection.GetColumn(i);
+        const byte *value = expected->AccessWithNullCheck(i);
+        EXPECT_EQ(column->IsNull(row), value == nullptr);
+        if (value == nullptr) continue;
+        const uint16_t attr_size = layout.AttrSize(expected->ColumnIds()[i]);
+        EXPECT_EQ(std::memcmp(column->GetData() + row * attr_size, value, attr_size), 0);
+      }
+    }
+  }
+  EXPECT_EQ(num_scanned, tested.InsertedTuples().size());
+
+  delete[] buffer;
+}
+
 // Generates a random table layout and coin flip bias for an attribute being null, inserts 1 random tuple into an empty
 // DataTable. Then, randomly updates the tuple num_updates times. Finally, Selects at each timestamp to verify that the
 // delta chain produces the correct tuple. Repeats for num_iterations.
@@ -322,6 +469,48 @@ TEST_F(DataTableTests, SimpleVersionChain) {
   }
 }
 
+// Generates a random table layout and coin flip bias for an attribute being null, inserts 1 random tuple into an empty
+// DataTable and randomly updates it num_updates times. Then, either updates or selects the tuple once more with a
+// transaction that knows no transaction older than prune_horizon is alive, which should cut the version chain without
+// the GC's help. Selects at timestamps older than the horizon, which the test is free to do in violation of MVCC, can
+// then only reconstruct the version right before it, while newer versions are still intact. Repeats for num_iterations.
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, InlineVersionChainPruning) {
+  const uint32_t num_iterations = 50;
+  const uint32_t num_updates = 5;
+  const uint16_t max_columns = 100;
+  const transaction::timestamp_t prune_horizon(3);
+
+  for (uint32_t iteration = 0; iteration < num_iterations; ++iteration) {
+    for (const bool prune_on_read : {false, true}) {
+      RandomDataTableTestObject tested(&block_store_, max_columns, null_ratio_(generator_), &generator_);
+      transaction::timestamp_t timestamp(0);
+      storage::TupleSlot tuple = tested.InsertRandomTuple(timestamp++, &generator_, &buffer_pool_);
+      for (uint32_t i = 0; i < num_updates; ++i)
+        EXPECT_TRUE(tested.RandomlyUpdateTuple(timestamp++, tuple, &generator_, &buffer_pool_));
+
+      // Nothing is pruned yet, so the oldest version is still there
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(
+          tested.Layout(), tested.GetReferenceVersionedTuple(tuple, transaction::timestamp_t(0)),
+          tested.SelectIntoBuffer(tuple, transaction::timestamp_t(0), &buffer_pool_)));
+
+      if (prune_on_read) {
+        tested.SelectIntoBuffer(tuple, timestamp, &buffer_pool_, prune_horizon);
+      } else {
+        EXPECT_TRUE(tested.RandomlyUpdateTuple(timestamp++, tuple, &generator_, &buffer_pool_, prune_horizon));
+      }
+
+      const storage::ProjectedRow *oldest_kept = tested.GetReferenceVersionedTuple(tuple, prune_horizon - 1);
+      for (transaction::timestamp_t i(0); i < timestamp; i++) {
+        const storage::ProjectedRow *reference_version =
+            i < prune_horizon ? oldest_kept : tested.GetReferenceVersionedTuple(tuple, i);
+        storage::ProjectedRow *stored_version = tested.SelectIntoBuffer(tuple, i, &buffer_pool_);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), reference_version, stored_version));
+      }
+    }
+  }
+}
+
 // Generates a random table layout and coin flip bias for an attribute being null, inserts 1 random tuple into an empty
 // DataTable. Then, randomly updates the tuple with a negative timestamp, representing an uncommitted transaction. Then
 // a second update attempts to change the tuple and should fail. Then, the first transaction's timestamp is updated to a
@@ -348,6 +537,144 @@ TEST_F(DataTableTests, WriteWriteConflictUpdateFails) {
   }
 }
 
+// Inserts a batch of random tuples, spanning several blocks, into a table that already holds some tuples. Checks that
+// every tuple lands in the next free slot and reads back the same as was inserted.
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, InsertBatch) {
+  const uint32_t num_iterations = 10;
+  const uint16_t max_columns = 20;
+  for (uint32_t iteration = 0; iteration < num_iterations; ++iteration) {
+    RandomDataTableTestObject tested(&block_store_, max_columns, null_ratio_(generator_), &generator_);
+    const storage::BlockLayout &layout = tested.Layout();
+    // Start the batch in the middle of a block
+    const uint32_t num_existing = std::uniform_int_distribution<uint32_t>(0, layout.NumSlots() - 1)(generator_);
+    for (uint32_t i = 0; i < num_existing; ++i)
+      tested.InsertRandomTuple(transaction::timestamp_t(0), &generator_, &buffer_pool_);
+
+    // Generate the batch row by row
+    const uint32_t num_inserts = 2 * layout.NumSlots() + 1;
+    std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+    storage::ProjectedColumnsInitializer initializer(layout, all_cols, num_inserts);
+    auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+    storage::ProjectedColumns *columns = initializer.Initialize(buffer);
+    columns->SetNumTuples(num_inserts);
+    storage::ProjectedRowInitializer row_initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+    auto *row_buffer = common::AllocationUtil::AllocateAligned(row_initializer.ProjectedRowSize());
+    storage::ProjectedRow *row = row_initializer.InitializeRow(row_buffer);
+    const double null_bias = null_ratio_(generator_);
+    for (uint32_t i = 0; i < num_inserts; ++i) {
+      StorageTestUtil::PopulateRandomRow(row, layout, null_bias, &generator_);
+      storage::ProjectedColumns::RowView view = columns->InterpretAsRow(i);
+      for (uint16_t j = 0; j < row->NumColumns(); j++)
+        storage::StorageUtil::CopyWithNullCheck(row->AccessWithNullCheck(j), &view, layout.AttrSize(all_cols[j]), j);
+    }
+
+    auto *txn = new transaction::TransactionContext(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                                    common::ManagedPointer(&buffer_pool_), DISABLED);
+    tested.GetTable().InsertBatch(common::ManagedPointer(txn), columns);
+
+    storage::ProjectedRow *stored = row_initializer.InitializeRow(row_buffer);
+    for (uint32_t i = 0; i < num_inserts; ++i) {
+      const storage::TupleSlot slot = columns->TupleSlots()[i];
+      EXPECT_EQ(slot.GetOffset(), (num_existing + i) % layout.NumSlots());
+      if (slot.GetOffset() != 0) {
+        EXPECT_EQ(slot.GetBlock(), columns->TupleSlots()[i - 1].GetBlock());
+      }
+      EXPECT_TRUE(tested.GetTable().Select(common::ManagedPointer(txn), slot, stored));
+      storage::ProjectedColumns::RowView view = columns->InterpretAsRow(i);
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(layout, stored, &view));
+    }
+    delete txn;
+    delete[] row_buffer;
+    delete[] buffer;
+  }
+}
+
+// Varlen values the caller does not hand over to the table are copied into the varlen arena of the block, so that the
+// table does not depend on the caller's memory, and the row written can be pointed at the copies
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, BorrowedVarlensCopiedIntoArena) {
+  block_store_.SetUseVarlenArenas(true);
+  const storage::BlockLayout layout({8, storage::VARLEN_COLUMN});
+  storage::DataTable table{common::ManagedPointer(&block_store_), layout, storage::layout_version_t(0)};
+  const std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+  storage::ProjectedRowInitializer initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+  auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *select_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  storage::ProjectedRow *row = initializer.InitializeRow(buffer);
+  auto *txn = new transaction::TransactionContext(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                                  common::ManagedPointer(&buffer_pool_), DISABLED);
+
+  // Write a value that lives in memory of the caller, and scribble over that memory afterwards
+  std::string value = "a value too long to be inlined";
+  auto *entry = reinterpret_cast<storage::VarlenEntry *>(row->AccessForceNotNull(0));
+  *entry = storage::VarlenEntry::Create(reinterpret_cast<const byte *>(value.data()),
+                                        static_cast<uint32_t>(value.size()), false);
+  const storage::TupleSlot slot = table.Insert(common::ManagedPointer(txn), *row);
+  const std::string original = value;
+  value.assign(value.size(), 'x');
+
+  storage::ProjectedRow *stored = initializer.InitializeRow(select_buffer);
+  EXPECT_TRUE(table.Select(common::ManagedPointer(txn), slot, stored));
+  auto *stored_entry = reinterpret_cast<storage::VarlenEntry *>(stored->AccessWithNullCheck(0));
+  ASSERT_NE(stored_entry, nullptr);
+  EXPECT_EQ(stored_entry->StringView(), original);
+  EXPECT_FALSE(stored_entry->NeedReclaim());
+  ASSERT_NE(slot.GetBlock()->varlen_arena_.load(), nullptr);
+  EXPECT_TRUE(slot.GetBlock()->varlen_arena_.load()->Contains(stored_entry->Content()));
+
+  table.RepointVarlens(slot, row);
+  EXPECT_EQ(entry->Content(), stored_entry->Content());
+
+  // Updates copy the new value into the same arena
+  std::string new_value = "another value too long to be inlined";
+  *entry = storage::VarlenEntry::Create(reinterpret_cast<const byte *>(new_value.data()),
+                                        static_cast<uint32_t>(new_value.size()), false);
+  EXPECT_TRUE(table.Update(common::ManagedPointer(txn), slot, *row));
+  new_value.assign(new_value.size(), 'x');
+  EXPECT_TRUE(table.Select(common::ManagedPointer(txn), slot, stored));
+  EXPECT_EQ(stored_entry->StringView(), "another value too long to be inlined");
+  EXPECT_TRUE(slot.GetBlock()->varlen_arena_.load()->Contains(stored_entry->Content()));
+
+  delete txn;
+  delete[] select_buffer;
+  delete[] buffer;
+}
+
+// Without varlen arenas, which only the compactor gives back, borrowed varlen values are copied into memory of their
+// own, which the GC frees once they are overwritten
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, BorrowedVarlensCopiedWithoutArena) {
+  const storage::BlockLayout layout({8, storage::VARLEN_COLUMN});
+  storage::DataTable table{common::ManagedPointer(&block_store_), layout, storage::layout_version_t(0)};
+  const std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+  storage::ProjectedRowInitializer initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+  auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *select_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  storage::ProjectedRow *row = initializer.InitializeRow(buffer);
+  auto *txn = new transaction::TransactionContext(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                                  common::ManagedPointer(&buffer_pool_), DISABLED);
+
+  std::string value = "a value too long to be inlined";
+  auto *entry = reinterpret_cast<storage::VarlenEntry *>(row->AccessForceNotNull(0));
+  *entry = storage::VarlenEntry::Create(reinterpret_cast<const byte *>(value.data()),
+                                        static_cast<uint32_t>(value.size()), false);
+  const storage::TupleSlot slot = table.Insert(common::ManagedPointer(txn), *row);
+  value.assign(value.size(), 'x');
+
+  storage::ProjectedRow *stored = initializer.InitializeRow(select_buffer);
+  EXPECT_TRUE(table.Select(common::ManagedPointer(txn), slot, stored));
+  auto *stored_entry = reinterpret_cast<storage::VarlenEntry *>(stored->AccessWithNullCheck(0));
+  ASSERT_NE(stored_entry, nullptr);
+  EXPECT_EQ(stored_entry->StringView(), "a value too long to be inlined");
+  EXPECT_TRUE(stored_entry->NeedReclaim());
+  EXPECT_EQ(slot.GetBlock()->varlen_arena_.load(), nullptr);
+
+  delete txn;
+  delete[] select_buffer;
+  delete[] buffer;
+}
+
 // Test that insertion into a block does not wrap around even in the presence of deleted slots. This makes compaction
 // a lot easier to write.
 // NOLINTNEXTLINE
@@ -376,4 +703,26 @@ TEST_F(DataTableTests, InsertNoWrap) {
     delete txn;
   }
 }
+
+// Fills the blocks of a table on the NUMA node of the inserting thread until the node runs out of blocks, and checks
+// that the block that spilled over to another node is filled up before the table asks for another one.
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, InsertIntoSpilledBlock) {
+  storage::BlockStore block_store(4, 4, storage::BlockPlacement::LOCAL, 2);
+  const uint16_t local_node = block_store.InsertionNode();
+  ASSERT_NE(local_node, common::NumaUtil::ANY_NODE);
+  RandomDataTableTestObject tested(&block_store, 10, null_ratio_(generator_), &generator_);
+  auto *txn = new transaction::TransactionContext(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                                  common::ManagedPointer(&buffer_pool_), DISABLED);
+  // The local node has two blocks to give, after which the third block comes from the other node
+  for (uint32_t i = 0; i < 2 * tested.Layout().NumSlots() + 2; i++)
+    tested.InsertRandomTuple(txn, &generator_, &buffer_pool_);
+  EXPECT_EQ(block_store.InsertionNode(), common::NumaUtil::ANY_NODE);
+  const std::vector<uint16_t> block_nodes = tested.GetTable().GetBlockNumaNodes();
+  ASSERT_EQ(block_nodes.size(), 3);
+  EXPECT_EQ(block_nodes[0], local_node);
+  EXPECT_EQ(block_nodes[1], local_node);
+  EXPECT_NE(block_nodes[2], local_node);
+  delete txn;
+}
 }  // namespace terrier
@@ -1,12 +1,25 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
+#include "catalog/catalog.h"
+#include "catalog/postgres/pg_namespace.h"
 #include "common/hash_util.h"
+#include "main/db_main.h"
+#include "storage/arrow_export_endpoint.h"
 #include "storage/arrow_serializer.h"
 #include "storage/block_access_controller.h"
 #include "storage/block_compactor.h"
 #include "storage/garbage_collector.h"
+#include "storage/sql_table.h"
 #include "storage/storage_defs.h"
 #include "storage/tuple_access_strategy.h"
 #include "test_util/storage_test_util.h"
@@ -15,6 +28,7 @@
 
 #define EXPORT_TABLE_NAME "test_table.arrow"
 #define CSV_TABLE_NAME "test_table.csv"
+#define EXPORT_SOCKET_NAME "test_table.sock"
 #define PYSCRIPT_NAME "transform_table.py"
 #define PYSCRIPT                                      \
   "import pyarrow as pa\n"                            \
@@ -362,4 +376,150 @@ TEST_F(ExportTableTest, ExportVarlenTableTest) {
   gc.PerformGarbageCollection();  // Second call to deallocate.
 }
 
+// Streams a table to a client of an export endpoint and checks that it receives the same bytes as are written to a file
+// NOLINTNEXTLINE
+TEST_F(ExportTableTest, ExportTableOverSocketTest) {
+  unlink(EXPORT_TABLE_NAME);
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutWithVarlens(100, &generator_);
+  storage::TupleAccessStrategy accessor(layout);
+  // Technically, the block above is not "in" the table, but since we don't sequential scan that does not matter
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  storage::RawBlock *block = table.begin()->GetBlock();
+  accessor.InitializeRawBlock(&table, block, storage::layout_version_t(0));
+
+  // Enable GC to cleanup transactions started by the block compactor
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_), true, DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+  auto tuples = StorageTestUtil::PopulateBlockRandomly(&table, block, percent_empty_, &generator_);
+
+  // Mix gathered and dictionary compressed columns, so that dictionary messages are interleaved with record batches
+  auto &arrow_metadata = accessor.GetArrowBlockMetadata(block);
+  std::vector<type::TypeId> column_types;
+  column_types.resize(layout.NumColumns());
+  bool dictionary_compressed = false;
+  for (storage::col_id_t col_id : layout.AllColumns()) {
+    if (layout.IsVarlen(col_id)) {
+      arrow_metadata.GetColumnInfo(layout, col_id).Type() = dictionary_compressed
+                                                                ? storage::ArrowColumnType::DICTIONARY_COMPRESSED
+                                                                : storage::ArrowColumnType::GATHERED_VARLEN;
+      dictionary_compressed = !dictionary_compressed;
+      column_types[col_id.UnderlyingValue()] = type::TypeId::VARCHAR;
+    } else {
+      arrow_metadata.GetColumnInfo(layout, col_id).Type() = storage::ArrowColumnType::FIXED_LENGTH;
+      column_types[col_id.UnderlyingValue()] = type::TypeId::INTEGER;
+    }
+  }
+
+  storage::BlockCompactor compactor;
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+  gc.PerformGarbageCollection();
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+
+  storage::ArrowSerializer arrow_serializer(table);
+  arrow_serializer.ExportTable(EXPORT_TABLE_NAME, &column_types);
+  std::ifstream exported_file(EXPORT_TABLE_NAME, std::ios_base::in | std::ios_base::binary);
+  const std::string expected((std::istreambuf_iterator<char>(exported_file)), std::istreambuf_iterator<char>());
+  exported_file.close();
+  unlink(EXPORT_TABLE_NAME);
+
+  std::string received;
+  {
+    storage::ArrowExportEndpoint endpoint(EXPORT_SOCKET_NAME);
+    std::thread client([&] {
+      struct sockaddr_un addr;
+      std::memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      std::strncpy(addr.sun_path, EXPORT_SOCKET_NAME, sizeof(addr.sun_path) - 1);
+      const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+      ASSERT_EQ(connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)), 0);
+      char buffer[4096];
+      ssize_t bytes_read;
+      while ((bytes_read = read(fd, buffer, sizeof(buffer))) > 0) received.append(buffer, bytes_read);
+      close(fd);
+    });
+    endpoint.ServeTable(table, &column_types);
+    client.join();
+  }
+
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(received, expected);
+
+  for (auto &entry : tuples) delete[] reinterpret_cast<byte *>(entry.second);  // reclaim memory used for bookkeeping
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate
+}
+
+// Asks the export endpoint of a DBMain for a table that is still being inserted into. The export must not wait for the
+// block of the table to be frozen, and leaves it out instead.
+// NOLINTNEXTLINE
+TEST_F(ExportTableTest, ExportRequestedTableTest) {
+  auto db_main = DBMain::Builder()
+                     .SetUseGC(true)
+                     .SetUseGCThread(true)
+                     .SetUseCatalog(true)
+                     .SetUseArrowExport(true)
+                     .SetArrowExportSocketPath(EXPORT_SOCKET_NAME)
+                     .Build();
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto catalog = db_main->GetCatalogLayer()->GetCatalog();
+
+  auto *txn = txn_manager->BeginTransaction();
+  const auto db_oid = catalog->GetDatabaseOid(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE);
+  auto db_catalog = catalog->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  catalog::Schema schema({{"attribute", type::TypeId::INTEGER, false,
+                           parser::ConstantValueExpression(type::TypeId::INTEGER)}});
+  const auto table_oid = db_catalog->CreateTable(common::ManagedPointer(txn),
+                                                 catalog::postgres::NAMESPACE_DEFAULT_NAMESPACE_OID, "foo", schema);
+  const auto &table_schema = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid);
+  auto *table = new storage::SqlTable(db_main->GetStorageLayer()->GetBlockStore(), table_schema);
+  EXPECT_TRUE(db_catalog->SetTablePointer(common::ManagedPointer(txn), table_oid, table));
+  const auto initializer = table->InitializerForProjectedRow({table_schema.GetColumn(0).Oid()});
+  for (int32_t i = 0; i < 10; i++) {
+    auto *const redo = txn->StageWrite(db_oid, table_oid, initializer);
+    *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(0)) = i;
+    table->Insert(common::ManagedPointer(txn), redo);
+  }
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  const auto request_table = [](const std::string &request) {
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, EXPORT_SOCKET_NAME, sizeof(addr.sun_path) - 1);
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    EXPECT_EQ(connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)), 0);
+    EXPECT_EQ(write(fd, request.c_str(), request.size()), static_cast<ssize_t>(request.size()));
+    std::string received;
+    char buffer[4096];
+    ssize_t bytes_read;
+    while ((bytes_read = read(fd, buffer, sizeof(buffer))) > 0) received.append(buffer, bytes_read);
+    close(fd);
+    return received;
+  };
+
+  // The table is found by the name or the oid of its database, and by its name with or without its namespace. Only
+  // the schema message is sent, since the only block of the table is not frozen.
+  for (const auto &request : {std::string(catalog::DEFAULT_DATABASE) + " foo\n",
+                              std::to_string(db_oid.UnderlyingValue()) + " public.foo\n"}) {
+    const auto received = request_table(request);
+    ASSERT_GE(received.size(), 2 * sizeof(int32_t));
+    const auto *prefix = reinterpret_cast<const int32_t *>(received.data());
+    EXPECT_EQ(prefix[0], -1);
+    EXPECT_EQ(received.size(), 2 * sizeof(int32_t) + prefix[1]);
+  }
+
+  // Nothing is sent for a table that does not exist
+  EXPECT_TRUE(request_table(std::string(catalog::DEFAULT_DATABASE) + " bar\n").empty());
+  EXPECT_TRUE(request_table("nodb foo\n").empty());
+}
+
 }  // namespace terrier
@@ -88,6 +88,28 @@ struct GarbageCollectorTests : public ::terrier::TerrierTest {
   std::default_random_engine generator_;
   const uint32_t num_iterations_ = 100;
   const uint16_t max_columns_ = 100;
+
+  // Scans the whole table a few tuples at a time, checks every tuple against selecting it on its own, and returns the
+  // number of tuples scanned
+  static uint32_t ScanAndSelect(GarbageCollectorDataTableTestObject *tested, transaction::TransactionContext *txn) {
+    storage::ProjectedColumnsInitializer initializer(
+        tested->Layout(), StorageTestUtil::ProjectionListAllColumns(tested->Layout()), 100);
+    byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+    storage::ProjectedColumns *columns = initializer.Initialize(buffer);
+    uint32_t num_scanned = 0;
+    auto it = tested->table_.begin();
+    while (it != tested->table_.end()) {
+      tested->table_.Scan(common::ManagedPointer(txn), &it, columns);
+      for (uint32_t i = 0; i < columns->NumTuples(); i++, num_scanned++) {
+        storage::ProjectedColumns::RowView stored = columns->InterpretAsRow(i);
+        storage::ProjectedRow *selected = tested->SelectIntoBuffer(txn, columns->TupleSlots()[i]);
+        EXPECT_TRUE(tested->select_result_);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested->Layout(), &stored, selected));
+      }
+    }
+    delete[] buffer;
+    return num_scanned;
+  }
 };
 
 // Run a single txn that performs an Insert. Confirm that it takes 2 GC cycles to process this tuple.
@@ -699,4 +721,53 @@ TEST_F(GarbageCollectorTests, InsertUpdate1) {
     EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
   }
 }
+
+// Checks that a block counts the slots with version chains, so that the GC leaves it without versions once it unlinks
+// the last chain, and that scans, which copy such blocks in bulk, read the same tuples as selecting them one by one.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ScanCleanBlocks) {
+  auto db_main = DBMain::Builder().SetUseGC(true).Build();
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+  GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                             &generator_);
+  const uint32_t num_inserts = tested.Layout().NumSlots() + tested.Layout().NumSlots() / 2;
+
+  auto *txn0 = txn_manager->BeginTransaction();
+  std::vector<storage::TupleSlot> slots;
+  for (uint32_t i = 0; i < num_inserts; i++)
+    slots.push_back(tested.table_.Insert(common::ManagedPointer(txn0), *tested.GenerateRandomTuple(&generator_)));
+  storage::RawBlock *const first_block = slots.front().GetBlock();
+  storage::RawBlock *const last_block = slots.back().GetBlock();
+  ASSERT_NE(first_block, last_block);
+  EXPECT_EQ(first_block->num_versioned_slots_.load(), tested.Layout().NumSlots());
+  txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+  EXPECT_EQ(first_block->num_versioned_slots_.load(), 0);
+  EXPECT_EQ(last_block->num_versioned_slots_.load(), 0);
+
+  // Uncommitted writes give the first block versions again, which a concurrent scan must not see past
+  auto *txn1 = txn_manager->BeginTransaction();
+  EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn1), slots[0], *tested.GenerateRandomUpdate(&generator_)));
+  EXPECT_TRUE(tested.table_.Delete(common::ManagedPointer(txn1), slots[1]));
+  EXPECT_EQ(first_block->num_versioned_slots_.load(), 2);
+  EXPECT_EQ(last_block->num_versioned_slots_.load(), 0);
+
+  auto *txn2 = txn_manager->BeginTransaction();
+  EXPECT_EQ(ScanAndSelect(&tested, txn2), num_inserts);
+  txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+  EXPECT_EQ(first_block->num_versioned_slots_.load(), 0);
+
+  // The deleted tuple leaves a gap in the first block, which is copied in bulk around it
+  auto *txn3 = txn_manager->BeginTransaction();
+  EXPECT_EQ(ScanAndSelect(&tested, txn3), num_inserts - 1);
+  txn_manager->Commit(txn3, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
 }  // namespace terrier
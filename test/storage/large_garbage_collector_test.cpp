@@ -9,11 +9,11 @@
 namespace terrier {
 class LargeGCTests : public TerrierTest {
  public:
-  void RunTest(const LargeDataTableTestConfiguration &config) {
+  void RunTest(const LargeDataTableTestConfiguration &config, const uint32_t gc_num_threads = 1) {
     for (uint32_t iteration = 0; iteration < config.NumIterations(); iteration++) {
       std::default_random_engine generator;
 
-      auto db_main = DBMain::Builder().SetUseGC(true).SetUseGCThread(true).Build();
+      auto db_main = DBMain::Builder().SetUseGC(true).SetUseGCThread(true).SetGCNumThreads(gc_num_threads).Build();
       auto *const tested = new LargeDataTableTestObject(config, db_main->GetStorageLayer()->GetBlockStore().Get(),
                                                         db_main->GetTransactionLayer()->GetTransactionManager().Get(),
                                                         &generator, DISABLED);
@@ -137,6 +137,24 @@ TEST_F(LargeGCTests, HighAbortRateHighThreadWithGC) {
   RunTest(config);
 }
 
+// This test duplicates MixedReadWriteWithGC with a GC that unlinks on several worker threads. Larger batches let GC
+// invocations collect enough txns to split the work.
+// NOLINTNEXTLINE
+TEST_F(LargeGCTests, MixedReadWriteWithParallelGC) {
+  auto config = LargeDataTableTestConfiguration::Builder()
+                    .SetNumIterations(10)
+                    .SetNumTxns(5000)
+                    .SetBatchSize(1000)
+                    .SetNumConcurrentTxns(MultiThreadTestUtil::HardwareConcurrency())
+                    .SetUpdateSelectRatio({0.5, 0.5})
+                    .SetTxnLength(10)
+                    .SetInitialTableSize(1000)
+                    .SetMaxColumns(20)
+                    .SetVarlenAllowed(true)
+                    .Build();
+  RunTest(config, 4);
+}
+
 // This test attempts to simulate a TPC-C-like scenario.
 // NOLINTNEXTLINE
 TEST_F(LargeGCTests, TPCCishWithGC) {
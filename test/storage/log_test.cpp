@@ -11,6 +11,7 @@
 #include "storage/projected_row.h"
 #include "storage/sql_table.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/log_compression.h"
 #include "storage/write_ahead_log/log_manager.h"
 #include "test_util/catalog_test_util.h"
 #include "test_util/data_table_test_util.h"
@@ -63,12 +64,13 @@ class WriteAheadLoggingTests : public TerrierTest {
     if (record_type == storage::LogRecordType::COMMIT) {
       auto txn_commit = in->ReadValue<transaction::timestamp_t>();
       auto oldest_active_txn = in->ReadValue<transaction::timestamp_t>();
+      auto previous_commit = in->ReadValue<transaction::timestamp_t>();
 
       // Okay to fill in null since nobody will invoke the callback.
       // is_read_only argument is set to false, because we do not write out a commit record for a transaction if it is
       // not read-only.
       return storage::CommitRecord::Initialize(buf, txn_begin, txn_commit, nullptr, nullptr, oldest_active_txn, false,
-                                               nullptr, nullptr);
+                                               nullptr, nullptr, previous_commit);
     }
 
     if (record_type == storage::LogRecordType::ABORT)
@@ -447,4 +449,119 @@ TEST_F(WriteAheadLoggingTests, ReadOnlyCallbackTest) {
   // DeferredAction
   db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete sql_table; });
 }
+
+// Verify that flushing a group of buffers with a single vectored write preserves the contents and order of every buffer
+TEST_F(WriteAheadLoggingTests, GroupFlushTest) {
+  log_manager_->PersistAndStop();
+
+  const char *group_log_file = "./group_flush_test.log";
+  unlink(group_log_file);
+  const uint32_t num_writers = 3;
+  const uint32_t values_per_writer = common::Constants::LOG_BUFFER_SIZE / sizeof(uint32_t);
+
+  std::vector<std::unique_ptr<BufferedLogWriter>> writers;
+  std::vector<BufferedLogWriter *> batch;
+  for (uint32_t i = 0; i < num_writers; i++) {
+    writers.emplace_back(std::make_unique<BufferedLogWriter>(group_log_file));
+    batch.push_back(writers.back().get());
+  }
+  // Fill the first writer completely and the others partially so that buffers of differing sizes are grouped
+  uint32_t next_value = 0;
+  for (uint32_t i = 0; i < num_writers; i++) {
+    for (uint32_t j = 0; j < values_per_writer / (i + 1); j++, next_value++)
+      writers[i]->BufferWrite(&next_value, sizeof(uint32_t));
+  }
+  EXPECT_TRUE(writers[0]->IsBufferFull());
+
+  EXPECT_EQ(BufferedLogWriter::FlushBuffers(batch), next_value * sizeof(uint32_t));
+  writers.front()->Persist();
+  for (auto &writer : writers) writer->Close();
+
+  BufferedLogReader in(group_log_file);
+  for (uint32_t expected = 0; expected < next_value; expected++) EXPECT_EQ(in.ReadValue<uint32_t>(), expected);
+  EXPECT_FALSE(in.HasMore());
+  unlink(group_log_file);
+}
+
+// Verify that the log frame codec round trips both repetitive and random data, and rejects corrupted input
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, LogCompressionTest) {
+  log_manager_->PersistAndStop();
+
+  std::uniform_int_distribution<uint32_t> byte_dist(0, UINT8_MAX);
+  std::vector<byte> repetitive, random;
+  for (uint32_t i = 0; i < 1 << 16; i++) {
+    // Repeating records with a changing counter, similar to a log of inserts
+    repetitive.push_back(static_cast<byte>(i % 64 == 0 ? byte_dist(generator_) : i % 7));
+    random.push_back(static_cast<byte>(byte_dist(generator_)));
+  }
+
+  for (const auto *input : {&repetitive, &random}) {
+    std::vector<byte> compressed;
+    LogCompressionUtil::Compress(input->data(), static_cast<uint32_t>(input->size()), &compressed);
+    std::vector<byte> decompressed(input->size());
+    EXPECT_TRUE(LogCompressionUtil::Decompress(compressed.data(), static_cast<uint32_t>(compressed.size()),
+                                               decompressed.data(), static_cast<uint32_t>(decompressed.size())));
+    EXPECT_EQ(*input, decompressed);
+    if (input == &repetitive) {
+      EXPECT_LT(compressed.size(), input->size() / 4);
+    }
+
+    // Input that was cut short does not decompress to the full size
+    EXPECT_FALSE(LogCompressionUtil::Decompress(compressed.data(), static_cast<uint32_t>(compressed.size() / 2),
+                                                decompressed.data(), static_cast<uint32_t>(decompressed.size())));
+  }
+
+  std::vector<byte> varints;
+  const std::vector<uint64_t> values = {0, 1, 127, 128, 300, UINT32_MAX, UINT64_MAX};
+  for (const auto value : values) LogCompressionUtil::AppendVarint(value, &varints);
+  uint32_t offset = 0;
+  for (const auto expected : values) {
+    uint64_t value;
+    EXPECT_TRUE(LogCompressionUtil::ReadVarint(varints.data(), static_cast<uint32_t>(varints.size()), &offset, &value));
+    EXPECT_EQ(value, expected);
+  }
+  EXPECT_EQ(offset, varints.size());
+}
+
+// Verify that a commit persisted by one log stream is only acknowledged once every commit before it is persisted, even
+// if another log stream persists that one later
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, DurableWatermarkTest) {
+  log_manager_->PersistAndStop();
+
+  transaction::TimestampManager timestamp_manager;
+  DurableWatermark watermark;
+  transaction::timestamp_t previous_commit;
+  const auto first = watermark.CheckOutCommitTimestamp(&timestamp_manager, &previous_commit);
+  EXPECT_EQ(previous_commit, transaction::INVALID_TXN_TIMESTAMP);
+  const auto second = watermark.CheckOutCommitTimestamp(&timestamp_manager, &previous_commit);
+  EXPECT_EQ(previous_commit, first);
+  // A read-only transaction that could have read from both
+  const auto read_only = timestamp_manager.CheckOutTimestamp();
+
+  std::promise<bool> first_promise, second_promise, read_only_promise;
+  auto first_durable = first_promise.get_future(), second_durable = second_promise.get_future(),
+       read_only_durable = read_only_promise.get_future();
+  std::vector<CommitCallback> stream0{{TestCommitCallback, &second_promise, second},
+                                      {TestCommitCallback, &read_only_promise, read_only}};
+  std::vector<CommitCallback> stream1{{TestCommitCallback, &first_promise, first}};
+
+  // The second commit is persisted first, but it has to wait for the first one
+  watermark.Persisted(&stream0);
+  EXPECT_TRUE(stream0.empty());
+  EXPECT_EQ(second_durable.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+  EXPECT_EQ(read_only_durable.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+
+  // Persisting the first one makes all of them durable
+  watermark.Persisted(&stream1);
+  EXPECT_TRUE(first_durable.get());
+  EXPECT_TRUE(second_durable.get());
+  EXPECT_TRUE(read_only_durable.get());
+
+  // A new chain does not link to the commits before
+  watermark.StartNewChain();
+  watermark.CheckOutCommitTimestamp(&timestamp_manager, &previous_commit);
+  EXPECT_EQ(previous_commit, transaction::INVALID_TXN_TIMESTAMP);
+}
 }  // namespace terrier::storage
@@ -1,15 +1,27 @@
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <fstream>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
 #include "catalog/catalog.h"
 #include "catalog/postgres/pg_namespace.h"
+#include "common/allocator.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
 #include "storage/garbage_collector_thread.h"
+#include "storage/index/index.h"
 #include "storage/index/index_builder.h"
+#include "storage/recovery/checkpoint_manager.h"
 #include "storage/recovery/disk_log_provider.h"
+#include "storage/recovery/merging_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
 #include "storage/sql_table.h"
 #include "storage/write_ahead_log/log_manager.h"
@@ -24,6 +36,11 @@
 // executions will read old test's data, and the cause of the errors will be hard to identify. Trust me it will drive
 // you nuts...
 #define LOG_FILE_NAME "./test.log"
+#define LOG_ARCHIVE_FILE_NAME "./test.log.archive"
+#define CHECKPOINT_FILE_NAME "./test.checkpoint"
+#define REPLICA_NETWORK_PORT 15731
+#define REPLICATION_PORT 15732
+#define STALLED_REPLICATION_PORT 15733
 
 namespace terrier::storage {
 class RecoveryTests : public TerrierTest {
@@ -45,12 +62,46 @@ class RecoveryTests : public TerrierTest {
   common::ManagedPointer<catalog::Catalog> recovery_catalog_;
   common::ManagedPointer<common::DedicatedThreadRegistry> recovery_thread_registry_;
 
-  void SetUp() override {
-    // Unlink log file incase one exists from previous test iteration
-    unlink(LOG_FILE_NAME);
+  // Most number of log streams a test uses, so that we know which log files to unlink
+  static constexpr uint32_t MAX_LOG_STREAMS = 4;
+
+  void UnlinkLogFiles() {
+    for (uint32_t i = 0; i < MAX_LOG_STREAMS; i++) unlink(LogManager::LogStreamFilePath(LOG_FILE_NAME, i).c_str());
+    unlink(CHECKPOINT_FILE_NAME);
+  }
+
+  // (Re)creates the original components, logging to the given number of log streams. If a replica host is given, the
+  // log is also shipped to the replica listening on REPLICATION_PORT.
+  void BuildOriginalDBMain(const uint32_t num_log_streams, const bool compress_logs = false,
+                           const std::string &replica_host = "") {
+    db_main_.reset();
+    UnlinkLogFiles();
+
+    db_main_ = terrier::DBMain::Builder()
+                   .SetWalFilePath(LOG_FILE_NAME)
+                   .SetWalNumStreams(num_log_streams)
+                   .SetWalCompression(compress_logs)
+                   .SetReplicationReplicaHost(replica_host)
+                   .SetReplicationPort(REPLICATION_PORT)
+                   .SetUseLogging(true)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+  }
+
+  // Shuts the original components down, and starts them again with startup recovery from their log files
+  void RestartOriginalDBMain(const uint32_t num_log_streams) {
+    db_main_.reset();
 
     db_main_ = terrier::DBMain::Builder()
                    .SetWalFilePath(LOG_FILE_NAME)
+                   .SetWalNumStreams(num_log_streams)
+                   .SetWalRecovery(true)
                    .SetUseLogging(true)
                    .SetUseGC(true)
                    .SetUseGCThread(true)
@@ -60,6 +111,11 @@ class RecoveryTests : public TerrierTest {
     log_manager_ = db_main_->GetLogManager();
     block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
     catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+  }
+
+  void SetUp() override {
+    // Unlink log files incase they exist from previous test iteration
+    BuildOriginalDBMain(1);
 
     recovery_db_main_ = terrier::DBMain::Builder()
                             .SetUseThreadRegistry(true)
@@ -76,8 +132,8 @@ class RecoveryTests : public TerrierTest {
   }
 
   void TearDown() override {
-    // Delete log file
-    unlink(LOG_FILE_NAME);
+    // Delete log files
+    UnlinkLogFiles();
   }
 
   catalog::IndexSchema DummyIndexSchema() {
@@ -183,26 +239,11 @@ class RecoveryTests : public TerrierTest {
     recovery_manager.WaitForRecoveryToFinish();
   }
 
-  void RunTest(const LargeSqlTableTestConfiguration &config) {
-    // Run workload
-    auto *tested =
-        new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
-    tested->SimulateOltp(100, 4);
-
-    ShutdownAndRestartSystem();
-
-    // Instantiate recovery manager, and recover the tables.
-    DiskLogProvider log_provider{LOG_FILE_NAME};
-    RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
-                                     recovery_catalog_,
-                                     recovery_txn_manager_,
-                                     recovery_deferred_action_manager_,
-                                     recovery_thread_registry_,
-                                     recovery_block_store_};
-    recovery_manager.StartRecovery();
-    recovery_manager.WaitForRecoveryToFinish();
-
-    // Check we recovered all the original tables
+  // Checks that every table of the workload was recovered by the given recovery manager
+  void CheckRecoveredTables(LargeSqlTableTestObject *const tested,
+                            const common::ManagedPointer<catalog::Catalog> recovered_catalog,
+                            const common::ManagedPointer<transaction::TransactionManager> recovered_txn_manager,
+                            const RecoveryManager &recovery_manager) {
     for (auto &database : tested->GetTables()) {
       auto database_oid = database.first;
       for (auto &table_oid : database.second) {
@@ -212,8 +253,8 @@ class RecoveryTests : public TerrierTest {
                                       ->GetTable(common::ManagedPointer(original_txn), table_oid);
 
         // Get Recovered table
-        auto *recovery_txn = recovery_txn_manager_->BeginTransaction();
-        auto db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(recovery_txn), database_oid);
+        auto *recovery_txn = recovered_txn_manager->BeginTransaction();
+        auto db_catalog = recovered_catalog->GetDatabaseCatalog(common::ManagedPointer(recovery_txn), database_oid);
         EXPECT_TRUE(db_catalog != nullptr);
         auto recovered_sql_table = db_catalog->GetTable(common::ManagedPointer(recovery_txn), table_oid);
         EXPECT_TRUE(recovered_sql_table != nullptr);
@@ -221,11 +262,49 @@ class RecoveryTests : public TerrierTest {
         EXPECT_TRUE(StorageTestUtil::SqlTableEqualDeep(
             original_sql_table->table_.layout_, original_sql_table, recovered_sql_table,
             tested->GetTupleSlotsForTable(database_oid, table_oid), recovery_manager.tuple_slot_map_,
-            txn_manager_.Get(), recovery_txn_manager_.Get()));
+            txn_manager_.Get(), recovered_txn_manager.Get()));
         txn_manager_->Commit(original_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
-        recovery_txn_manager_->Commit(recovery_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+        recovered_txn_manager->Commit(recovery_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
       }
     }
+  }
+
+  void RunTest(const LargeSqlTableTestConfiguration &config, const uint32_t num_replay_threads = 1,
+               const bool take_checkpoint = false) {
+    // Run workload
+    auto *tested =
+        new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+    tested->SimulateOltp(100, 4);
+
+    if (take_checkpoint) {
+      // Checkpoint halfway through the workload, so that recovery has to combine the checkpoint with the log tail
+      CheckpointManager checkpoint_manager(CHECKPOINT_FILE_NAME, catalog_, txn_manager_,
+                                           db_main_->GetTransactionLayer()->GetTimestampManager(), log_manager_);
+      checkpoint_manager.TakeCheckpoint(LOG_ARCHIVE_FILE_NAME);
+      // The log covered by the checkpoint should have been truncated
+      EXPECT_NE(0, access(LOG_ARCHIVE_FILE_NAME, F_OK));
+      tested->SimulateOltp(100, 4);
+    }
+
+    ShutdownAndRestartSystem();
+
+    // Instantiate recovery manager, and recover the tables.
+    MergingLogProvider log_provider{LOG_FILE_NAME, log_manager_->NumLogStreams()};
+    std::unique_ptr<DiskLogProvider> checkpoint_provider =
+        take_checkpoint ? std::make_unique<DiskLogProvider>(CHECKPOINT_FILE_NAME) : nullptr;
+    RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+                                     recovery_catalog_,
+                                     recovery_txn_manager_,
+                                     recovery_deferred_action_manager_,
+                                     recovery_thread_registry_,
+                                     recovery_block_store_,
+                                     num_replay_threads,
+                                     common::ManagedPointer<AbstractLogProvider>(checkpoint_provider.get())};
+    recovery_manager.StartRecovery();
+    recovery_manager.WaitForRecoveryToFinish();
+
+    // Check we recovered all the original tables
+    CheckRecoveredTables(tested, recovery_catalog_, recovery_txn_manager_, recovery_manager);
     // the table can't be freed until after all GC on it is guaranteed to be done. The easy way to do that is to use a
     // DeferredAction
     db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
@@ -282,6 +361,248 @@ TEST_F(RecoveryTests, MultiDatabaseTest) {
   RecoveryTests::RunTest(config);
 }
 
+// This test runs the multi-database workload, but replays changes to different tables in parallel. It verifies that the
+// recovered tables are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplayTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(5)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.5, 0.1, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 4);
+}
+
+// This test takes a checkpoint in the middle of a multi-database workload. It then recovers from the checkpoint and the
+// log written after it, and verifies that the recovered tables are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.5, 0.1, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 1, true);
+}
+
+// This test logs a multi-database workload to several log files in parallel, and takes a checkpoint in the middle of
+// it. It then recovers from the checkpoint and the merged log files, and verifies that the recovered tables are equal
+// to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MultipleLogStreamsTest) {
+  BuildOriginalDBMain(MAX_LOG_STREAMS);
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.5, 0.1, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, 1, true);
+}
+
+// A transaction takes its commit timestamp before its commit record is handed to its log stream, so two transactions
+// on the same stream can reach the file in the opposite order. This test writes such log files by hand and checks that
+// the merged records still come out in commit order, with every transaction's records right before its commit. The
+// files also hold a commit whose predecessor is missing, and replay has to stop before it.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MergeOutOfOrderLogStreamsTest) {
+  const std::string merge_log_file = "./test_merge.log";
+  const uint64_t no_commit = transaction::INVALID_TXN_TIMESTAMP.UnderlyingValue();
+  // Writes a record in the log format, without the fields the provider does not need to tell records apart
+  auto write_record = [](std::ofstream *out, const LogRecordType type, const uint64_t txn_begin,
+                         const uint64_t txn_commit, const uint64_t previous_commit) {
+    const uint32_t size = type == LogRecordType::COMMIT
+                              ? CommitRecord::Size()
+                              : (type == LogRecordType::ABORT ? AbortRecord::Size() : DeleteRecord::Size());
+    out->write(reinterpret_cast<const char *>(&size), sizeof(size));
+    out->write(reinterpret_cast<const char *>(&type), sizeof(type));
+    out->write(reinterpret_cast<const char *>(&txn_begin), sizeof(txn_begin));
+    if (type == LogRecordType::COMMIT) {
+      // Commit timestamp, then the oldest active transaction, then the commit before
+      out->write(reinterpret_cast<const char *>(&txn_commit), sizeof(txn_commit));
+      out->write(reinterpret_cast<const char *>(&txn_begin), sizeof(txn_begin));
+      out->write(reinterpret_cast<const char *>(&previous_commit), sizeof(previous_commit));
+    } else if (type == LogRecordType::DELETE) {
+      const catalog::db_oid_t db_oid(1);
+      const catalog::table_oid_t table_oid(1);
+      const TupleSlot slot(nullptr, 0);
+      out->write(reinterpret_cast<const char *>(&db_oid), sizeof(db_oid));
+      out->write(reinterpret_cast<const char *>(&table_oid), sizeof(table_oid));
+      out->write(reinterpret_cast<const char *>(&slot), sizeof(slot));
+    }
+  };
+
+  {
+    // Stream 0 holds the transaction that committed at 8 before the one that committed at 4
+    std::ofstream stream0(LogManager::LogStreamFilePath(merge_log_file, 0), std::ios::binary | std::ios::trunc);
+    write_record(&stream0, LogRecordType::DELETE, 3, 0, 0);
+    write_record(&stream0, LogRecordType::DELETE, 1, 0, 0);
+    write_record(&stream0, LogRecordType::COMMIT, 3, 8, 6);
+    write_record(&stream0, LogRecordType::COMMIT, 1, 4, no_commit);
+    // Aborts
+    write_record(&stream0, LogRecordType::DELETE, 7, 0, 0);
+    write_record(&stream0, LogRecordType::ABORT, 7, 0, 0);
+    // Never commits
+    write_record(&stream0, LogRecordType::DELETE, 9, 0, 0);
+    std::ofstream stream1(LogManager::LogStreamFilePath(merge_log_file, 1), std::ios::binary | std::ios::trunc);
+    write_record(&stream1, LogRecordType::DELETE, 5, 0, 0);
+    write_record(&stream1, LogRecordType::COMMIT, 5, 6, 4);
+    // Commits after the one at 10, whose commit record is lost
+    write_record(&stream1, LogRecordType::DELETE, 11, 0, 0);
+    write_record(&stream1, LogRecordType::COMMIT, 11, 12, 10);
+  }
+
+  MergingLogProvider log_provider{merge_log_file, 2};
+  const std::vector<std::pair<LogRecordType, uint64_t>> expected = {
+      {LogRecordType::DELETE, 1}, {LogRecordType::COMMIT, 1}, {LogRecordType::DELETE, 5},
+      {LogRecordType::COMMIT, 5}, {LogRecordType::DELETE, 3}, {LogRecordType::COMMIT, 3}};
+  for (const auto &record : expected) {
+    auto pair = log_provider.GetNextRecord();
+    ASSERT_NE(pair.first, nullptr);
+    EXPECT_EQ(pair.first->RecordType(), record.first);
+    EXPECT_EQ(pair.first->TxnBegin(), transaction::timestamp_t(record.second));
+    delete[] reinterpret_cast<byte *>(pair.first);
+  }
+  EXPECT_EQ(log_provider.GetNextRecord().first, nullptr);
+  EXPECT_TRUE(log_provider.StoppedAtGap());
+
+  for (uint32_t i = 0; i < 2; i++) unlink(LogManager::LogStreamFilePath(merge_log_file, i).c_str());
+}
+
+// This test writes the log of a multi-database workload in the compact, compressed log format. It then recovers from
+// the log, and verifies that the recovered tables are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CompressedLogTest) {
+  BuildOriginalDBMain(1, true);
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.5, 0.1, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config);
+}
+
+// This test ships the log of a multi-database workload to a replica, which replays it as it arrives. The replica only
+// comes up after the primary started logging, so that the primary has to hold the log back until the replica connects.
+// Once the primary stops replication, it verifies that the replica's tables are equal to the test tables.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ReplicationTest) {
+  BuildOriginalDBMain(1, false, "127.0.0.1");
+  EXPECT_TRUE(db_main_->GetLogShipper()->Replicating());
+  auto *txn = txn_manager_->BeginTransaction();
+  CreateDatabase(txn, catalog_, "replicated_db");
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  auto replica = terrier::DBMain::Builder()
+                     .SetUseGC(true)
+                     .SetUseGCThread(true)
+                     .SetUseCatalog(true)
+                     .SetCreateDefaultDatabase(false)
+                     .SetUseStatsStorage(true)
+                     .SetUseExecution(true)
+                     .SetUseTrafficCop(true)
+                     .SetUseNetwork(true)
+                     .SetNetworkPort(REPLICA_NETWORK_PORT)
+                     .SetUseReplication(true)
+                     .SetReplicationPort(REPLICATION_PORT)
+                     .Build();
+  replica->GetNetworkLayer()->GetReplicationServer()->RunServer();
+  EXPECT_TRUE(replica->GetTrafficCop()->IsReplica());
+
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(3)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(100)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.3, 0.5, 0.1, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+  tested->SimulateOltp(100, 4);
+
+  // Everything persisted has been shipped once the log manager stops
+  ShutdownAndRestartSystem();
+  db_main_->GetLogShipper()->StopReplication();
+  replica->GetReplicationLayer()->WaitForReplicationToFinish();
+
+  CheckRecoveredTables(tested, replica->GetCatalogLayer()->GetCatalog(),
+                       replica->GetTransactionLayer()->GetTransactionManager(),
+                       *replica->GetReplicationLayer()->GetRecoveryManager());
+
+  // Connections to the replica do not get a temporary namespace, which would take an oid from the replicated catalog
+  const auto oids = replica->GetTrafficCop()->CreateTempNamespace(network::connection_id_t(0), "replicated_db");
+  EXPECT_NE(oids.first, catalog::INVALID_DATABASE_OID);
+  EXPECT_EQ(oids.second, catalog::INVALID_NAMESPACE_OID);
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+}
+
+// This test ships the log to a replica that accepts the connection but never reads from it, and checks that the primary
+// gives up on the replica once the socket is full instead of waiting on it forever.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, StalledReplicaTest) {
+  const int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(listen_fd, 0);
+  const int reuse = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  struct sockaddr_in addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(STALLED_REPLICATION_PORT);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  ASSERT_EQ(bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)), 0);
+  ASSERT_EQ(listen(listen_fd, 1), 0);
+
+  // The connection is established by the kernel without the replica ever accepting it
+  LogShipper shipper("127.0.0.1", STALLED_REPLICATION_PORT, std::chrono::milliseconds(100),
+                     std::chrono::milliseconds(10));
+  EXPECT_TRUE(shipper.Replicating());
+  while (!shipper.Connected()) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // Far more than the socket buffers of both ends hold
+  const std::vector<byte> logs(64 << 20);
+  shipper.ShipLogs(logs.data(), logs.size());
+  EXPECT_FALSE(shipper.Replicating());
+  close(listen_fd);
+}
+
+// This test ships the log to a replica that never comes up, and checks that the primary holds the log back for it up
+// to the limit, and then gives up on the replica instead of holding back more.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, UnreachableReplicaTest) {
+  LogShipper shipper("127.0.0.1", STALLED_REPLICATION_PORT, std::chrono::milliseconds(100),
+                     std::chrono::milliseconds(10), 1 << 20);
+  const std::vector<byte> logs(1 << 19);
+  shipper.ShipLogs(logs.data(), logs.size());
+  shipper.ShipLogs(logs.data(), logs.size());
+  EXPECT_TRUE(shipper.Replicating());
+  EXPECT_FALSE(shipper.Connected());
+  shipper.ShipLogs(logs.data(), logs.size());
+  EXPECT_FALSE(shipper.Replicating());
+}
+
+// This test checks that a primary refuses to ship the log of more than one log stream, which the replica could not
+// replay in commit order.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ReplicationNeedsSingleLogStreamTest) {
+  EXPECT_THROW(BuildOriginalDBMain(2, false, "127.0.0.1"), std::runtime_error);
+}
+
 // Tests that we correctly process records corresponding to a drop database command.
 // NOLINTNEXTLINE
 TEST_F(RecoveryTests, DropDatabaseTest) {
@@ -375,6 +696,64 @@ TEST_F(RecoveryTests, DropIndexTest) {
   recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+// Tests that an index with INCLUDE columns is recovered with them, rather than with every column as part of its key.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, IncludeIndexTest) {
+  std::string database_name = "testdb";
+  auto namespace_oid = catalog::postgres::NAMESPACE_DEFAULT_NAMESPACE_OID;
+  std::string table_name = "testtable";
+  std::string index_name = "testindex";
+
+  // Create a table with two columns, and an index on the first that includes the second
+  auto *txn = txn_manager_->BeginTransaction();
+  auto db_oid = CreateDatabase(txn, catalog_, database_name);
+  auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  std::vector<catalog::Schema::Column> table_cols;
+  for (const char *name : {"key", "payload"})
+    table_cols.emplace_back(name, type::TypeId::INTEGER, false,
+                            parser::ConstantValueExpression(type::TypeId::INTEGER));
+  auto table_oid =
+      db_catalog->CreateTable(common::ManagedPointer(txn), namespace_oid, table_name, catalog::Schema(table_cols));
+  EXPECT_NE(table_oid, catalog::INVALID_TABLE_OID);
+  const auto &table_schema = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid);
+  EXPECT_TRUE(db_catalog->SetTablePointer(common::ManagedPointer(txn), table_oid,
+                                          new storage::SqlTable(block_store_, table_schema)));
+
+  std::vector<catalog::IndexSchema::Column> index_cols;
+  for (uint16_t i = 0; i < 2; i++) {
+    index_cols.emplace_back("", type::TypeId::INTEGER, false,
+                            parser::ColumnValueExpression(db_oid, table_oid, table_schema.GetColumn(i).Oid()));
+    StorageTestUtil::ForceOid(&(index_cols[i]), catalog::indexkeycol_oid_t(i + 1));
+  }
+  catalog::IndexSchema index_schema(index_cols, storage::index::IndexType::ART, false, false, false, true, 1);
+  auto index_oid =
+      db_catalog->CreateIndex(common::ManagedPointer(txn), namespace_oid, index_name, table_oid, index_schema);
+  EXPECT_NE(index_oid, catalog::INVALID_INDEX_OID);
+  EXPECT_TRUE(db_catalog->SetIndexPointer(common::ManagedPointer(txn), index_oid,
+                                          storage::index::IndexBuilder().SetKeySchema(index_schema).Build()));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  ShutdownAndRestartSystem();
+
+  // Instantiate recovery manager, and recover the catalog
+  SingleRecovery();
+
+  // Assert the index was recovered with its INCLUDE column, and that it stores the columns it includes
+  txn = recovery_txn_manager_->BeginTransaction();
+  db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  ASSERT_TRUE(db_catalog);
+  EXPECT_EQ(index_oid, db_catalog->GetIndexOid(common::ManagedPointer(txn), namespace_oid, index_name));
+  const auto &recovered_schema = db_catalog->GetIndexSchema(common::ManagedPointer(txn), index_oid);
+  EXPECT_EQ(recovered_schema.GetColumns().size(), 2);
+  EXPECT_EQ(recovered_schema.NumKeyColumns(), 1);
+  EXPECT_EQ(recovered_schema.NumIncludeColumns(), 1);
+  auto recovered_index = db_catalog->GetIndex(common::ManagedPointer(txn), index_oid);
+  ASSERT_TRUE(recovered_index);
+  EXPECT_EQ(recovered_index->Type(), storage::index::IndexType::ART);
+  EXPECT_TRUE(recovered_index->StoresColumns());
+  recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 // Tests that we correctly process records corresponding to a drop namespace command.
 // NOLINTNEXTLINE
 TEST_F(RecoveryTests, DropNamespaceTest) {
@@ -767,4 +1146,70 @@ TEST_F(RecoveryTests, DoubleRecoveryTest) {
       [=]() { unlink(secondary_log_file.c_str()); });
 }
 
+// Tests that DBMain recovers a log written to several log streams at startup, and that the log it writes while
+// recovering can be recovered in turn.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, StartupRecoveryTest) {
+  const uint32_t num_log_streams = MAX_LOG_STREAMS;
+  const int32_t num_rows = 100;
+  std::string database_name = "testdb";
+  auto namespace_oid = catalog::postgres::NAMESPACE_DEFAULT_NAMESPACE_OID;
+  std::string table_name = "testtable";
+  BuildOriginalDBMain(num_log_streams);
+
+  auto *txn = txn_manager_->BeginTransaction();
+  auto db_oid = CreateDatabase(txn, catalog_, database_name);
+  auto table_oid = CreateTable(txn, catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid), namespace_oid,
+                               table_name);
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Every row is inserted by its own transaction, so that they are spread over the log streams
+  for (int32_t i = 0; i < num_rows; i++) {
+    txn = txn_manager_->BeginTransaction();
+    auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    auto table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+    const auto col_oid = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid).GetColumn(0).Oid();
+    auto *const redo = txn->StageWrite(db_oid, table_oid, table->InitializerForProjectedRow({col_oid}));
+    *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(0)) = i;
+    table->Insert(common::ManagedPointer(txn), redo);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+
+  // Recover once from the original log, and once more from the log written by that recovery, to fewer log streams
+  for (const uint32_t restart_log_streams : {num_log_streams, 1U}) {
+    RestartOriginalDBMain(restart_log_streams);
+    for (uint32_t i = 0; i < num_log_streams; i++)
+      EXPECT_NE(0, access(LogManager::LogStreamFilePath(std::string(LOG_FILE_NAME) + ".recovering", i).c_str(), F_OK));
+
+    txn = txn_manager_->BeginTransaction();
+    EXPECT_EQ(db_oid, catalog_->GetDatabaseOid(common::ManagedPointer(txn), database_name));
+    auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+    ASSERT_TRUE(db_catalog);
+    EXPECT_EQ(table_oid, db_catalog->GetTableOid(common::ManagedPointer(txn), namespace_oid, table_name));
+    auto table = db_catalog->GetTable(common::ManagedPointer(txn), table_oid);
+    ASSERT_TRUE(table);
+
+    // Every row is recovered exactly once
+    const auto col_oid = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid).GetColumn(0).Oid();
+    const auto pci = table->InitializerForProjectedColumns({col_oid}, num_rows);
+    byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+    auto *pc = pci.Initialize(buffer);
+    std::vector<bool> recovered(num_rows, false);
+    int32_t num_recovered = 0;
+    for (auto it = table->begin(); it != table->end();) {
+      table->Scan(common::ManagedPointer(txn), &it, pc);
+      for (uint32_t i = 0; i < pc->NumTuples(); i++) {
+        const auto value = reinterpret_cast<int32_t *>(pc->ColumnStart(0))[i];
+        ASSERT_TRUE(value >= 0 && value < num_rows);
+        EXPECT_FALSE(recovered[value]);
+        recovered[value] = true;
+        num_recovered++;
+      }
+    }
+    delete[] buffer;
+    EXPECT_EQ(num_rows, num_recovered);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+}
+
 }  // namespace terrier::storage
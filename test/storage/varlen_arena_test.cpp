@@ -0,0 +1,56 @@
+#include "storage/varlen_arena.h"
+
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "test_util/test_harness.h"
+
+namespace terrier {
+
+struct VarlenArenaTests : public TerrierTest {
+  std::default_random_engine generator_;
+};
+
+// Values of random sizes are handed out aligned, do not overlap, and keep their contents until the arena is gone
+// NOLINTNEXTLINE
+TEST_F(VarlenArenaTests, AllocateRandomSizes) {
+  storage::VarlenArena arena;
+  std::uniform_int_distribution<uint32_t> size_dist(1, 2 * storage::VarlenArena::MAX_PACKED_SIZE);
+  std::vector<std::pair<byte *, uint32_t>> values;
+  uint64_t total_size = 0;
+  for (uint32_t i = 0; total_size < storage::VarlenArena::MAX_SIZE / 2; i++) {
+    const uint32_t size = size_dist(generator_);
+    byte *const value = arena.Allocate(size);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(value) % sizeof(uint64_t), 0);
+    EXPECT_TRUE(arena.Contains(value));
+    EXPECT_TRUE(arena.Contains(value + size - 1));
+    std::memset(value, static_cast<int>(i % 256), size);
+    values.emplace_back(value, size);
+    total_size += size;
+  }
+  EXPECT_GE(arena.Size(), total_size);
+
+  for (uint32_t i = 0; i < values.size(); i++)
+    for (uint32_t j = 0; j < values[i].second; j++) ASSERT_EQ(static_cast<uint8_t>(values[i].first[j]), i % 256);
+
+  byte unrelated;
+  EXPECT_FALSE(arena.Contains(&unrelated));
+}
+
+// An arena stops handing out memory once it holds MAX_SIZE bytes
+// NOLINTNEXTLINE
+TEST_F(VarlenArenaTests, SizeLimit) {
+  storage::VarlenArena arena;
+  const uint32_t value_size = storage::VarlenArena::MAX_PACKED_SIZE;
+  const uint64_t num_values = storage::VarlenArena::MAX_SIZE / value_size;
+  for (uint64_t i = 0; i < num_values; i++) EXPECT_NE(arena.Allocate(value_size), nullptr);
+  EXPECT_EQ(arena.Size(), storage::VarlenArena::MAX_SIZE);
+  EXPECT_EQ(arena.Allocate(value_size), nullptr);
+  EXPECT_EQ(arena.Allocate(1), nullptr);
+  EXPECT_EQ(arena.Allocate(storage::VarlenArena::MAX_SIZE), nullptr);
+}
+
+}  // namespace terrier
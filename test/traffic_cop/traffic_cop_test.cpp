@@ -144,6 +144,52 @@ TEST_F(TrafficCopTests, BasicTest) {
   }
 }
 
+/**
+ * Test that SET synchronous_commit only changes the connection that sets it, and that commits made without waiting for
+ * the log to be persisted are visible right away
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, AsynchronousCommitTest) {
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::connection other_connection(fmt::format(
+        "host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql", port_, catalog::DEFAULT_DATABASE));
+    EXPECT_TRUE(db_main_->GetTrafficCop()->SynchronousCommit());
+
+    pqxx::nontransaction set_off(connection);
+    set_off.exec("SET synchronous_commit = off;");
+    set_off.commit();
+    EXPECT_TRUE(db_main_->GetSettingsManager()->GetBool(settings::Param::synchronous_commit));
+    EXPECT_TRUE(db_main_->GetTrafficCop()->SynchronousCommit());
+
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+    txn1.exec("INSERT INTO TableA VALUES (1, 'abc');");
+    txn1.commit();
+
+    // The other connection still waits for its commits to be persisted, and sees the asynchronous commit
+    pqxx::work txn2(other_connection);
+    pqxx::result r = txn2.exec("SELECT * FROM TableA");
+    EXPECT_EQ(r.size(), 1);
+    txn2.exec("INSERT INTO TableA VALUES (2, 'def');");
+    txn2.commit();
+
+    pqxx::nontransaction set_default(connection);
+    set_default.exec("SET synchronous_commit TO DEFAULT;");
+    set_default.commit();
+    EXPECT_TRUE(db_main_->GetTrafficCop()->SynchronousCommit());
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+
+  // A value that is not a boolean is rejected
+  pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                          port_, catalog::DEFAULT_DATABASE));
+  pqxx::nontransaction set_invalid(connection);
+  EXPECT_ANY_THROW(set_invalid.exec("SET synchronous_commit = maybe;"));
+}
+
 /**
  * Test whether a temporary namespace is created for a connection to the database
  */
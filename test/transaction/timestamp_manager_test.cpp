@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <vector>
+
+#include "common/worker_pool.h"
+#include "main/db_main.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+
+namespace terrier {
+
+class TimestampManagerTests : public TerrierTest {
+ protected:
+  void SetUp() override {
+    db_main_ = DBMain::Builder().Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    timestamp_manager_ = db_main_->GetTransactionLayer()->GetTimestampManager();
+  }
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
+  const uint32_t num_threads_ = MultiThreadTestUtil::HardwareConcurrency();
+  common::WorkerPool thread_pool_{num_threads_, {}};
+};
+
+// Begins txns on many threads and finishes them on different threads than the ones that began them. Checks that the
+// oldest running txn is tracked correctly throughout.
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, OldestTransactionStartTime) {
+  const uint32_t txns_per_thread = 100;
+  EXPECT_EQ(timestamp_manager_->OldestTransactionStartTime(), timestamp_manager_->CurrentTime());
+
+  std::vector<std::vector<transaction::TransactionContext *>> txns(num_threads_);
+  auto begin = [&](uint32_t id) {
+    for (uint32_t i = 0; i < txns_per_thread; i++) {
+      auto *const txn = txn_manager_->BeginTransaction();
+      // A running txn can never be younger than the oldest running txn
+      EXPECT_LE(timestamp_manager_->OldestTransactionStartTime(), txn->StartTime());
+      txns[id].push_back(txn);
+    }
+  };
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool_, num_threads_, begin);
+
+  transaction::timestamp_t oldest = timestamp_manager_->CurrentTime();
+  for (const auto &thread_txns : txns) {
+    for (auto *const txn : thread_txns) oldest = std::min(oldest, txn->StartTime());
+  }
+  EXPECT_EQ(timestamp_manager_->OldestTransactionStartTime(), oldest);
+  EXPECT_EQ(timestamp_manager_->CachedOldestTransactionStartTime(), oldest);
+
+  auto finish = [&](uint32_t id) {
+    for (auto *const txn : txns[(id + 1) % num_threads_]) {
+      if (txn->StartTime().UnderlyingValue() % 2 == 0) {
+        txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      } else {
+        txn_manager_->Abort(txn);
+      }
+    }
+  };
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool_, num_threads_, finish);
+  EXPECT_EQ(timestamp_manager_->OldestTransactionStartTime(), timestamp_manager_->CurrentTime());
+
+  // GC is disabled, so we clean up the txns ourselves
+  for (const auto &thread_txns : txns) {
+    for (auto *const txn : thread_txns) delete txn;
+  }
+}
+
+}  // namespace terrier